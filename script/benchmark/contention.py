@@ -0,0 +1,90 @@
+#!/usr/bin/env python
+# encoding: utf-8
+
+## ==============================================
+## GOAL : Compare the concurrency control protocols under contention
+## ==============================================
+
+from __future__ import print_function
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+## ==============================================
+## CONFIGURATION
+## ==============================================
+
+# For each benchmark, the option that sets the contention, its default
+# values, and the columns of the throughput and the abort rate in
+# outputfile.summary. ycsb contends more with a higher skew, tpcc with fewer
+# warehouses.
+BENCHMARKS = {
+    "ycsb": ("-z", [0.0, 0.5, 0.8, 0.9, 0.99], 6, 7),
+    "tpcc": ("-w", [16, 8, 4, 2, 1], 3, 4),
+}
+
+SUMMARY_FILE = "outputfile.summary"
+
+PROTOCOLS = ["to", "occ", "2pl_nowait", "2pl_waitdie", "ssi"]
+
+## ==============================================
+## FUNCTIONS
+## ==============================================
+
+def run_benchmark(binary, benchmark, protocol, contention, extra_args):
+    """Run the benchmark once and return its throughput and abort rate."""
+    option, _, throughput_column, abort_rate_column = BENCHMARKS[benchmark]
+    work_dir = tempfile.mkdtemp()
+    try:
+        command = [binary,
+                   "-t", protocol,
+                   option, str(contention)] + extra_args
+        with open(os.devnull, "w") as devnull:
+            subprocess.check_call(command, cwd=work_dir,
+                                  stdout=devnull, stderr=devnull)
+        with open(os.path.join(work_dir, SUMMARY_FILE)) as summary:
+            fields = summary.readline().split()
+        return (float(fields[throughput_column]),
+                float(fields[abort_rate_column]))
+    finally:
+        shutil.rmtree(work_dir)
+
+## ==============================================
+## MAIN
+## ==============================================
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description="Measure throughput and abort rate against the contention",
+        epilog="Arguments after -- are passed to the benchmark")
+    parser.add_argument("binary", help="path to the ycsb or tpcc binary")
+    parser.add_argument("-b", "--benchmark", choices=sorted(BENCHMARKS),
+                        default="ycsb", help="benchmark the binary runs")
+    parser.add_argument("-p", "--protocols", nargs="+", default=PROTOCOLS,
+                        choices=PROTOCOLS,
+                        help="concurrency control protocols to compare")
+    parser.add_argument("-c", "--contentions", type=float, nargs="+",
+                        help="zipf thetas (ycsb) or warehouse counts (tpcc) "
+                             "to run at")
+    args, extra_args = parser.parse_known_args()
+    if extra_args and extra_args[0] == "--":
+        extra_args = extra_args[1:]
+
+    contentions = args.contentions or BENCHMARKS[args.benchmark][1]
+    if args.benchmark == "tpcc":
+        contentions = [int(contention) for contention in contentions]
+
+    print("level  " + " ".join("%-12s %-8s" % (protocol + " tput", "aborts")
+                               for protocol in args.protocols))
+    for contention in contentions:
+        results = []
+        for protocol in args.protocols:
+            results.append(run_benchmark(args.binary, args.benchmark,
+                                         protocol, contention, extra_args))
+        print("%-6g " % contention +
+              " ".join("%-12.1f %-8.4f" % result for result in results))
+        sys.stdout.flush()
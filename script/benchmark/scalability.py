@@ -0,0 +1,91 @@
+#!/usr/bin/env python
+# encoding: utf-8
+
+## ==============================================
+## GOAL : Plot throughput against the number of backends for ycsb and tpcc
+##        and the number of transaction ids a backend reserves at a time.
+##        Commit ids are always taken from the shared counter.
+## ==============================================
+
+from __future__ import print_function
+
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+
+## ==============================================
+## CONFIGURATION
+## ==============================================
+
+# Column of the throughput in the first line of outputfile.summary
+THROUGHPUT_COLUMN = {
+    "ycsb": 6,
+    "tpcc": 3,
+}
+
+SUMMARY_FILE = "outputfile.summary"
+
+## ==============================================
+## FUNCTIONS
+## ==============================================
+
+def run_benchmark(binary, benchmark, backend_count, txn_id_batch_size, extra_args):
+    """Run the benchmark once and return its throughput."""
+    work_dir = tempfile.mkdtemp()
+    try:
+        command = [binary,
+                   "-b", str(backend_count),
+                   "-s", str(txn_id_batch_size)] + extra_args
+        with open(os.devnull, "w") as devnull:
+            subprocess.check_call(command, cwd=work_dir,
+                                  stdout=devnull, stderr=devnull)
+        with open(os.path.join(work_dir, SUMMARY_FILE)) as summary:
+            fields = summary.readline().split()
+        return float(fields[THROUGHPUT_COLUMN[benchmark]])
+    finally:
+        shutil.rmtree(work_dir)
+
+
+def get_backend_counts(max_backend_count):
+    """1, 2, 4, ... up to and including max_backend_count."""
+    backend_counts = []
+    backend_count = 1
+    while backend_count < max_backend_count:
+        backend_counts.append(backend_count)
+        backend_count *= 2
+    backend_counts.append(max_backend_count)
+    return backend_counts
+
+## ==============================================
+## MAIN
+## ==============================================
+
+if __name__ == '__main__':
+    parser = argparse.ArgumentParser(
+        description="Measure how the throughput scales with the backends",
+        epilog="Arguments after -- are passed to the benchmark")
+    parser.add_argument("benchmark", choices=sorted(THROUGHPUT_COLUMN.keys()))
+    parser.add_argument("binary", help="path to the benchmark binary")
+    parser.add_argument("-m", "--max_backend_count", type=int, default=64)
+    parser.add_argument("-s", "--txn_id_batch_sizes", type=int, nargs="+",
+                        default=[1, 32],
+                        help="transaction id batch sizes to compare")
+    args, extra_args = parser.parse_known_args()
+    if extra_args and extra_args[0] == "--":
+        extra_args = extra_args[1:]
+
+    print("backends " + " ".join(
+        "batch=%-10d" % txn_id_batch_size
+        for txn_id_batch_size in args.txn_id_batch_sizes))
+    for backend_count in get_backend_counts(args.max_backend_count):
+        throughputs = []
+        for txn_id_batch_size in args.txn_id_batch_sizes:
+            throughputs.append(run_benchmark(
+                args.binary, args.benchmark, backend_count, txn_id_batch_size,
+                extra_args))
+        print("%-8d " % backend_count +
+              " ".join("%-16.1f" % throughput for throughput in throughputs))
+        sys.stdout.flush()
@@ -103,6 +103,14 @@ void IndexTuner::BuildIndex(storage::DataTable* table,
         new storage::Tuple(table_schema, true));
 
     auto tile_group = table->GetTileGroup(index_tile_group_offset);
+
+    // Skip the tile groups dropped by compaction
+    if (tile_group == nullptr) {
+      index->IncrementIndexedTileGroupOffset();
+      index_tile_group_offset++;
+      continue;
+    }
+
     auto tile_group_id = tile_group->GetTileGroupId();
     oid_t active_tuple_count = tile_group->GetNextTupleSlot();
 
@@ -0,0 +1,148 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set.cpp
+//
+// Identification: src/common/read_write_set.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/read_write_set.h"
+
+#include <algorithm>
+
+#include "common/macros.h"
+
+namespace peloton {
+
+namespace {
+
+// Sets up to this size are searched linearly
+const size_t kLinearSearchLimit = 16;
+
+// Sets that grew beyond this size are freed instead of being recycled
+const size_t kMaxRecycledSize = 4096;
+
+// Number of free sets kept by each thread
+const size_t kMaxFreeSetCount = 8;
+
+inline size_t HashLocation(const oid_t &tile_group_id, const oid_t &tuple_id) {
+  uint64_t key = (static_cast<uint64_t>(tile_group_id) << 32) | tuple_id;
+  return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32);
+}
+
+struct FreeSets {
+  std::vector<ReadWriteSet *> sets;
+
+  ~FreeSets() {
+    for (auto rw_set : sets) {
+      delete rw_set;
+    }
+  }
+};
+
+thread_local FreeSets free_sets;
+
+}  // namespace
+
+std::unique_ptr<ReadWriteSet, ReadWriteSet::Deleter> ReadWriteSet::Create() {
+  ReadWriteSet *rw_set;
+  if (free_sets.sets.empty() == false) {
+    rw_set = free_sets.sets.back();
+    free_sets.sets.pop_back();
+  } else {
+    rw_set = new ReadWriteSet();
+  }
+  return std::unique_ptr<ReadWriteSet, Deleter>(rw_set);
+}
+
+std::shared_ptr<ReadWriteSet> ReadWriteSet::CreateShared() {
+  return std::shared_ptr<ReadWriteSet>(Create());
+}
+
+void ReadWriteSet::Release(ReadWriteSet *rw_set) {
+  if (rw_set->entries_.capacity() > kMaxRecycledSize ||
+      free_sets.sets.size() >= kMaxFreeSetCount) {
+    delete rw_set;
+    return;
+  }
+  rw_set->Clear();
+  free_sets.sets.push_back(rw_set);
+}
+
+RWType *ReadWriteSet::Find(const oid_t &tile_group_id, const oid_t &tuple_id) {
+  if (index_.empty()) {
+    for (auto &entry : entries_) {
+      if (entry.tuple_id == tuple_id && entry.tile_group_id == tile_group_id) {
+        return &entry.type;
+      }
+    }
+    return nullptr;
+  }
+
+  size_t mask = index_.size() - 1;
+  for (size_t slot = HashLocation(tile_group_id, tuple_id) & mask;;
+       slot = (slot + 1) & mask) {
+    if (index_[slot] == 0) {
+      return nullptr;
+    }
+    auto &entry = entries_[index_[slot] - 1];
+    if (entry.tuple_id == tuple_id && entry.tile_group_id == tile_group_id) {
+      return &entry.type;
+    }
+  }
+}
+
+void ReadWriteSet::Insert(const oid_t &tile_group_id, const oid_t &tuple_id,
+                          const RWType &type) {
+  PL_ASSERT(Find(tile_group_id, tuple_id) == nullptr);
+  entries_.push_back({tile_group_id, tuple_id, type});
+
+  if (index_.empty()) {
+    if (entries_.size() > kLinearSearchLimit) {
+      RebuildIndex(4 * kLinearSearchLimit);
+    }
+  } else if (2 * entries_.size() > index_.size()) {
+    // keep the load factor of the index under one half
+    RebuildIndex(2 * index_.size());
+  } else {
+    AddToIndex(static_cast<uint32_t>(entries_.size() - 1));
+  }
+}
+
+void ReadWriteSet::Set(const oid_t &tile_group_id, const oid_t &tuple_id,
+                       const RWType &type) {
+  auto entry_type = Find(tile_group_id, tuple_id);
+  if (entry_type != nullptr) {
+    *entry_type = type;
+  } else {
+    Insert(tile_group_id, tuple_id, type);
+  }
+}
+
+void ReadWriteSet::Clear() {
+  entries_.clear();
+  index_.clear();
+}
+
+void ReadWriteSet::RebuildIndex(size_t capacity) {
+  index_.assign(capacity, 0);
+  for (size_t position = 0; position < entries_.size(); position++) {
+    AddToIndex(static_cast<uint32_t>(position));
+  }
+}
+
+void ReadWriteSet::AddToIndex(uint32_t position) {
+  auto &entry = entries_[position];
+  size_t mask = index_.size() - 1;
+  size_t slot = HashLocation(entry.tile_group_id, entry.tuple_id) & mask;
+  while (index_[slot] != 0) {
+    slot = (slot + 1) & mask;
+  }
+  index_[slot] = position + 1;
+}
+
+}  // End peloton namespace
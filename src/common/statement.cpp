@@ -63,4 +63,10 @@ const std::shared_ptr<planner::AbstractPlan>& Statement::GetPlanTree() const {
   return plan_tree;
 }
 
+void Statement::SetReadOnlyBegin(bool read_only_begin_) {
+  read_only_begin = read_only_begin_;
+}
+
+bool Statement::IsReadOnlyBegin() const { return read_only_begin; }
+
 }  // namespace peloton
@@ -0,0 +1,181 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// typed_value.cpp
+//
+// Identification: src/common/typed_value.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/typed_value.h"
+#include "common/boolean_value.h"
+#include "common/decimal_value.h"
+#include "common/numeric_value.h"
+#include "common/timestamp_value.h"
+#include "common/varlen_value.h"
+
+#include <sstream>
+#include <boost/functional/hash.hpp>
+
+namespace peloton {
+namespace common {
+
+TypedValue TypedValue::GetNullValueByType(Type::TypeId type_id) {
+  switch (type_id) {
+    case Type::BOOLEAN:
+      return GetBoolean(PELOTON_BOOLEAN_NULL);
+    case Type::TINYINT:
+      return TypedValue(PELOTON_INT8_NULL);
+    case Type::SMALLINT:
+      return TypedValue(PELOTON_INT16_NULL);
+    case Type::INTEGER:
+      return TypedValue(PELOTON_INT32_NULL);
+    case Type::BIGINT:
+      return TypedValue(PELOTON_INT64_NULL);
+    case Type::DECIMAL:
+      return TypedValue(PELOTON_DECIMAL_NULL);
+    case Type::TIMESTAMP:
+      return GetTimestamp(PELOTON_TIMESTAMP_NULL);
+    case Type::VARCHAR:
+      return TypedValue(nullptr, 0);
+    default:
+      break;
+  }
+  throw Exception(EXCEPTION_TYPE_UNKNOWN_TYPE, "Unknown type.");
+}
+
+TypedValue TypedValue::FromValue(const Value &value) {
+  TypedValue result;
+  result.type_id_ = value.GetTypeId();
+  switch (result.type_id_) {
+    case Type::BOOLEAN:
+    case Type::TINYINT:
+      result.value_.tinyint = value.GetAs<int8_t>();
+      return result;
+    case Type::SMALLINT:
+      result.value_.smallint = value.GetAs<int16_t>();
+      return result;
+    case Type::INTEGER:
+    case Type::PARAMETER_OFFSET:
+      result.value_.integer = value.GetAs<int32_t>();
+      return result;
+    case Type::BIGINT:
+      result.value_.bigint = value.GetAs<int64_t>();
+      return result;
+    case Type::DECIMAL:
+      result.value_.decimal = value.GetAs<double>();
+      return result;
+    case Type::TIMESTAMP:
+      result.value_.timestamp = value.GetAs<uint64_t>();
+      return result;
+    case Type::VARCHAR: {
+      auto &varlen = static_cast<const VarlenValue &>(value);
+      result.len_ = varlen.GetLength();
+      result.value_.ptr = const_cast<char *>(varlen.GetData());
+      return result;
+    }
+    default:
+      break;
+  }
+  throw Exception(EXCEPTION_TYPE_UNKNOWN_TYPE, "Unknown type.");
+}
+
+Value *TypedValue::ToValue() const {
+  switch (type_id_) {
+    case Type::BOOLEAN:
+      return new BooleanValue(value_.boolean);
+    case Type::TINYINT:
+      return new IntegerValue(value_.tinyint);
+    case Type::SMALLINT:
+      return new IntegerValue(value_.smallint);
+    case Type::INTEGER:
+      return new IntegerValue(value_.integer);
+    case Type::PARAMETER_OFFSET:
+      return new IntegerValue(value_.integer, true);
+    case Type::BIGINT:
+      return new IntegerValue(value_.bigint);
+    case Type::DECIMAL:
+      return new DecimalValue(value_.decimal);
+    case Type::TIMESTAMP:
+      return new TimestampValue(value_.timestamp);
+    case Type::VARCHAR:
+      return new VarlenValue(value_.ptr, len_);
+    default:
+      break;
+  }
+  throw Exception(EXCEPTION_TYPE_UNKNOWN_TYPE, "Unknown type.");
+}
+
+size_t TypedValue::Hash() const {
+  size_t seed = 0;
+  HashCombine(seed);
+  return seed;
+}
+
+// Integral values hash the same regardless of their width so that equal
+// values of different integer types land in the same bucket.
+void TypedValue::HashCombine(size_t &seed) const {
+  switch (type_id_) {
+    case Type::BOOLEAN:
+      boost::hash_combine(seed, value_.boolean);
+      break;
+    case Type::TINYINT:
+    case Type::SMALLINT:
+    case Type::INTEGER:
+    case Type::PARAMETER_OFFSET:
+    case Type::BIGINT:
+      boost::hash_combine(seed, GetAsBigInt());
+      break;
+    case Type::DECIMAL:
+      boost::hash_combine(seed, value_.decimal);
+      break;
+    case Type::TIMESTAMP:
+      boost::hash_combine(seed, value_.timestamp);
+      break;
+    case Type::VARCHAR:
+      if (IsNull() || len_ == PELOTON_VARCHAR_MAX_LEN)
+        boost::hash_combine(seed, len_);
+      else
+        boost::hash_range(seed, value_.ptr, value_.ptr + len_);
+      break;
+    default:
+      throw Exception(EXCEPTION_TYPE_UNKNOWN_TYPE, "Unknown type.");
+  }
+}
+
+std::string TypedValue::ToString() const {
+  if (IsNull()) return "null";
+  std::ostringstream os;
+  switch (type_id_) {
+    case Type::BOOLEAN:
+      os << (value_.boolean ? "true" : "false");
+      break;
+    case Type::TINYINT:
+    case Type::SMALLINT:
+    case Type::INTEGER:
+    case Type::PARAMETER_OFFSET:
+    case Type::BIGINT:
+      os << GetAsBigInt();
+      break;
+    case Type::DECIMAL:
+      os << value_.decimal;
+      break;
+    case Type::TIMESTAMP:
+      os << value_.timestamp;
+      break;
+    case Type::VARCHAR:
+      if (len_ == PELOTON_VARCHAR_MAX_LEN) return "varlen_max";
+      // Stored strings carry their terminating null character
+      os << std::string(value_.ptr, len_ - 1);
+      break;
+    default:
+      throw Exception(EXCEPTION_TYPE_UNKNOWN_TYPE, "Unknown type.");
+  }
+  return os.str();
+}
+
+}  // namespace common
+}  // namespace peloton
@@ -13,9 +13,327 @@
 
 #include "concurrency/epoch_manager.h"
 
+#include <algorithm>
+
+#include "common/logger.h"
+
 namespace peloton {
 namespace concurrency {
 
-//  volatile cid_t EpochManager::curr_epoch_ = 1;
+constexpr size_t EpochSlot::INVALID_EPOCH;
+
+// Slot of the thread in the manager it last used
+struct EpochManager::LocalEpochs {
+  EpochManager *manager = nullptr;
+  EpochSlot *slot = nullptr;
+
+  ~LocalEpochs() {
+    if (slot != nullptr) {
+      manager->ReleaseSlot(slot);
+    }
+  }
+};
+
+namespace {
+
+// Add a begin cid to the epoch history of the slot. The slot has a single
+// writer, so the version works as a sequence lock for the epoch thread.
+void RecordBeginCid(EpochSlot *slot, size_t epoch, cid_t begin_cid) {
+  auto version = slot->version.load(std::memory_order_relaxed);
+  slot->version.store(version + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  if (slot->last_epoch.load(std::memory_order_relaxed) == epoch) {
+    if (begin_cid > slot->last_max_cid.load(std::memory_order_relaxed)) {
+      slot->last_max_cid.store(begin_cid, std::memory_order_relaxed);
+    }
+  } else {
+    slot->prev_epoch.store(slot->last_epoch.load(std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+    slot->prev_max_cid.store(
+        slot->last_max_cid.load(std::memory_order_relaxed),
+        std::memory_order_relaxed);
+    slot->last_epoch.store(epoch, std::memory_order_relaxed);
+    slot->last_max_cid.store(begin_cid, std::memory_order_relaxed);
+  }
+
+  // Must be ordered before the check of the current epoch in EnterEpoch
+  slot->version.store(version + 2);
+}
+
+// Get the max begin cid registered in the slot for the given epoch
+cid_t GetMaxBeginCid(const EpochSlot *slot, size_t epoch) {
+  while (true) {
+    auto version = slot->version.load();
+    if (version & 1) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    auto last_epoch = slot->last_epoch.load(std::memory_order_relaxed);
+    auto last_max_cid = slot->last_max_cid.load(std::memory_order_relaxed);
+    auto prev_epoch = slot->prev_epoch.load(std::memory_order_relaxed);
+    auto prev_max_cid = slot->prev_max_cid.load(std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot->version.load(std::memory_order_relaxed) != version) {
+      continue;
+    }
+
+    if (last_epoch == epoch) {
+      return last_max_cid;
+    } else if (prev_epoch == epoch) {
+      return prev_max_cid;
+    }
+    return 0;
+  }
+}
+
+}  // namespace
+
+EpochManager::EpochManager()
+    : current_epoch_(0),
+      max_dead_cid_(0),
+      advance_round_(0),
+      max_finished_cid_(0),
+      finish_(false) {
+  ts_thread_ = std::thread(&EpochManager::Start, this);
+}
+
+EpochManager::~EpochManager() {
+  finish_ = true;
+  ts_thread_.join();
+}
+
+void EpochManager::Reset() {
+  finish_ = true;
+  ts_thread_.join();
+
+  {
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    for (auto &slot : slots_) {
+      slot->Init();
+    }
+  }
+  closed_epochs_.clear();
+  max_finished_cid_ = 0;
+  current_epoch_ = 0;
+  max_dead_cid_ = 0;
+
+  finish_ = false;
+  ts_thread_ = std::thread(&EpochManager::Start, this);
+}
+
+size_t EpochManager::EnterEpoch(cid_t begin_cid, EpochSlot **slot) {
+  auto local_slot = GetLocalEpochs().slot;
+  if (slot != nullptr) {
+    *slot = local_slot;
+  }
+
+  // Publish the txn in the epoch before checking that the epoch is still
+  // open. Either the epoch thread sees the txn when it closes the epoch, or
+  // the txn sees the new epoch and registers again in it.
+  local_slot->lock.Lock();
+  auto &active = local_slot->active;
+  auto epoch = current_epoch_.load();
+  while (true) {
+    if (active.empty()) {
+      local_slot->active_epoch.store(epoch);
+    }
+    RecordBeginCid(local_slot, epoch, begin_cid);
+
+    auto current_epoch = current_epoch_.load();
+    if (current_epoch == epoch) {
+      break;
+    }
+    epoch = current_epoch;
+  }
+
+  if (active.empty() == false && active.back().first == epoch) {
+    active.back().second++;
+  } else {
+    active.emplace_back(epoch, 1);
+  }
+  local_slot->lock.Unlock();
+
+  return epoch;
+}
+
+void EpochManager::ExitEpoch(size_t epoch, EpochSlot *slot) {
+  if (slot == nullptr) {
+    slot = GetLocalEpochs().slot;
+  }
+
+  slot->lock.Lock();
+  auto &active = slot->active;
+  auto itr = std::find_if(active.begin(), active.end(),
+                          [epoch](const std::pair<size_t, size_t> &entry) {
+                            return entry.first == epoch;
+                          });
+  if (itr == active.end()) {
+    slot->lock.Unlock();
+    LOG_ERROR("Exit epoch %lu that was not entered in this slot", epoch);
+    PL_ASSERT(false);
+    return;
+  }
+
+  itr->second--;
+  if (itr->second == 0) {
+    active.erase(itr);
+    auto active_epoch =
+        active.empty() ? EpochSlot::INVALID_EPOCH : active.front().first;
+    slot->active_epoch.store(active_epoch, std::memory_order_release);
+  }
+  slot->lock.Unlock();
+}
+
+cid_t EpochManager::EnterSnapshot(cid_t min_cid, EpochSlot **slot) {
+  auto local_slot = GetLocalEpochs().slot;
+  if (slot != nullptr) {
+    *slot = local_slot;
+  }
+
+  // Register min_cid as a begin cid, so the max finished cid reaches it once
+  // its epoch and every older running txn are done
+  if (max_finished_cid_.load() < min_cid) {
+    ExitEpoch(EnterEpoch(min_cid, nullptr), local_slot);
+    while (max_finished_cid_.load() < min_cid) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  // The max finished cid is only read between two rounds of the epoch thread,
+  // and the pin is only kept if no round started in the meantime. The next
+  // round then sees the pin before it publishes a new max dead cid.
+  local_slot->lock.Lock();
+  auto &snapshots = local_slot->snapshots;
+  while (true) {
+    auto round = advance_round_.load();
+    if (round & 1) {
+      std::this_thread::yield();
+      continue;
+    }
+
+    // The max dead cid of this round is at most the max finished cid, so no
+    // version of the snapshot has been reclaimed
+    auto snapshot_cid = max_finished_cid_.load();
+
+    // Older snapshots in the slot already hold back the max dead cid
+    if (snapshots.empty()) {
+      local_slot->snapshot_cid.store(snapshot_cid);
+    }
+
+    if (advance_round_.load() == round) {
+      snapshots.push_back(snapshot_cid);
+      local_slot->lock.Unlock();
+      return snapshot_cid;
+    }
+  }
 }
+
+void EpochManager::ExitSnapshot(cid_t snapshot_cid, EpochSlot *slot) {
+  if (slot == nullptr) {
+    slot = GetLocalEpochs().slot;
+  }
+
+  slot->lock.Lock();
+  auto &snapshots = slot->snapshots;
+  auto itr = std::find(snapshots.begin(), snapshots.end(), snapshot_cid);
+  if (itr == snapshots.end()) {
+    slot->lock.Unlock();
+    LOG_ERROR("Exit snapshot %lu that was not entered in this slot",
+              snapshot_cid);
+    PL_ASSERT(false);
+    return;
+  }
+
+  snapshots.erase(itr);
+  auto oldest_snapshot_cid = snapshots.empty() ? MAX_CID : snapshots.front();
+  slot->snapshot_cid.store(oldest_snapshot_cid, std::memory_order_release);
+  slot->lock.Unlock();
+}
+
+void EpochManager::Start() {
+  while (!finish_) {
+    // the epoch advances every 40 milliseconds.
+    std::this_thread::sleep_for(std::chrono::milliseconds(EPOCH_LENGTH));
+
+    AdvanceEpoch();
+  }
 }
+
+void EpochManager::AdvanceEpoch() {
+  advance_round_++;
+
+  // Txns that read the closed epoch after this point register again in the
+  // new one, so the slots hold every txn of the closed epoch
+  auto closed_epoch = current_epoch_.fetch_add(1);
+
+  cid_t closed_max_cid = 0;
+  size_t oldest_epoch = closed_epoch + 1;
+  cid_t oldest_snapshot_cid = MAX_CID;
+  {
+    std::lock_guard<std::mutex> lock(slots_mutex_);
+    for (auto &slot : slots_) {
+      closed_max_cid =
+          std::max(closed_max_cid, GetMaxBeginCid(slot.get(), closed_epoch));
+      oldest_epoch = std::min(oldest_epoch, slot->active_epoch.load());
+      oldest_snapshot_cid =
+          std::min(oldest_snapshot_cid, slot->snapshot_cid.load());
+    }
+  }
+
+  if (closed_max_cid != 0) {
+    closed_epochs_.emplace_back(closed_epoch, closed_max_cid);
+  }
+
+  // Closed epochs older than every running txn are dead
+  while (closed_epochs_.empty() == false &&
+         closed_epochs_.front().first < oldest_epoch) {
+    max_finished_cid_ =
+        std::max(max_finished_cid_.load(), closed_epochs_.front().second);
+    closed_epochs_.pop_front();
+  }
+  max_dead_cid_ = std::min(max_finished_cid_.load(), oldest_snapshot_cid);
+
+  advance_round_++;
+}
+
+EpochManager::LocalEpochs &EpochManager::GetLocalEpochs() {
+  static thread_local LocalEpochs local;
+
+  if (local.manager != this) {
+    if (local.slot != nullptr) {
+      local.manager->ReleaseSlot(local.slot);
+    }
+    local.manager = this;
+    local.slot = AcquireSlot();
+  }
+  return local;
+}
+
+EpochSlot *EpochManager::AcquireSlot() {
+  std::lock_guard<std::mutex> lock(slots_mutex_);
+
+  // Slots of finished threads keep their history, which still describes
+  // epochs the epoch thread may not have closed yet, and the txns they
+  // handed to other threads
+  for (auto &slot : slots_) {
+    if (slot->in_use == false) {
+      slot->in_use = true;
+      return slot.get();
+    }
+  }
+
+  slots_.emplace_back(new EpochSlot());
+  slots_.back()->in_use = true;
+  return slots_.back().get();
+}
+
+void EpochManager::ReleaseSlot(EpochSlot *slot) {
+  std::lock_guard<std::mutex> lock(slots_mutex_);
+  slot->in_use = false;
+}
+
+}  // End concurrency namespace
+}  // End peloton namespace
@@ -0,0 +1,117 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager.cpp
+//
+// Identification: src/concurrency/optimistic_transaction_manager.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/optimistic_transaction_manager.h"
+
+#include "catalog/manager.h"
+#include "common/logger.h"
+#include "common/platform.h"
+#include "concurrency/transaction.h"
+
+namespace peloton {
+namespace concurrency {
+
+OptimisticTransactionManager &OptimisticTransactionManager::GetInstance() {
+  static OptimisticTransactionManager txn_manager;
+  return txn_manager;
+}
+
+bool OptimisticTransactionManager::AcquireOwnership(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  // a declared read-only transaction never writes.
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    return false;
+  }
+
+  if (tile_group_header->SetAtomicTransactionId(
+          tuple_id, current_txn->GetTransactionId()) == false) {
+    return false;
+  }
+
+  // a newer version may have been committed after the current transaction
+  // began. the end commit id cannot change anymore once we own the tuple.
+  if (tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+    tile_group_header->SetTransactionId(tuple_id, INITIAL_TXN_ID);
+    return false;
+  }
+
+  return true;
+}
+
+bool OptimisticTransactionManager::PerformRead(
+    Transaction *const current_txn, const ItemPointer &location) {
+
+  LOG_TRACE("PerformRead (%u, %u)\n", location.block, location.offset);
+  auto tile_group_header =
+      catalog::Manager::GetInstance().GetTileGroup(location.block)->GetHeader();
+
+  // the read is only recorded in the read set, and validated at commit time.
+  // a declared read-only transaction reads a snapshot that no running
+  // transaction can change, so it does not need to validate anything.
+  if (current_txn->IsDeclaredReadOnly() == false &&
+      IsOwner(current_txn, tile_group_header, location.offset) == false) {
+    current_txn->RecordRead(location);
+  }
+
+  // Increment table read op stats
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementTableReads(
+        location.block);
+  }
+  return true;
+}
+
+Result OptimisticTransactionManager::CommitTransaction(
+    Transaction *const current_txn) {
+  LOG_TRACE("Committing peloton txn : %lu ", current_txn->GetTransactionId());
+
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    return TimestampOrderingTransactionManager::CommitTransaction(current_txn);
+  }
+
+  auto &manager = catalog::Manager::GetInstance();
+  auto txn_id = current_txn->GetTransactionId();
+
+  // every tuple in the write set is already owned by the current transaction.
+  cid_t end_commit_id = GetNextCommitId();
+
+  // validate the read set.
+  for (auto &tuple_entry : current_txn->GetReadWriteSet()) {
+    if (tuple_entry.type != RW_TYPE_READ) {
+      continue;
+    }
+
+    auto tile_group_header =
+        manager.GetTileGroup(tuple_entry.tile_group_id)->GetHeader();
+    auto tuple_slot = tuple_entry.tuple_id;
+
+    // a committing transaction sets the end commit id before it releases the
+    // ownership, so the ownership must be read first.
+    txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_slot);
+    COMPILER_MEMORY_FENCE;
+    cid_t tuple_end_cid = tile_group_header->GetEndCommitId(tuple_slot);
+
+    if ((tuple_txn_id != INITIAL_TXN_ID && tuple_txn_id != txn_id) ||
+        tuple_end_cid != MAX_CID) {
+      LOG_TRACE("Validation failed on (%u, %u)", tuple_entry.tile_group_id,
+                tuple_slot);
+      return AbortTransaction(current_txn);
+    }
+  }
+
+  return InstallTransaction(current_txn, end_commit_id);
+}
+
+}  // End concurrency namespace
+}  // End peloton namespace
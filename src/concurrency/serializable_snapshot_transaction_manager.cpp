@@ -0,0 +1,170 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// serializable_snapshot_transaction_manager.cpp
+//
+// Identification: src/concurrency/serializable_snapshot_transaction_manager.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/serializable_snapshot_transaction_manager.h"
+
+#include <algorithm>
+
+#include "catalog/manager.h"
+#include "common/logger.h"
+#include "concurrency/transaction.h"
+
+namespace peloton {
+namespace concurrency {
+
+SerializableSnapshotTransactionManager &
+SerializableSnapshotTransactionManager::GetInstance() {
+  static SerializableSnapshotTransactionManager txn_manager;
+  return txn_manager;
+}
+
+cid_t *SerializableSnapshotTransactionManager::GetPredecessorField(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  return (cid_t *)(tile_group_header->GetReservedFieldRef(tuple_id) +
+                   PREDECESSOR_OFFSET);
+}
+
+cid_t *SerializableSnapshotTransactionManager::GetSuccessorField(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  return (cid_t *)(tile_group_header->GetReservedFieldRef(tuple_id) +
+                   SUCCESSOR_OFFSET);
+}
+
+void SerializableSnapshotTransactionManager::InitTupleReserved(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t tuple_id) {
+  TimestampOrderingTransactionManager::InitTupleReserved(tile_group_header,
+                                                         tuple_id);
+  *GetSuccessorField(tile_group_header, tuple_id) = MAX_CID;
+}
+
+bool SerializableSnapshotTransactionManager::PerformRead(
+    Transaction *const current_txn, const ItemPointer &location) {
+
+  LOG_TRACE("PerformRead (%u, %u)\n", location.block, location.offset);
+  auto tile_group_header =
+      catalog::Manager::GetInstance().GetTileGroup(location.block)->GetHeader();
+
+  // unlike optimistic concurrency control, a declared read-only transaction
+  // records its reads too. its snapshot is consistent, but it can still be the
+  // reader that closes a dangerous structure.
+  if (IsOwner(current_txn, tile_group_header, location.offset) == false) {
+    current_txn->RecordRead(location);
+  }
+
+  // Increment table read op stats
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementTableReads(
+        location.block);
+  }
+  return true;
+}
+
+Result SerializableSnapshotTransactionManager::CommitTransaction(
+    Transaction *const current_txn) {
+  LOG_TRACE("Committing peloton txn : %lu ", current_txn->GetTransactionId());
+
+  auto &manager = catalog::Manager::GetInstance();
+
+  // the versions that were read or overwritten. they are locked in a fixed
+  // order, so that two transactions that share a version check and publish
+  // their dependencies one after the other.
+  std::vector<ReadWriteEntry> versions;
+  for (auto &tuple_entry : current_txn->GetReadWriteSet()) {
+    if (tuple_entry.type != RW_TYPE_INSERT &&
+        tuple_entry.type != RW_TYPE_INS_DEL) {
+      versions.push_back(tuple_entry);
+    }
+  }
+  std::sort(versions.begin(), versions.end(),
+            [](const ReadWriteEntry &lhs, const ReadWriteEntry &rhs) {
+              return lhs.tile_group_id < rhs.tile_group_id ||
+                     (lhs.tile_group_id == rhs.tile_group_id &&
+                      lhs.tuple_id < rhs.tuple_id);
+            });
+
+  std::vector<storage::TileGroupHeader *> headers;
+  headers.reserve(versions.size());
+  for (auto &version : versions) {
+    auto tile_group_header =
+        manager.GetTileGroup(version.tile_group_id)->GetHeader();
+    GetSpinlockField(tile_group_header, version.tuple_id)->Lock();
+    headers.push_back(tile_group_header);
+  }
+
+  // the latest commit id that the transaction must be serialized after: the
+  // creators of the versions it read or overwrote, and the readers of the
+  // versions it overwrote.
+  cid_t predecessor_cid = 0;
+  // the earliest commit id that the transaction must be serialized before,
+  // inherited from the transactions that overwrote the versions it read.
+  cid_t successor_cid = MAX_CID;
+
+  for (size_t i = 0; i < versions.size(); ++i) {
+    auto tile_group_header = headers[i];
+    auto tuple_slot = versions[i].tuple_id;
+
+    predecessor_cid = std::max(
+        predecessor_cid, tile_group_header->GetBeginCommitId(tuple_slot));
+
+    if (versions[i].type == RW_TYPE_READ) {
+      // the successor is published before the end commit id, so a version
+      // whose overwriting transaction is still installing is covered too.
+      successor_cid = std::min(
+          successor_cid, *GetSuccessorField(tile_group_header, tuple_slot));
+    } else {
+      predecessor_cid = std::max(
+          predecessor_cid, *GetPredecessorField(tile_group_header, tuple_slot));
+    }
+  }
+
+  // every predecessor published its commit id before the locks above were
+  // taken, so it is older than the one taken now.
+  cid_t end_commit_id = GetNextCommitId();
+  PL_ASSERT(end_commit_id > predecessor_cid);
+  successor_cid = std::min(successor_cid, end_commit_id);
+
+  if (successor_cid <= predecessor_cid) {
+    LOG_TRACE("Dangerous structure: successor %lu, predecessor %lu",
+              successor_cid, predecessor_cid);
+    for (size_t i = 0; i < versions.size(); ++i) {
+      GetSpinlockField(headers[i], versions[i].tuple_id)->Unlock();
+    }
+    return AbortTransaction(current_txn);
+  }
+
+  for (size_t i = 0; i < versions.size(); ++i) {
+    auto tile_group_header = headers[i];
+    auto tuple_slot = versions[i].tuple_id;
+
+    if (versions[i].type == RW_TYPE_READ) {
+      auto predecessor_field =
+          GetPredecessorField(tile_group_header, tuple_slot);
+      *predecessor_field = std::max(*predecessor_field, end_commit_id);
+    } else {
+      *GetSuccessorField(tile_group_header, tuple_slot) = successor_cid;
+    }
+
+    GetSpinlockField(tile_group_header, tuple_slot)->Unlock();
+  }
+
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    return TimestampOrderingTransactionManager::CommitTransaction(current_txn);
+  }
+
+  return InstallTransaction(current_txn, end_commit_id);
+}
+
+}  // End concurrency namespace
+}  // End peloton namespace
@@ -93,8 +93,33 @@ Transaction *TimestampOrderingTransactionManager::BeginTransaction() {
   cid_t begin_cid = GetNextCommitId();
   Transaction *txn = new Transaction(txn_id, begin_cid);
 
-  auto eid = EpochManagerFactory::GetInstance().EnterEpoch(begin_cid);
+  EpochSlot *epoch_slot = nullptr;
+  auto eid =
+      EpochManagerFactory::GetInstance().EnterEpoch(begin_cid, &epoch_slot);
   txn->SetEpochId(eid);
+  txn->SetEpochSlot(epoch_slot);
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()
+        ->GetTxnLatencyMetric()
+        .StartTimer();
+  }
+
+  return txn;
+}
+
+Transaction *TimestampOrderingTransactionManager::BeginReadOnlyTransaction() {
+  txn_id_t txn_id = GetNextTransactionId();
+
+  // The snapshot covers every cid handed out so far, so it sees each commit
+  // that finished before the txn began. Every txn that could still write
+  // below the snapshot has finished, so the txn does not need to leave any
+  // trace on the tuples it reads.
+  EpochSlot *epoch_slot = nullptr;
+  cid_t snapshot_cid = EpochManagerFactory::GetInstance().EnterSnapshot(
+      GetCurrentCommitId() - 1, &epoch_slot);
+  Transaction *txn = new Transaction(txn_id, snapshot_cid, true);
+  txn->SetEpochSlot(epoch_slot);
 
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     stats::BackendStatsContext::GetInstance()
@@ -106,21 +131,48 @@ Transaction *TimestampOrderingTransactionManager::BeginTransaction() {
 }
 
 void TimestampOrderingTransactionManager::EndTransaction(Transaction *current_txn) {
-  EpochManagerFactory::GetInstance().ExitEpoch(current_txn->GetEpochId());
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    // nothing to recycle and nothing to log. the response still waits for
+    // the commits in the snapshot to be durable.
+    EpochManagerFactory::GetInstance().ExitSnapshot(
+        current_txn->GetBeginCommitId(), current_txn->GetEpochSlot());
+
+    if (current_txn->GetResult() == RESULT_SUCCESS &&
+        current_txn->GetCommitCallback()) {
+      logging::LogManager::GetInstance().ReleaseSnapshotOnFlush(
+          current_txn->GetBeginCommitId(), current_txn->GetCommitCallback());
+    }
+
+    delete current_txn;
+    current_txn = nullptr;
+
+    if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+      stats::BackendStatsContext::GetInstance()
+          ->GetTxnLatencyMetric()
+          .RecordLatency();
+    }
+    return;
+  }
+
   auto &log_manager = logging::LogManager::GetInstance();
 
   if (current_txn->GetResult() == RESULT_SUCCESS) {
     gc::GCManagerFactory::GetInstance().
-        RecycleTransaction(current_txn->GetGCSetPtr(), current_txn->GetBeginCommitId(), GC_SET_TYPE_COMMITTED);
+        RecycleTransaction(current_txn->GetGCSetPtr(), current_txn->GetEndCommitId(), GC_SET_TYPE_COMMITTED);
         // Log the transaction's commit
-        // For time stamp ordering, every transaction only has one timestamp
-        log_manager.LogCommitTransaction(current_txn->GetBeginCommitId());
+        log_manager.LogCommitTransaction(current_txn->GetEndCommitId(),
+                                         current_txn->GetCommitCallback());
   } else {
     gc::GCManagerFactory::GetInstance().
         RecycleTransaction(current_txn->GetGCSetPtr(), GetNextCommitId(), GC_SET_TYPE_ABORTED);
     log_manager.DoneLogging();
   }
 
+  // the commit is logged before the txn leaves its epoch, so a snapshot that
+  // covers the commit knows which commit id has to be durable
+  EpochManagerFactory::GetInstance().ExitEpoch(current_txn->GetEpochId(),
+                                              current_txn->GetEpochSlot());
+
   delete current_txn;
   current_txn = nullptr;
 
@@ -293,7 +345,9 @@ bool TimestampOrderingTransactionManager::IsOwnable(
     const oid_t &tuple_id) {
   auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
   auto tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
-  return tuple_txn_id == INITIAL_TXN_ID &&
+  // a declared read-only transaction never writes.
+  return current_txn->IsDeclaredReadOnly() == false &&
+         tuple_txn_id == INITIAL_TXN_ID &&
          tuple_end_cid > current_txn->GetBeginCommitId();
 }
 
@@ -301,6 +355,11 @@ bool TimestampOrderingTransactionManager::AcquireOwnership(
     Transaction *const current_txn,
     const storage::TileGroupHeader *const tile_group_header,
     const oid_t &tuple_id) {
+  // a declared read-only transaction never writes.
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    return false;
+  }
+
   auto txn_id = current_txn->GetTransactionId();
 
   // to acquire the ownership, we must guarantee that no other transactions that
@@ -369,6 +428,17 @@ bool TimestampOrderingTransactionManager::PerformRead(
     }
     return true;
   }
+  // a declared read-only transaction reads below every running writer, so it
+  // neither needs to block writers nor to validate its reads.
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    // Increment table read op stats
+    if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+      stats::BackendStatsContext::GetInstance()->IncrementTableReads(
+          location.block);
+    }
+    return true;
+  }
+
   // if the current transaction does not own this tuple, then attemp to set last
   // reader cid.
   if (SetLastReaderCommitId(tile_group_header, tuple_id,
@@ -391,6 +461,7 @@ bool TimestampOrderingTransactionManager::PerformRead(
 void TimestampOrderingTransactionManager::PerformInsert(
     Transaction *const current_txn, const ItemPointer &location,
     ItemPointer *index_entry_ptr) {
+  PL_ASSERT(current_txn->IsDeclaredReadOnly() == false);
 
   oid_t tile_group_id = location.block;
   oid_t tuple_id = location.offset;
@@ -673,11 +744,30 @@ Result TimestampOrderingTransactionManager::CommitTransaction(
     Transaction *const current_txn) {
   LOG_TRACE("Committing peloton txn : %lu ", current_txn->GetTransactionId());
 
+  // a declared read-only transaction has nothing to install or to log.
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    Result result = current_txn->GetResult();
+
+    EndTransaction(current_txn);
+
+    // Increment # txns committed metric
+    if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+      stats::BackendStatsContext::GetInstance()->IncrementTxnCommitted(0);
+    }
+
+    return result;
+  }
+
+  // for time stamp ordering, every transaction only has one timestamp.
+  return InstallTransaction(current_txn, current_txn->GetBeginCommitId());
+}
+
+Result TimestampOrderingTransactionManager::InstallTransaction(
+    Transaction *const current_txn, const cid_t end_commit_id) {
   auto &manager = catalog::Manager::GetInstance();
   auto &log_manager = logging::LogManager::GetInstance();
 
-  // generate transaction id.
-  cid_t end_commit_id = current_txn->GetBeginCommitId();
+  current_txn->SetEndCommitId(end_commit_id);
   log_manager.LogBeginTransaction(end_commit_id);
 
   auto &rw_set = current_txn->GetReadWriteSet();
@@ -688,7 +778,8 @@ Result TimestampOrderingTransactionManager::CommitTransaction(
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     if (!rw_set.empty()) {
       database_id =
-          manager.GetTileGroup(rw_set.begin()->first)->GetDatabaseId();
+          manager.GetTileGroup(rw_set.begin()->tile_group_id)
+              ->GetDatabaseId();
     }
   }
 
@@ -696,109 +787,113 @@ Result TimestampOrderingTransactionManager::CommitTransaction(
   // 1. install a new version for update operations;
   // 2. install an empty version for delete operations;
   // 3. install a new tuple for insert operations.
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
+  for (auto &tuple_entry : rw_set) {
+    oid_t tile_group_id = tuple_entry.tile_group_id;
     auto tile_group = manager.GetTileGroup(tile_group_id);
     auto tile_group_header = tile_group->GetHeader();
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RW_TYPE_UPDATE) {
-        // we must guarantee that, at any time point, only one version is
-        // visible.
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
 
-        PL_ASSERT(new_version.IsNull() == false);
+    auto tuple_slot = tuple_entry.tuple_id;
+    if (tuple_entry.type == RW_TYPE_UPDATE) {
+      // we must guarantee that, at any time point, only one version is
+      // visible.
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
 
-        auto cid = tile_group_header->GetEndCommitId(tuple_slot);
-        PL_ASSERT(cid > end_commit_id);
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-        new_tile_group_header->SetBeginCommitId(new_version.offset,
-                                                end_commit_id);
-        new_tile_group_header->SetEndCommitId(new_version.offset, cid);
+      PL_ASSERT(new_version.IsNull() == false);
 
-        COMPILER_MEMORY_FENCE;
+      auto cid = tile_group_header->GetEndCommitId(tuple_slot);
+      PL_ASSERT(cid > end_commit_id);
+      auto new_tile_group_header =
+          manager.GetTileGroup(new_version.block)->GetHeader();
+      new_tile_group_header->SetBeginCommitId(new_version.offset,
+                                              end_commit_id);
+      new_tile_group_header->SetEndCommitId(new_version.offset, cid);
+      new_tile_group_header->SetModifiedCommitId(end_commit_id);
 
-        tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+      COMPILER_MEMORY_FENCE;
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetModifiedCommitId(end_commit_id);
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INITIAL_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = RW_TYPE_UPDATE;
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        // add to log manager
-        log_manager.LogUpdate(end_commit_id, ItemPointer(tile_group_id, tuple_slot), new_version);
+      // add to gc set.
+      gc_set->Set(tile_group_id, tuple_slot, RW_TYPE_UPDATE);
 
-      } else if (tuple_entry.second == RW_TYPE_DELETE) {
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
+      // add to log manager
+      log_manager.LogUpdate(end_commit_id, ItemPointer(tile_group_id, tuple_slot), new_version);
 
-        auto cid = tile_group_header->GetEndCommitId(tuple_slot);
-        PL_ASSERT(cid > end_commit_id);
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-        new_tile_group_header->SetBeginCommitId(new_version.offset,
-                                                end_commit_id);
-        new_tile_group_header->SetEndCommitId(new_version.offset, cid);
+    } else if (tuple_entry.type == RW_TYPE_DELETE) {
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
 
-        COMPILER_MEMORY_FENCE;
+      auto cid = tile_group_header->GetEndCommitId(tuple_slot);
+      PL_ASSERT(cid > end_commit_id);
+      auto new_tile_group_header =
+          manager.GetTileGroup(new_version.block)->GetHeader();
+      new_tile_group_header->SetBeginCommitId(new_version.offset,
+                                              end_commit_id);
+      new_tile_group_header->SetEndCommitId(new_version.offset, cid);
+      new_tile_group_header->SetModifiedCommitId(end_commit_id);
 
-        tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+      COMPILER_MEMORY_FENCE;
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      tile_group_header->SetEndCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetModifiedCommitId(end_commit_id);
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = RW_TYPE_DELETE;
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        // add to log manager
-        log_manager.LogDelete(end_commit_id, ItemPointer(tile_group_id, tuple_slot));
+      // add to gc set.
+      gc_set->Set(tile_group_id, tuple_slot, RW_TYPE_DELETE);
 
-      } else if (tuple_entry.second == RW_TYPE_INSERT) {
-        PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
-                  current_txn->GetTransactionId());
-        // set the begin commit id to persist insert
-        tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      // add to log manager
+      log_manager.LogDelete(end_commit_id, ItemPointer(tile_group_id, tuple_slot));
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+    } else if (tuple_entry.type == RW_TYPE_INSERT) {
+      PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
+                current_txn->GetTransactionId());
+      // set the begin commit id to persist insert
+      tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetModifiedCommitId(end_commit_id);
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        // nothing to be added to gc set.
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        // add to log manager
-        log_manager.LogInsert(end_commit_id, ItemPointer(tile_group_id, tuple_slot));
+      // nothing to be added to gc set.
 
-      } else if (tuple_entry.second == RW_TYPE_INS_DEL) {
-        PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
-                  current_txn->GetTransactionId());
+      // add to log manager
+      log_manager.LogInsert(end_commit_id, ItemPointer(tile_group_id, tuple_slot));
 
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+    } else if (tuple_entry.type == RW_TYPE_INS_DEL) {
+      PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
+                current_txn->GetTransactionId());
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // set the begin commit id to persist insert
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = RW_TYPE_INS_DEL;
+      // set the begin commit id to persist insert
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
-        // no log is needed for this case
-      }
+      // add to gc set.
+      gc_set->Set(tile_group_id, tuple_slot, RW_TYPE_INS_DEL);
+
+      // no log is needed for this case
     }
   }
 
@@ -828,153 +923,152 @@ Result TimestampOrderingTransactionManager::AbortTransaction(
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     if (!rw_set.empty()) {
       database_id =
-          manager.GetTileGroup(rw_set.begin()->first)->GetDatabaseId();
+          manager.GetTileGroup(rw_set.begin()->tile_group_id)
+              ->GetDatabaseId();
     }
   }
 
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
+  for (auto &tuple_entry : rw_set) {
+    oid_t tile_group_id = tuple_entry.tile_group_id;
     auto tile_group = manager.GetTileGroup(tile_group_id);
     auto tile_group_header = tile_group->GetHeader();
 
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
-      if (tuple_entry.second == RW_TYPE_UPDATE) {
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
-
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
-
-        // these two fields can be set at any time.
-        new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
-
-        COMPILER_MEMORY_FENCE;
-
-        // as the aborted version has already been placed in the version chain,
-        // we need to unlink it by resetting the item pointers.
-        auto old_prev =
-            new_tile_group_header->GetPrevItemPointer(new_version.offset);
-
-        // check whether the previous version exists.
-        if (old_prev.IsNull() == true) {
-          PL_ASSERT(tile_group_header->GetEndCommitId(tuple_slot) == MAX_CID);
-          // if we updated the latest version.
-          // We must first adjust the head pointer
-          // before we unlink the aborted version from version list
-          ItemPointer *index_entry_ptr =
-              tile_group_header->GetIndirection(tuple_slot);
-          UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
-              index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
-          PL_ASSERT(res == true);
-        }
-        //////////////////////////////////////////////////
+    auto tuple_slot = tuple_entry.tuple_id;
+    if (tuple_entry.type == RW_TYPE_UPDATE) {
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
+
+      auto new_tile_group_header =
+          manager.GetTileGroup(new_version.block)->GetHeader();
+
+      // these two fields can be set at any time.
+      new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+
+      COMPILER_MEMORY_FENCE;
+
+      // as the aborted version has already been placed in the version chain,
+      // we need to unlink it by resetting the item pointers.
+      auto old_prev =
+          new_tile_group_header->GetPrevItemPointer(new_version.offset);
+
+      // check whether the previous version exists.
+      if (old_prev.IsNull() == true) {
+        PL_ASSERT(tile_group_header->GetEndCommitId(tuple_slot) == MAX_CID);
+        // if we updated the latest version.
+        // We must first adjust the head pointer
+        // before we unlink the aborted version from version list
+        ItemPointer *index_entry_ptr =
+            tile_group_header->GetIndirection(tuple_slot);
+        UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
+            index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
+        PL_ASSERT(res == true);
+      }
+      //////////////////////////////////////////////////
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
 
-        if (old_prev.IsNull() == false) {
-          auto old_prev_tile_group_header = catalog::Manager::GetInstance()
-                                                .GetTileGroup(old_prev.block)
-                                                ->GetHeader();
-          old_prev_tile_group_header->SetNextItemPointer(
-              old_prev.offset, ItemPointer(tile_group_id, tuple_slot));
-          tile_group_header->SetPrevItemPointer(tuple_slot, old_prev);
-        } else {
-          tile_group_header->SetPrevItemPointer(tuple_slot, INVALID_ITEMPOINTER);
-        }
+      if (old_prev.IsNull() == false) {
+        auto old_prev_tile_group_header = catalog::Manager::GetInstance()
+                                              .GetTileGroup(old_prev.block)
+                                              ->GetHeader();
+        old_prev_tile_group_header->SetNextItemPointer(
+            old_prev.offset, ItemPointer(tile_group_id, tuple_slot));
+        tile_group_header->SetPrevItemPointer(tuple_slot, old_prev);
+      } else {
+        tile_group_header->SetPrevItemPointer(tuple_slot, INVALID_ITEMPOINTER);
+      }
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](new_version.block)[new_version.offset] = RW_TYPE_UPDATE;
+      // add to gc set.
+      gc_set->Set(new_version.block, new_version.offset, RW_TYPE_UPDATE);
 
-      } else if (tuple_entry.second == RW_TYPE_DELETE) {
+    } else if (tuple_entry.type == RW_TYPE_DELETE) {
 
-        ItemPointer new_version =
-            tile_group_header->GetPrevItemPointer(tuple_slot);
+      ItemPointer new_version =
+          tile_group_header->GetPrevItemPointer(tuple_slot);
 
-        auto new_tile_group_header =
-            manager.GetTileGroup(new_version.block)->GetHeader();
+      auto new_tile_group_header =
+          manager.GetTileGroup(new_version.block)->GetHeader();
 
-        new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
-        new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetBeginCommitId(new_version.offset, MAX_CID);
+      new_tile_group_header->SetEndCommitId(new_version.offset, MAX_CID);
 
-        COMPILER_MEMORY_FENCE;
+      COMPILER_MEMORY_FENCE;
 
-        // as the aborted version has already been placed in the version chain,
-        // we need to unlink it by resetting the item pointers.
-        auto old_prev =
-            new_tile_group_header->GetPrevItemPointer(new_version.offset);
+      // as the aborted version has already been placed in the version chain,
+      // we need to unlink it by resetting the item pointers.
+      auto old_prev =
+          new_tile_group_header->GetPrevItemPointer(new_version.offset);
 
-        // check whether the previous version exists.
-        if (old_prev.IsNull() == true) {
-          // if we updated the latest version.
-          // We must first adjust the head pointer
-          // before we unlink the aborted version from version list
-          ItemPointer *index_entry_ptr =
-              tile_group_header->GetIndirection(tuple_slot);
-          UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
-              index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
-          PL_ASSERT(res == true);
-        }
-        //////////////////////////////////////////////////
+      // check whether the previous version exists.
+      if (old_prev.IsNull() == true) {
+        // if we updated the latest version.
+        // We must first adjust the head pointer
+        // before we unlink the aborted version from version list
+        ItemPointer *index_entry_ptr =
+            tile_group_header->GetIndirection(tuple_slot);
+        UNUSED_ATTRIBUTE auto res = AtomicUpdateItemPointer(
+            index_entry_ptr, ItemPointer(tile_group_id, tuple_slot));
+        PL_ASSERT(res == true);
+      }
+      //////////////////////////////////////////////////
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        new_tile_group_header->SetTransactionId(new_version.offset,
-                                                INVALID_TXN_ID);
+      new_tile_group_header->SetTransactionId(new_version.offset,
+                                              INVALID_TXN_ID);
 
-        if (old_prev.IsNull() == false) {
-          auto old_prev_tile_group_header = catalog::Manager::GetInstance()
-                                                .GetTileGroup(old_prev.block)
-                                                ->GetHeader();
-          old_prev_tile_group_header->SetNextItemPointer(
-              old_prev.offset, ItemPointer(tile_group_id, tuple_slot));
-        }
+      if (old_prev.IsNull() == false) {
+        auto old_prev_tile_group_header = catalog::Manager::GetInstance()
+                                              .GetTileGroup(old_prev.block)
+                                              ->GetHeader();
+        old_prev_tile_group_header->SetNextItemPointer(
+            old_prev.offset, ItemPointer(tile_group_id, tuple_slot));
+      }
 
-        tile_group_header->SetPrevItemPointer(tuple_slot, old_prev);
+      tile_group_header->SetPrevItemPointer(tuple_slot, old_prev);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](new_version.block)[new_version.offset] = RW_TYPE_DELETE;
+      // add to gc set.
+      gc_set->Set(new_version.block, new_version.offset, RW_TYPE_DELETE);
 
-      } else if (tuple_entry.second == RW_TYPE_INSERT) {
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+    } else if (tuple_entry.type == RW_TYPE_INSERT) {
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = RW_TYPE_INSERT;
+      // add to gc set.
+      gc_set->Set(tile_group_id, tuple_slot, RW_TYPE_INSERT);
 
-      } else if (tuple_entry.second == RW_TYPE_INS_DEL) {
-        tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
-        tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
+    } else if (tuple_entry.type == RW_TYPE_INS_DEL) {
+      tile_group_header->SetBeginCommitId(tuple_slot, MAX_CID);
+      tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
 
-        // we should set the version before releasing the lock.
-        COMPILER_MEMORY_FENCE;
+      // we should set the version before releasing the lock.
+      COMPILER_MEMORY_FENCE;
 
-        tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
+      tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
 
-        // add to gc set.
-        gc_set->operator[](tile_group_id)[tuple_slot] = RW_TYPE_INS_DEL;
-      }
+      // add to gc set.
+      gc_set->Set(tile_group_id, tuple_slot, RW_TYPE_INS_DEL);
     }
   }
 
@@ -28,14 +28,12 @@ void Transaction::RecordRead(const ItemPointer &location) {
   oid_t tile_group_id = location.block;
   oid_t tuple_id = location.offset;
 
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
-    PL_ASSERT(rw_set_.at(tile_group_id).at(tuple_id) != RW_TYPE_DELETE &&
-              rw_set_.at(tile_group_id).at(tuple_id) != RW_TYPE_INS_DEL);
+  RWType *type = rw_set_->Find(tile_group_id, tuple_id);
+  if (type != nullptr) {
+    PL_ASSERT(*type != RW_TYPE_DELETE && *type != RW_TYPE_INS_DEL);
     return;
   } else {
-    rw_set_[tile_group_id][tuple_id] = RW_TYPE_READ;
+    rw_set_->Insert(tile_group_id, tuple_id, RW_TYPE_READ);
   }
 }
 
@@ -43,24 +41,22 @@ void Transaction::RecordUpdate(const ItemPointer &location) {
   oid_t tile_group_id = location.block;
   oid_t tuple_id = location.offset;
 
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
-    RWType &type = rw_set_.at(tile_group_id).at(tuple_id);
-    if (type == RW_TYPE_READ) {
-      type = RW_TYPE_UPDATE;
+  RWType *type = rw_set_->Find(tile_group_id, tuple_id);
+  if (type != nullptr) {
+    if (*type == RW_TYPE_READ) {
+      *type = RW_TYPE_UPDATE;
       // record write.
       is_written_ = true;
 
       return;
     }
-    if (type == RW_TYPE_UPDATE) {
+    if (*type == RW_TYPE_UPDATE) {
       return;
     }
-    if (type == RW_TYPE_INSERT) {
+    if (*type == RW_TYPE_INSERT) {
       return;
     }
-    if (type == RW_TYPE_DELETE) {
+    if (*type == RW_TYPE_DELETE) {
       PL_ASSERT(false);
       return;
     }
@@ -72,12 +68,10 @@ void Transaction::RecordInsert(const ItemPointer &location) {
   oid_t tile_group_id = location.block;
   oid_t tuple_id = location.offset;
 
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
+  if (rw_set_->Find(tile_group_id, tuple_id) != nullptr) {
     PL_ASSERT(false);
   } else {
-    rw_set_[tile_group_id][tuple_id] = RW_TYPE_INSERT;
+    rw_set_->Insert(tile_group_id, tuple_id, RW_TYPE_INSERT);
     ++insert_count_;
 
   }
@@ -87,29 +81,27 @@ bool Transaction::RecordDelete(const ItemPointer &location) {
   oid_t tile_group_id = location.block;
   oid_t tuple_id = location.offset;
 
-  if (rw_set_.find(tile_group_id) != rw_set_.end() &&
-      rw_set_.at(tile_group_id).find(tuple_id) !=
-          rw_set_.at(tile_group_id).end()) {
-    RWType &type = rw_set_.at(tile_group_id).at(tuple_id);
-    if (type == RW_TYPE_READ) {
-      type = RW_TYPE_DELETE;
+  RWType *type = rw_set_->Find(tile_group_id, tuple_id);
+  if (type != nullptr) {
+    if (*type == RW_TYPE_READ) {
+      *type = RW_TYPE_DELETE;
       // record write.
       is_written_ = true;
 
       return false;
     }
-    if (type == RW_TYPE_UPDATE) {
-      type = RW_TYPE_DELETE;
+    if (*type == RW_TYPE_UPDATE) {
+      *type = RW_TYPE_DELETE;
 
       return false;
     }
-    if (type == RW_TYPE_INSERT) {
-      type = RW_TYPE_INS_DEL;
+    if (*type == RW_TYPE_INSERT) {
+      *type = RW_TYPE_INS_DEL;
       --insert_count_;
 
       return true;
     }
-    if (type == RW_TYPE_DELETE) {
+    if (*type == RW_TYPE_DELETE) {
       PL_ASSERT(false);
       return false;
     }
@@ -0,0 +1,77 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// transaction_manager.cpp
+//
+// Identification: src/concurrency/transaction_manager.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/transaction_manager.h"
+
+namespace peloton {
+namespace concurrency {
+
+namespace {
+
+// Range [next, end) of ids reserved by a thread
+struct IdRange {
+  uint64_t next = 0;
+  uint64_t end = 0;
+
+  // generation of the counter the range was taken from
+  uint64_t generation = 0;
+};
+
+thread_local IdRange txn_id_range;
+
+std::atomic<uint64_t> id_generation_counter(0);
+
+}  // namespace
+
+uint64_t TransactionManager::GetNewIdGeneration() {
+  return ++id_generation_counter;
+}
+
+void TransactionManager::SetTxnIdBatchSize(size_t batch_size) {
+  PL_ASSERT(batch_size > 0);
+  txn_id_batch_size_ = batch_size;
+  id_generation_ = GetNewIdGeneration();
+}
+
+txn_id_t TransactionManager::GetNextTransactionId() {
+  size_t batch_size = txn_id_batch_size_.load(std::memory_order_relaxed);
+  if (batch_size == 1) {
+    return next_txn_id_++;
+  }
+
+  // Transaction ids only need to be unique
+  uint64_t generation = id_generation_.load();
+  if (txn_id_range.next == txn_id_range.end ||
+      txn_id_range.generation != generation) {
+    txn_id_range.next = next_txn_id_.fetch_add(batch_size);
+    txn_id_range.end = txn_id_range.next + batch_size;
+    txn_id_range.generation = generation;
+  }
+  return txn_id_range.next++;
+}
+
+cid_t TransactionManager::GetNextCommitId() {
+  // Commit ids are never batched: begin and commit timestamps have to follow
+  // real time across threads, or a transaction could begin with a snapshot
+  // that misses a commit which finished before it began. A scalable commit
+  // timestamp scheme that keeps this order (e.g. epoch-based timestamps) is
+  // not implemented, so every begin and commit still goes through next_cid_.
+  cid_t temp_cid = next_cid_++;
+
+  // wait if we do not yet have a grant for this commit id
+  while (temp_cid > maximum_grant_cid_.load())
+    ;
+  return temp_cid;
+}
+
+}  // End concurrency namespace
+}  // End peloton namespace
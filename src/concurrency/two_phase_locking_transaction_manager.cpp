@@ -0,0 +1,351 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// two_phase_locking_transaction_manager.cpp
+//
+// Identification: src/concurrency/two_phase_locking_transaction_manager.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "concurrency/two_phase_locking_transaction_manager.h"
+
+#include "catalog/manager.h"
+#include "common/logger.h"
+#include "common/platform.h"
+#include "common/read_write_set.h"
+#include "concurrency/transaction.h"
+
+namespace peloton {
+namespace concurrency {
+
+TwoPhaseLockingTransactionManager &
+TwoPhaseLockingTransactionManager::GetInstance(
+    DeadlockPreventionType deadlock_prevention) {
+  static TwoPhaseLockingTransactionManager no_wait_txn_manager(
+      DEADLOCK_PREVENTION_TYPE_NO_WAIT);
+  static TwoPhaseLockingTransactionManager wait_die_txn_manager(
+      DEADLOCK_PREVENTION_TYPE_WAIT_DIE);
+
+  if (deadlock_prevention == DEADLOCK_PREVENTION_TYPE_WAIT_DIE) {
+    return wait_die_txn_manager;
+  } else {
+    return no_wait_txn_manager;
+  }
+}
+
+size_t *TwoPhaseLockingTransactionManager::GetReaderCountField(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  return (size_t *)(tile_group_header->GetReservedFieldRef(tuple_id) +
+                    READER_COUNT_OFFSET);
+}
+
+// the oldest reader is only meaningful while the reader count is not zero. as
+// it is not updated when a reader leaves, it may be older than every reader.
+txn_id_t *TwoPhaseLockingTransactionManager::GetOldestReaderField(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  return (txn_id_t *)(tile_group_header->GetReservedFieldRef(tuple_id) +
+                      OLDEST_READER_OFFSET);
+}
+
+bool TwoPhaseLockingTransactionManager::CanWait(
+    const txn_id_t &txn_id, const txn_id_t &holder_txn_id) const {
+  return deadlock_prevention_ == DEADLOCK_PREVENTION_TYPE_WAIT_DIE &&
+         txn_id <= holder_txn_id;
+}
+
+void TwoPhaseLockingTransactionManager::AddReader(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id, const txn_id_t &txn_id) {
+  size_t *reader_count = GetReaderCountField(tile_group_header, tuple_id);
+  txn_id_t *oldest_reader = GetOldestReaderField(tile_group_header, tuple_id);
+  if (*reader_count == 0 || txn_id < *oldest_reader) {
+    *oldest_reader = txn_id;
+  }
+  (*reader_count)++;
+}
+
+bool TwoPhaseLockingTransactionManager::IsReader(
+    Transaction *const current_txn, const oid_t &tile_group_id,
+    const oid_t &tuple_id) {
+  const RWType *type =
+      current_txn->GetReadWriteSet().Find(tile_group_id, tuple_id);
+  return type != nullptr && *type == RW_TYPE_READ;
+}
+
+bool TwoPhaseLockingTransactionManager::AcquireReadLock(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  auto txn_id = current_txn->GetTransactionId();
+
+  while (true) {
+    GetSpinlockField(tile_group_header, tuple_id)->Lock();
+
+    txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+    if (tuple_txn_id == INITIAL_TXN_ID) {
+      AddReader(tile_group_header, tuple_id, txn_id);
+      GetSpinlockField(tile_group_header, tuple_id)->Unlock();
+      return true;
+    }
+
+    GetSpinlockField(tile_group_header, tuple_id)->Unlock();
+
+    if (tuple_txn_id == INVALID_TXN_ID ||
+        CanWait(txn_id, tuple_txn_id) == false) {
+      return false;
+    }
+    _mm_pause();
+  }
+}
+
+void TwoPhaseLockingTransactionManager::ReleaseWriteLock(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tile_group_id, const oid_t &tuple_id) {
+  GetSpinlockField(tile_group_header, tuple_id)->Lock();
+  tile_group_header->SetTransactionId(tuple_id, INITIAL_TXN_ID);
+  if (IsReader(current_txn, tile_group_id, tuple_id) == true) {
+    AddReader(tile_group_header, tuple_id, current_txn->GetTransactionId());
+  }
+  GetSpinlockField(tile_group_header, tuple_id)->Unlock();
+}
+
+void TwoPhaseLockingTransactionManager::ReleaseReadLocks(
+    Transaction *const current_txn) {
+  auto &manager = catalog::Manager::GetInstance();
+
+  for (auto &tuple_entry : current_txn->GetReadWriteSet()) {
+    if (tuple_entry.type != RW_TYPE_READ) {
+      continue;
+    }
+
+    auto tile_group_header =
+        manager.GetTileGroup(tuple_entry.tile_group_id)->GetHeader();
+    auto tuple_slot = tuple_entry.tuple_id;
+
+    // the read lock was turned into a write lock, which is released with the
+    // rest of the write set.
+    if (IsOwner(current_txn, tile_group_header, tuple_slot) == true) {
+      continue;
+    }
+
+    GetSpinlockField(tile_group_header, tuple_slot)->Lock();
+    size_t *reader_count = GetReaderCountField(tile_group_header, tuple_slot);
+    PL_ASSERT(*reader_count > 0);
+    (*reader_count)--;
+    GetSpinlockField(tile_group_header, tuple_slot)->Unlock();
+  }
+}
+
+// the locks leave only the latest committed version worth reading, whatever
+// the begin commit id of the transaction is.
+VisibilityType TwoPhaseLockingTransactionManager::IsVisible(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  // a declared read-only transaction reads its snapshot without locks.
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    return TimestampOrderingTransactionManager::IsVisible(
+        current_txn, tile_group_header, tuple_id);
+  }
+
+  txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+  cid_t tuple_begin_cid = tile_group_header->GetBeginCommitId(tuple_id);
+  cid_t tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
+
+  // the tuple has already been owned by the current transaction.
+  bool own = (current_txn->GetTransactionId() == tuple_txn_id);
+  // the tuple has already been committed.
+  bool activated = (tuple_begin_cid != MAX_CID);
+  // the tuple has been replaced by a newer version.
+  bool invalidated = (tuple_end_cid != MAX_CID);
+
+  if (tuple_txn_id == INVALID_TXN_ID || CidIsInDirtyRange(tuple_begin_cid)) {
+    // the tuple is not available.
+    if (activated && !invalidated) {
+      // deleted tuple
+      return VISIBILITY_DELETED;
+    } else {
+      // aborted tuple
+      return VISIBILITY_INVISIBLE;
+    }
+  }
+
+  if (own == true) {
+    if (tuple_begin_cid == MAX_CID && tuple_end_cid != INVALID_CID) {
+      PL_ASSERT(tuple_end_cid == MAX_CID);
+      // the only version that is visible is the newly inserted/updated one.
+      return VISIBILITY_OK;
+    } else if (tuple_end_cid == INVALID_CID) {
+      // tuple being deleted by current txn
+      return VISIBILITY_DELETED;
+    } else {
+      // old version of the tuple that is being updated by current txn
+      return VISIBILITY_INVISIBLE;
+    }
+  }
+
+  // an uncommitted version of another transaction is never read. the
+  // version it replaces is, once its write lock is released.
+  if (activated && !invalidated) {
+    return VISIBILITY_OK;
+  } else {
+    return VISIBILITY_INVISIBLE;
+  }
+}
+
+// a tuple locked by an older transaction cannot be owned, as waiting for it
+// would either deadlock or end with a newer version.
+bool TwoPhaseLockingTransactionManager::IsOwnable(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  auto tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+  auto tuple_end_cid = tile_group_header->GetEndCommitId(tuple_id);
+  if (current_txn->IsDeclaredReadOnly() == true || tuple_end_cid != MAX_CID) {
+    return false;
+  }
+  return tuple_txn_id == INITIAL_TXN_ID ||
+         (tuple_txn_id != INVALID_TXN_ID &&
+          CanWait(current_txn->GetTransactionId(), tuple_txn_id));
+}
+
+bool TwoPhaseLockingTransactionManager::AcquireOwnership(
+    Transaction *const current_txn,
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  // a declared read-only transaction never writes.
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    return false;
+  }
+
+  auto txn_id = current_txn->GetTransactionId();
+  auto tile_group_id = tile_group_header->GetTileGroup()->GetTileGroupId();
+
+  // a transaction that already holds the read lock upgrades it.
+  bool is_reader = IsReader(current_txn, tile_group_id, tuple_id);
+  size_t other_reader_count = 0;
+
+  while (true) {
+    GetSpinlockField(tile_group_header, tuple_id)->Lock();
+
+    txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_id);
+    size_t *reader_count = GetReaderCountField(tile_group_header, tuple_id);
+    other_reader_count = *reader_count - (is_reader ? 1 : 0);
+
+    if (tuple_txn_id == INITIAL_TXN_ID && other_reader_count == 0) {
+      tile_group_header->SetTransactionId(tuple_id, txn_id);
+      // the write lock covers the read lock.
+      *reader_count = 0;
+      GetSpinlockField(tile_group_header, tuple_id)->Unlock();
+      break;
+    }
+
+    bool can_wait = true;
+    if (tuple_txn_id != INITIAL_TXN_ID) {
+      can_wait = (tuple_txn_id != INVALID_TXN_ID &&
+                  CanWait(txn_id, tuple_txn_id));
+    }
+    if (other_reader_count != 0) {
+      can_wait = can_wait &&
+                 CanWait(txn_id, *GetOldestReaderField(tile_group_header,
+                                                       tuple_id));
+    }
+
+    GetSpinlockField(tile_group_header, tuple_id)->Unlock();
+
+    if (can_wait == false) {
+      return false;
+    }
+    _mm_pause();
+  }
+
+  // a newer version may have been committed before the lock was taken.
+  if (tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+    ReleaseWriteLock(current_txn, tile_group_header, tile_group_id, tuple_id);
+    return false;
+  }
+
+  return true;
+}
+
+void TwoPhaseLockingTransactionManager::YieldOwnership(
+    Transaction *const current_txn, const oid_t &tile_group_id,
+    const oid_t &tuple_id) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group_header = manager.GetTileGroup(tile_group_id)->GetHeader();
+  PL_ASSERT(IsOwner(current_txn, tile_group_header, tuple_id));
+  ReleaseWriteLock(current_txn, tile_group_header, tile_group_id, tuple_id);
+}
+
+bool TwoPhaseLockingTransactionManager::PerformRead(
+    Transaction *const current_txn, const ItemPointer &location) {
+  oid_t tile_group_id = location.block;
+  oid_t tuple_id = location.offset;
+
+  LOG_TRACE("PerformRead (%u, %u)\n", location.block, location.offset);
+  auto tile_group_header =
+      catalog::Manager::GetInstance().GetTileGroup(tile_group_id)->GetHeader();
+
+  // the write lock, or a read lock taken before, already covers the read.
+  // a declared read-only transaction reads a snapshot and takes no lock.
+  if (current_txn->IsDeclaredReadOnly() == false &&
+      IsOwner(current_txn, tile_group_header, tuple_id) == false &&
+      IsReader(current_txn, tile_group_id, tuple_id) == false) {
+    if (AcquireReadLock(current_txn, tile_group_header, tuple_id) == false) {
+      LOG_TRACE("Transaction read failed");
+      return false;
+    }
+
+    // the version may have been replaced while we waited for the lock.
+    if (tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+      GetSpinlockField(tile_group_header, tuple_id)->Lock();
+      (*GetReaderCountField(tile_group_header, tuple_id))--;
+      GetSpinlockField(tile_group_header, tuple_id)->Unlock();
+      return false;
+    }
+
+    current_txn->RecordRead(location);
+  }
+
+  // Increment table read op stats
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementTableReads(
+        location.block);
+  }
+  return true;
+}
+
+Result TwoPhaseLockingTransactionManager::CommitTransaction(
+    Transaction *const current_txn) {
+  LOG_TRACE("Committing peloton txn : %lu ", current_txn->GetTransactionId());
+
+  if (current_txn->IsDeclaredReadOnly() == true) {
+    return TimestampOrderingTransactionManager::CommitTransaction(current_txn);
+  }
+
+  // every lock is held here, so any transaction that conflicts with the
+  // current one takes its commit id later.
+  cid_t end_commit_id = GetNextCommitId();
+
+  ReleaseReadLocks(current_txn);
+
+  return InstallTransaction(current_txn, end_commit_id);
+}
+
+Result TwoPhaseLockingTransactionManager::AbortTransaction(
+    Transaction *const current_txn) {
+  if (current_txn->IsDeclaredReadOnly() == false) {
+    ReleaseReadLocks(current_txn);
+  }
+
+  return TimestampOrderingTransactionManager::AbortTransaction(current_txn);
+}
+
+}  // End concurrency namespace
+}  // End peloton namespace
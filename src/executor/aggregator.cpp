@@ -181,7 +181,7 @@ HashAggregator::~HashAggregator() {
       delete entry.second->aggregates[aggno];
     }
     delete[] entry.second->aggregates;
-    for (auto val : entry.first) {
+    for (auto val : entry.second->group_by_values) {
       delete val;
     }
     for (auto val :entry.second->first_tuple_values) {
@@ -194,13 +194,13 @@ HashAggregator::~HashAggregator() {
 bool HashAggregator::Advance(AbstractTuple *cur_tuple) {
   AggregateList *aggregate_list;
 
-  // Configure a group-by-key and search for the required group.
+  // Configure a group-by-key and search for the required group. The key
+  // only references the tuple, so probing an existing group never allocates.
   group_by_key_values.clear();
   for (oid_t column_itr = 0; column_itr < node->GetGroupbyColIds().size();
        column_itr++) {
-    common::Value *cur_tuple_val =
-        cur_tuple->GetValue(node->GetGroupbyColIds()[column_itr]);
-    group_by_key_values.push_back(cur_tuple_val);
+    group_by_key_values.push_back(
+        cur_tuple->GetTypedValue(node->GetGroupbyColIds()[column_itr]));
   }
 
   auto map_itr = aggregates_map.find(group_by_key_values);
@@ -211,6 +211,16 @@ bool HashAggregator::Advance(AbstractTuple *cur_tuple) {
     // Allocate new aggregate list
     aggregate_list = new AggregateList();
     aggregate_list->aggregates = new Agg *[node->GetUniqueAggTerms().size()];
+    // Copy the group-by values, and key the group on the copies, which
+    // outlive the current tuple
+    std::vector<common::TypedValue> group_by_key;
+    for (auto column_id : node->GetGroupbyColIds()) {
+      // group_by_values has the ownership
+      aggregate_list->group_by_values.push_back(
+          cur_tuple->GetValue(column_id));
+      group_by_key.push_back(common::TypedValue::FromValue(
+          *aggregate_list->group_by_values.back()));
+    }
     // Make a deep copy of the first tuple we meet
     for (size_t col_id = 0; col_id < num_input_columns; col_id++) {
       // first_tuple_values has the ownership
@@ -227,23 +237,21 @@ bool HashAggregator::Advance(AbstractTuple *cur_tuple) {
     }
 
     aggregates_map.insert(
-        HashAggregateMapType::value_type(group_by_key_values, aggregate_list));
+        HashAggregateMapType::value_type(group_by_key, aggregate_list));
   }
   // Otherwise, the list is the second item of the pair.
   else {
     aggregate_list = map_itr->second;
-    for (auto val : group_by_key_values)
-      delete val;
   }
 
   // Update the aggregation calculation
   for (oid_t aggno = 0; aggno < node->GetUniqueAggTerms().size(); aggno++) {
     auto predicate = node->GetUniqueAggTerms()[aggno].expression;
-    std::unique_ptr<common::Value> value(
-        common::ValueFactory::GetIntegerValue(1).Copy());
+    std::unique_ptr<common::Value> value;
     if (predicate) {
-      value.reset(node->GetUniqueAggTerms()[aggno].expression->Evaluate(
-          cur_tuple, nullptr, this->executor_context)->Copy());
+      value = predicate->Evaluate(cur_tuple, nullptr, this->executor_context);
+    } else {
+      value.reset(common::ValueFactory::GetIntegerValue(1).Copy());
     }
 
     aggregate_list->aggregates[aggno]->Advance(value.get());
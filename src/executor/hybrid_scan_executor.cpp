@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <ctime>
@@ -22,6 +23,7 @@
 #include <utility>
 #include <vector>
 
+#include "common/config.h"
 #include "common/logger.h"
 #include "common/timer.h"
 #include "common/types.h"
@@ -32,7 +34,9 @@
 #include "executor/logical_tile_factory.h"
 #include "expression/abstract_expression.h"
 #include "expression/container_tuple.h"
+#include "gc/gc_manager_factory.h"
 #include "planner/hybrid_scan_plan.h"
+#include "statistics/backend_stats_context.h"
 #include "storage/data_table.h"
 #include "storage/tile.h"
 #include "storage/tile_group_header.h"
@@ -122,15 +126,22 @@ bool HybridScanExecutor::DInit() {
     } else {
       current_tile_group_offset_ = indexed_tile_group_offset_ + 1;
       std::shared_ptr<storage::TileGroup> tile_group;
-      if (current_tile_group_offset_ < table_tile_group_count_) {
-        tile_group = table_->GetTileGroup(current_tile_group_offset_);
-      } else {
-        tile_group = table_->GetTileGroup(table_tile_group_count_ - 1);
+      oid_t threshold_offset =
+          std::min(current_tile_group_offset_, table_tile_group_count_ - 1);
+
+      // skip the tile groups dropped by compaction
+      for (; threshold_offset < table_tile_group_count_ && tile_group == nullptr;
+           threshold_offset++) {
+        tile_group = table_->GetTileGroup(threshold_offset);
       }
 
-      oid_t tuple_id = 0;
-      ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
-      block_threshold = location.block;
+      if (tile_group == nullptr) {
+        block_threshold = INVALID_OID;
+      } else {
+        oid_t tuple_id = 0;
+        ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
+        block_threshold = location.block;
+      }
     }
 
     result_itr_ = START_OID;
@@ -189,6 +200,18 @@ bool HybridScanExecutor::SeqScanUtil() {
   while (current_tile_group_offset_ < table_tile_group_count_) {
     LOG_TRACE("Current tile group offset : %u", current_tile_group_offset_);
     auto tile_group = table_->GetTileGroup(current_tile_group_offset_++);
+
+    // Dropped by compaction
+    if (tile_group == nullptr) {
+      continue;
+    }
+
+    // Skip tile groups whose zone map rules the predicate out
+    if (predicate_ != nullptr &&
+        predicate_->MayMatch(tile_group->GetZoneMap(), executor_context_) ==
+            false)
+      continue;
+
     auto tile_group_header = tile_group->GetHeader();
 
     oid_t active_tuple_count = tile_group->GetNextTupleSlot();
@@ -214,35 +237,18 @@ bool HybridScanExecutor::SeqScanUtil() {
       // Check transaction visibility
       if (transaction_manager.IsVisible(current_txn, tile_group_header,
                                         tuple_id)) {
-        // If the tuple is visible, then perform predicate evaluation.
-        if (predicate_ == nullptr) {
-          position_list.push_back(tuple_id);
-        } else {
-          expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
-                                                               tuple_id);
-          auto eval = predicate_->Evaluate(&tuple, nullptr, executor_context_)
-                          ->IsTrue();
-          if (eval == true) {
-            position_list.push_back(tuple_id);
-          }
-        }
-      } else {
-        expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
-                                                             tuple_id);
-        auto eval =
-            predicate_->Evaluate(&tuple, nullptr, executor_context_)->IsTrue();
-        if (eval == true) {
-          position_list.push_back(tuple_id);
-          auto res = transaction_manager.PerformRead(current_txn, location);
-          if (!res) {
-            transaction_manager.SetTransactionResult(current_txn,
-                                                     RESULT_FAILURE);
-            return res;
-          }
-        }
+        position_list.push_back(tuple_id);
       }
     }
 
+    // If the tuples are visible, then perform predicate evaluation.
+    if (predicate_ != nullptr && position_list.empty() == false) {
+      std::vector<oid_t> visible_list(std::move(position_list));
+      position_list.clear();
+      predicate_->EvaluateBatch(tile_group.get(), visible_list, position_list,
+                                executor_context_);
+    }
+
     // Don't return empty tiles
     if (position_list.size() == 0) {
       continue;
@@ -364,15 +370,18 @@ bool HybridScanExecutor::ExecPrimaryIndexLookup() {
 
   std::map<oid_t, std::vector<oid_t>> visible_tuples;
 
+  auto current_txn = executor_context_->GetTransaction();
+
   // for every tuple that is found in the index.
-  for (auto tuple_location : tuple_location_ptrs) {
+  for (auto tuple_location_ptr : tuple_location_ptrs) {
+    ItemPointer tuple_location = *tuple_location_ptr;
     if (type_ == HYBRID_SCAN_TYPE_HYBRID &&
-        tuple_location->block >= (block_threshold)) {
-      item_pointers_.insert(*tuple_location);
+        tuple_location.block >= (block_threshold)) {
+      item_pointers_.insert(tuple_location);
     }
 
     auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tuple_location->block);
+    auto tile_group = manager.GetTileGroup(tuple_location.block);
     auto tile_group_header = tile_group.get()->GetHeader();
 
     // perform transaction read
@@ -380,12 +389,24 @@ bool HybridScanExecutor::ExecPrimaryIndexLookup() {
     while (true) {
       ++chain_length;
 
-      if (transaction_manager.IsVisible(current_txn, tile_group_header,
-                                        tuple_location->offset)) {
+      auto visibility = transaction_manager.IsVisible(
+          current_txn, tile_group_header, tuple_location.offset);
+
+      // if the tuple is deleted
+      if (visibility == VISIBILITY_DELETED) {
+        break;
+      }
+      // if the tuple is visible.
+      else if (visibility == VISIBILITY_OK) {
+        // unlink the versions behind this one that nobody can see anymore
+        gc::GCManagerFactory::GetInstance().PruneVersionChain(
+            tile_group_header, tuple_location.offset);
+
         visible_tuples[tuple_location.block].push_back(tuple_location.offset);
         auto res = transaction_manager.PerformRead(current_txn, tuple_location);
         if (!res) {
-          transaction_manager.SetTransactionResult(RESULT_FAILURE);
+          transaction_manager.SetTransactionResult(current_txn,
+                                                   RESULT_FAILURE);
           return res;
         }
         break;
@@ -411,6 +432,11 @@ bool HybridScanExecutor::ExecPrimaryIndexLookup() {
         tile_group_header = tile_group.get()->GetHeader();
       }
     }
+    LOG_TRACE("Traverse length: %d\n", (int)chain_length);
+    if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+      stats::BackendStatsContext::GetInstance()->RecordVersionChainLength(
+          chain_length);
+    }
   }
 
   // Construct a logical tile for each block
@@ -30,8 +30,10 @@
 #include "storage/tile_group_header.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "common/logger.h"
+#include "common/config.h"
 #include "catalog/manager.h"
 #include "gc/gc_manager_factory.h"
+#include "statistics/backend_stats_context.h"
 
 namespace peloton {
 namespace executor {
@@ -200,6 +202,10 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
         LOG_TRACE("perform read: %u, %u", tuple_location.block,
                   tuple_location.offset);
 
+        // unlink the versions behind this one that nobody can see anymore
+        gc::GCManagerFactory::GetInstance().PruneVersionChain(
+            tile_group_header, tuple_location.offset);
+
         bool eval = true;
         // if having predicate, then perform evaluation.
         if (predicate_ != nullptr) {
@@ -274,6 +280,10 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
       }
     }
     LOG_TRACE("Traverse length: %d\n", (int)chain_length);
+    if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+      stats::BackendStatsContext::GetInstance()->RecordVersionChainLength(
+          chain_length);
+    }
   }
 
   // Construct a logical tile for each block
@@ -363,6 +373,10 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
         LOG_TRACE("perform read: %u, %u", tuple_location.block,
                   tuple_location.offset);
 
+        // unlink the versions behind this one that nobody can see anymore
+        gc::GCManagerFactory::GetInstance().PruneVersionChain(
+            tile_group_header, tuple_location.offset);
+
         // Further check if the version has the secondary key
         storage::Tuple key_tuple(index_->GetKeySchema(), true);
         expression::ContainerTuple<storage::TileGroup> candidate_tuple(
@@ -462,6 +476,10 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
       }
     }
     LOG_TRACE("Traverse length: %d\n", (int)chain_length);
+    if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+      stats::BackendStatsContext::GetInstance()->RecordVersionChainLength(
+          chain_length);
+    }
   }
 
   // Construct a logical tile for each block
@@ -178,6 +178,24 @@ common::Value *LogicalTile::GetValue(oid_t tuple_id, oid_t column_id) {
   }
 }
 
+common::TypedValue LogicalTile::GetTypedValue(oid_t tuple_id,
+                                              oid_t column_id) {
+  PL_ASSERT(column_id < schema_.size());
+  PL_ASSERT(tuple_id < total_tuples_);
+  PL_ASSERT(visible_rows_[tuple_id]);
+
+  ColumnInfo &cp = schema_[column_id];
+  oid_t base_tuple_id = position_lists_[cp.position_list_idx][tuple_id];
+  storage::Tile *base_tile = cp.base_tile.get();
+
+  if (base_tuple_id == NULL_OID) {
+    return common::TypedValue::GetNullValueByType(
+        base_tile->GetSchema()->GetType(cp.origin_column_id));
+  } else {
+    return base_tile->GetTypedValue(base_tuple_id, cp.origin_column_id);
+  }
+}
+
 // this function is designed for overriding pure virtual function.
 void LogicalTile::SetValue(common::Value &value UNUSED_ATTRIBUTE,
                            oid_t tuple_id UNUSED_ATTRIBUTE,
@@ -46,11 +46,17 @@ void CleanExecutorTree(executor::AbstractExecutor *root);
 peloton_status PlanExecutor::ExecutePlan(
     const planner::AbstractPlan *plan,
     const std::vector<common::Value *> &params, std::vector<ResultType> &result,
-    const std::vector<int> &result_format) {
+    const std::vector<int> &result_format, const bool read_only) {
   peloton_status p_status;
 
   if (plan == nullptr) return p_status;
 
+  if (read_only == true && IsReadOnlyPlan(plan) == false) {
+    LOG_ERROR("Cannot execute a write in a read-only transaction");
+    p_status.m_result = Result::RESULT_FAILURE;
+    return p_status;
+  }
+
   LOG_TRACE("PlanExecutor Start ");
 
   bool status;
@@ -62,7 +68,8 @@ peloton_status PlanExecutor::ExecutePlan(
   // This happens for single statement queries in PG
   // if (txn == nullptr) {
   single_statement_txn = true;
-  auto txn = txn_manager.BeginTransaction();
+  auto txn = (read_only == true) ? txn_manager.BeginReadOnlyTransaction()
+                                 : txn_manager.BeginTransaction();
   // }
   PL_ASSERT(txn);
 
@@ -179,9 +186,15 @@ cleanup:
 int PlanExecutor::ExecutePlan(
     const planner::AbstractPlan *plan,
     const std::vector<common::Value *> &params,
-    std::vector<std::unique_ptr<executor::LogicalTile>> &logical_tile_list) {
+    std::vector<std::unique_ptr<executor::LogicalTile>> &logical_tile_list,
+    const bool read_only) {
   if (plan == nullptr) return -1;
 
+  if (read_only == true && IsReadOnlyPlan(plan) == false) {
+    LOG_ERROR("Cannot execute a write in a read-only transaction");
+    return -1;
+  }
+
   LOG_TRACE("PlanExecutor Start ");
 
   bool status;
@@ -194,7 +207,8 @@ int PlanExecutor::ExecutePlan(
   // This happens for single statement queries in PG
   // if (txn == nullptr) {
   single_statement_txn = true;
-  auto txn = txn_manager.BeginTransaction();
+  auto txn = (read_only == true) ? txn_manager.BeginReadOnlyTransaction()
+                                 : txn_manager.BeginTransaction();
   // }
   PL_ASSERT(txn);
 
@@ -298,6 +312,29 @@ void PlanExecutor::PrintPlan(const planner::AbstractPlan *plan,
   }
 }
 
+/**
+ * @brief Check whether a plan tree only reads.
+ * @param The plan tree
+ * @return false if some node of the plan writes.
+ */
+bool PlanExecutor::IsReadOnlyPlan(const planner::AbstractPlan *plan) {
+  switch (plan->GetPlanNodeType()) {
+    case PLAN_NODE_TYPE_UPDATE:
+    case PLAN_NODE_TYPE_INSERT:
+    case PLAN_NODE_TYPE_DELETE:
+    case PLAN_NODE_TYPE_DROP:
+    case PLAN_NODE_TYPE_CREATE:
+      return false;
+    default:
+      break;
+  }
+
+  for (auto &child : plan->GetChildren()) {
+    if (IsReadOnlyPlan(child.get()) == false) return false;
+  }
+  return true;
+}
+
 /**
  * @brief Build Executor Context
  */
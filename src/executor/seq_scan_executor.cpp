@@ -12,11 +12,17 @@
 
 #include "executor/seq_scan_executor.h"
 
+#include <atomic>
+#include <condition_variable>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 #include <numeric>
 
+#include "common/init.h"
+#include "common/thread_pool.h"
 #include "common/types.h"
 #include "executor/logical_tile.h"
 #include "executor/logical_tile_factory.h"
@@ -33,6 +39,35 @@
 namespace peloton {
 namespace executor {
 
+namespace {
+
+// State shared by the threads of a parallel scan. Tasks that the thread pool
+// only starts after the scan is over must still find it, so it is shared.
+struct ParallelScanState {
+  ParallelScanState(oid_t begin_offset, oid_t end_offset)
+      : end_offset(end_offset),
+        next_offset(begin_offset),
+        results(end_offset),
+        pending_count(end_offset - begin_offset) {}
+
+  const oid_t end_offset;
+
+  // Next tile group offset to hand out
+  std::atomic<oid_t> next_offset;
+
+  // Positions found in each tile group
+  std::vector<std::vector<oid_t>> results;
+
+  std::mutex mutex;
+  std::condition_variable finished;
+  oid_t pending_count;
+
+  // First exception thrown by a scan thread
+  std::exception_ptr error;
+};
+
+}  // namespace
+
 /**
  * @brief Constructor for seqscan executor.
  * @param node Seqscan node corresponding to this executor.
@@ -56,6 +91,8 @@ bool SeqScanExecutor::DInit() {
   target_table_ = node.GetTable();
   
   current_tile_group_offset_ = START_OID;
+  parallel_scan_done_ = false;
+  parallel_scan_results_.clear();
 
   if (target_table_ != nullptr) {
     table_tile_group_count_ = target_table_->GetTileGroupCount();
@@ -87,12 +124,16 @@ bool SeqScanExecutor::DExecute() {
 
       if (predicate_ != nullptr) {
         // Invalidate tuples that don't satisfy the predicate.
-        for (oid_t tuple_id : *tile) {
-          expression::ContainerTuple<LogicalTile> tuple(tile.get(), tuple_id);
-          auto eval = predicate_->Evaluate(&tuple, nullptr, executor_context_);
-          if (eval->IsFalse()) {
-          //if (predicate_->Evaluate(&tuple, nullptr, executor_context_)
-          //        .IsFalse()) {
+        std::vector<oid_t> selection(tile->begin(), tile->end());
+        std::vector<oid_t> matches;
+        predicate_->EvaluateBatch(tile.get(), selection, matches,
+                                  executor_context_);
+
+        auto match_itr = matches.begin();
+        for (oid_t tuple_id : selection) {
+          if (match_itr != matches.end() && *match_itr == tuple_id) {
+            match_itr++;
+          } else {
             tile->RemoveVisibility(tuple_id);
           }
         }
@@ -123,50 +164,37 @@ bool SeqScanExecutor::DExecute() {
 
     auto current_txn = executor_context_->GetTransaction();
 
+    // Scan the tile groups up front when several threads may be used
+    if (executor_context_->GetDegreeOfParallelism() > 1 &&
+        parallel_scan_done_ == false) {
+      ParallelScan();
+    }
+
     // Retrieve next tile group.
     while (current_tile_group_offset_ < table_tile_group_count_) {
-      auto tile_group =
-          target_table_->GetTileGroup(current_tile_group_offset_++);
-      auto tile_group_header = tile_group->GetHeader();
-
-      oid_t active_tuple_count = tile_group->GetNextTupleSlot();
-
-      // Construct position list by looping through tile group
-      // and applying the predicate.
       std::vector<oid_t> position_list;
-      for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
-        ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
-
-
-        auto visibility = transaction_manager.IsVisible(current_txn, tile_group_header, tuple_id);
+      auto tile_group = target_table_->GetTileGroup(current_tile_group_offset_);
+      // skip the tile groups dropped by compaction
+      if (tile_group == nullptr) {
+        current_tile_group_offset_++;
+        continue;
+      }
+      if (parallel_scan_done_) {
+        position_list =
+            std::move(parallel_scan_results_[current_tile_group_offset_]);
+      } else {
+        ScanTileGroup(tile_group.get(), position_list);
+      }
+      current_tile_group_offset_++;
 
-        // check transaction visibility
-        if (visibility == VISIBILITY_OK) {
-          // if the tuple is visible, then perform predicate evaluation.
-          if (predicate_ == nullptr) {
-            position_list.push_back(tuple_id);
-            auto res = transaction_manager.PerformRead(current_txn, location);
-            if (!res) {
-              transaction_manager.SetTransactionResult(current_txn, RESULT_FAILURE);
-              return res;
-            }
-          } else {
-            expression::ContainerTuple<storage::TileGroup> tuple(
-                tile_group.get(), tuple_id);
-            LOG_TRACE("Evaluate predicate for a tuple");
-            auto eval = predicate_->Evaluate(&tuple, nullptr, executor_context_);
-            LOG_TRACE("Evaluation result: %s", eval->GetInfo().c_str());
-            if (eval->IsTrue()) {
-              position_list.push_back(tuple_id);
-              auto res = transaction_manager.PerformRead(current_txn, location);
-              if (!res) {
-                transaction_manager.SetTransactionResult(current_txn, RESULT_FAILURE);
-                return res;
-              } else {
-                LOG_TRACE("Sequential Scan Predicate Satisfied");
-              }
-            }
-          }
+      // Reads are recorded by this thread only, as the transaction's
+      // read-write set is not thread-safe
+      for (oid_t tuple_id : position_list) {
+        ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
+        auto res = transaction_manager.PerformRead(current_txn, location);
+        if (!res) {
+          transaction_manager.SetTransactionResult(current_txn, RESULT_FAILURE);
+          return res;
         }
       }
 
@@ -189,5 +217,93 @@ bool SeqScanExecutor::DExecute() {
   return false;
 }
 
+void SeqScanExecutor::ScanTileGroup(storage::TileGroup *tile_group,
+                                    std::vector<oid_t> &position_list) const {
+  // Skip tile groups whose zone map rules the predicate out
+  if (predicate_ != nullptr &&
+      predicate_->MayMatch(tile_group->GetZoneMap(), executor_context_) ==
+          false)
+    return;
+
+  concurrency::TransactionManager &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  auto current_txn = executor_context_->GetTransaction();
+  auto tile_group_header = tile_group->GetHeader();
+
+  oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+
+  // Construct position list by looping through tile group
+  // and applying the predicate.
+  for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+    auto visibility = transaction_manager.IsVisible(
+        current_txn, tile_group_header, tuple_id);
+
+    // check transaction visibility
+    if (visibility == VISIBILITY_OK) {
+      position_list.push_back(tuple_id);
+    }
+  }
+
+  // if the tuple is visible, then perform predicate evaluation.
+  if (predicate_ != nullptr && position_list.empty() == false) {
+    LOG_TRACE("Evaluate predicate for %lu tuples", position_list.size());
+    std::vector<oid_t> visible_list(std::move(position_list));
+    position_list.clear();
+    predicate_->EvaluateBatch(tile_group, visible_list, position_list,
+                              executor_context_);
+  }
+}
+
+/**
+ * @brief Morsel-driven scan of the table. Every thread repeatedly claims the
+ * next tile group and scans it. The calling thread takes part as well, so the
+ * scan completes even when the thread pool is busy.
+ */
+void SeqScanExecutor::ParallelScan() {
+  auto tile_group_count = table_tile_group_count_ - current_tile_group_offset_;
+  auto state = std::make_shared<ParallelScanState>(current_tile_group_offset_,
+                                                   table_tile_group_count_);
+
+  auto scan = [this, state]() {
+    while (true) {
+      oid_t offset = state->next_offset++;
+      // Do not touch the executor once every tile group has been claimed
+      if (offset >= state->end_offset) return;
+
+      try {
+        auto tile_group = target_table_->GetTileGroup(offset);
+        if (tile_group != nullptr) {
+          ScanTileGroup(tile_group.get(), state->results[offset]);
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        if (state->error == nullptr) state->error = std::current_exception();
+      }
+
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (--state->pending_count == 0) state->finished.notify_all();
+    }
+  };
+
+  size_t thread_count = std::min<size_t>(
+      executor_context_->GetDegreeOfParallelism(), tile_group_count);
+  LOG_TRACE("Scan %u tile groups with %lu threads", tile_group_count,
+            thread_count);
+  for (size_t thread_itr = 1; thread_itr < thread_count; thread_itr++) {
+    thread_pool.SubmitTask(scan);
+  }
+  scan();
+
+  {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->finished.wait(lock, [&state]() { return state->pending_count == 0; });
+    if (state->error != nullptr) std::rethrow_exception(state->error);
+  }
+
+  parallel_scan_results_ = std::move(state->results);
+  parallel_scan_done_ = true;
+}
+
 }  // namespace executor
 }  // namespace peloton
@@ -0,0 +1,45 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// abstract_expression.cpp
+//
+// Identification: src/expression/abstract_expression.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "expression/abstract_expression.h"
+
+#include "executor/logical_tile.h"
+#include "expression/container_tuple.h"
+#include "storage/tile_group.h"
+
+namespace peloton {
+namespace expression {
+
+void AbstractExpression::EvaluateBatch(storage::TileGroup *tile_group,
+                                       const std::vector<oid_t> &selection,
+                                       std::vector<oid_t> &output,
+                                       executor::ExecutorContext *context) const {
+  for (oid_t tuple_id : selection) {
+    ContainerTuple<storage::TileGroup> tuple(tile_group, tuple_id);
+    if (EvaluatePredicate(&tuple, nullptr, context) == CMP_TRUE)
+      output.push_back(tuple_id);
+  }
+}
+
+void AbstractExpression::EvaluateBatch(executor::LogicalTile *tile,
+                                       const std::vector<oid_t> &selection,
+                                       std::vector<oid_t> &output,
+                                       executor::ExecutorContext *context) const {
+  for (oid_t tuple_id : selection) {
+    ContainerTuple<executor::LogicalTile> tuple(tile, tuple_id);
+    if (EvaluatePredicate(&tuple, nullptr, context) == CMP_TRUE)
+      output.push_back(tuple_id);
+  }
+}
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -0,0 +1,580 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// column_kernels.cpp
+//
+// Identification: src/expression/column_kernels.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "expression/column_kernels.h"
+
+#include <immintrin.h>
+#include <atomic>
+#include <limits>
+
+namespace peloton {
+namespace expression {
+
+using namespace peloton::common;
+
+// The vector kernels are compiled for their own instruction set only, so the
+// rest of the binary does not depend on it
+#define TARGET_SSE42 __attribute__((target("sse4.2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+
+namespace {
+
+//===--------------------------------------------------------------------===//
+// Terms
+//===--------------------------------------------------------------------===//
+
+// A term as seen by the kernels : the constant converted to the column type
+// and the outcomes of the three-way comparison that satisfy the operator.
+template <class T>
+struct KernelTerm {
+  T constant;
+  bool less;
+  bool equal;
+  bool greater;
+};
+
+// Unused terms accept everything so that the kernels always evaluate
+// kMaxTerms terms without branching on the term count.
+template <class T>
+struct KernelTerms {
+  T null_value;
+  KernelTerm<T> term[ColumnKernels::kMaxTerms];
+};
+
+bool GetOutcomes(ExpressionType op, bool &less, bool &equal, bool &greater) {
+  switch (op) {
+    case (EXPRESSION_TYPE_COMPARE_EQUAL):
+      less = false, equal = true, greater = false;
+      return true;
+    case (EXPRESSION_TYPE_COMPARE_NOTEQUAL):
+      less = true, equal = false, greater = true;
+      return true;
+    case (EXPRESSION_TYPE_COMPARE_LESSTHAN):
+      less = true, equal = false, greater = false;
+      return true;
+    case (EXPRESSION_TYPE_COMPARE_GREATERTHAN):
+      less = false, equal = false, greater = true;
+      return true;
+    case (EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO):
+      less = true, equal = true, greater = false;
+      return true;
+    case (EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO):
+      less = false, equal = true, greater = true;
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Convert a constant to the representation of the column it is compared
+// with. Constants that would need a wider comparison are rejected.
+bool GetConstant(const TypedValue &constant, int32_t &value) {
+  if (constant.IsInteger() == false) return false;
+  int64_t wide = constant.GetAsBigInt();
+  if (wide < std::numeric_limits<int32_t>::min() ||
+      wide > std::numeric_limits<int32_t>::max())
+    return false;
+  value = static_cast<int32_t>(wide);
+  return true;
+}
+
+bool GetConstant(const TypedValue &constant, int64_t &value) {
+  if (constant.IsInteger() == false) return false;
+  value = constant.GetAsBigInt();
+  return true;
+}
+
+bool GetConstant(const TypedValue &constant, double &value) {
+  if (constant.IsInteger() == false &&
+      constant.GetTypeId() != Type::DECIMAL)
+    return false;
+  value = constant.GetAsDecimal();
+  return true;
+}
+
+bool GetConstant(const TypedValue &constant, uint64_t &value) {
+  if (constant.GetTypeId() != Type::TIMESTAMP) return false;
+  value = constant.GetAs<uint64_t>();
+  return true;
+}
+
+template <class T>
+bool BuildTerms(const ColumnComparison *terms, size_t term_count, T null_value,
+                KernelTerms<T> &kernel_terms) {
+  if (term_count == 0 || term_count > ColumnKernels::kMaxTerms) return false;
+
+  kernel_terms.null_value = null_value;
+  for (size_t term_itr = 0; term_itr < ColumnKernels::kMaxTerms; term_itr++) {
+    auto &kernel_term = kernel_terms.term[term_itr];
+    if (term_itr >= term_count) {
+      kernel_term.constant = null_value;
+      kernel_term.less = kernel_term.equal = kernel_term.greater = true;
+      continue;
+    }
+    if (GetOutcomes(terms[term_itr].op, kernel_term.less, kernel_term.equal,
+                    kernel_term.greater) == false)
+      return false;
+    if (GetConstant(terms[term_itr].constant, kernel_term.constant) == false)
+      return false;
+  }
+  return true;
+}
+
+// Timestamps are unsigned while the vector units only compare signed
+// integers. Flipping the sign bit maps the unsigned order onto the signed one.
+const int64_t kSignBit = std::numeric_limits<int64_t>::min();
+
+KernelTerms<int64_t> FlipSignBit(const KernelTerms<uint64_t> &terms) {
+  KernelTerms<int64_t> flipped;
+  flipped.null_value = static_cast<int64_t>(terms.null_value) ^ kSignBit;
+  for (size_t term_itr = 0; term_itr < ColumnKernels::kMaxTerms; term_itr++) {
+    flipped.term[term_itr].constant =
+        static_cast<int64_t>(terms.term[term_itr].constant) ^ kSignBit;
+    flipped.term[term_itr].less = terms.term[term_itr].less;
+    flipped.term[term_itr].equal = terms.term[term_itr].equal;
+    flipped.term[term_itr].greater = terms.term[term_itr].greater;
+  }
+  return flipped;
+}
+
+//===--------------------------------------------------------------------===//
+// Scalar kernels
+//===--------------------------------------------------------------------===//
+
+template <class T>
+inline bool Matches(const KernelTerms<T> &terms, T value) {
+  bool match = (value != terms.null_value);
+  for (size_t term_itr = 0; term_itr < ColumnKernels::kMaxTerms; term_itr++) {
+    auto &term = terms.term[term_itr];
+    if (value < term.constant)
+      match &= term.less;
+    else if (value == term.constant)
+      match &= term.equal;
+    else
+      match &= term.greater;
+  }
+  return match;
+}
+
+inline void SetBit(uint64_t *bitmap, oid_t position, bool value) {
+  bitmap[position >> 6] |= static_cast<uint64_t>(value) << (position & 63);
+}
+
+template <class T>
+void FilterScalar(const T *values, oid_t begin, oid_t end,
+                  const KernelTerms<T> &terms, uint64_t *bitmap) {
+  for (oid_t position = begin; position < end; position++)
+    SetBit(bitmap, position, Matches(terms, values[position]));
+}
+
+// Tail of the biased 64-bit vector kernels
+void FilterScalarFlipped(const int64_t *values, oid_t begin, oid_t end,
+                         int64_t bias, const KernelTerms<int64_t> &terms,
+                         uint64_t *bitmap) {
+  for (oid_t position = begin; position < end; position++)
+    SetBit(bitmap, position, Matches(terms, values[position] ^ bias));
+}
+
+//===--------------------------------------------------------------------===//
+// SSE4.2 kernels
+//===--------------------------------------------------------------------===//
+
+TARGET_SSE42 void FilterInt32Sse42(const int32_t *values, oid_t count,
+                                   const KernelTerms<int32_t> &terms,
+                                   uint64_t *bitmap) {
+  const oid_t lanes = 4;
+  const __m128i ones = _mm_set1_epi32(-1);
+  const __m128i zeros = _mm_setzero_si128();
+  const __m128i null_value = _mm_set1_epi32(terms.null_value);
+  __m128i constant[ColumnKernels::kMaxTerms], less[ColumnKernels::kMaxTerms],
+      equal[ColumnKernels::kMaxTerms], greater[ColumnKernels::kMaxTerms];
+  for (size_t term_itr = 0; term_itr < ColumnKernels::kMaxTerms; term_itr++) {
+    auto &term = terms.term[term_itr];
+    constant[term_itr] = _mm_set1_epi32(term.constant);
+    less[term_itr] = term.less ? ones : zeros;
+    equal[term_itr] = term.equal ? ones : zeros;
+    greater[term_itr] = term.greater ? ones : zeros;
+  }
+
+  oid_t vector_end = count - count % lanes;
+  for (oid_t position = 0; position < vector_end; position += lanes) {
+    __m128i value =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + position));
+    __m128i mask = _mm_andnot_si128(_mm_cmpeq_epi32(value, null_value), ones);
+    for (size_t term_itr = 0; term_itr < ColumnKernels::kMaxTerms;
+         term_itr++) {
+      __m128i match = _mm_or_si128(
+          _mm_and_si128(less[term_itr],
+                        _mm_cmpgt_epi32(constant[term_itr], value)),
+          _mm_or_si128(
+              _mm_and_si128(equal[term_itr],
+                            _mm_cmpeq_epi32(value, constant[term_itr])),
+              _mm_and_si128(greater[term_itr],
+                            _mm_cmpgt_epi32(value, constant[term_itr]))));
+      mask = _mm_and_si128(mask, match);
+    }
+    uint64_t bits = static_cast<uint32_t>(
+        _mm_movemask_ps(_mm_castsi128_ps(mask)));
+    bitmap[position >> 6] |= bits << (position & 63);
+  }
+  FilterScalar(values, vector_end, count, terms, bitmap);
+}
+
+TARGET_SSE42 void FilterInt64Sse42(const int64_t *values, oid_t count,
+                                   int64_t bias,
+                                   const KernelTerms<int64_t> &terms,
+                                   uint64_t *bitmap) {
+  const oid_t lanes = 2;
+  const __m128i ones = _mm_set1_epi64x(-1);
+  const __m128i zeros = _mm_setzero_si128();
+  const __m128i bias_value = _mm_set1_epi64x(bias);
+  const __m128i null_value = _mm_set1_epi64x(terms.null_value);
+  __m128i constant[ColumnKernels::kMaxTerms], less[ColumnKernels::kMaxTerms],
+      equal[ColumnKernels::kMaxTerms], greater[ColumnKernels::kMaxTerms];
+  for (size_t term_itr = 0; term_itr < ColumnKernels::kMaxTerms; term_itr++) {
+    auto &term = terms.term[term_itr];
+    constant[term_itr] = _mm_set1_epi64x(term.constant);
+    less[term_itr] = term.less ? ones : zeros;
+    equal[term_itr] = term.equal ? ones : zeros;
+    greater[term_itr] = term.greater ? ones : zeros;
+  }
+
+  oid_t vector_end = count - count % lanes;
+  for (oid_t position = 0; position < vector_end; position += lanes) {
+    __m128i value = _mm_xor_si128(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(values + position)),
+        bias_value);
+    __m128i mask = _mm_andnot_si128(_mm_cmpeq_epi64(value, null_value), ones);
+    for (size_t term_itr = 0; term_itr < ColumnKernels::kMaxTerms;
+         term_itr++) {
+      __m128i match = _mm_or_si128(
+          _mm_and_si128(less[term_itr],
+                        _mm_cmpgt_epi64(constant[term_itr], value)),
+          _mm_or_si128(
+              _mm_and_si128(equal[term_itr],
+                            _mm_cmpeq_epi64(value, constant[term_itr])),
+              _mm_and_si128(greater[term_itr],
+                            _mm_cmpgt_epi64(value, constant[term_itr]))));
+      mask = _mm_and_si128(mask, match);
+    }
+    uint64_t bits = static_cast<uint32_t>(
+        _mm_movemask_pd(_mm_castsi128_pd(mask)));
+    bitmap[position >> 6] |= bits << (position & 63);
+  }
+  FilterScalarFlipped(values, vector_end, count, bias, terms, bitmap);
+}
+
+TARGET_SSE42 void FilterDoubleSse42(const double *values, oid_t count,
+                                    const KernelTerms<double> &terms,
+                                    uint64_t *bitmap) {
+  const oid_t lanes = 2;
+  const __m128d ones = _mm_castsi128_pd(_mm_set1_epi64x(-1));
+  const __m128d zeros = _mm_setzero_pd();
+  const __m128d null_value = _mm_set1_pd(terms.null_value);
+  __m128d constant[ColumnKernels::kMaxTerms], less[ColumnKernels::kMaxTerms],
+      equal[ColumnKernels::kMaxTerms], greater[ColumnKernels::kMaxTerms];
+  for (size_t term_itr = 0; term_itr < ColumnKernels::kMaxTerms; term_itr++) {
+    auto &term = terms.term[term_itr];
+    constant[term_itr] = _mm_set1_pd(term.constant);
+    less[term_itr] = term.less ? ones : zeros;
+    equal[term_itr] = term.equal ? ones : zeros;
+    greater[term_itr] = term.greater ? ones : zeros;
+  }
+
+  oid_t vector_end = count - count % lanes;
+  for (oid_t position = 0; position < vector_end; position += lanes) {
+    __m128d value = _mm_loadu_pd(values + position);
+    __m128d mask = _mm_cmpneq_pd(value, null_value);
+    for (size_t term_itr = 0; term_itr < ColumnKernels::kMaxTerms;
+         term_itr++) {
+      __m128d match = _mm_or_pd(
+          _mm_and_pd(less[term_itr], _mm_cmplt_pd(value, constant[term_itr])),
+          _mm_or_pd(
+              _mm_and_pd(equal[term_itr],
+                         _mm_cmpeq_pd(value, constant[term_itr])),
+              _mm_and_pd(greater[term_itr],
+                         _mm_cmpgt_pd(value, constant[term_itr]))));
+      mask = _mm_and_pd(mask, match);
+    }
+    uint64_t bits = static_cast<uint32_t>(_mm_movemask_pd(mask));
+    bitmap[position >> 6] |= bits << (position & 63);
+  }
+  FilterScalar(values, vector_end, count, terms, bitmap);
+}
+
+//===--------------------------------------------------------------------===//
+// AVX2 kernels
+//===--------------------------------------------------------------------===//
+
+TARGET_AVX2 void FilterInt32Avx2(const int32_t *values, oid_t count,
+                                 const KernelTerms<int32_t> &terms,
+                                 uint64_t *bitmap) {
+  const oid_t lanes = 8;
+  const __m256i ones = _mm256_set1_epi32(-1);
+  const __m256i zeros = _mm256_setzero_si256();
+  const __m256i null_value = _mm256_set1_epi32(terms.null_value);
+  __m256i constant[ColumnKernels::kMaxTerms], less[ColumnKernels::kMaxTerms],
+      equal[ColumnKernels::kMaxTerms], greater[ColumnKernels::kMaxTerms];
+  for (size_t term_itr = 0; term_itr < ColumnKernels::kMaxTerms; term_itr++) {
+    auto &term = terms.term[term_itr];
+    constant[term_itr] = _mm256_set1_epi32(term.constant);
+    less[term_itr] = term.less ? ones : zeros;
+    equal[term_itr] = term.equal ? ones : zeros;
+    greater[term_itr] = term.greater ? ones : zeros;
+  }
+
+  oid_t vector_end = count - count % lanes;
+  for (oid_t position = 0; position < vector_end; position += lanes) {
+    __m256i value = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(values + position));
+    __m256i mask =
+        _mm256_andnot_si256(_mm256_cmpeq_epi32(value, null_value), ones);
+    for (size_t term_itr = 0; term_itr < ColumnKernels::kMaxTerms;
+         term_itr++) {
+      __m256i match = _mm256_or_si256(
+          _mm256_and_si256(less[term_itr],
+                           _mm256_cmpgt_epi32(constant[term_itr], value)),
+          _mm256_or_si256(
+              _mm256_and_si256(equal[term_itr],
+                               _mm256_cmpeq_epi32(value, constant[term_itr])),
+              _mm256_and_si256(greater[term_itr],
+                               _mm256_cmpgt_epi32(value, constant[term_itr]))));
+      mask = _mm256_and_si256(mask, match);
+    }
+    uint64_t bits = static_cast<uint32_t>(
+        _mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+    bitmap[position >> 6] |= bits << (position & 63);
+  }
+  FilterScalar(values, vector_end, count, terms, bitmap);
+}
+
+TARGET_AVX2 void FilterInt64Avx2(const int64_t *values, oid_t count,
+                                 int64_t bias,
+                                 const KernelTerms<int64_t> &terms,
+                                 uint64_t *bitmap) {
+  const oid_t lanes = 4;
+  const __m256i ones = _mm256_set1_epi64x(-1);
+  const __m256i zeros = _mm256_setzero_si256();
+  const __m256i bias_value = _mm256_set1_epi64x(bias);
+  const __m256i null_value = _mm256_set1_epi64x(terms.null_value);
+  __m256i constant[ColumnKernels::kMaxTerms], less[ColumnKernels::kMaxTerms],
+      equal[ColumnKernels::kMaxTerms], greater[ColumnKernels::kMaxTerms];
+  for (size_t term_itr = 0; term_itr < ColumnKernels::kMaxTerms; term_itr++) {
+    auto &term = terms.term[term_itr];
+    constant[term_itr] = _mm256_set1_epi64x(term.constant);
+    less[term_itr] = term.less ? ones : zeros;
+    equal[term_itr] = term.equal ? ones : zeros;
+    greater[term_itr] = term.greater ? ones : zeros;
+  }
+
+  oid_t vector_end = count - count % lanes;
+  for (oid_t position = 0; position < vector_end; position += lanes) {
+    __m256i value = _mm256_xor_si256(
+        _mm256_loadu_si256(
+            reinterpret_cast<const __m256i *>(values + position)),
+        bias_value);
+    __m256i mask =
+        _mm256_andnot_si256(_mm256_cmpeq_epi64(value, null_value), ones);
+    for (size_t term_itr = 0; term_itr < ColumnKernels::kMaxTerms;
+         term_itr++) {
+      __m256i match = _mm256_or_si256(
+          _mm256_and_si256(less[term_itr],
+                           _mm256_cmpgt_epi64(constant[term_itr], value)),
+          _mm256_or_si256(
+              _mm256_and_si256(equal[term_itr],
+                               _mm256_cmpeq_epi64(value, constant[term_itr])),
+              _mm256_and_si256(greater[term_itr],
+                               _mm256_cmpgt_epi64(value, constant[term_itr]))));
+      mask = _mm256_and_si256(mask, match);
+    }
+    uint64_t bits = static_cast<uint32_t>(
+        _mm256_movemask_pd(_mm256_castsi256_pd(mask)));
+    bitmap[position >> 6] |= bits << (position & 63);
+  }
+  FilterScalarFlipped(values, vector_end, count, bias, terms, bitmap);
+}
+
+TARGET_AVX2 void FilterDoubleAvx2(const double *values, oid_t count,
+                                  const KernelTerms<double> &terms,
+                                  uint64_t *bitmap) {
+  const oid_t lanes = 4;
+  const __m256d ones = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+  const __m256d zeros = _mm256_setzero_pd();
+  const __m256d null_value = _mm256_set1_pd(terms.null_value);
+  __m256d constant[ColumnKernels::kMaxTerms], less[ColumnKernels::kMaxTerms],
+      equal[ColumnKernels::kMaxTerms], greater[ColumnKernels::kMaxTerms];
+  for (size_t term_itr = 0; term_itr < ColumnKernels::kMaxTerms; term_itr++) {
+    auto &term = terms.term[term_itr];
+    constant[term_itr] = _mm256_set1_pd(term.constant);
+    less[term_itr] = term.less ? ones : zeros;
+    equal[term_itr] = term.equal ? ones : zeros;
+    greater[term_itr] = term.greater ? ones : zeros;
+  }
+
+  oid_t vector_end = count - count % lanes;
+  for (oid_t position = 0; position < vector_end; position += lanes) {
+    __m256d value = _mm256_loadu_pd(values + position);
+    __m256d mask = _mm256_cmp_pd(value, null_value, _CMP_NEQ_OQ);
+    for (size_t term_itr = 0; term_itr < ColumnKernels::kMaxTerms;
+         term_itr++) {
+      __m256d match = _mm256_or_pd(
+          _mm256_and_pd(less[term_itr], _mm256_cmp_pd(value, constant[term_itr],
+                                                      _CMP_LT_OQ)),
+          _mm256_or_pd(
+              _mm256_and_pd(equal[term_itr],
+                            _mm256_cmp_pd(value, constant[term_itr],
+                                          _CMP_EQ_OQ)),
+              _mm256_and_pd(greater[term_itr],
+                            _mm256_cmp_pd(value, constant[term_itr],
+                                          _CMP_GT_OQ))));
+      mask = _mm256_and_pd(mask, match);
+    }
+    uint64_t bits = static_cast<uint32_t>(_mm256_movemask_pd(mask));
+    bitmap[position >> 6] |= bits << (position & 63);
+  }
+  FilterScalar(values, vector_end, count, terms, bitmap);
+}
+
+//===--------------------------------------------------------------------===//
+// Dispatch
+//===--------------------------------------------------------------------===//
+
+ColumnKernelIsa DetectIsa() {
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) return COLUMN_KERNEL_ISA_AVX2;
+  if (__builtin_cpu_supports("sse4.2")) return COLUMN_KERNEL_ISA_SSE42;
+  return COLUMN_KERNEL_ISA_SCALAR;
+}
+
+const ColumnKernelIsa supported_isa = DetectIsa();
+
+std::atomic<int> current_isa(supported_isa);
+
+}  // namespace
+
+ColumnKernelIsa ColumnKernels::GetSupportedIsa() { return supported_isa; }
+
+ColumnKernelIsa ColumnKernels::GetIsa() {
+  return static_cast<ColumnKernelIsa>(current_isa.load());
+}
+
+void ColumnKernels::SetIsa(ColumnKernelIsa isa) {
+  current_isa = (isa < supported_isa) ? isa : supported_isa;
+}
+
+bool ColumnKernels::IsSupportedType(Type::TypeId type_id) {
+  switch (type_id) {
+    case Type::INTEGER:
+    case Type::BIGINT:
+    case Type::DECIMAL:
+    case Type::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool ColumnKernels::Filter(Type::TypeId column_type, const char *column,
+                           oid_t count, const ColumnComparison *terms,
+                           size_t term_count, std::vector<uint64_t> &bitmap) {
+  // Nothing compares true against NULL
+  for (size_t term_itr = 0; term_itr < term_count; term_itr++) {
+    if (terms[term_itr].constant.IsNull()) {
+      bitmap.assign((count + 63) / 64, 0);
+      return true;
+    }
+  }
+
+  auto isa = GetIsa();
+  switch (column_type) {
+    case Type::INTEGER: {
+      KernelTerms<int32_t> kernel_terms;
+      if (BuildTerms(terms, term_count, PELOTON_INT32_NULL, kernel_terms) ==
+          false)
+        return false;
+      bitmap.assign((count + 63) / 64, 0);
+      auto values = reinterpret_cast<const int32_t *>(column);
+      if (isa == COLUMN_KERNEL_ISA_AVX2)
+        FilterInt32Avx2(values, count, kernel_terms, bitmap.data());
+      else if (isa == COLUMN_KERNEL_ISA_SSE42)
+        FilterInt32Sse42(values, count, kernel_terms, bitmap.data());
+      else
+        FilterScalar(values, 0, count, kernel_terms, bitmap.data());
+      return true;
+    }
+    case Type::BIGINT: {
+      KernelTerms<int64_t> kernel_terms;
+      if (BuildTerms(terms, term_count, PELOTON_INT64_NULL, kernel_terms) ==
+          false)
+        return false;
+      bitmap.assign((count + 63) / 64, 0);
+      auto values = reinterpret_cast<const int64_t *>(column);
+      if (isa == COLUMN_KERNEL_ISA_AVX2)
+        FilterInt64Avx2(values, count, 0, kernel_terms, bitmap.data());
+      else if (isa == COLUMN_KERNEL_ISA_SSE42)
+        FilterInt64Sse42(values, count, 0, kernel_terms, bitmap.data());
+      else
+        FilterScalar(values, 0, count, kernel_terms, bitmap.data());
+      return true;
+    }
+    case Type::DECIMAL: {
+      KernelTerms<double> kernel_terms;
+      if (BuildTerms(terms, term_count, PELOTON_DECIMAL_NULL, kernel_terms) ==
+          false)
+        return false;
+      bitmap.assign((count + 63) / 64, 0);
+      auto values = reinterpret_cast<const double *>(column);
+      if (isa == COLUMN_KERNEL_ISA_AVX2)
+        FilterDoubleAvx2(values, count, kernel_terms, bitmap.data());
+      else if (isa == COLUMN_KERNEL_ISA_SSE42)
+        FilterDoubleSse42(values, count, kernel_terms, bitmap.data());
+      else
+        FilterScalar(values, 0, count, kernel_terms, bitmap.data());
+      return true;
+    }
+    case Type::TIMESTAMP: {
+      KernelTerms<uint64_t> kernel_terms;
+      if (BuildTerms(terms, term_count, PELOTON_TIMESTAMP_NULL,
+                     kernel_terms) == false)
+        return false;
+      bitmap.assign((count + 63) / 64, 0);
+      if (isa == COLUMN_KERNEL_ISA_SCALAR) {
+        FilterScalar(reinterpret_cast<const uint64_t *>(column), 0, count,
+                     kernel_terms, bitmap.data());
+        return true;
+      }
+      auto values = reinterpret_cast<const int64_t *>(column);
+      auto flipped_terms = FlipSignBit(kernel_terms);
+      if (isa == COLUMN_KERNEL_ISA_AVX2)
+        FilterInt64Avx2(values, count, kSignBit, flipped_terms,
+                        bitmap.data());
+      else
+        FilterInt64Sse42(values, count, kSignBit, flipped_terms,
+                         bitmap.data());
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+void ColumnKernels::SelectFromBitmap(const std::vector<uint64_t> &bitmap,
+                                     const std::vector<oid_t> &selection,
+                                     std::vector<oid_t> &output) {
+  for (oid_t tuple_id : selection) {
+    if ((bitmap[tuple_id >> 6] >> (tuple_id & 63)) & 1)
+      output.push_back(tuple_id);
+  }
+}
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -0,0 +1,330 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// comparison_expression.cpp
+//
+// Identification: src/expression/comparison_expression.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "expression/comparison_expression.h"
+
+#include <algorithm>
+#include <functional>
+
+#include "executor/logical_tile.h"
+#include "expression/column_kernels.h"
+#include "expression/tuple_value_expression.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "storage/zone_map.h"
+
+namespace peloton {
+namespace expression {
+
+namespace {
+
+//===--------------------------------------------------------------------===//
+// Column readers
+//===--------------------------------------------------------------------===//
+
+// Reads one column of a tile group, resolving the tile and the column offset
+// once for the whole batch.
+class TileGroupColumnReader {
+ public:
+  TileGroupColumnReader(storage::TileGroup *tile_group, oid_t column_id) {
+    oid_t tile_offset, tile_column_id;
+    tile_group->LocateTileAndColumn(column_id, tile_offset, tile_column_id);
+    tile_ = tile_group->GetTile(tile_offset);
+    column_type_ = tile_->GetSchema()->GetType(tile_column_id);
+    column_offset_ = tile_->GetSchema()->GetOffset(tile_column_id);
+    is_packed_ = (tile_->GetSchema()->GetLength() ==
+                  tile_->GetSchema()->GetLength(tile_column_id));
+  }
+
+  inline TypedValue Get(oid_t tuple_id) const {
+    return TypedValue::DeserializeFrom(GetLocation(tuple_id), column_type_);
+  }
+
+  inline const char *GetLocation(oid_t tuple_id) const {
+    return tile_->GetTupleLocation(tuple_id) + column_offset_;
+  }
+
+  Type::TypeId GetColumnType() const { return column_type_; }
+
+  // Whether the column is stored alone in its tile, in which case its values
+  // are laid out back to back
+  bool IsPacked() const { return is_packed_; }
+
+  static constexpr bool kHasRawAccess = true;
+
+ private:
+  storage::Tile *tile_;
+  Type::TypeId column_type_;
+  size_t column_offset_;
+  bool is_packed_;
+};
+
+// Reads one column of a logical tile through its position lists.
+class LogicalTileColumnReader {
+ public:
+  LogicalTileColumnReader(executor::LogicalTile *tile, oid_t column_id)
+      : tile_(tile), column_id_(column_id) {}
+
+  inline TypedValue Get(oid_t tuple_id) const {
+    return tile_->GetTypedValue(tuple_id, column_id_);
+  }
+
+  inline const char *GetLocation(UNUSED_ATTRIBUTE oid_t tuple_id) const {
+    return nullptr;
+  }
+
+  Type::TypeId GetColumnType() const { return Type::INVALID; }
+
+  static constexpr bool kHasRawAccess = false;
+
+ private:
+  executor::LogicalTile *tile_;
+  oid_t column_id_;
+};
+
+//===--------------------------------------------------------------------===//
+// Kernels
+//===--------------------------------------------------------------------===//
+
+// Generic kernel : compare typed values read off the column
+template <template <class> class Op, class Reader>
+void FilterColumn(const Reader &reader, const TypedValue &constant,
+                  const std::vector<oid_t> &selection,
+                  std::vector<oid_t> &output) {
+  Op<int> op;
+  for (oid_t tuple_id : selection) {
+    TypedValue value = reader.Get(tuple_id);
+    if (value.IsNull()) continue;
+    if (op(value.CompareTo(constant), 0)) output.push_back(tuple_id);
+  }
+}
+
+// Integer kernel : compare the raw column bytes with a widened constant
+template <template <class> class Op, class T, class Reader>
+void FilterIntegerColumn(const Reader &reader, T null_value, int64_t constant,
+                         const std::vector<oid_t> &selection,
+                         std::vector<oid_t> &output) {
+  Op<int64_t> op;
+  for (oid_t tuple_id : selection) {
+    T value = *reinterpret_cast<const T *>(reader.GetLocation(tuple_id));
+    if (value == null_value) continue;
+    if (op(static_cast<int64_t>(value), constant)) output.push_back(tuple_id);
+  }
+}
+
+template <template <class> class Op, class Reader>
+void FilterColumnWithOp(const Reader &reader, const TypedValue &constant,
+                        const std::vector<oid_t> &selection,
+                        std::vector<oid_t> &output) {
+  if (Reader::kHasRawAccess && constant.IsInteger()) {
+    int64_t value = constant.GetAsBigInt();
+    switch (reader.GetColumnType()) {
+      case Type::SMALLINT:
+        FilterIntegerColumn<Op, int16_t>(reader, PELOTON_INT16_NULL, value,
+                                         selection, output);
+        return;
+      case Type::INTEGER:
+        FilterIntegerColumn<Op, int32_t>(reader, PELOTON_INT32_NULL, value,
+                                         selection, output);
+        return;
+      case Type::BIGINT:
+        FilterIntegerColumn<Op, int64_t>(reader, PELOTON_INT64_NULL, value,
+                                         selection, output);
+        return;
+      default:
+        break;
+    }
+  }
+  FilterColumn<Op>(reader, constant, selection, output);
+}
+
+template <class Reader>
+void FilterColumnByType(ExpressionType op, const Reader &reader,
+                        const TypedValue &constant,
+                        const std::vector<oid_t> &selection,
+                        std::vector<oid_t> &output) {
+  switch (op) {
+    case (EXPRESSION_TYPE_COMPARE_EQUAL):
+      FilterColumnWithOp<std::equal_to>(reader, constant, selection, output);
+      return;
+    case (EXPRESSION_TYPE_COMPARE_NOTEQUAL):
+      FilterColumnWithOp<std::not_equal_to>(reader, constant, selection,
+                                            output);
+      return;
+    case (EXPRESSION_TYPE_COMPARE_LESSTHAN):
+      FilterColumnWithOp<std::less>(reader, constant, selection, output);
+      return;
+    case (EXPRESSION_TYPE_COMPARE_GREATERTHAN):
+      FilterColumnWithOp<std::greater>(reader, constant, selection, output);
+      return;
+    case (EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO):
+      FilterColumnWithOp<std::less_equal>(reader, constant, selection, output);
+      return;
+    case (EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO):
+      FilterColumnWithOp<std::greater_equal>(reader, constant, selection,
+                                             output);
+      return;
+    default:
+      throw Exception("Invalid comparison expression type.");
+  }
+}
+
+// Vector kernel : evaluate the terms over a packed column and pick the
+// selected positions off the resulting bitmap. Returns false if there is no
+// kernel for the column or if the selection is too sparse for a full pass
+// over the column to pay off.
+bool FilterPackedColumn(const TileGroupColumnReader &reader,
+                        const ColumnComparison *terms, size_t term_count,
+                        const std::vector<oid_t> &selection,
+                        std::vector<oid_t> &output) {
+  if (reader.IsPacked() == false ||
+      ColumnKernels::IsSupportedType(reader.GetColumnType()) == false)
+    return false;
+  if (selection.empty()) return true;
+
+  oid_t count = *std::max_element(selection.begin(), selection.end()) + 1;
+  if (selection.size() < count / 8) return false;
+
+  std::vector<uint64_t> bitmap;
+  if (ColumnKernels::Filter(reader.GetColumnType(), reader.GetLocation(0),
+                            count, terms, term_count, bitmap) == false)
+    return false;
+  ColumnKernels::SelectFromBitmap(bitmap, selection, output);
+  return true;
+}
+
+// Mirror a comparison so that "constant <op> column" becomes
+// "column <op'> constant"
+ExpressionType MirrorComparison(ExpressionType op) {
+  switch (op) {
+    case (EXPRESSION_TYPE_COMPARE_LESSTHAN):
+      return EXPRESSION_TYPE_COMPARE_GREATERTHAN;
+    case (EXPRESSION_TYPE_COMPARE_GREATERTHAN):
+      return EXPRESSION_TYPE_COMPARE_LESSTHAN;
+    case (EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO):
+      return EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO;
+    case (EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO):
+      return EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO;
+    default:
+      return op;
+  }
+}
+
+bool IsConstantOperand(const AbstractExpression *expr) {
+  return (expr->GetExpressionType() == EXPRESSION_TYPE_VALUE_CONSTANT ||
+          expr->GetExpressionType() == EXPRESSION_TYPE_VALUE_PARAMETER);
+}
+
+bool IsColumnOperand(const AbstractExpression *expr) {
+  return (expr->GetExpressionType() == EXPRESSION_TYPE_VALUE_TUPLE &&
+          static_cast<const TupleValueExpression *>(expr)->GetTupleIdx() == 0);
+}
+
+}  // namespace
+
+//===--------------------------------------------------------------------===//
+// ComparisonExpression
+//===--------------------------------------------------------------------===//
+
+bool ComparisonExpression::GetColumnConstantShape(
+    executor::ExecutorContext *context, oid_t &column_id, TypedValue &constant,
+    ExpressionType &op) const {
+  const AbstractExpression *column_expr = nullptr;
+  const AbstractExpression *constant_expr = nullptr;
+
+  if (IsColumnOperand(left_) && IsConstantOperand(right_)) {
+    column_expr = left_;
+    constant_expr = right_;
+    op = exp_type_;
+  } else if (IsConstantOperand(left_) && IsColumnOperand(right_)) {
+    column_expr = right_;
+    constant_expr = left_;
+    op = MirrorComparison(exp_type_);
+  } else {
+    return false;
+  }
+
+  if (constant_expr->EvaluateTyped(nullptr, nullptr, context, constant) ==
+      false)
+    return false;
+
+  column_id =
+      static_cast<const TupleValueExpression *>(column_expr)->GetColumnId();
+  return true;
+}
+
+void ComparisonExpression::EvaluateBatch(
+    storage::TileGroup *tile_group, const std::vector<oid_t> &selection,
+    std::vector<oid_t> &output, executor::ExecutorContext *context) const {
+  oid_t column_id;
+  TypedValue constant;
+  ExpressionType op;
+  if (GetColumnConstantShape(context, column_id, constant, op) == false) {
+    AbstractExpression::EvaluateBatch(tile_group, selection, output, context);
+    return;
+  }
+
+  // Nothing can compare true against NULL
+  if (constant.IsNull()) return;
+
+  TileGroupColumnReader reader(tile_group, column_id);
+  ColumnComparison term = {op, constant};
+  if (FilterPackedColumn(reader, &term, 1, selection, output)) return;
+  FilterColumnByType(op, reader, constant, selection, output);
+}
+
+bool ComparisonExpression::MayMatch(const storage::ZoneMap &zone_map,
+                                    executor::ExecutorContext *context) const {
+  oid_t column_id;
+  TypedValue constant;
+  ExpressionType op;
+  if (GetColumnConstantShape(context, column_id, constant, op) == false)
+    return true;
+  return zone_map.MayMatch(column_id, op, constant);
+}
+
+bool ComparisonExpression::EvaluateRangeBatch(
+    const ComparisonExpression *other, storage::TileGroup *tile_group,
+    const std::vector<oid_t> &selection, std::vector<oid_t> &output,
+    executor::ExecutorContext *context) const {
+  ColumnComparison terms[2];
+  oid_t column_id, other_column_id;
+  if (GetColumnConstantShape(context, column_id, terms[0].constant,
+                             terms[0].op) == false ||
+      other->GetColumnConstantShape(context, other_column_id,
+                                    terms[1].constant, terms[1].op) == false ||
+      column_id != other_column_id)
+    return false;
+
+  TileGroupColumnReader reader(tile_group, column_id);
+  return FilterPackedColumn(reader, terms, 2, selection, output);
+}
+
+void ComparisonExpression::EvaluateBatch(
+    executor::LogicalTile *tile, const std::vector<oid_t> &selection,
+    std::vector<oid_t> &output, executor::ExecutorContext *context) const {
+  oid_t column_id;
+  TypedValue constant;
+  ExpressionType op;
+  if (GetColumnConstantShape(context, column_id, constant, op) == false) {
+    AbstractExpression::EvaluateBatch(tile, selection, output, context);
+    return;
+  }
+
+  if (constant.IsNull()) return;
+
+  LogicalTileColumnReader reader(tile, column_id);
+  FilterColumnByType(op, reader, constant, selection, output);
+}
+
+}  // End expression namespace
+}  // End peloton namespace
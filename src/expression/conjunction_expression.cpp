@@ -0,0 +1,131 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// conjunction_expression.cpp
+//
+// Identification: src/expression/conjunction_expression.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "expression/conjunction_expression.h"
+
+#include "executor/logical_tile.h"
+#include "expression/comparison_expression.h"
+#include "storage/tile_group.h"
+#include "storage/zone_map.h"
+
+namespace peloton {
+namespace expression {
+
+namespace {
+
+bool IsComparison(const AbstractExpression *expr) {
+  switch (expr->GetExpressionType()) {
+    case (EXPRESSION_TYPE_COMPARE_EQUAL):
+    case (EXPRESSION_TYPE_COMPARE_NOTEQUAL):
+    case (EXPRESSION_TYPE_COMPARE_LESSTHAN):
+    case (EXPRESSION_TYPE_COMPARE_GREATERTHAN):
+    case (EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO):
+    case (EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO):
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+template <class Container>
+void ConjunctionExpression::EvaluateBatchImpl(
+    Container *container, const std::vector<oid_t> &selection,
+    std::vector<oid_t> &output, executor::ExecutorContext *context) const {
+  switch (exp_type_) {
+    case (EXPRESSION_TYPE_CONJUNCTION_AND): {
+      // Only the survivors of the left side are handed to the right side
+      std::vector<oid_t> left_output;
+      left_->EvaluateBatch(container, selection, left_output, context);
+      if (left_output.empty()) return;
+      right_->EvaluateBatch(container, left_output, output, context);
+      return;
+    }
+    case (EXPRESSION_TYPE_CONJUNCTION_OR): {
+      // The right side only sees positions that the left side rejected
+      std::vector<oid_t> left_output;
+      left_->EvaluateBatch(container, selection, left_output, context);
+      if (left_output.size() == selection.size()) {
+        output.insert(output.end(), left_output.begin(), left_output.end());
+        return;
+      }
+
+      std::vector<oid_t> remaining;
+      auto left_itr = left_output.begin();
+      for (oid_t tuple_id : selection) {
+        if (left_itr != left_output.end() && *left_itr == tuple_id)
+          left_itr++;
+        else
+          remaining.push_back(tuple_id);
+      }
+
+      std::vector<oid_t> right_output;
+      right_->EvaluateBatch(container, remaining, right_output, context);
+
+      // Both outputs are subsequences of the selection, so merge them back
+      // in selection order
+      left_itr = left_output.begin();
+      auto right_itr = right_output.begin();
+      for (oid_t tuple_id : selection) {
+        if (left_itr != left_output.end() && *left_itr == tuple_id) {
+          output.push_back(tuple_id);
+          left_itr++;
+        } else if (right_itr != right_output.end() && *right_itr == tuple_id) {
+          output.push_back(tuple_id);
+          right_itr++;
+        }
+      }
+      return;
+    }
+    default:
+      throw Exception("Invalid conjunction expression type.");
+  }
+}
+
+void ConjunctionExpression::EvaluateBatch(
+    storage::TileGroup *tile_group, const std::vector<oid_t> &selection,
+    std::vector<oid_t> &output, executor::ExecutorContext *context) const {
+  // Two bounds on the same column are checked in one pass over it
+  if (exp_type_ == EXPRESSION_TYPE_CONJUNCTION_AND && IsComparison(left_) &&
+      IsComparison(right_)) {
+    auto left = static_cast<const ComparisonExpression *>(left_);
+    auto right = static_cast<const ComparisonExpression *>(right_);
+    if (left->EvaluateRangeBatch(right, tile_group, selection, output,
+                                 context))
+      return;
+  }
+  EvaluateBatchImpl(tile_group, selection, output, context);
+}
+
+void ConjunctionExpression::EvaluateBatch(
+    executor::LogicalTile *tile, const std::vector<oid_t> &selection,
+    std::vector<oid_t> &output, executor::ExecutorContext *context) const {
+  EvaluateBatchImpl(tile, selection, output, context);
+}
+
+bool ConjunctionExpression::MayMatch(const storage::ZoneMap &zone_map,
+                                     executor::ExecutorContext *context) const {
+  switch (exp_type_) {
+    case (EXPRESSION_TYPE_CONJUNCTION_AND):
+      return (left_->MayMatch(zone_map, context) &&
+              right_->MayMatch(zone_map, context));
+    case (EXPRESSION_TYPE_CONJUNCTION_OR):
+      return (left_->MayMatch(zone_map, context) ||
+              right_->MayMatch(zone_map, context));
+    default:
+      throw Exception("Invalid conjunction expression type.");
+  }
+}
+
+}  // End expression namespace
+}  // End peloton namespace
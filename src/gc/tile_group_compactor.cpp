@@ -0,0 +1,271 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_compactor.cpp
+//
+// Identification: src/gc/tile_group_compactor.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <atomic>
+#include <chrono>
+
+#include "gc/tile_group_compactor.h"
+#include "gc/gc_manager_factory.h"
+#include "catalog/catalog.h"
+#include "catalog/manager.h"
+#include "common/logger.h"
+#include "common/value.h"
+#include "concurrency/transaction.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "storage/data_table.h"
+#include "storage/database.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+namespace peloton {
+namespace gc {
+
+TileGroupCompactor::~TileGroupCompactor() { StopCompactor(); }
+
+void TileGroupCompactor::StartCompactor() {
+  if (is_running_ == true) {
+    return;
+  }
+  LOG_TRACE("Starting tile group compactor");
+  is_running_ = true;
+  compactor_thread_.reset(
+      new std::thread(&TileGroupCompactor::Running, this));
+}
+
+void TileGroupCompactor::StopCompactor() {
+  if (is_running_ == false) {
+    return;
+  }
+  LOG_TRACE("Stopping tile group compactor");
+  {
+    std::lock_guard<std::mutex> lock(running_mutex_);
+    is_running_ = false;
+  }
+  running_cv_.notify_all();
+  compactor_thread_->join();
+  compactor_thread_.reset();
+}
+
+void TileGroupCompactor::Running() {
+  while (true) {
+    CompactTables();
+
+    std::unique_lock<std::mutex> lock(running_mutex_);
+    running_cv_.wait_for(lock, std::chrono::milliseconds(round_interval_),
+                         [this]() { return is_running_ == false; });
+    if (is_running_ == false) {
+      return;
+    }
+  }
+}
+
+void TileGroupCompactor::CompactTables() {
+  auto catalog = catalog::Catalog::GetInstance();
+  auto database_count = catalog->GetDatabaseCount();
+
+  // loop all databases
+  for (oid_t database_idx = 1; database_idx < database_count; database_idx++) {
+    auto database = catalog->GetDatabaseWithOffset(database_idx);
+    auto table_count = database->GetTableCount();
+
+    // loop all tables
+    for (oid_t table_idx = 0; table_idx < table_count; table_idx++) {
+      storage::DataTable *target_table = database->GetTable(table_idx);
+      PL_ASSERT(target_table);
+      CompactTable(target_table);
+    }
+  }
+}
+
+void TileGroupCompactor::CompactTable(storage::DataTable *table) {
+  // without an index, the versions have no indirection to switch over
+  if (table->GetIndexCount() == 0) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(compaction_mutex_);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &gc_manager = GCManagerFactory::GetInstance();
+
+  size_t tile_group_budget = max_tile_groups_per_round_;
+  size_t tuple_budget = max_tuples_per_round_;
+
+  auto tile_group_count = table->GetTileGroupCount();
+  for (oid_t tile_group_offset = START_OID;
+       tile_group_offset < tile_group_count; tile_group_offset++) {
+    auto tile_group = table->GetTileGroup(tile_group_offset);
+
+    // already dropped
+    if (tile_group == nullptr) {
+      continue;
+    }
+
+    auto tile_group_header = tile_group->GetHeader();
+    auto tile_group_id = tile_group->GetTileGroupId();
+
+    if (tile_group_header->GetImmutability() == false) {
+      if (tile_group_budget == 0 || IsSparse(tile_group.get()) == false) {
+        continue;
+      }
+
+      // a txn that begins after the current cid is read finds the tile group
+      // immutable
+      tile_group_header->SetImmutability();
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      immutable_tile_groups_[tile_group_id] = {
+          txn_manager.GetCurrentCommitId(), INVALID_CID};
+      tile_group_budget--;
+      compacted_tile_group_count_++;
+      LOG_TRACE("Compacting tile group %u", tile_group_id);
+    }
+
+    auto &immutable_tile_group = immutable_tile_groups_[tile_group_id];
+    auto max_committed_cid = txn_manager.GetMaxCommittedCid();
+
+    if (immutable_tile_group.drop_cid == INVALID_CID) {
+      if (tuple_budget > 0) {
+        tuple_budget -= RelocateTuples(table, tile_group.get(), tuple_budget);
+      }
+
+      // the transactions that began before the tile group became immutable
+      // may have been handed one of its recycled slots. once they are over,
+      // a free slot stays free.
+      if (immutable_tile_group.immutable_cid < max_committed_cid &&
+          IsFree(tile_group_header) == true) {
+        immutable_tile_group.drop_cid = txn_manager.GetCurrentCommitId();
+      }
+    } else if (immutable_tile_group.drop_cid < max_committed_cid &&
+               immutable_tile_group.drop_cid < gc_manager.GetUnlinkedCid()) {
+      // the indexes may still point to an aborted insert until the GC has
+      // unlinked it, and the transactions that were scanning the tile group
+      // are over
+      if (IsFree(tile_group_header) == false) {
+        immutable_tile_group.drop_cid = INVALID_CID;
+        continue;
+      }
+      table->DropTileGroup(tile_group_offset);
+      immutable_tile_groups_.erase(tile_group_id);
+      dropped_tile_group_count_++;
+      LOG_TRACE("Dropped compacted tile group %u", tile_group_id);
+    }
+  }
+}
+
+bool TileGroupCompactor::IsSparse(storage::TileGroup *tile_group) const {
+  auto tile_group_header = tile_group->GetHeader();
+  auto allocated_tuple_count = tile_group->GetAllocatedTupleCount();
+
+  // tuples are still being inserted into the tile group
+  if (tile_group_header->GetCurrentNextTupleSlot() < allocated_tuple_count) {
+    return false;
+  }
+
+  size_t max_live_tuple_count = allocated_tuple_count * occupancy_threshold_;
+  size_t live_tuple_count = 0;
+  for (oid_t tuple_id = 0; tuple_id < allocated_tuple_count; tuple_id++) {
+    // the latest version of a tuple, or one that is being modified
+    if (tile_group_header->GetTransactionId(tuple_id) != INVALID_TXN_ID &&
+        tile_group_header->GetEndCommitId(tuple_id) == MAX_CID) {
+      if (++live_tuple_count > max_live_tuple_count) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool TileGroupCompactor::IsFree(
+    storage::TileGroupHeader *tile_group_header) const {
+  auto tuple_count = tile_group_header->GetCurrentNextTupleSlot();
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    // a slot that was reset by the GC, or never used
+    if (tile_group_header->GetTransactionId(tuple_id) != INVALID_TXN_ID ||
+        tile_group_header->GetBeginCommitId(tuple_id) != MAX_CID) {
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t TileGroupCompactor::RelocateTuples(storage::DataTable *table,
+                                          storage::TileGroup *tile_group,
+                                          size_t max_tuple_count) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &manager = catalog::Manager::GetInstance();
+
+  auto tile_group_header = tile_group->GetHeader();
+  auto tile_group_id = tile_group->GetTileGroupId();
+  auto tuple_count = tile_group_header->GetCurrentNextTupleSlot();
+  auto column_count = table->GetSchema()->GetColumnCount();
+
+  size_t relocated_tuple_count = 0;
+  oid_t tuple_id = 0;
+  while (tuple_id < tuple_count && relocated_tuple_count < max_tuple_count) {
+    auto txn = txn_manager.BeginTransaction();
+    size_t txn_tuple_count = 0;
+
+    for (; tuple_id < tuple_count && txn_tuple_count < max_tuples_per_txn_ &&
+               relocated_tuple_count + txn_tuple_count < max_tuple_count;
+         tuple_id++) {
+      if (txn_manager.IsVisible(txn, tile_group_header, tuple_id) !=
+              VISIBILITY_OK ||
+          tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+        continue;
+      }
+
+      // leave the tuples that are being modified for a later round
+      if (txn_manager.IsOwnable(txn, tile_group_header, tuple_id) == false ||
+          txn_manager.AcquireOwnership(txn, tile_group_header, tuple_id) ==
+              false) {
+        skipped_tuple_count_++;
+        continue;
+      }
+
+      // a newer version was committed in the meantime
+      if (tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+        txn_manager.YieldOwnership(txn, tile_group_id, tuple_id);
+        skipped_tuple_count_++;
+        continue;
+      }
+
+      // the new version is a copy of the old one. the indexed values are the
+      // same, so the index entries are left alone.
+      ItemPointer new_location = table->AcquireVersion();
+      auto new_tile_group = manager.GetTileGroup(new_location.block);
+      for (oid_t column_id = 0; column_id < column_count; column_id++) {
+        std::unique_ptr<common::Value> value(
+            tile_group->GetValue(tuple_id, column_id));
+        new_tile_group->SetValue(*value, new_location.offset, column_id);
+      }
+
+      txn_manager.PerformUpdate(txn, ItemPointer(tile_group_id, tuple_id),
+                                new_location);
+      txn_tuple_count++;
+    }
+
+    auto result = txn_manager.CommitTransaction(txn);
+    if (result == RESULT_SUCCESS) {
+      relocated_tuple_count += txn_tuple_count;
+      relocated_tuple_count_ += txn_tuple_count;
+    } else {
+      skipped_tuple_count_ += txn_tuple_count;
+    }
+  }
+
+  LOG_TRACE("Relocated %lu tuples of tile group %u", relocated_tuple_count,
+            tile_group_id);
+  return relocated_tuple_count;
+}
+
+}  // namespace gc
+}  // namespace peloton
@@ -15,8 +15,10 @@
 #include "storage/database.h"
 #include "storage/tile_group.h"
 #include "catalog/manager.h"
+#include "common/config.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "expression/container_tuple.h"
+#include "statistics/backend_stats_context.h"
 
 namespace peloton {
 namespace gc {
@@ -29,7 +31,11 @@ void TransactionLevelGCManager::StartGC(int thread_id) {
 
 void TransactionLevelGCManager::StopGC(int thread_id) {
   LOG_TRACE("Stopping GC");
-  this->is_running_ = false;
+  {
+    std::lock_guard<std::mutex> lock(park_mutex_);
+    this->is_running_ = false;
+  }
+  park_cv_.notify_all();
   this->gc_threads_[thread_id]->join();
   ClearGarbage(thread_id);
 }
@@ -67,55 +73,190 @@ void TransactionLevelGCManager::Running(const int &thread_id) {
 
     Unlink(thread_id, max_cid);
 
+    if (thread_id == 0 && is_adaptive_ == true) {
+      AdjustThreadCount();
+    }
+
+    // a thread that no garbage is handed to sleeps once it has drained its
+    // own. it still wakes up now and then for the garbage of the workers
+    // that hashed it before the thread was deactivated.
+    if (thread_id >= active_thread_count_ && IsDrained(thread_id) == true) {
+      std::unique_lock<std::mutex> lock(park_mutex_);
+      park_cv_.wait_for(lock, std::chrono::milliseconds(control_interval_),
+                        [this, thread_id]() {
+        return thread_id < active_thread_count_ || is_running_ == false;
+      });
+    }
+
     if (is_running_ == false) {
       return;
     }
   }
 }
 
+void TransactionLevelGCManager::AdjustThreadCount() {
+  auto now = std::chrono::steady_clock::now();
+  if (now - last_control_time_ <
+      std::chrono::milliseconds(control_interval_)) {
+    return;
+  }
+  last_control_time_ = now;
+
+  size_t backlog = GetUnlinkBacklog() + GetReclaimBacklog();
+  int target_thread_count = std::min<size_t>(
+      backlog / backlog_per_thread_ + 1, gc_thread_count_);
+  int active_thread_count = active_thread_count_;
+
+  // scale up at once to keep the garbage bounded under a burst, and down one
+  // thread at a time so that a short lull does not park them all
+  if (target_thread_count > active_thread_count) {
+    SetActiveThreadCount(target_thread_count);
+  } else if (target_thread_count < active_thread_count) {
+    SetActiveThreadCount(active_thread_count - 1);
+  }
+}
+
+void TransactionLevelGCManager::SetActiveThreadCount(int thread_count) {
+  if (active_thread_count_ == thread_count) {
+    return;
+  }
+  LOG_TRACE("Handing the garbage to %d GC threads", thread_count);
+  {
+    std::lock_guard<std::mutex> lock(park_mutex_);
+    active_thread_count_ = thread_count;
+  }
+  park_cv_.notify_all();
+}
+
+bool TransactionLevelGCManager::IsDrained(const int &thread_id) {
+  return unlink_queues_[thread_id]->IsEmpty() == true &&
+         local_unlink_queues_[thread_id].empty() == true &&
+         reclaim_maps_[thread_id].empty() == true;
+}
+
 
 void TransactionLevelGCManager::RecycleTransaction(std::shared_ptr<ReadWriteSet> gc_set, const cid_t &timestamp, const GCSetType gc_set_type) {
     // Add the garbage context to the lockfree queue
     std::shared_ptr<GarbageContext> gc_context(new GarbageContext(gc_set, timestamp, gc_set_type));
-    unlink_queues_[HashToThread(gc_context->timestamp_)]->Enqueue(gc_context);
+    auto thread_id = HashToThread(gc_context->timestamp_);
+    queued_counts_[thread_id]++;
+    unlink_queues_[thread_id]->Enqueue(gc_context);
+}
+
+// The older versions of a version that began before every live transaction
+// are invisible to all of them. The worker cuts them off the chain, and then
+// claims them one by one by swapping their end cid, which is the begin cid of
+// the version above them, with INVALID_CID. The GC claims the versions of a
+// committed gc set in the same way before resetting them, so a version is
+// reclaimed exactly once, whichever of the two gets to it first. Commit ids
+// are never reused, so a slot that was reset and reused in the meantime
+// cannot be claimed by mistake.
+void TransactionLevelGCManager::PruneVersionChain(
+    storage::TileGroupHeader *tile_group_header, const oid_t &tuple_id) {
+  ItemPointer older_version = tile_group_header->GetNextItemPointer(tuple_id);
+  if (older_version.IsNull() == true) {
+    return;
+  }
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  cid_t end_cid = tile_group_header->GetBeginCommitId(tuple_id);
+  cid_t max_committed_cid = txn_manager.GetMaxCommittedCid();
+  if (end_cid > max_committed_cid) {
+    return;
+  }
+
+  // only one worker unlinks the tail of a version
+  if (tile_group_header->SetAtomicNextItemPointer(
+          tuple_id, older_version, INVALID_ITEMPOINTER) == false) {
+    return;
+  }
+
+  auto &manager = catalog::Manager::GetInstance();
+  auto gc_set = ReadWriteSet::CreateShared();
+  while (older_version.IsNull() == false) {
+    auto tile_group = manager.GetTileGroup(older_version.block);
+    if (tile_group == nullptr) {
+      break;
+    }
+    auto older_header = tile_group->GetHeader();
+
+    // read the next version before the claim lets the GC reset this one
+    ItemPointer next_version =
+        older_header->GetNextItemPointer(older_version.offset);
+    cid_t begin_cid = older_header->GetBeginCommitId(older_version.offset);
+    if (older_header->SetAtomicEndCommitId(older_version.offset, end_cid,
+                                           INVALID_CID) == false) {
+      // the GC got to the rest of the chain first
+      break;
+    }
+    gc_set->Insert(older_version.block, older_version.offset, RW_TYPE_UPDATE);
+
+    end_cid = begin_cid;
+    older_version = next_version;
+  }
+
+  if (gc_set->empty() == true) {
+    return;
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementPrunedVersions(
+        gc_set->size());
+  }
+
+  // the transactions of the current epoch never go past this version, and
+  // the older ones finish before the GC resets the pruned versions
+  RecycleTransaction(gc_set, max_committed_cid, GC_SET_TYPE_PRUNED);
 }
 
 void TransactionLevelGCManager::Unlink(const int &thread_id, const cid_t &max_cid) {
   
   int tuple_counter = 0;
 
+  // the oldest garbage context left in the local unlink queue
+  cid_t oldest_cid = MAX_CID;
+
   // check if any garbage can be unlinked from indexes.
   // every time we garbage collect at most MAX_ATTEMPT_COUNT tuples.
   std::vector<std::shared_ptr<GarbageContext>> garbages;
 
   // First iterate the local unlink queue
   local_unlink_queues_[thread_id].remove_if(
-    [this, &garbages, &tuple_counter, max_cid](const std::shared_ptr<GarbageContext>& garbage_ctx) -> bool {
+    [this, &garbages, &tuple_counter, &oldest_cid, max_cid](const std::shared_ptr<GarbageContext>& garbage_ctx) -> bool {
       bool res = garbage_ctx->timestamp_ < max_cid;
       if (res == true) {
-        DeleteFromIndexes(garbage_ctx);
         // Add to the garbage map
         garbages.push_back(garbage_ctx);
         tuple_counter++;
+      } else {
+        oldest_cid = std::min(oldest_cid, garbage_ctx->timestamp_);
       }
       return res;
     }
   );
 
+  bool is_drained = false;
   for (size_t i = 0; i < MAX_ATTEMPT_COUNT; ++i) {
 
     std::shared_ptr<GarbageContext> garbage_ctx;
     // if there's no more tuples in the queue, then break.
     if (unlink_queues_[thread_id]->Dequeue(garbage_ctx) == false) {
+      is_drained = true;
       break;
     }
+    queued_counts_[thread_id]--;
+
+    // the size of the versions is only a metric
+    if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+      garbage_ctx->version_bytes_ = GetVersionBytes(garbage_ctx);
+      dead_version_bytes_[thread_id] += garbage_ctx->version_bytes_;
+    }
 
     if (garbage_ctx->timestamp_ < max_cid) {
       // as the max timestamp of committed transactions is larger than the gc's timestamp,
       // it means that no active transactions can read it.
       // so we can unlink it.
       // we need to delete all the tuples from the indexes to which it belongs as well.
-      DeleteFromIndexes(garbage_ctx);
       // Add to the garbage map
       garbages.push_back(garbage_ctx);
       tuple_counter++;
@@ -123,19 +264,39 @@ void TransactionLevelGCManager::Unlink(const int &thread_id, const cid_t &max_ci
     } else {
       // if a tuple cannot be reclaimed, then add it back to the list.
       local_unlink_queues_[thread_id].push_back(garbage_ctx);
+      oldest_cid = std::min(oldest_cid, garbage_ctx->timestamp_);
     }
   }  // end for
 
+  // the index entries of all the garbage of this pass are deleted in batches
+  DeleteFromIndexes(garbages);
+
   auto safe_max_cid = concurrency::TransactionManagerFactory::GetInstance().GetNextCommitId();
   for(auto& item : garbages){
       reclaim_maps_[thread_id].insert(std::make_pair(safe_max_cid, item));
   }
+
+  // the contexts left in the local queue are not older than max_cid
+  if (is_drained == true) {
+    unlinked_cids_[thread_id] = max_cid;
+  }
+
+  // the contexts are reclaimed in the order they were unlinked, so the first
+  // one of the reclaim map stands for the unlinked ones
+  if (reclaim_maps_[thread_id].empty() == false) {
+    oldest_cid = std::min(oldest_cid,
+                          reclaim_maps_[thread_id].begin()->second->timestamp_);
+  }
+  oldest_cids_[thread_id] = oldest_cid;
+  local_counts_[thread_id] = local_unlink_queues_[thread_id].size();
+  reclaim_counts_[thread_id] = reclaim_maps_[thread_id].size();
   LOG_TRACE("Marked %d tuples as garbage", tuple_counter);
 }
 
 // executed by a single thread. so no synchronization is required.
 void TransactionLevelGCManager::Reclaim(const int &thread_id, const cid_t &max_cid) {
   int gc_counter = 0;
+  size_t version_counter = 0;
 
   // we delete garbage in the free list
   auto garbage_ctx_entry = reclaim_maps_[thread_id].begin();
@@ -147,6 +308,8 @@ void TransactionLevelGCManager::Reclaim(const int &thread_id, const cid_t &max_c
     // recycle it
     if (garbage_ts < max_cid) {
       AddToRecycleMap(garbage_ctx);
+      version_counter += garbage_ctx->gc_set_->size();
+      dead_version_bytes_[thread_id] -= garbage_ctx->version_bytes_;
 
       // Remove from the original map
       garbage_ctx_entry = reclaim_maps_[thread_id].erase(garbage_ctx_entry);
@@ -156,6 +319,8 @@ void TransactionLevelGCManager::Reclaim(const int &thread_id, const cid_t &max_c
       break;
     }
   }
+  reclaimed_version_count_ += version_counter;
+  reclaim_counts_[thread_id] = reclaim_maps_[thread_id].size();
   LOG_TRACE("Marked %d txn contexts as recycled", gc_counter);
 }
 
@@ -165,11 +330,12 @@ void TransactionLevelGCManager::AddToRecycleMap(std::shared_ptr<GarbageContext>
   for (auto &entry : *(garbage_ctx->gc_set_.get())) {
 
     auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(entry.first);
+    auto tile_group = manager.GetTileGroup(entry.tile_group_id);
 
-    // During the resetting, a table may deconstruct because of the DROP TABLE request
+    // During the resetting, a table may deconstruct because of the DROP TABLE
+    // request, or the tile group may have been dropped by compaction
     if (tile_group == nullptr) {
-      return;
+      continue;
     }
 
     PL_ASSERT(tile_group != nullptr);
@@ -180,20 +346,32 @@ void TransactionLevelGCManager::AddToRecycleMap(std::shared_ptr<GarbageContext>
 
     oid_t table_id = table->GetOid();
 
-    for (auto &element : entry.second) {
+    // as this transaction has been committed, we should reclaim older versions.
+    ItemPointer location(entry.tile_group_id, entry.tuple_id);
 
-      // as this transaction has been committed, we should reclaim older versions.
-      ItemPointer location(entry.first, element.first); 
-      
-      // If the tuple being reset no longer exists, just skip it
-      if (ResetTuple(location) == false) {
+    // an old version may have been pruned by a worker already, see
+    // PruneVersionChain()
+    if (garbage_ctx->gc_set_type_ == GC_SET_TYPE_COMMITTED &&
+        (entry.type == RW_TYPE_UPDATE || entry.type == RW_TYPE_DELETE)) {
+      auto tile_group_header = tile_group->GetHeader();
+      if (tile_group_header->SetAtomicEndCommitId(
+              entry.tuple_id, garbage_ctx->timestamp_, INVALID_CID) == false) {
         continue;
       }
-      // if the entry for table_id exists.
-      PL_ASSERT(recycle_queue_map_.find(table_id) != recycle_queue_map_.end());
-      recycle_queue_map_[table_id]->Enqueue(location);
+    }
 
+    // If the tuple being reset no longer exists, just skip it
+    if (ResetTuple(location) == false) {
+      continue;
     }
+
+    // the free slots of a tile group that is being compacted are not reused
+    if (tile_group->GetHeader()->GetImmutability() == true) {
+      continue;
+    }
+    // if the entry for table_id exists.
+    PL_ASSERT(recycle_queue_map_.find(table_id) != recycle_queue_map_.end());
+    recycle_queue_map_[table_id]->Enqueue(location);
   }
 
 }
@@ -205,7 +383,15 @@ ItemPointer TransactionLevelGCManager::ReturnFreeSlot(const oid_t &table_id) {
   ItemPointer location;
   auto recycle_queue = recycle_queue_map_[table_id];
 
-  if (recycle_queue->Dequeue(location) == true) {
+  auto &manager = catalog::Manager::GetInstance();
+  while (recycle_queue->Dequeue(location) == true) {
+    // the slot was recycled before its tile group became immutable
+    auto tile_group = manager.GetTileGroup(location.block);
+    if (tile_group == nullptr ||
+        tile_group->GetHeader()->GetImmutability() == true) {
+      continue;
+    }
+
     LOG_TRACE("Reuse tuple(%u, %u) in table %u", location.block,
               location.offset, table_id);
     return location;
@@ -213,6 +399,60 @@ ItemPointer TransactionLevelGCManager::ReturnFreeSlot(const oid_t &table_id) {
   return INVALID_ITEMPOINTER;
 }
 
+cid_t TransactionLevelGCManager::GetUnlinkedCid() {
+  cid_t unlinked_cid = MAX_CID;
+  for (auto &thread_unlinked_cid : unlinked_cids_) {
+    unlinked_cid = std::min<cid_t>(unlinked_cid, thread_unlinked_cid);
+  }
+  return unlinked_cid;
+}
+
+size_t TransactionLevelGCManager::GetUnlinkBacklog() {
+  size_t backlog = 0;
+  for (int thread_id = 0; thread_id < gc_thread_count_; ++thread_id) {
+    backlog += queued_counts_[thread_id] + local_counts_[thread_id];
+  }
+  return backlog;
+}
+
+size_t TransactionLevelGCManager::GetReclaimBacklog() {
+  size_t backlog = 0;
+  for (auto &reclaim_count : reclaim_counts_) {
+    backlog += reclaim_count;
+  }
+  return backlog;
+}
+
+cid_t TransactionLevelGCManager::GetOldestUnreclaimedCid() {
+  cid_t oldest_cid = MAX_CID;
+  for (auto &thread_oldest_cid : oldest_cids_) {
+    oldest_cid = std::min<cid_t>(oldest_cid, thread_oldest_cid);
+  }
+  return oldest_cid;
+}
+
+size_t TransactionLevelGCManager::GetDeadVersionBytes() {
+  size_t version_bytes = 0;
+  for (auto &thread_version_bytes : dead_version_bytes_) {
+    version_bytes += thread_version_bytes;
+  }
+  return version_bytes;
+}
+
+size_t TransactionLevelGCManager::GetVersionBytes(
+    const std::shared_ptr<GarbageContext> &garbage_ctx) {
+  auto &manager = catalog::Manager::GetInstance();
+  size_t version_bytes = 0;
+  for (auto &entry : *(garbage_ctx->gc_set_.get())) {
+    auto tile_group = manager.GetTileGroup(entry.tile_group_id);
+    if (tile_group == nullptr) {
+      continue;
+    }
+    version_bytes += tile_group->GetAbstractTable()->GetSchema()->GetLength();
+  }
+  return version_bytes;
+}
+
 void TransactionLevelGCManager::ClearGarbage(int thread_id) {
   while(!unlink_queues_[thread_id]->IsEmpty() || !local_unlink_queues_[thread_id].empty()) {
     Unlink(thread_id, MAX_CID);
@@ -225,80 +465,109 @@ void TransactionLevelGCManager::ClearGarbage(int thread_id) {
   return;
 }
 
-void TransactionLevelGCManager::DeleteFromIndexes(const std::shared_ptr<GarbageContext>& garbage_ctx) {
+void TransactionLevelGCManager::DeleteFromIndexes(
+    const std::vector<std::shared_ptr<GarbageContext>> &garbages) {
 
-  GCSetType gc_set_type = garbage_ctx->gc_set_type_;
-  
-  if (gc_set_type == GC_SET_TYPE_COMMITTED) {
-    // if the transaction is committed, 
-    // then we need to remove tuples that are deleted by the transaction from indexes.
-    for (auto entry : *(garbage_ctx->gc_set_.get())) {
-      for (auto &element : entry.second) {
-        if (element.second == RW_TYPE_DELETE || element.second == RW_TYPE_INS_DEL) {
-          // only old versions are stored in the gc set.
-          // so we can safely get indirection from the indirection array.
-          auto tile_group_header = catalog::Manager::GetInstance()
-                                       .GetTileGroup(entry.first)
-                                       ->GetHeader();
-          ItemPointer *indirection = tile_group_header->GetIndirection(element.first);
-
-          DeleteTupleFromIndexes(indirection);
+  auto &manager = catalog::Manager::GetInstance();
 
+  // the indirections of the tuples to unlink, by table
+  std::unordered_map<storage::DataTable *, std::vector<ItemPointer *>> table_indirections;
+
+  for (auto &garbage_ctx : garbages) {
+    GCSetType gc_set_type = garbage_ctx->gc_set_type_;
+
+    // pruned versions have a newer version, which keeps their index entries
+    if (gc_set_type == GC_SET_TYPE_PRUNED) {
+      continue;
+    }
+    PL_ASSERT(gc_set_type == GC_SET_TYPE_COMMITTED ||
+              gc_set_type == GC_SET_TYPE_ABORTED);
+
+    for (auto &entry : *(garbage_ctx->gc_set_.get())) {
+      if (gc_set_type == GC_SET_TYPE_COMMITTED) {
+        // if the transaction is committed,
+        // then we need to remove tuples that are deleted by the transaction from indexes.
+        if (entry.type != RW_TYPE_DELETE && entry.type != RW_TYPE_INS_DEL) {
+          continue;
+        }
+      } else {
+        // if the transaction is aborted,
+        // then we need to remove tuples that are inserted by the transaction from indexes.
+        if (entry.type != RW_TYPE_INSERT && entry.type != RW_TYPE_INS_DEL) {
+          continue;
         }
       }
-    }
 
-  } else {
-    PL_ASSERT(gc_set_type == GC_SET_TYPE_ABORTED);
+      // only old versions are stored in the gc set.
+      // so we can safely get indirection from the indirection array.
+      auto tile_group = manager.GetTileGroup(entry.tile_group_id);
+      ItemPointer *indirection =
+          tile_group->GetHeader()->GetIndirection(entry.tuple_id);
 
-    for (auto entry : *(garbage_ctx->gc_set_.get())) {
-      for (auto &element : entry.second) {
-        if (element.second == RW_TYPE_INSERT || element.second == RW_TYPE_INS_DEL) {
-          auto tile_group_header = catalog::Manager::GetInstance()
-                                       .GetTileGroup(entry.first)
-                                       ->GetHeader();
-          ItemPointer *indirection = tile_group_header->GetIndirection(element.first);
+      storage::DataTable *table =
+        dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+      PL_ASSERT(table != nullptr);
 
-          DeleteTupleFromIndexes(indirection);
-           
-        }
-      }
+      table_indirections[table].push_back(indirection);
     }
   }
 
+  for (auto &entry : table_indirections) {
+    auto &indirections = entry.second;
+    for (size_t offset = 0; offset < indirections.size();
+         offset += INDEX_DELETE_BATCH_SIZE) {
+      size_t batch_size = std::min<size_t>(INDEX_DELETE_BATCH_SIZE,
+                                           indirections.size() - offset);
+      DeleteTuplesFromIndexes(entry.first, &indirections[offset], batch_size);
+    }
+  }
 }
 
-// delete a tuple from all its indexes it belongs to.
-void TransactionLevelGCManager::DeleteTupleFromIndexes(ItemPointer *indirection) {
-  LOG_TRACE("Deleting indirection %p from index", indirection);
-  
-  ItemPointer location = *indirection;
+// delete a batch of tuples of a table from all its indexes.
+void TransactionLevelGCManager::DeleteTuplesFromIndexes(
+    storage::DataTable *table, ItemPointer *const *indirections,
+    const size_t &tuple_count) {
+  LOG_TRACE("Deleting %lu indirections of table %u from index", tuple_count,
+            table->GetOid());
 
   auto &manager = catalog::Manager::GetInstance();
-  auto tile_group = manager.GetTileGroup(location.block);
 
-  PL_ASSERT(tile_group != nullptr);
-
-  storage::DataTable *table =
-    dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
-  PL_ASSERT(table != nullptr);
+  // construct the expired versions.
+  std::vector<std::shared_ptr<storage::TileGroup>> tile_groups;
+  std::vector<expression::ContainerTuple<storage::TileGroup>> expired_tuples;
+  tile_groups.reserve(tuple_count);
+  expired_tuples.reserve(tuple_count);
+  for (size_t tuple_idx = 0; tuple_idx < tuple_count; ++tuple_idx) {
+    ItemPointer location = *(indirections[tuple_idx]);
+    auto tile_group = manager.GetTileGroup(location.block);
+    PL_ASSERT(tile_group != nullptr);
 
-  // construct the expired version.
-  expression::ContainerTuple<storage::TileGroup> expired_tuple(tile_group.get(), location.offset);
+    oid_t tuple_id = location.offset;
+    expired_tuples.emplace_back(tile_group.get(), tuple_id);
+    tile_groups.push_back(std::move(tile_group));
+  }
 
-  // unlink the version from all the indexes.
+  // unlink the versions from all the indexes, one batch per index.
   for (size_t idx = 0; idx < table->GetIndexCount(); ++idx) {
     auto index = table->GetIndex(idx);
     auto index_schema = index->GetKeySchema();
     auto indexed_columns = index_schema->GetIndexedColumns();
 
-    // build key.
-    std::unique_ptr<storage::Tuple> key(
-      new storage::Tuple(index_schema, true));
-    key->SetFromTuple(&expired_tuple, indexed_columns, index->GetPool());
-
-    index->DeleteEntry(key.get(), indirection);
+    // build keys.
+    std::vector<std::unique_ptr<storage::Tuple>> keys;
+    std::vector<std::pair<const storage::Tuple *, ItemPointer *>> entries;
+    keys.reserve(tuple_count);
+    entries.reserve(tuple_count);
+    for (size_t tuple_idx = 0; tuple_idx < tuple_count; ++tuple_idx) {
+      std::unique_ptr<storage::Tuple> key(
+        new storage::Tuple(index_schema, true));
+      key->SetFromTuple(&expired_tuples[tuple_idx], indexed_columns,
+                        index->GetPool());
+      entries.emplace_back(key.get(), indirections[tuple_idx]);
+      keys.push_back(std::move(key));
+    }
 
+    index->DeleteEntries(entries);
   }
 }
 
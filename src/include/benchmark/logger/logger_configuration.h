@@ -85,6 +85,12 @@ class configuration {
 
   // asynchronous_mode
   AsynchronousType asynchronous_mode;
+
+  // number of log streams, each with its own frontend logger and files
+  int log_stream_count;
+
+  // number of threads that replay the log (0 : one per core)
+  int recovery_thread_count;
 };
 
 void Usage(FILE *out);
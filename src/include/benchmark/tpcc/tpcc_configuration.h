@@ -191,6 +191,12 @@ class configuration {
   // number of gc threads
   bool gc_backend_count;
 
+  // number of transaction ids a backend reserves at a time
+  int txn_id_batch_size;
+
+  // concurrency control protocol
+  ConcurrencyType protocol;
+
   // throughput
   double throughput = 0;
 
@@ -225,6 +231,10 @@ void ValidateWarehouseCount(const configuration &state);
 
 void ValidateGCBackendCount(const configuration &state);
 
+void ValidateTxnIdBatchSize(const configuration &state);
+
+void ValidateProtocol(const configuration &state);
+
 void WriteOutput();
 
 }  // namespace tpcc
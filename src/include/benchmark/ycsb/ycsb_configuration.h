@@ -76,6 +76,12 @@ class configuration {
   // number of gc threads
   bool gc_backend_count;
 
+  // number of transaction ids a backend reserves at a time
+  int txn_id_batch_size;
+
+  // concurrency control protocol
+  ConcurrencyType protocol;
+
   // throughput
   double throughput = 0;
 
@@ -116,6 +122,10 @@ void ValidateZipfTheta(const configuration &state);
 
 void ValidateGCBackendCount(const configuration &state);
 
+void ValidateTxnIdBatchSize(const configuration &state);
+
+void ValidateProtocol(const configuration &state);
+
 void WriteOutput();
 
 }  // namespace ycsb
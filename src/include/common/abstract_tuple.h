@@ -15,6 +15,7 @@
 
 #include "common/types.h"
 #include "common/value.h"
+#include "common/typed_value.h"
 
 namespace peloton {
 
@@ -33,6 +34,10 @@ class AbstractTuple {
   /** @brief Get the value at the given column id. */
   virtual common::Value *GetValue(oid_t column_id) const = 0;
 
+  /** @brief Get an allocation-free view of the value at the given column id.
+   */
+  virtual common::TypedValue GetTypedValue(oid_t column_id) const = 0;
+
   /** @brief Set the value at the given column id. */
   virtual void SetValue(oid_t column_id, const common::Value &value) = 0;
 
@@ -0,0 +1,97 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set.h
+//
+// Identification: src/include/common/read_write_set.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "common/types.h"
+
+namespace peloton {
+
+//===--------------------------------------------------------------------===//
+// Read Write Set
+//===--------------------------------------------------------------------===//
+
+struct ReadWriteEntry {
+  oid_t tile_group_id;
+  oid_t tuple_id;
+  RWType type;
+};
+
+/**
+ * The tuples accessed by a transaction, in the order of their first access.
+ *
+ * Entries are appended to a flat array. Small sets are searched linearly;
+ * larger ones also keep an open addressing hash index over the array to
+ * find duplicates. Sets are recycled by the thread that releases them, so a
+ * worker usually reuses the memory of its previous transactions.
+ */
+class ReadWriteSet {
+  ReadWriteSet(ReadWriteSet const &) = delete;
+
+ public:
+  typedef std::vector<ReadWriteEntry>::const_iterator const_iterator;
+
+  struct Deleter {
+    void operator()(ReadWriteSet *rw_set) const { Release(rw_set); }
+  };
+
+  // Get an empty set, reusing one released by the current thread if any
+  static std::unique_ptr<ReadWriteSet, Deleter> Create();
+
+  // Same, for a set that is shared with the GC
+  static std::shared_ptr<ReadWriteSet> CreateShared();
+
+  // Get the type recorded for a tuple, nullptr if the tuple is not in the set
+  RWType *Find(const oid_t &tile_group_id, const oid_t &tuple_id);
+
+  const RWType *Find(const oid_t &tile_group_id, const oid_t &tuple_id) const {
+    return const_cast<ReadWriteSet *>(this)->Find(tile_group_id, tuple_id);
+  }
+
+  // Append a tuple that is not in the set yet
+  void Insert(const oid_t &tile_group_id, const oid_t &tuple_id,
+              const RWType &type);
+
+  // Record the type of a tuple, whether it is in the set or not
+  void Set(const oid_t &tile_group_id, const oid_t &tuple_id,
+           const RWType &type);
+
+  void Clear();
+
+  size_t size() const { return entries_.size(); }
+
+  bool empty() const { return entries_.empty(); }
+
+  const_iterator begin() const { return entries_.begin(); }
+
+  const_iterator end() const { return entries_.end(); }
+
+ private:
+  ReadWriteSet() {}
+
+  static void Release(ReadWriteSet *rw_set);
+
+  void RebuildIndex(size_t capacity);
+
+  void AddToIndex(uint32_t position);
+
+  std::vector<ReadWriteEntry> entries_;
+
+  // Positions + 1 of the entries, 0 for an empty slot. Only built once the
+  // set outgrows a linear search.
+  std::vector<uint32_t> index_;
+};
+
+}  // End peloton namespace
@@ -66,6 +66,10 @@ class Statement {
 
   const std::shared_ptr<planner::AbstractPlan>& GetPlanTree() const;
 
+  void SetReadOnlyBegin(bool read_only_begin);
+
+  bool IsReadOnlyBegin() const;
+
  private:
   // logical name of statement
   std::string statement_name;
@@ -84,6 +88,9 @@ class Statement {
 
   // cached plan tree
   std::shared_ptr<planner::AbstractPlan> plan_tree;
+
+  // whether the statement is a BEGIN READ ONLY
+  bool read_only_begin = false;
 };
 
 }  // namespace peloton
@@ -0,0 +1,329 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// typed_value.h
+//
+// Identification: src/include/common/typed_value.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstring>
+
+#include "common/value.h"
+#include "common/exception.h"
+#include "common/macros.h"
+
+namespace peloton {
+namespace common {
+
+// Result of a comparison between two typed values. SQL comparisons are
+// three-valued, so a comparison involving a NULL yields CMP_NULL.
+enum CmpBool {
+  CMP_FALSE = 0,
+  CMP_TRUE = 1,
+  CMP_NULL = 2
+};
+
+// A typed value is a compact, non-virtual, stack-allocated view over SQL data.
+// It carries the same type tag and payload as a Value but never allocates:
+// variable length data is referenced in place (in a tile, a tuple or a Value)
+// and must outlive the typed value.
+//
+// Typed values are meant for the execution hot path (predicate evaluation,
+// hashing and key building). The Value hierarchy remains the owning
+// representation; FromValue() and ToValue() convert between the two.
+class TypedValue {
+ public:
+  TypedValue() : type_id_(Type::INVALID), len_(0) { value_.bigint = 0; }
+
+  TypedValue(int8_t i) : type_id_(Type::TINYINT), len_(0) {
+    value_.bigint = 0;
+    value_.tinyint = i;
+  }
+  TypedValue(int16_t i) : type_id_(Type::SMALLINT), len_(0) {
+    value_.bigint = 0;
+    value_.smallint = i;
+  }
+  TypedValue(int32_t i) : type_id_(Type::INTEGER), len_(0) {
+    value_.bigint = 0;
+    value_.integer = i;
+  }
+  TypedValue(int64_t i) : type_id_(Type::BIGINT), len_(0) {
+    value_.bigint = i;
+  }
+  TypedValue(double d) : type_id_(Type::DECIMAL), len_(0) {
+    value_.decimal = d;
+  }
+
+  // A varchar referencing len bytes at data (data is not copied)
+  TypedValue(const char *data, uint32_t len)
+      : type_id_(Type::VARCHAR), len_(len) {
+    value_.ptr = const_cast<char *>(data);
+  }
+
+  static inline TypedValue GetBoolean(int8_t b) {
+    TypedValue result;
+    result.type_id_ = Type::BOOLEAN;
+    result.value_.boolean = b;
+    return result;
+  }
+
+  static inline TypedValue GetTimestamp(uint64_t t) {
+    TypedValue result;
+    result.type_id_ = Type::TIMESTAMP;
+    result.value_.timestamp = t;
+    return result;
+  }
+
+  // Get the NULL value of the given type
+  static TypedValue GetNullValueByType(Type::TypeId type_id);
+
+  // Read a value of the given type from tile or tuple storage
+  static inline TypedValue DeserializeFrom(const char *storage,
+                                           const Type::TypeId type_id) {
+    TypedValue result;
+    result.type_id_ = type_id;
+    switch (type_id) {
+      case Type::BOOLEAN:
+      case Type::TINYINT:
+        result.value_.tinyint = *reinterpret_cast<const int8_t *>(storage);
+        return result;
+      case Type::SMALLINT:
+        result.value_.smallint = *reinterpret_cast<const int16_t *>(storage);
+        return result;
+      case Type::INTEGER:
+        result.value_.integer = *reinterpret_cast<const int32_t *>(storage);
+        return result;
+      case Type::BIGINT:
+        result.value_.bigint = *reinterpret_cast<const int64_t *>(storage);
+        return result;
+      case Type::DECIMAL:
+        result.value_.decimal = *reinterpret_cast<const double *>(storage);
+        return result;
+      case Type::TIMESTAMP:
+        result.value_.timestamp = *reinterpret_cast<const uint64_t *>(storage);
+        return result;
+      case Type::VARCHAR: {
+        const char *ptr = *reinterpret_cast<const char *const *>(storage);
+        if (ptr == nullptr) {
+          result.value_.ptr = nullptr;
+          result.len_ = 0;
+        } else {
+          result.len_ = *reinterpret_cast<const uint32_t *>(ptr);
+          result.value_.ptr = const_cast<char *>(ptr + sizeof(uint32_t));
+        }
+        return result;
+      }
+      default:
+        break;
+    }
+    throw Exception(EXCEPTION_TYPE_UNKNOWN_TYPE, "Unknown type.");
+  }
+
+  // Build a view over an existing value (varlen data is not copied)
+  static TypedValue FromValue(const Value &value);
+
+  // Materialize a heap-allocated Value holding a copy of this value
+  Value *ToValue() const;
+
+  Type::TypeId GetTypeId() const { return type_id_; }
+
+  template <class T>
+  T GetAs() const { return *reinterpret_cast<const T *>(&value_); }
+
+  // Access the raw variable length data
+  const char *GetData() const { return value_.ptr; }
+
+  // Get the length of the variable length data
+  uint32_t GetLength() const { return len_; }
+
+  inline bool IsNull() const {
+    switch (type_id_) {
+      case Type::BOOLEAN:
+        return (value_.boolean == PELOTON_BOOLEAN_NULL);
+      case Type::TINYINT:
+        return (value_.tinyint == PELOTON_INT8_NULL);
+      case Type::SMALLINT:
+        return (value_.smallint == PELOTON_INT16_NULL);
+      case Type::INTEGER:
+      case Type::PARAMETER_OFFSET:
+        return (value_.integer == PELOTON_INT32_NULL);
+      case Type::BIGINT:
+        return (value_.bigint == PELOTON_INT64_NULL);
+      case Type::DECIMAL:
+        return (value_.decimal == PELOTON_DECIMAL_NULL);
+      case Type::TIMESTAMP:
+        return (value_.timestamp == PELOTON_TIMESTAMP_NULL);
+      case Type::VARCHAR:
+        return (value_.ptr == nullptr || len_ == 0);
+      default:
+        break;
+    }
+    throw Exception(EXCEPTION_TYPE_UNKNOWN_TYPE, "Unknown type.");
+  }
+
+  inline bool IsInteger() const {
+    switch (type_id_) {
+      case Type::TINYINT:
+      case Type::SMALLINT:
+      case Type::INTEGER:
+      case Type::BIGINT:
+      case Type::PARAMETER_OFFSET:
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  // Widen an integer value to 64 bits
+  inline int64_t GetAsBigInt() const {
+    switch (type_id_) {
+      case Type::TINYINT:
+        return value_.tinyint;
+      case Type::SMALLINT:
+        return value_.smallint;
+      case Type::INTEGER:
+      case Type::PARAMETER_OFFSET:
+        return value_.integer;
+      case Type::BIGINT:
+        return value_.bigint;
+      default:
+        break;
+    }
+    throw Exception(EXCEPTION_TYPE_MISMATCH_TYPE,
+                    Type::GetInstance(type_id_).ToString() +
+                        " is not an integer type.");
+  }
+
+  // Widen a numeric value to a double
+  inline double GetAsDecimal() const {
+    if (type_id_ == Type::DECIMAL) return value_.decimal;
+    return static_cast<double>(GetAsBigInt());
+  }
+
+  // Compare two non-null values. Returns a negative number, zero or a
+  // positive number if this value is less than, equal to or greater than o.
+  // Throws if the two types cannot be compared.
+  inline int CompareTo(const TypedValue &o) const {
+    if (IsInteger() && o.IsInteger()) {
+      int64_t x = GetAsBigInt(), y = o.GetAsBigInt();
+      return (x < y) ? -1 : ((x > y) ? 1 : 0);
+    }
+    switch (type_id_) {
+      case Type::TINYINT:
+      case Type::SMALLINT:
+      case Type::INTEGER:
+      case Type::BIGINT:
+      case Type::PARAMETER_OFFSET:
+      case Type::DECIMAL:
+        if (o.type_id_ == Type::DECIMAL || o.IsInteger()) {
+          double x = GetAsDecimal(), y = o.GetAsDecimal();
+          return (x < y) ? -1 : ((x > y) ? 1 : 0);
+        }
+        break;
+      case Type::TIMESTAMP:
+        if (o.type_id_ == Type::TIMESTAMP) {
+          uint64_t x = value_.timestamp, y = o.value_.timestamp;
+          return (x < y) ? -1 : ((x > y) ? 1 : 0);
+        }
+        break;
+      case Type::BOOLEAN:
+        if (o.type_id_ == Type::BOOLEAN)
+          return value_.boolean - o.value_.boolean;
+        break;
+      case Type::VARCHAR:
+        if (o.type_id_ == Type::VARCHAR) return CompareVarlen(o);
+        break;
+      default:
+        break;
+    }
+    std::string msg =
+        "Operation between " + Type::GetInstance(type_id_).ToString() +
+        " and " + Type::GetInstance(o.type_id_).ToString() + " is invalid.";
+    throw Exception(EXCEPTION_TYPE_MISMATCH_TYPE, msg);
+  }
+
+  // Compute a hash value
+  size_t Hash() const;
+  void HashCombine(size_t &seed) const;
+
+  // Debug
+  std::string ToString() const;
+
+ private:
+  inline int CompareVarlen(const TypedValue &o) const {
+    // A maximal varchar compares by length only, as in VarlenValue
+    if (len_ == PELOTON_VARCHAR_MAX_LEN || o.len_ == PELOTON_VARCHAR_MAX_LEN)
+      return (len_ < o.len_) ? -1 : ((len_ > o.len_) ? 1 : 0);
+    uint32_t min_len = (len_ < o.len_) ? len_ : o.len_;
+    int result = memcmp(value_.ptr, o.value_.ptr, min_len);
+    if (result != 0) return result;
+    return (len_ < o.len_) ? -1 : ((len_ > o.len_) ? 1 : 0);
+  }
+
+  // The data type
+  Type::TypeId type_id_;
+
+  // Length of the varlen data referenced by value_.ptr
+  uint32_t len_;
+
+  // The actual value item
+  union Val {
+    int8_t boolean;
+    int8_t tinyint;
+    int16_t smallint;
+    int32_t integer;
+    int64_t bigint;
+    double decimal;
+    uint64_t timestamp;
+    char *ptr;
+  } value_;
+};
+
+//===--------------------------------------------------------------------===//
+// Comparison functions
+//===--------------------------------------------------------------------===//
+
+inline CmpBool GetCmpBool(bool boolean) {
+  return boolean ? CMP_TRUE : CMP_FALSE;
+}
+
+inline CmpBool CompareEquals(const TypedValue &l, const TypedValue &r) {
+  if (l.IsNull() || r.IsNull()) return CMP_NULL;
+  return GetCmpBool(l.CompareTo(r) == 0);
+}
+
+inline CmpBool CompareNotEquals(const TypedValue &l, const TypedValue &r) {
+  if (l.IsNull() || r.IsNull()) return CMP_NULL;
+  return GetCmpBool(l.CompareTo(r) != 0);
+}
+
+inline CmpBool CompareLessThan(const TypedValue &l, const TypedValue &r) {
+  if (l.IsNull() || r.IsNull()) return CMP_NULL;
+  return GetCmpBool(l.CompareTo(r) < 0);
+}
+
+inline CmpBool CompareLessThanEquals(const TypedValue &l,
+                                     const TypedValue &r) {
+  if (l.IsNull() || r.IsNull()) return CMP_NULL;
+  return GetCmpBool(l.CompareTo(r) <= 0);
+}
+
+inline CmpBool CompareGreaterThan(const TypedValue &l, const TypedValue &r) {
+  if (l.IsNull() || r.IsNull()) return CMP_NULL;
+  return GetCmpBool(l.CompareTo(r) > 0);
+}
+
+inline CmpBool CompareGreaterThanEquals(const TypedValue &l,
+                                        const TypedValue &r) {
+  if (l.IsNull() || r.IsNull()) return CMP_NULL;
+  return GetCmpBool(l.CompareTo(r) >= 0);
+}
+
+}  // namespace common
+}  // namespace peloton
@@ -56,13 +56,15 @@ typedef enum LayoutType {
 enum LoggerMappingStrategyType {
   LOGGER_MAPPING_TYPE_INVALID = 0,
   LOGGER_MAPPING_TYPE_ROUND_ROBIN = 1,
-  LOGGER_MAPPING_TYPE_AFFINITY = 2,
+  LOGGER_MAPPING_TYPE_AFFINITY = 2, /* Pins a worker to the stream of its core */
   LOGGER_MAPPING_TYPE_MANUAL = 3
 };
 
 enum CheckpointType {
   CHECKPOINT_TYPE_INVALID = 0,
   CHECKPOINT_TYPE_NORMAL = 1,
+  CHECKPOINT_TYPE_FUZZY = 2,
+  CHECKPOINT_TYPE_INCREMENTAL = 3,
 };
 
 enum ReplicationType {
@@ -410,7 +412,17 @@ enum ExpressionType {
 
 enum ConcurrencyType {
   CONCURRENCY_TYPE_INVALID = 0,
-  CONCURRENCY_TYPE_TIMESTAMP_ORDERING = 1  // timestamp ordering
+  CONCURRENCY_TYPE_TIMESTAMP_ORDERING = 1,          // timestamp ordering
+  CONCURRENCY_TYPE_OPTIMISTIC = 2,                  // optimistic concurrency control
+  CONCURRENCY_TYPE_TWO_PHASE_LOCKING_NO_WAIT = 3,   // 2PL, abort on conflict
+  CONCURRENCY_TYPE_TWO_PHASE_LOCKING_WAIT_DIE = 4,  // 2PL, older txns wait
+  CONCURRENCY_TYPE_SERIALIZABLE_SNAPSHOT = 5        // serializable snapshot
+};
+
+enum DeadlockPreventionType {
+  DEADLOCK_PREVENTION_TYPE_INVALID = 0,
+  DEADLOCK_PREVENTION_TYPE_NO_WAIT = 1,  // abort on any lock conflict
+  DEADLOCK_PREVENTION_TYPE_WAIT_DIE = 2  // wait only for younger txns
 };
 
 //===--------------------------------------------------------------------===//
@@ -826,6 +838,10 @@ enum MetricType {
   TEMPORAL_METRIC = 8,
   //  Statistics for a specific table
   QUERY_METRIC = 9,
+  // Lengths of the traversed version chains
+  VERSION_CHAIN_METRIC = 10,
+  // Backlog and throughput of the garbage collector
+  GC_METRIC = 11,
 };
 
 static const int INVALID_FILE_DESCRIPTOR = -1;
@@ -965,10 +981,13 @@ enum RWType {
 
 enum GCSetType {
   GC_SET_TYPE_COMMITTED,
-  GC_SET_TYPE_ABORTED
+  GC_SET_TYPE_ABORTED,
+  // old versions unlinked by a worker that traversed their version chain
+  GC_SET_TYPE_PRUNED
 };
 
-typedef std::unordered_map<oid_t, std::unordered_map<oid_t, RWType>> ReadWriteSet;
+// see common/read_write_set.h
+class ReadWriteSet;
 
 //===--------------------------------------------------------------------===//
 // File Handle
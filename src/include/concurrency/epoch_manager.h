@@ -13,7 +13,13 @@
 
 #pragma once
 
+#include <atomic>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include "common/macros.h"
@@ -25,203 +31,147 @@ namespace concurrency {
 
 #define EPOCH_LENGTH 40
 
-struct Epoch {
-  std::atomic<int> txn_ref_count_;
-  cid_t max_cid_;
+//===--------------------------------------------------------------------===//
+// Epoch Slot
+//===--------------------------------------------------------------------===//
 
-  Epoch() : txn_ref_count_(0), max_cid_(0) {}
+// Epoch state of one worker thread. The owning thread registers its txns in
+// it, the epoch thread reads it once per epoch. A txn may finish on another
+// thread, which then releases the txn from the slot it was registered in.
+// The padding keeps the fields of two slots (and anything else on the heap)
+// off each other's cache lines.
+struct EpochSlot {
+  static constexpr size_t INVALID_EPOCH = std::numeric_limits<size_t>::max();
+
+  EpochSlot() { Init(); }
 
   void Init() {
-    txn_ref_count_ = 0;
-    max_cid_ = 0;
+    version = 0;
+    active_epoch = INVALID_EPOCH;
+    last_epoch = INVALID_EPOCH;
+    last_max_cid = 0;
+    prev_epoch = INVALID_EPOCH;
+    prev_max_cid = 0;
+    snapshot_cid = MAX_CID;
+    active.clear();
+    snapshots.clear();
   }
-};
 
-class EpochManager {
- public:
-  EpochManager()
-      : epoch_queue_(epoch_queue_size_),
-        queue_tail_(0),
-        current_epoch_(0),
-        queue_tail_gc(true),
-        max_cid(0),
-        finish_(false) {
-    // ts_thread_.reset(new std::thread(&EpochManager::Start, this));
-    // ts_thread_->detach();
-    ts_thread_ = std::thread(&EpochManager::Start, this);
-  }
+  UNUSED_ATTRIBUTE char padding_0_[CACHELINE_SIZE];
 
-  void Reset() {
-    finish_ = true;
-    ts_thread_.join();
+  // Odd while the owner is updating the epoch history below
+  std::atomic<size_t> version;
 
-    queue_tail_ = 0;
-    current_epoch_ = 0;
-    epoch_queue_[0].Init();
-    queue_tail_gc = true;
-    max_cid = 0;
+  // Oldest epoch of the running txns of the owner, INVALID_EPOCH if none
+  std::atomic<size_t> active_epoch;
 
-    finish_ = false;
-    ts_thread_ = std::thread(&EpochManager::Start, this);
-  }
+  // The two latest epochs entered by the owner and the largest begin cid
+  // registered in each of them
+  std::atomic<size_t> last_epoch;
+  std::atomic<cid_t> last_max_cid;
+  std::atomic<size_t> prev_epoch;
+  std::atomic<cid_t> prev_max_cid;
 
-  ~EpochManager() {
-    finish_ = true;
-    ts_thread_.join();
-  }
+  // Oldest snapshot of the running read-only txns of the owner, MAX_CID if
+  // none
+  std::atomic<cid_t> snapshot_cid;
 
-  //    static uint64_t GetEpoch() {
-  //
-  //      COMPILER_MEMORY_FENCE;
-  //
-  //      uint64_t ret_ts = curr_epoch_;
-  //
-  //      COMPILER_MEMORY_FENCE;
-  //
-  //      return ret_ts;
-  //    }
+  // Set while a thread owns the slot, only changed under the registry lock
+  bool in_use = false;
 
-  size_t EnterEpoch(cid_t begin_cid) {
-    auto epoch = current_epoch_.load();
+  // Protects the running txns below and the updates of active_epoch and
+  // snapshot_cid. Only contended when a txn exits on another thread.
+  Spinlock lock;
 
-    size_t epoch_idx = epoch % epoch_queue_size_;
-    epoch_queue_[epoch_idx].txn_ref_count_++;
+  // Epochs of the running txns, oldest first, with the number of txns in
+  // each of them
+  std::vector<std::pair<size_t, size_t>> active;
 
-    // Set the max cid in the tuple
-    auto max_cid_ptr = &(epoch_queue_[epoch_idx].max_cid_);
-    AtomicMax(max_cid_ptr, begin_cid);
+  // Snapshots of the running read-only txns, oldest first
+  std::vector<cid_t> snapshots;
 
-    return epoch;
-  }
+  UNUSED_ATTRIBUTE char padding_1_[CACHELINE_SIZE];
+};
 
-  void ExitEpoch(size_t epoch) {
-    PL_ASSERT(epoch >= queue_tail_);
-    PL_ASSERT(epoch <= current_epoch_);
+//===--------------------------------------------------------------------===//
+// Epoch Manager
+//===--------------------------------------------------------------------===//
 
-    auto epoch_idx = epoch % epoch_queue_size_;
+// Tracks the epochs of the running txns to find the largest cid that no
+// running or future txn can read below.
+//
+// Each worker thread registers its txns in a slot of its own, so beginning
+// and ending a txn does not write any shared cache line. The epoch thread
+// advances the epoch, then scans the slots to collect the max begin cid of
+// the epoch that just closed and the oldest epoch that still has running
+// txns. Every closed epoch older than that one is dead.
+//
+// Read-only txns do not enter an epoch. They wait until every txn that began
+// below the latest cid has finished, read at the max finished cid and pin it
+// in their slot so that the max dead cid cannot advance past their snapshot.
+//
+// A txn exits its epoch or snapshot through the slot it entered it in, which
+// the enter functions return. Without a slot, the calling thread's is used.
+class EpochManager {
+ public:
+  EpochManager();
 
-    epoch_queue_[epoch_idx].txn_ref_count_--;
-  }
-  // assume we store epoch_store max_store previously
-  cid_t GetMaxDeadTxnCid() {
-    // TODO:
-    // change to:
-    // increase tail
-    // return max
-    auto tail = queue_tail_.load();
-    auto head = current_epoch_.load();
-    if (head > 0) {
-      head--;
-    }
-    auto res = max_cid;
-
-    auto dead_num = 0;
-    while (tail < head) {
-      auto idx = tail % epoch_queue_size_;
-      // break when meeting running txn
-      if (epoch_queue_[idx].txn_ref_count_ > 0) {
-        break;
-      }
-
-      if (epoch_queue_[idx].max_cid_ > res) {
-        res = epoch_queue_[idx].max_cid_;
-      }
-      tail++;
-      dead_num++;
-    }
-    if (res > max_cid) {
-      AtomicMax(&max_cid, res);
-    }
-
-    if (dead_num > 32) {
-      IncreaseTail();
-    }
-    return max_cid;
-  }
+  ~EpochManager();
 
- private:
-  void Start() {
-    while (!finish_) {
-      // the epoch advances every 40 milliseconds.
-      std::this_thread::sleep_for(std::chrono::milliseconds(EPOCH_LENGTH));
-
-      auto next_idx = (current_epoch_.load() + 1) % epoch_queue_size_;
-      auto tail_idx = queue_tail_.load() % epoch_queue_size_;
-      if (next_idx == tail_idx) {
-        // overflow
-        // in this case, just increase tail
-        IncreaseTail();
-        continue;
-      }
-
-      // we have to init it first, then increase current epoch
-      // otherwise may read dirty data
-      epoch_queue_[next_idx].Init();
-      current_epoch_++;
-
-      IncreaseTail();
-    }
-  }
+  // Restart from epoch 0, no txn may be running
+  void Reset();
+
+  size_t EnterEpoch(cid_t begin_cid, EpochSlot **slot = nullptr);
 
-  void IncreaseTail() {
-    bool expect = true, desired = false;
-    if (!queue_tail_gc.compare_exchange_weak(expect, desired)) {
-      // someone now is increasing tail
-      return;
-    }
+  void ExitEpoch(size_t epoch, EpochSlot *slot = nullptr);
 
-    auto current = current_epoch_.load();
-    auto tail = queue_tail_.load();
+  // Get a snapshot cid of at least min_cid at which no txn can still write,
+  // and hold back the max dead cid at it until the snapshot is exited. Waits
+  // for the epochs of the txns that began at or below min_cid to die.
+  cid_t EnterSnapshot(cid_t min_cid, EpochSlot **slot = nullptr);
 
-    while (true) {
-      if (tail + 1 == current) {
-        break;
-      }
+  void ExitSnapshot(cid_t snapshot_cid, EpochSlot *slot = nullptr);
 
-      auto idx = tail % epoch_queue_size_;
+  // Every txn that began at or below this cid has finished, and no running
+  // snapshot is older than it
+  cid_t GetMaxDeadTxnCid() const { return max_dead_cid_.load(); }
 
-      // inc tail until we find an epoch that has running txn
-      if (epoch_queue_[idx].txn_ref_count_ > 0) {
-        break;
-      }
+ private:
+  struct LocalEpochs;
 
-      // save max cid
-      auto max = epoch_queue_[idx].max_cid_;
-      AtomicMax(&max_cid, max);
-      tail++;
-    }
+  void Start();
 
-    queue_tail_ = tail;
+  // Close the current epoch and collect the state of the slots
+  void AdvanceEpoch();
 
-    expect = false;
-    desired = true;
+  LocalEpochs &GetLocalEpochs();
 
-    queue_tail_gc.compare_exchange_weak(expect, desired);
-    return;
-  }
+  EpochSlot *AcquireSlot();
 
-  void AtomicMax(cid_t* addr, cid_t max) {
-    while (true) {
-      auto old = *addr;
-      if (old > max) {
-        return;
-      } else if (__sync_bool_compare_and_swap(addr, old, max)) {
-        return;
-      }
-    }
-  }
+  void ReleaseSlot(EpochSlot *slot);
 
  private:
-  // queue size
-  static const size_t epoch_queue_size_ = 2048;
-
-  // Epoch vector
-  std::vector<Epoch> epoch_queue_;
-  std::atomic<size_t> queue_tail_;
   std::atomic<size_t> current_epoch_;
-  std::atomic<bool> queue_tail_gc;
-  cid_t max_cid;
-  bool finish_;
+
+  UNUSED_ATTRIBUTE char padding_0_[CACHELINE_SIZE];
+
+  std::atomic<cid_t> max_dead_cid_;
+
+  // Odd while the epoch thread is collecting the slots
+  std::atomic<size_t> advance_round_;
+
+  // Registered slots, never freed before the manager
+  std::mutex slots_mutex_;
+  std::vector<std::unique_ptr<EpochSlot>> slots_;
+
+  // Closed epochs that may still have running txns, with the max begin cid
+  // registered in each of them. Only used by the epoch thread.
+  std::deque<std::pair<size_t, cid_t>> closed_epochs_;
+
+  // Max begin cid of the dead epochs. Only written by the epoch thread.
+  std::atomic<cid_t> max_finished_cid_;
+
+  std::atomic<bool> finish_;
 
   std::thread ts_thread_;
 };
@@ -0,0 +1,53 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// optimistic_transaction_manager.h
+//
+// Identification: src/include/concurrency/optimistic_transaction_manager.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "concurrency/timestamp_ordering_transaction_manager.h"
+
+namespace peloton {
+namespace concurrency {
+
+//===--------------------------------------------------------------------===//
+// optimistic concurrency control
+//===--------------------------------------------------------------------===//
+
+// Silo-style optimistic concurrency control on top of the multi-version
+// storage of timestamp ordering. Writes still lock the tuples they modify, but
+// reads leave no trace in the tuple header. Instead, every tuple that was read
+// is checked at commit time to still be the latest version and to not be
+// locked by another transaction.
+//
+// The commit id is taken after the writes are locked and before the reads are
+// validated, so a transaction that overwrites a tuple after it was validated
+// commits later. Inserts into a range that was scanned are not detected.
+class OptimisticTransactionManager
+    : public TimestampOrderingTransactionManager {
+ public:
+  OptimisticTransactionManager() {}
+
+  virtual ~OptimisticTransactionManager() {}
+
+  static OptimisticTransactionManager &GetInstance();
+
+  virtual bool AcquireOwnership(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  virtual bool PerformRead(Transaction *const current_txn,
+                           const ItemPointer &location);
+
+  virtual Result CommitTransaction(Transaction *const current_txn);
+};
+}
+}
@@ -0,0 +1,71 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// serializable_snapshot_transaction_manager.h
+//
+// Identification:
+// src/include/concurrency/serializable_snapshot_transaction_manager.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "concurrency/optimistic_transaction_manager.h"
+
+namespace peloton {
+namespace concurrency {
+
+//===--------------------------------------------------------------------===//
+// serializable snapshot isolation
+//===--------------------------------------------------------------------===//
+
+// Snapshot isolation made serializable by tracking rw-antidependencies. A
+// transaction reads the snapshot of its begin commit id and leaves no trace
+// in the tuple header, and the first transaction to update a tuple wins, as
+// in optimistic concurrency control.
+//
+// Instead of validating the reads, the commit checks for dangerous structures.
+// Every version remembers the latest commit id of the transactions that read
+// it (its predecessors), and, once it is overwritten, the earliest commit id
+// that the overwriting transaction depends on through its own
+// rw-antidependencies (its successors). A transaction aborts only when one of
+// its successors committed no later than one of its predecessors, which would
+// close a cycle in the serialization graph. Inserts into a range that was
+// scanned are not detected.
+class SerializableSnapshotTransactionManager
+    : public OptimisticTransactionManager {
+ public:
+  SerializableSnapshotTransactionManager() {}
+
+  virtual ~SerializableSnapshotTransactionManager() {}
+
+  static SerializableSnapshotTransactionManager &GetInstance();
+
+  virtual bool PerformRead(Transaction *const current_txn,
+                           const ItemPointer &location);
+
+  virtual Result CommitTransaction(Transaction *const current_txn);
+
+ protected:
+  virtual void InitTupleReserved(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t tuple_id);
+
+ private:
+  // the predecessor commit id takes the place of the last reader cid.
+  static const int PREDECESSOR_OFFSET = LAST_READER_OFFSET;
+  static const int SUCCESSOR_OFFSET = (PREDECESSOR_OFFSET + 8);
+
+  cid_t *GetPredecessorField(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  cid_t *GetSuccessorField(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+};
+}
+}
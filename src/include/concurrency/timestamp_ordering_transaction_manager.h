@@ -95,9 +95,16 @@ class TimestampOrderingTransactionManager : public TransactionManager {
 
   virtual Transaction *BeginTransaction();
 
+  virtual Transaction *BeginReadOnlyTransaction();
+
   virtual void EndTransaction(Transaction *current_txn);
 
- private:
+ protected:
+  // Install the versions written by the transaction with the given commit id
+  // and end the transaction.
+  Result InstallTransaction(Transaction *const current_txn,
+                            const cid_t end_commit_id);
+
   static const int LOCK_OFFSET = 0;
   static const int LAST_READER_OFFSET = (LOCK_OFFSET + 8);
 
@@ -114,7 +121,7 @@ class TimestampOrderingTransactionManager : public TransactionManager {
       const oid_t &tuple_id, const cid_t &current_cid);
 
   // Initiate reserved area of a tuple
-  void InitTupleReserved(
+  virtual void InitTupleReserved(
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t tuple_id);
 };
@@ -14,12 +14,14 @@
 #pragma once
 
 #include <atomic>
+#include <functional>
 #include <vector>
 #include <map>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "common/printable.h"
+#include "common/read_write_set.h"
 #include "common/types.h"
 #include "common/exception.h"
 
@@ -27,10 +29,15 @@
 namespace peloton {
 namespace concurrency {
 
+struct EpochSlot;
+
 //===--------------------------------------------------------------------===//
 // Transaction
 //===--------------------------------------------------------------------===//
 
+// Runs once the commit of a transaction is durable. The wire protocol does
+// not set one yet and keeps answering after a synchronous commit.
+typedef std::function<void()> CommitCallback;
 
 class Transaction : public Printable {
   Transaction(Transaction const &) = delete;
@@ -48,15 +55,32 @@ class Transaction : public Printable {
     Init(txn_id, begin_cid);
   }
 
+  Transaction(const txn_id_t &txn_id, const cid_t &begin_cid,
+              const bool declared_read_only) {
+    Init(txn_id, begin_cid, declared_read_only);
+  }
+
   ~Transaction() {}
 
-  void Init(const txn_id_t &txn_id, const cid_t &begin_cid) {
+  void Init(const txn_id_t &txn_id, const cid_t &begin_cid,
+            const bool declared_read_only = false) {
     txn_id_ = txn_id;
     begin_cid_ = begin_cid;
     end_cid_ = MAX_CID;
     is_written_ = false;
     insert_count_ = 0;
-    gc_set_.reset(new ReadWriteSet());
+    declared_read_only_ = declared_read_only;
+    if (rw_set_ == nullptr) {
+      rw_set_ = ReadWriteSet::Create();
+    } else {
+      rw_set_->Clear();
+    }
+    // a declared read-only txn never produces garbage
+    if (declared_read_only == false) {
+      gc_set_ = ReadWriteSet::CreateShared();
+    } else {
+      gc_set_.reset();
+    }
   }
 
   //===--------------------------------------------------------------------===//
@@ -75,6 +99,11 @@ class Transaction : public Printable {
 
   inline void SetEpochId(const size_t eid) { epoch_id_ = eid; }
 
+  // The epoch manager slot the txn registered its epoch or snapshot in
+  inline EpochSlot *GetEpochSlot() const { return epoch_slot_; }
+
+  inline void SetEpochSlot(EpochSlot *epoch_slot) { epoch_slot_ = epoch_slot; }
+
   void RecordRead(const ItemPointer &);
 
   void RecordUpdate(const ItemPointer &);
@@ -85,7 +114,7 @@ class Transaction : public Printable {
   bool RecordDelete(const ItemPointer &);
 
   inline const ReadWriteSet &GetReadWriteSet() {
-    return rw_set_;
+    return *rw_set_;
   }
 
   inline std::shared_ptr<ReadWriteSet> GetGCSetPtr() {
@@ -105,6 +134,22 @@ class Transaction : public Printable {
     return is_written_ == false && insert_count_ == 0;
   }
 
+  // Whether the txn was started as read-only. Such a txn reads a snapshot
+  // at which no txn can still write, so its reads are not tracked.
+  inline bool IsDeclaredReadOnly() const { return declared_read_only_; }
+
+  // The callback runs once the commit of the txn is durable, which lets the
+  // worker move on to its next txn instead of waiting for the log flush. It
+  // is dropped if the txn aborts. A declared read-only txn logs nothing, and
+  // runs the callback once the commits in its snapshot are durable.
+  inline void SetCommitCallback(const CommitCallback &commit_callback) {
+    commit_callback_ = commit_callback;
+  }
+
+  inline const CommitCallback &GetCommitCallback() const {
+    return commit_callback_;
+  }
+
  private:
   //===--------------------------------------------------------------------===//
   // Data members
@@ -122,7 +167,10 @@ class Transaction : public Printable {
   // epoch id
   size_t epoch_id_;
 
-  ReadWriteSet rw_set_;
+  // slot of the epoch manager the txn is registered in
+  EpochSlot *epoch_slot_ = nullptr;
+
+  std::unique_ptr<ReadWriteSet, ReadWriteSet::Deleter> rw_set_;
 
   // this set contains data location that needs to be gc'd in the transaction.
   std::shared_ptr<ReadWriteSet> gc_set_;
@@ -132,6 +180,10 @@ class Transaction : public Printable {
 
   bool is_written_;
   size_t insert_count_;
+
+  bool declared_read_only_;
+
+  CommitCallback commit_callback_;
 };
 
 }  // End concurrency namespace
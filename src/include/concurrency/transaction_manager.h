@@ -47,19 +47,23 @@ class TransactionManager {
     next_txn_id_ = ATOMIC_VAR_INIT(START_TXN_ID);
     next_cid_ = ATOMIC_VAR_INIT(START_CID);
     maximum_grant_cid_ = ATOMIC_VAR_INIT(MAX_CID);
+    txn_id_batch_size_ = ATOMIC_VAR_INIT(1);
+    id_generation_ = ATOMIC_VAR_INIT(GetNewIdGeneration());
   }
 
   virtual ~TransactionManager() {}
 
-  txn_id_t GetNextTransactionId() { return next_txn_id_++; }
+  txn_id_t GetNextTransactionId();
 
-  cid_t GetNextCommitId() {
-    cid_t temp_cid = next_cid_++;
-    // wait if we do not yet have a grant for this commit id
-    while (temp_cid > maximum_grant_cid_.load())
-      ;
-    return temp_cid;
-  }
+  cid_t GetNextCommitId();
+
+  // Let every thread reserve this many transaction ids at a time instead of
+  // taking them one by one from the shared counter. Transaction ids only
+  // need to be unique. This does not touch commit ids: they still come one
+  // by one from next_cid_, see GetNextCommitId().
+  void SetTxnIdBatchSize(size_t batch_size);
+
+  size_t GetTxnIdBatchSize() const { return txn_id_batch_size_.load(); }
 
   cid_t GetCurrentCommitId() { return next_cid_.load(); }
 
@@ -125,12 +129,21 @@ class TransactionManager {
   }
 
   // for use by recovery
-  void SetNextCid(cid_t cid) { next_cid_ = cid; }
+  void SetNextCid(cid_t cid) {
+    next_cid_ = cid;
+    id_generation_ = GetNewIdGeneration();
+  }
 
   void SetMaxGrantCid(cid_t cid) { maximum_grant_cid_ = cid; }
 
   virtual Transaction *BeginTransaction() = 0;
 
+  // Begin a txn that only reads. Its reads never conflict with any writer
+  // and it sees every commit that finished before it began. In exchange, it
+  // waits until every txn that began before it has finished, which takes
+  // about an epoch, and longer while an older txn is still running.
+  virtual Transaction *BeginReadOnlyTransaction() = 0;
+
   virtual void EndTransaction(Transaction *current_txn) = 0;
 
   virtual Result CommitTransaction(Transaction *const current_txn) = 0;
@@ -140,6 +153,7 @@ class TransactionManager {
   void ResetStates() {
     next_txn_id_ = START_TXN_ID;
     next_cid_ = START_CID;
+    id_generation_ = GetNewIdGeneration();
   }
 
   // this function generates the maximum commit id of committed transactions.
@@ -163,9 +177,19 @@ class TransactionManager {
       std::make_pair(INVALID_CID, INVALID_CID);
 
  private:
+  // Ids reserved by a thread are dropped when the generation changes
+  static uint64_t GetNewIdGeneration();
+
+  // The counters are written by every transaction, so keep each of them on
+  // its own cache line and away from the fields that are only read
+  UNUSED_ATTRIBUTE char padding_0_[CACHELINE_SIZE];
   std::atomic<txn_id_t> next_txn_id_;
+  UNUSED_ATTRIBUTE char padding_1_[CACHELINE_SIZE - sizeof(std::atomic<txn_id_t>)];
   std::atomic<cid_t> next_cid_;
+  UNUSED_ATTRIBUTE char padding_2_[CACHELINE_SIZE - sizeof(std::atomic<cid_t>)];
   std::atomic<cid_t> maximum_grant_cid_;
+  std::atomic<size_t> txn_id_batch_size_;
+  std::atomic<uint64_t> id_generation_;
 };
 }  // End storage namespace
 }  // End peloton namespace
@@ -14,6 +14,9 @@
 #pragma once
 
 #include "concurrency/timestamp_ordering_transaction_manager.h"
+#include "concurrency/optimistic_transaction_manager.h"
+#include "concurrency/two_phase_locking_transaction_manager.h"
+#include "concurrency/serializable_snapshot_transaction_manager.h"
 
 namespace peloton {
 namespace concurrency {
@@ -25,6 +28,20 @@ class TransactionManagerFactory {
       case CONCURRENCY_TYPE_TIMESTAMP_ORDERING:
         return TimestampOrderingTransactionManager::GetInstance();
 
+      case CONCURRENCY_TYPE_OPTIMISTIC:
+        return OptimisticTransactionManager::GetInstance();
+
+      case CONCURRENCY_TYPE_TWO_PHASE_LOCKING_NO_WAIT:
+        return TwoPhaseLockingTransactionManager::GetInstance(
+            DEADLOCK_PREVENTION_TYPE_NO_WAIT);
+
+      case CONCURRENCY_TYPE_TWO_PHASE_LOCKING_WAIT_DIE:
+        return TwoPhaseLockingTransactionManager::GetInstance(
+            DEADLOCK_PREVENTION_TYPE_WAIT_DIE);
+
+      case CONCURRENCY_TYPE_SERIALIZABLE_SNAPSHOT:
+        return SerializableSnapshotTransactionManager::GetInstance();
+
       default:
         return TimestampOrderingTransactionManager::GetInstance();
     }
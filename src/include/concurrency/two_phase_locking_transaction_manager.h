@@ -0,0 +1,115 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// two_phase_locking_transaction_manager.h
+//
+// Identification:
+// src/include/concurrency/two_phase_locking_transaction_manager.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include "concurrency/timestamp_ordering_transaction_manager.h"
+
+namespace peloton {
+namespace concurrency {
+
+//===--------------------------------------------------------------------===//
+// two-phase locking
+//===--------------------------------------------------------------------===//
+
+// Strict two-phase locking on top of the multi-version storage of timestamp
+// ordering. The txn id field of a tuple is its write lock. The reserved field
+// holds a read lock, i.e. the number of readers and the oldest of them, and
+// the spinlock that protects both locks. All the locks are held until the
+// transaction commits or aborts, so a transaction always reads the latest
+// committed version of a tuple.
+//
+// Deadlocks are prevented by either aborting on any conflict (no-wait), or by
+// letting a transaction wait only for transactions that are younger than
+// itself (wait-die). The age of a transaction is given by its txn id.
+class TwoPhaseLockingTransactionManager
+    : public TimestampOrderingTransactionManager {
+ public:
+  TwoPhaseLockingTransactionManager(DeadlockPreventionType deadlock_prevention)
+      : deadlock_prevention_(deadlock_prevention) {}
+
+  virtual ~TwoPhaseLockingTransactionManager() {}
+
+  static TwoPhaseLockingTransactionManager &GetInstance(
+      DeadlockPreventionType deadlock_prevention);
+
+  DeadlockPreventionType GetDeadlockPrevention() const {
+    return deadlock_prevention_;
+  }
+
+  virtual VisibilityType IsVisible(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  virtual bool IsOwnable(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  virtual bool AcquireOwnership(
+      Transaction *const current_txn,
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  virtual void YieldOwnership(Transaction *const current_txn,
+                              const oid_t &tile_group_id,
+                              const oid_t &tuple_id);
+
+  virtual bool PerformRead(Transaction *const current_txn,
+                           const ItemPointer &location);
+
+  virtual Result CommitTransaction(Transaction *const current_txn);
+
+  virtual Result AbortTransaction(Transaction *const current_txn);
+
+ private:
+  // the read lock takes the place of the last reader cid.
+  static const int READER_COUNT_OFFSET = LAST_READER_OFFSET;
+  static const int OLDEST_READER_OFFSET = (READER_COUNT_OFFSET + 8);
+
+  size_t *GetReaderCountField(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  txn_id_t *GetOldestReaderField(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  // Whether a transaction may wait for the holder of a lock
+  bool CanWait(const txn_id_t &txn_id, const txn_id_t &holder_txn_id) const;
+
+  bool AcquireReadLock(Transaction *const current_txn,
+                       const storage::TileGroupHeader *const tile_group_header,
+                       const oid_t &tuple_id);
+
+  // Must be called with the spinlock held
+  void AddReader(const storage::TileGroupHeader *const tile_group_header,
+                 const oid_t &tuple_id, const txn_id_t &txn_id);
+
+  // Whether the current transaction holds the read lock of a tuple
+  bool IsReader(Transaction *const current_txn, const oid_t &tile_group_id,
+                const oid_t &tuple_id);
+
+  // Release the write lock of a tuple, and take back its read lock if the
+  // write lock was an upgrade
+  void ReleaseWriteLock(Transaction *const current_txn,
+                        const storage::TileGroupHeader *const tile_group_header,
+                        const oid_t &tile_group_id, const oid_t &tuple_id);
+
+  void ReleaseReadLocks(Transaction *const current_txn);
+
+  DeadlockPreventionType deadlock_prevention_;
+};
+}
+}
@@ -296,6 +296,10 @@ class HashAggregator : public AbstractAggregator {
 
   /** List of aggregates for a specific group. */
   struct AggregateList {
+    // Keep a deep copy of the group-by values of this group; the typed
+    // values of its key in the hash table reference them
+    std::vector<common::Value *> group_by_values;
+
     // Keep a deep copy of the first tuple we met of this group
     std::vector<common::Value *> first_tuple_values;
 
@@ -305,23 +309,22 @@ class HashAggregator : public AbstractAggregator {
 
   /** Hash function of internal hash table */
   struct ValueVectorHasher
-      : std::unary_function<std::vector<common::Value *>, std::size_t> {
+      : std::unary_function<std::vector<common::TypedValue>, std::size_t> {
     // Generate a 64-bit number for the a vector of value
-    size_t operator()(const std::vector<common::Value *> &values) const {
+    size_t operator()(const std::vector<common::TypedValue> &values) const {
       size_t seed = 0;
-      for (auto v : values) {
-        v->HashCombine(seed);
+      for (auto &v : values) {
+        v.HashCombine(seed);
       }
       return seed;
     }
   };
 
   struct ValueVectorCmp {
-    bool operator()(const std::vector<common::Value *> &lhs,
-                    const std::vector<common::Value *> &rhs) const {
+    bool operator()(const std::vector<common::TypedValue> &lhs,
+                    const std::vector<common::TypedValue> &rhs) const {
       for (size_t i = 0; i < lhs.size() && i < rhs.size(); i++) {
-        std::unique_ptr<common::Value> neq(lhs[i]->CompareNotEquals(*rhs[i]));
-        if (neq->IsTrue())
+        if (common::CompareNotEquals(lhs[i], rhs[i]) == common::CMP_TRUE)
           return false;
       }
       if (lhs.size() == rhs.size())
@@ -331,11 +334,11 @@ class HashAggregator : public AbstractAggregator {
   };
 
   // Default equal_to should works well
-  typedef std::unordered_map<std::vector<common::Value *>, AggregateList *,
+  typedef std::unordered_map<std::vector<common::TypedValue>, AggregateList *,
                              ValueVectorHasher, ValueVectorCmp> HashAggregateMapType;
 
-  /** @brief Group by key values used */
-  std::vector<common::Value *> group_by_key_values;
+  /** @brief Group by key of the current tuple, referencing its storage */
+  std::vector<common::TypedValue> group_by_key_values;
 
   /** @brief Hash table */
   HashAggregateMapType aggregates_map;
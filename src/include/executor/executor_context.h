@@ -55,6 +55,13 @@ class ExecutorContext {
   // Get a varlen pool (will construct the pool only if needed)
   common::VarlenPool *GetExecutorContextPool();
 
+  // Number of threads an executor may use to process its input in parallel
+  size_t GetDegreeOfParallelism() const { return degree_of_parallelism_; }
+
+  void SetDegreeOfParallelism(size_t degree_of_parallelism) {
+    degree_of_parallelism_ = degree_of_parallelism;
+  }
+
   // num of tuple processed
   uint32_t num_processed = 0;
 
@@ -72,6 +79,9 @@ class ExecutorContext {
   // pool
   std::unique_ptr<common::VarlenPool> pool_;
 
+  // degree of parallelism, 1 means serial execution
+  size_t degree_of_parallelism_ = 1;
+
 };
 
 }  // namespace executor
@@ -21,6 +21,7 @@
 #include "common/printable.h"
 #include "common/types.h"
 #include "common/value.h"
+#include "common/typed_value.h"
 
 namespace peloton {
 
@@ -84,6 +85,8 @@ class LogicalTile : public Printable {
 
   common::Value *GetValue(oid_t tuple_id, oid_t column_id);
 
+  common::TypedValue GetTypedValue(oid_t tuple_id, oid_t column_id);
+
   void SetValue(common::Value &value, oid_t tuple_id, oid_t column_id);
 
   size_t GetTupleCount();
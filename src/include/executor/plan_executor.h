@@ -56,6 +56,9 @@ class PlanExecutor {
   static void PrintPlan(const planner::AbstractPlan *plan,
                         std::string prefix = "");
 
+  // Check that no node of the plan tree writes
+  static bool IsReadOnlyPlan(const planner::AbstractPlan *plan);
+
   // Copy From
   static inline void copyFromTo(const std::string &src,
                                 std::vector<unsigned char> &dst) {
@@ -81,11 +84,14 @@ class PlanExecutor {
    *        Before ExecutePlan, a node first receives value list, so we should
    * pass
    *        value list directly rather than passing Postgres's ParamListInfo
+   *        A read_only plan runs in a declared read-only transaction and
+   *        fails if it writes anything
    */
   static peloton_status ExecutePlan(const planner::AbstractPlan *plan,
                                     const std::vector<common::Value *> &params,
                                     std::vector<ResultType> &result,
-                                    const std::vector<int> &result_format);
+                                    const std::vector<int> &result_format,
+                                    const bool read_only = false);
 
   /*
    * @brief When a peloton node recvs a query plan, this function is invoked
@@ -95,7 +101,8 @@ class PlanExecutor {
   static int ExecutePlan(
       const planner::AbstractPlan *plan,
       const std::vector<common::Value *> &params,
-      std::vector<std::unique_ptr<executor::LogicalTile>> &logical_tile_list);
+      std::vector<std::unique_ptr<executor::LogicalTile>> &logical_tile_list,
+      const bool read_only = false);
 };
 
 }  // namespace bridge
@@ -13,6 +13,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "planner/seq_scan_plan.h"
 #include "executor/abstract_scan_executor.h"
 
@@ -35,6 +37,15 @@ class SeqScanExecutor : public AbstractScanExecutor {
   bool DExecute();
 
  private:
+  // Collect the positions of the tile group that are visible to the
+  // transaction and satisfy the predicate
+  void ScanTileGroup(storage::TileGroup *tile_group,
+                     std::vector<oid_t> &position_list) const;
+
+  // Scan all the tile groups with up to the degree of parallelism of the
+  // executor context threads and keep the positions of each one
+  void ParallelScan();
+
   //===--------------------------------------------------------------------===//
   // Executor State
   //===--------------------------------------------------------------------===//
@@ -45,6 +56,12 @@ class SeqScanExecutor : public AbstractScanExecutor {
   /** @brief Keeps track of the number of tile groups to scan. */
   oid_t table_tile_group_count_ = INVALID_OID;
 
+  /** @brief Whether the tile groups were scanned by ParallelScan(). */
+  bool parallel_scan_done_ = false;
+
+  /** @brief Positions found by ParallelScan(), by tile group offset. */
+  std::vector<std::vector<oid_t>> parallel_scan_results_;
+
   //===--------------------------------------------------------------------===//
   // Plan Info
   //===--------------------------------------------------------------------===//
@@ -14,11 +14,13 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include "common/serializeio.h"
 #include "common/printable.h"
 #include "common/types.h"
 #include "common/value_factory.h"
+#include "common/typed_value.h"
 #include "common/macros.h"
 #include "common/logger.h"
 
@@ -27,8 +29,14 @@ namespace peloton {
 class Printable;
 class AbstractTuple;
 
+namespace storage {
+class TileGroup;
+class ZoneMap;
+}
+
 namespace executor {
 class ExecutorContext;
+class LogicalTile;
 }
 
 namespace expression {
@@ -63,6 +71,57 @@ class AbstractExpression : public Printable {
                               const AbstractTuple *tuple2,
                               executor::ExecutorContext *context) const = 0;
 
+  /**
+   * Evaluate a boolean expression without allocating a result value.
+   * Expressions without an allocation-free path fall back to Evaluate().
+   */
+  virtual CmpBool EvaluatePredicate(const AbstractTuple *tuple1,
+                                    const AbstractTuple *tuple2,
+                                    executor::ExecutorContext *context) const {
+    auto result = Evaluate(tuple1, tuple2, context);
+    if (result->IsNull()) return CMP_NULL;
+    return result->IsTrue() ? CMP_TRUE : CMP_FALSE;
+  }
+
+  /**
+   * Evaluate this expression into a stack-allocated typed value. Returns
+   * false if the expression cannot be evaluated without allocating, in which
+   * case the caller must use Evaluate() instead.
+   */
+  virtual bool EvaluateTyped(UNUSED_ATTRIBUTE const AbstractTuple *tuple1,
+                             UNUSED_ATTRIBUTE const AbstractTuple *tuple2,
+                             UNUSED_ATTRIBUTE executor::ExecutorContext *context,
+                             UNUSED_ATTRIBUTE TypedValue &result) const {
+    return false;
+  }
+
+  /**
+   * Filter a batch of tuples with this boolean expression. The positions in
+   * selection for which the expression is true are appended to output, in
+   * selection order. Expressions without a batch kernel evaluate one tuple at
+   * a time through EvaluatePredicate().
+   */
+  virtual void EvaluateBatch(storage::TileGroup *tile_group,
+                             const std::vector<oid_t> &selection,
+                             std::vector<oid_t> &output,
+                             executor::ExecutorContext *context) const;
+
+  virtual void EvaluateBatch(executor::LogicalTile *tile,
+                             const std::vector<oid_t> &selection,
+                             std::vector<oid_t> &output,
+                             executor::ExecutorContext *context) const;
+
+  /**
+   * Return false if no tuple summarized by the zone map can satisfy this
+   * boolean expression, so that scans can skip the whole tile group. True
+   * is always a safe answer.
+   */
+  virtual bool MayMatch(UNUSED_ATTRIBUTE const storage::ZoneMap &zone_map,
+                        UNUSED_ATTRIBUTE executor::ExecutorContext *context)
+      const {
+    return true;
+  }
+
   /**
    * Return true if this expression or any descendent has a value that should be
    * substituted with a parameter.
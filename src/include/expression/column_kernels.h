@@ -0,0 +1,79 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// column_kernels.h
+//
+// Identification: src/include/expression/column_kernels.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "common/typed_value.h"
+#include "common/types.h"
+
+namespace peloton {
+namespace expression {
+
+//===--------------------------------------------------------------------===//
+// Column Kernels
+//===--------------------------------------------------------------------===//
+
+// Instruction sets the column kernels can be compiled for. The kernels are
+// built for every instruction set and the best one supported by the CPU is
+// picked at runtime, so the binary still runs on machines without AVX2.
+enum ColumnKernelIsa {
+  COLUMN_KERNEL_ISA_SCALAR = 0,
+  COLUMN_KERNEL_ISA_SSE42 = 1,
+  COLUMN_KERNEL_ISA_AVX2 = 2
+};
+
+// One "column <op> constant" term of a column filter
+struct ColumnComparison {
+  ExpressionType op;
+  common::TypedValue constant;
+};
+
+// Filters over a densely packed fixed-width column, i.e. a column that is
+// stored alone in its tile (column and FSM layouts). The result is a
+// selection bitmap where bit i is set when the i-th value of the column
+// satisfies every term.
+class ColumnKernels {
+ public:
+  // Largest number of terms a single pass can evaluate (e.g. BETWEEN)
+  static const size_t kMaxTerms = 2;
+
+  // Best instruction set supported by this CPU
+  static ColumnKernelIsa GetSupportedIsa();
+
+  // Instruction set used by Filter(). Defaults to the supported one.
+  static ColumnKernelIsa GetIsa();
+
+  // Restrict the kernels to the given instruction set (it is lowered to the
+  // supported one if needed). Used to compare against the scalar kernels.
+  static void SetIsa(ColumnKernelIsa isa);
+
+  // Whether values of the given type have a kernel
+  static bool IsSupportedType(common::Type::TypeId type_id);
+
+  // Evaluate the conjunction of the terms over the first count values of the
+  // column and overwrite the bitmap with the result. NULL values never match.
+  // Returns false if there is no kernel for the column type, the comparison
+  // operators or the constants; the bitmap is then left untouched.
+  static bool Filter(common::Type::TypeId column_type, const char *column,
+                     oid_t count, const ColumnComparison *terms,
+                     size_t term_count, std::vector<uint64_t> &bitmap);
+
+  // Append the positions of the selection whose bit is set to the output
+  static void SelectFromBitmap(const std::vector<uint64_t> &bitmap,
+                               const std::vector<oid_t> &selection,
+                               std::vector<oid_t> &output);
+};
+
+}  // End expression namespace
+}  // End peloton namespace
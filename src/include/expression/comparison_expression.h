@@ -59,11 +59,67 @@ class ComparisonExpression : public AbstractExpression {
     }
   }
 
+  CmpBool EvaluatePredicate(const AbstractTuple *tuple1,
+                            const AbstractTuple *tuple2,
+                            executor::ExecutorContext *context) const override {
+    TypedValue vl, vr;
+    if (left_->EvaluateTyped(tuple1, tuple2, context, vl) == false ||
+        right_->EvaluateTyped(tuple1, tuple2, context, vr) == false) {
+      return AbstractExpression::EvaluatePredicate(tuple1, tuple2, context);
+    }
+    switch (exp_type_) {
+      case (EXPRESSION_TYPE_COMPARE_EQUAL):
+        return CompareEquals(vl, vr);
+      case (EXPRESSION_TYPE_COMPARE_NOTEQUAL):
+        return CompareNotEquals(vl, vr);
+      case (EXPRESSION_TYPE_COMPARE_LESSTHAN):
+        return CompareLessThan(vl, vr);
+      case (EXPRESSION_TYPE_COMPARE_GREATERTHAN):
+        return CompareGreaterThan(vl, vr);
+      case (EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO):
+        return CompareLessThanEquals(vl, vr);
+      case (EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO):
+        return CompareGreaterThanEquals(vl, vr);
+      default:
+        throw Exception("Invalid comparison expression type.");
+    }
+  }
+
+  void EvaluateBatch(storage::TileGroup *tile_group,
+                     const std::vector<oid_t> &selection,
+                     std::vector<oid_t> &output,
+                     executor::ExecutorContext *context) const override;
+
+  void EvaluateBatch(executor::LogicalTile *tile,
+                     const std::vector<oid_t> &selection,
+                     std::vector<oid_t> &output,
+                     executor::ExecutorContext *context) const override;
+
+  bool MayMatch(const storage::ZoneMap &zone_map,
+                executor::ExecutorContext *context) const override;
+
+  // Evaluate "this AND other" in a single pass over the column when both
+  // compare the same packed column with a constant (e.g. BETWEEN). Returns
+  // false, without touching the output, if the shape has no such kernel.
+  bool EvaluateRangeBatch(const ComparisonExpression *other,
+                          storage::TileGroup *tile_group,
+                          const std::vector<oid_t> &selection,
+                          std::vector<oid_t> &output,
+                          executor::ExecutorContext *context) const;
+
   AbstractExpression *Copy() const override {
     return new ComparisonExpression(exp_type_,
                                     left_ ? left_->Copy() : nullptr,
                                     right_ ? right_->Copy() : nullptr);
   }
+
+ private:
+  // Match the "column <op> constant" shape (in either operand order) that has
+  // a batch kernel. On success, the column id, the constant and the operator
+  // to apply as "column <op> constant" are returned.
+  bool GetColumnConstantShape(executor::ExecutorContext *context,
+                              oid_t &column_id, TypedValue &constant,
+                              ExpressionType &op) const;
 };
 
 }  // End expression namespace
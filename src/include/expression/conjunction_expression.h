@@ -61,11 +61,55 @@ class ConjunctionExpression : public AbstractExpression {
     }
   }
 
+  CmpBool EvaluatePredicate(const AbstractTuple *tuple1,
+                            const AbstractTuple *tuple2,
+                            executor::ExecutorContext *context) const override {
+    CmpBool vl = left_->EvaluatePredicate(tuple1, tuple2, context);
+    switch (exp_type_) {
+      case (EXPRESSION_TYPE_CONJUNCTION_AND): {
+        if (vl == CMP_FALSE) return CMP_FALSE;
+        CmpBool vr = right_->EvaluatePredicate(tuple1, tuple2, context);
+        if (vr == CMP_FALSE) return CMP_FALSE;
+        if (vl == CMP_TRUE && vr == CMP_TRUE) return CMP_TRUE;
+        return CMP_NULL;
+      }
+      case (EXPRESSION_TYPE_CONJUNCTION_OR): {
+        if (vl == CMP_TRUE) return CMP_TRUE;
+        CmpBool vr = right_->EvaluatePredicate(tuple1, tuple2, context);
+        if (vr == CMP_TRUE) return CMP_TRUE;
+        if (vl == CMP_FALSE && vr == CMP_FALSE) return CMP_FALSE;
+        return CMP_NULL;
+      }
+      default:
+        throw Exception("Invalid conjunction expression type.");
+    }
+  }
+
+  void EvaluateBatch(storage::TileGroup *tile_group,
+                     const std::vector<oid_t> &selection,
+                     std::vector<oid_t> &output,
+                     executor::ExecutorContext *context) const override;
+
+  void EvaluateBatch(executor::LogicalTile *tile,
+                     const std::vector<oid_t> &selection,
+                     std::vector<oid_t> &output,
+                     executor::ExecutorContext *context) const override;
+
+  bool MayMatch(const storage::ZoneMap &zone_map,
+                executor::ExecutorContext *context) const override;
+
   AbstractExpression *Copy() const override {
     return new ConjunctionExpression(exp_type_,
                                      left_ ? left_->Copy() : nullptr,
                                      right_ ? right_->Copy() : nullptr);
   }
+
+ private:
+  template <class Container>
+  void EvaluateBatchImpl(Container *container,
+                         const std::vector<oid_t> &selection,
+                         std::vector<oid_t> &output,
+                         executor::ExecutorContext *context) const;
 };
 
 }  // End expression namespace
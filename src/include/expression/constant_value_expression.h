@@ -37,6 +37,15 @@ class ConstantValueExpression : public AbstractExpression {
     return std::unique_ptr<Value>(value_->Copy());
   }
 
+  bool EvaluateTyped(UNUSED_ATTRIBUTE const AbstractTuple *tuple1,
+                     UNUSED_ATTRIBUTE const AbstractTuple *tuple2,
+                     UNUSED_ATTRIBUTE executor::ExecutorContext *context,
+                     TypedValue &result) const override {
+    // The view references value_, which lives as long as this expression
+    result = TypedValue::FromValue(*value_);
+    return true;
+  }
+
   Value *GetValue() const { return value_->Copy(); }
 
   bool HasParameter() const override { return false; }
@@ -62,6 +62,13 @@ class ContainerTuple : public AbstractTuple {
     return container_->GetValue(tuple_id_, column_id);
   }
 
+  /** @brief Get a view of the value at the given column id. */
+  common::TypedValue GetTypedValue(oid_t column_id) const override {
+    PL_ASSERT(container_ != nullptr);
+
+    return container_->GetTypedValue(tuple_id_, column_id);
+  }
+
   /** @brief Get the raw location of the tuple's contents. */
   inline char *GetData() const override {
     // NOTE: We can't.Get a table tuple from a tilegroup or logical tile
@@ -181,6 +188,14 @@ class ContainerTuple<std::vector<common::Value *>> : public AbstractTuple {
     return ((*container_)[column_id])->Copy();
   }
 
+  /** @brief Get a view of the value at the given column id. */
+  common::TypedValue GetTypedValue(oid_t column_id) const override {
+    PL_ASSERT(container_ != nullptr);
+    PL_ASSERT(column_id < container_->size());
+
+    return common::TypedValue::FromValue(*((*container_)[column_id]));
+  }
+
   void SetValue(UNUSED_ATTRIBUTE oid_t column_id,
     UNUSED_ATTRIBUTE const common::Value &value) {}
 
@@ -250,6 +265,13 @@ class ContainerTuple<storage::TileGroup> : public AbstractTuple {
     return container_->GetValue(tuple_id_, column_id);
   }
 
+  /** @brief Get a view of the value at the given column id. */
+  common::TypedValue GetTypedValue(oid_t column_id) const override {
+    PL_ASSERT(container_ != nullptr);
+
+    return container_->GetTypedValue(tuple_id_, column_id);
+  }
+
   void SetValue(oid_t column_id, const common::Value &value) {
     std::unique_ptr<common::Value> val(value.Copy());
     container_->SetValue(*val, tuple_id_, column_id);
@@ -39,6 +39,14 @@ class ParameterValueExpression : public AbstractExpression {
     return std::unique_ptr<Value>(context->GetParams().at(value_idx_));
   }
 
+  bool EvaluateTyped(UNUSED_ATTRIBUTE const AbstractTuple *tuple1,
+                     UNUSED_ATTRIBUTE const AbstractTuple *tuple2,
+                     executor::ExecutorContext *context,
+                     TypedValue &result) const override {
+    result = TypedValue::FromValue(*context->GetParams().at(value_idx_));
+    return true;
+  }
+
   AbstractExpression *Copy() const override {
     return new ParameterValueExpression(value_idx_);
   }
@@ -47,12 +47,28 @@ class TupleValueExpression : public AbstractExpression {
     }
   }
 
+  bool EvaluateTyped(const AbstractTuple *tuple1, const AbstractTuple *tuple2,
+                     UNUSED_ATTRIBUTE executor::ExecutorContext *context,
+                     TypedValue &result) const override {
+    if (tuple_idx_ == 0) {
+      assert(tuple1 != nullptr);
+      result = tuple1->GetTypedValue(value_idx_);
+    }
+    else {
+      assert(tuple2 != nullptr);
+      result = tuple2->GetTypedValue(value_idx_);
+    }
+    return true;
+  }
+
   AbstractExpression *Copy() const override {
     return new TupleValueExpression(value_type_, tuple_idx_, value_idx_);
   }
 
   int GetColumnId() const { return value_idx_; }
 
+  int GetTupleIdx() const { return tuple_idx_; }
+
  protected:
   int value_idx_;
   int tuple_idx_;
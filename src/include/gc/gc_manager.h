@@ -20,6 +20,11 @@
 #include "common/logger.h"
 
 namespace peloton {
+
+namespace storage {
+class TileGroupHeader;
+}
+
 namespace gc {
 
 //===--------------------------------------------------------------------===//
@@ -55,10 +60,43 @@ class GCManager {
 
   virtual void RegisterTable(const oid_t &table_id UNUSED_ATTRIBUTE) { }
 
+  // Every garbage context recycled with a timestamp below the returned cid
+  // has been unlinked from the indexes. Without GC, nothing is ever unlinked.
+  virtual cid_t GetUnlinkedCid() { return INVALID_CID; }
+
+  //===--------------------------------------------------------------------===//
+  // Backlog
+  //===--------------------------------------------------------------------===//
+
+  // Number of garbage contexts waiting to be unlinked from the indexes
+  virtual size_t GetUnlinkBacklog() { return 0; }
+
+  // Number of unlinked garbage contexts waiting to be reclaimed
+  virtual size_t GetReclaimBacklog() { return 0; }
+
+  // Number of versions reclaimed since the start
+  virtual size_t GetReclaimedVersionCount() { return 0; }
+
+  // Timestamp of the oldest garbage context that was not reclaimed yet
+  virtual cid_t GetOldestUnreclaimedCid() { return MAX_CID; }
+
+  // Bytes of the tuple slots held by the garbage the GC threads picked up,
+  // only counted while the stats are collected
+  virtual size_t GetDeadVersionBytes() { return 0; }
+
+  // Number of GC threads that garbage is handed to
+  virtual int GetActiveThreadCount() { return 0; }
+
   virtual void RecycleTransaction(std::shared_ptr<ReadWriteSet> gc_set UNUSED_ATTRIBUTE, 
                                    const cid_t &timestamp UNUSED_ATTRIBUTE,
                                    const GCSetType gc_set_type UNUSED_ATTRIBUTE) {}
 
+  // Called by a worker that found a visible version, to unlink the older
+  // versions that no transaction can see anymore
+  virtual void PruneVersionChain(
+      storage::TileGroupHeader *tile_group_header UNUSED_ATTRIBUTE,
+      const oid_t &tuple_id UNUSED_ATTRIBUTE) {}
+
  private:
   bool is_running_;
 };
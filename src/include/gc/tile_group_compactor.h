@@ -0,0 +1,211 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_compactor.h
+//
+// Identification: src/include/gc/tile_group_compactor.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "common/types.h"
+
+// a full tile group with at most this fraction of live tuples is compacted
+#define DEFAULT_COMPACTION_OCCUPANCY_THRESHOLD 0.1
+// tile groups of a table that start being compacted in one round
+#define DEFAULT_COMPACTION_TILE_GROUPS_PER_ROUND 16
+// tuples of a table relocated in one round
+#define DEFAULT_COMPACTION_TUPLES_PER_ROUND 10000
+// tuples relocated by one transaction
+#define DEFAULT_COMPACTION_TUPLES_PER_TXN 100
+// pause between two rounds, in milliseconds
+#define DEFAULT_COMPACTION_ROUND_INTERVAL 1000
+
+namespace peloton {
+
+namespace storage {
+class DataTable;
+class TileGroup;
+class TileGroupHeader;
+}
+
+namespace gc {
+
+//===--------------------------------------------------------------------===//
+// Tile Group Compactor
+//===--------------------------------------------------------------------===//
+
+// Merges the sparse tile groups of the tables, so that scans and the catalog
+// stop paying for the tile groups left behind by deletes.
+//
+// A full tile group whose occupancy fell below the threshold becomes
+// immutable: the GC stops recycling its slots. Its live tuples are then moved
+// out by transactions that update them in place, without changing any value.
+// The new versions land in the active tile groups, and the indirections that
+// the indexes point to are switched over to them, so the index entries stay
+// as they are. The old versions are reclaimed by the GC like any other.
+//
+// Once every slot of the tile group is free, and the GC has unlinked all the
+// versions that were recycled before, the tile group is dropped from its
+// table and from the catalog. A tile group that holds the empty version of a
+// deleted tuple is never dropped, as those versions are not reclaimed.
+//
+// Every round, the compactor visits every table, and the knobs bound the
+// work done on each of them.
+class TileGroupCompactor {
+ public:
+  TileGroupCompactor(const TileGroupCompactor &) = delete;
+  TileGroupCompactor &operator=(const TileGroupCompactor &) = delete;
+  TileGroupCompactor(TileGroupCompactor &&) = delete;
+  TileGroupCompactor &operator=(TileGroupCompactor &&) = delete;
+
+  TileGroupCompactor() {}
+
+  ~TileGroupCompactor();
+
+  static TileGroupCompactor &GetInstance() {
+    static TileGroupCompactor compactor;
+    return compactor;
+  }
+
+  // Start and stop the background compaction thread
+  void StartCompactor();
+
+  void StopCompactor();
+
+  bool GetStatus() const { return is_running_; }
+
+  // Run a round over every table of the catalog
+  void CompactTables();
+
+  // Run a round over a table
+  void CompactTable(storage::DataTable *table);
+
+  //===--------------------------------------------------------------------===//
+  // Knobs
+  //===--------------------------------------------------------------------===//
+
+  inline void SetOccupancyThreshold(double occupancy_threshold) {
+    occupancy_threshold_ = occupancy_threshold;
+  }
+
+  inline double GetOccupancyThreshold() const { return occupancy_threshold_; }
+
+  inline void SetMaxTileGroupsPerRound(size_t max_tile_groups_per_round) {
+    max_tile_groups_per_round_ = max_tile_groups_per_round;
+  }
+
+  inline size_t GetMaxTileGroupsPerRound() const {
+    return max_tile_groups_per_round_;
+  }
+
+  inline void SetMaxTuplesPerRound(size_t max_tuples_per_round) {
+    max_tuples_per_round_ = max_tuples_per_round;
+  }
+
+  inline size_t GetMaxTuplesPerRound() const { return max_tuples_per_round_; }
+
+  inline void SetMaxTuplesPerTxn(size_t max_tuples_per_txn) {
+    max_tuples_per_txn_ = max_tuples_per_txn;
+  }
+
+  inline size_t GetMaxTuplesPerTxn() const { return max_tuples_per_txn_; }
+
+  inline void SetRoundInterval(size_t round_interval) {
+    round_interval_ = round_interval;
+  }
+
+  inline size_t GetRoundInterval() const { return round_interval_; }
+
+  //===--------------------------------------------------------------------===//
+  // Metrics
+  //===--------------------------------------------------------------------===//
+
+  // tile groups that became immutable
+  inline size_t GetCompactedTileGroupCount() const {
+    return compacted_tile_group_count_;
+  }
+
+  // tile groups dropped once empty
+  inline size_t GetDroppedTileGroupCount() const {
+    return dropped_tile_group_count_;
+  }
+
+  // live tuples moved out of the immutable tile groups
+  inline size_t GetRelocatedTupleCount() const {
+    return relocated_tuple_count_;
+  }
+
+  // live tuples left in place for now, because another transaction was
+  // modifying them
+  inline size_t GetSkippedTupleCount() const { return skipped_tuple_count_; }
+
+ private:
+  // a tile group that is being compacted
+  struct ImmutableTileGroup {
+    // the current cid once the tile group became immutable. it is read, not
+    // taken, so the compactor adds no commit id to the global counter.
+    cid_t immutable_cid;
+    // the current cid once every slot of the tile group was found free
+    cid_t drop_cid;
+  };
+
+  void Running();
+
+  // Whether a full tile group has few enough live tuples to be compacted
+  bool IsSparse(storage::TileGroup *tile_group) const;
+
+  // Whether no slot of a tile group holds a version
+  bool IsFree(storage::TileGroupHeader *tile_group_header) const;
+
+  // Move at most max_tuple_count live tuples out of a tile group, and return
+  // how many were moved
+  size_t RelocateTuples(storage::DataTable *table,
+                        storage::TileGroup *tile_group, size_t max_tuple_count);
+
+  std::unique_ptr<std::thread> compactor_thread_;
+
+  std::atomic<bool> is_running_ = ATOMIC_VAR_INIT(false);
+
+  // wakes up the compaction thread when it is stopped
+  std::mutex running_mutex_;
+  std::condition_variable running_cv_;
+
+  // serializes the rounds
+  std::mutex compaction_mutex_;
+
+  // the tile groups being compacted, by tile group id
+  std::unordered_map<oid_t, ImmutableTileGroup> immutable_tile_groups_;
+
+  double occupancy_threshold_ = DEFAULT_COMPACTION_OCCUPANCY_THRESHOLD;
+
+  size_t max_tile_groups_per_round_ = DEFAULT_COMPACTION_TILE_GROUPS_PER_ROUND;
+
+  size_t max_tuples_per_round_ = DEFAULT_COMPACTION_TUPLES_PER_ROUND;
+
+  size_t max_tuples_per_txn_ = DEFAULT_COMPACTION_TUPLES_PER_TXN;
+
+  size_t round_interval_ = DEFAULT_COMPACTION_ROUND_INTERVAL;
+
+  std::atomic<size_t> compacted_tile_group_count_ = ATOMIC_VAR_INIT(0);
+
+  std::atomic<size_t> dropped_tile_group_count_ = ATOMIC_VAR_INIT(0);
+
+  std::atomic<size_t> relocated_tuple_count_ = ATOMIC_VAR_INIT(0);
+
+  std::atomic<size_t> skipped_tuple_count_ = ATOMIC_VAR_INIT(0);
+};
+
+}  // namespace gc
+}  // namespace peloton
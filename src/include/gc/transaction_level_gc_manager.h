@@ -12,6 +12,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 #include <unordered_map>
 #include <map>
@@ -20,28 +24,45 @@
 
 #include "common/types.h"
 #include "common/logger.h"
+#include "common/read_write_set.h"
 #include "gc/gc_manager.h"
 
 #include "container/lock_free_queue.h"
 
 namespace peloton {
+
+namespace storage {
+class DataTable;
+}
+
 namespace gc {
 
 #define MAX_QUEUE_LENGTH 100000
 #define MAX_ATTEMPT_COUNT 100000
+// index entries deleted by one batch. the batch holds the btree index lock
+// and the bwtree epoch, so that readers are not kept waiting for long.
+#define INDEX_DELETE_BATCH_SIZE 1024
+
+// garbage contexts a GC thread is expected to keep up with. the controller
+// hands the garbage to one more thread for every such backlog.
+#define DEFAULT_GC_BACKLOG_PER_THREAD 10000
+// how often the controller adjusts the GC threads, in milliseconds
+#define DEFAULT_GC_CONTROL_INTERVAL 100
 
 
 struct GarbageContext {
-  GarbageContext() : timestamp_(INVALID_CID), gc_set_type_(GC_SET_TYPE_COMMITTED) {}
+  GarbageContext() : timestamp_(INVALID_CID), gc_set_type_(GC_SET_TYPE_COMMITTED), version_bytes_(0) {}
   GarbageContext(std::shared_ptr<ReadWriteSet> gc_set, 
                  const cid_t &timestamp, 
-                 const GCSetType gc_set_type) : timestamp_(timestamp), gc_set_type_(gc_set_type) {
+                 const GCSetType gc_set_type) : timestamp_(timestamp), gc_set_type_(gc_set_type), version_bytes_(0) {
     gc_set_ = gc_set;
   }
 
   std::shared_ptr<ReadWriteSet> gc_set_;
   cid_t timestamp_;
   GCSetType gc_set_type_;
+  // bytes of the tuple slots of the versions, set once a GC thread picks it up
+  size_t version_bytes_;
 };
 
 class TransactionLevelGCManager : public GCManager {
@@ -49,8 +70,15 @@ public:
   TransactionLevelGCManager(int thread_count) 
     : is_running_(true),
       gc_thread_count_(thread_count),
+      active_thread_count_(thread_count),
       gc_threads_(thread_count),
-      reclaim_maps_(thread_count) {
+      reclaim_maps_(thread_count),
+      unlinked_cids_(thread_count),
+      queued_counts_(thread_count),
+      local_counts_(thread_count),
+      reclaim_counts_(thread_count),
+      oldest_cids_(thread_count),
+      dead_version_bytes_(thread_count) {
 
     unlink_queues_.reserve(thread_count);
     for (int i = 0; i < gc_thread_count_; ++i) {
@@ -59,6 +87,12 @@ public:
       );
       unlink_queues_.push_back(unlink_queue);
       local_unlink_queues_.emplace_back();
+      unlinked_cids_[i] = INVALID_CID;
+      queued_counts_[i] = 0;
+      local_counts_[i] = 0;
+      reclaim_counts_[i] = 0;
+      oldest_cids_[i] = MAX_CID;
+      dead_version_bytes_[i] = 0;
     }
   }
 
@@ -86,8 +120,52 @@ public:
 
   virtual void RecycleTransaction(std::shared_ptr<ReadWriteSet> gc_set, const cid_t &timestamp, const GCSetType) override;
 
+  virtual void PruneVersionChain(storage::TileGroupHeader *tile_group_header,
+                                 const oid_t &tuple_id) override;
+
   virtual ItemPointer ReturnFreeSlot(const oid_t &table_id) override;
 
+  virtual cid_t GetUnlinkedCid() override;
+
+  virtual size_t GetUnlinkBacklog() override;
+
+  virtual size_t GetReclaimBacklog() override;
+
+  virtual size_t GetReclaimedVersionCount() override {
+    return reclaimed_version_count_;
+  }
+
+  virtual cid_t GetOldestUnreclaimedCid() override;
+
+  virtual size_t GetDeadVersionBytes() override;
+
+  virtual int GetActiveThreadCount() override { return active_thread_count_; }
+
+  // The controller hands the garbage to as many of the GC threads as the
+  // backlog needs, and parks the others once they have drained their own
+  // garbage. It is off by default, and disabling it hands the garbage to all
+  // of them again.
+  inline void SetAdaptive(bool is_adaptive) {
+    is_adaptive_ = is_adaptive;
+    if (is_adaptive == false) {
+      SetActiveThreadCount(gc_thread_count_);
+    }
+  }
+
+  inline bool IsAdaptive() const { return is_adaptive_; }
+
+  inline void SetBacklogPerThread(size_t backlog_per_thread) {
+    backlog_per_thread_ = backlog_per_thread;
+  }
+
+  inline size_t GetBacklogPerThread() const { return backlog_per_thread_; }
+
+  inline void SetControlInterval(size_t control_interval) {
+    control_interval_ = control_interval;
+  }
+
+  inline size_t GetControlInterval() const { return control_interval_; }
+
   virtual void RegisterTable(const oid_t &table_id) override {
     // Insert a new entry for the table
     if (recycle_queue_map_.find(table_id) == recycle_queue_map_.end()) {
@@ -102,9 +180,20 @@ private:
   void StopGC(int thread_id);
 
   inline unsigned int HashToThread(const cid_t &ts) {
-    return (unsigned int)ts % gc_thread_count_;
+    return (unsigned int)ts % active_thread_count_;
   }
 
+  // Scale the active GC threads from the backlog, run by the first thread
+  void AdjustThreadCount();
+
+  void SetActiveThreadCount(int thread_count);
+
+  // Whether a GC thread holds no garbage anymore
+  bool IsDrained(const int &thread_id);
+
+  // Bytes of the tuple slots of the versions of a garbage context
+  size_t GetVersionBytes(const std::shared_ptr<GarbageContext> &garbage_ctx);
+
   void ClearGarbage(int thread_id);
 
   void Running(const int &thread_id);
@@ -117,9 +206,11 @@ private:
 
   bool ResetTuple(const ItemPointer &);
 
-  void DeleteFromIndexes(const std::shared_ptr<GarbageContext>& garbage_ctx);
+  void DeleteFromIndexes(const std::vector<std::shared_ptr<GarbageContext>> &garbages);
 
-  void DeleteTupleFromIndexes(ItemPointer *indirection);
+  void DeleteTuplesFromIndexes(storage::DataTable *table,
+                               ItemPointer *const *indirections,
+                               const size_t &tuple_count);
 
 private:
   //===--------------------------------------------------------------------===//
@@ -129,6 +220,21 @@ private:
 
   int gc_thread_count_;
 
+  // the garbage is handed to the first active_thread_count_ threads
+  std::atomic<int> active_thread_count_;
+
+  // wakes up the parked GC threads
+  std::mutex park_mutex_;
+  std::condition_variable park_cv_;
+
+  bool is_adaptive_ = false;
+
+  size_t backlog_per_thread_ = DEFAULT_GC_BACKLOG_PER_THREAD;
+
+  size_t control_interval_ = DEFAULT_GC_CONTROL_INTERVAL;
+
+  std::chrono::steady_clock::time_point last_control_time_;
+
   std::vector<std::unique_ptr<std::thread>> gc_threads_;
 
   // queues for to-be-unlinked tuples.
@@ -145,6 +251,24 @@ private:
   // queues for to-be-reused tuples.
   std::unordered_map<oid_t, std::shared_ptr<peloton::LockFreeQueue<ItemPointer>>> recycle_queue_map_;
 
+  // the max cid of the last unlink pass of each thread that drained its
+  // unlink queue.
+  std::vector<std::atomic<cid_t>> unlinked_cids_;
+
+  // the backlog of each thread. the garbage contexts are counted in the
+  // unlink queue, in the local unlink queue and in the reclaim map.
+  std::vector<std::atomic<size_t>> queued_counts_;
+  std::vector<std::atomic<size_t>> local_counts_;
+  std::vector<std::atomic<size_t>> reclaim_counts_;
+
+  // the timestamp of the oldest garbage context held by each thread
+  std::vector<std::atomic<cid_t>> oldest_cids_;
+
+  // the bytes of the versions held by each thread
+  std::vector<std::atomic<size_t>> dead_version_bytes_;
+
+  std::atomic<size_t> reclaimed_version_count_ = ATOMIC_VAR_INIT(0);
+
 };
 }
 }
@@ -50,6 +50,10 @@ class BTreeIndex : public Index {
 
   bool DeleteEntry(const storage::Tuple *key, ItemPointer *value);
 
+  void DeleteEntries(
+      const std::vector<std::pair<const storage::Tuple *, ItemPointer *>> &
+          entries);
+
   bool CondInsertEntry(const storage::Tuple *key, ItemPointer *value,
                        std::function<bool(const void *)> predicate);
 
@@ -79,6 +83,10 @@ class BTreeIndex : public Index {
   }
 
  protected:
+  // Delete the < key, location > pairs from the container, with the index
+  // lock held, and return how many were deleted
+  size_t DeleteFromContainer(const KeyType &index_key, ValueType value);
+
   MapType container;
 
   // equality checker and comparator
@@ -6184,12 +6184,53 @@ before_switch:
   bool Delete(const KeyType &key, const ValueType &value) {
     bwt_printf("Delete called\n");
 
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    bool ret = DeleteInEpoch(key, value);
+
+    epoch_manager.LeaveEpoch(epoch_node_p);
+
+    return ret;
+  }
+
+  /*
+   * DeleteBatch() - Remove a batch of key-value pairs from the tree
+   *
+   * The thread joins the epoch once for the whole batch instead of once
+   * per pair. If the batch is sorted by key, the traversals of consecutive
+   * pairs go through the same inner nodes and often end at the same leaf,
+   * which are then still in the cache.
+   *
+   * This function returns the number of pairs that existed and were deleted
+   */
+  size_t DeleteBatch(const std::vector<std::pair<KeyType, ValueType>> &items) {
+    bwt_printf("DeleteBatch called\n");
+
+    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
+
+    size_t delete_count = 0;
+    for(const auto &item : items) {
+      if(DeleteInEpoch(item.first, item.second) == true) {
+        delete_count++;
+      }
+    }
+
+    epoch_manager.LeaveEpoch(epoch_node_p);
+
+    return delete_count;
+  }
+
+  /*
+   * DeleteInEpoch() - Remove a key-value pair, with the epoch already joined
+   *
+   * This function returns false if the key and value pair does not
+   * exist. Return true if delete succeeds
+   */
+  bool DeleteInEpoch(const KeyType &key, const ValueType &value) {
     #ifdef BWTREE_DEBUG
     delete_op_count.fetch_add(1);
     #endif
 
-    EpochNode *epoch_node_p = epoch_manager.JoinEpoch();
-
     while(1) {
       Context context{key};
       std::pair<int, bool> index_pair;
@@ -6199,8 +6240,6 @@ before_switch:
       const KeyValuePair *item_p = Traverse(&context, &value, &index_pair);
 
       if(item_p == nullptr) {
-        epoch_manager.LeaveEpoch(epoch_node_p);
-
         return false;
       }
 
@@ -6244,8 +6283,6 @@ before_switch:
       bwt_printf("Retry installing leaf delete delta from the root\n");
     }
 
-    epoch_manager.LeaveEpoch(epoch_node_p);
-
     return true;
   }
 
@@ -91,6 +91,10 @@ class BWTreeIndex : public Index {
 
   bool DeleteEntry(const storage::Tuple *key, ItemPointer *value);
 
+  void DeleteEntries(
+      const std::vector<std::pair<const storage::Tuple *, ItemPointer *>> &
+          entries);
+
   bool CondInsertEntry(const storage::Tuple *key,
                        ItemPointer *value,
                        std::function<bool(const void *)> predicate);
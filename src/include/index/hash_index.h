@@ -0,0 +1,108 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_index.h
+//
+// Identification: src/include/index/hash_index.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/platform.h"
+#include "common/types.h"
+#include "index/index.h"
+
+namespace peloton {
+namespace index {
+
+/**
+ * Hash index for point lookups.
+ *
+ * The key space is split into a fixed number of partitions by hash value.
+ * Each partition is a hash multimap guarded by its own reader/writer lock, so
+ * operations on different partitions never contend.
+ *
+ * Keys are not ordered, so a scan that is not a point query goes over all the
+ * entries and checks the predicate on each of them.
+ *
+ * @see Index
+ */
+template <typename KeyType, typename ValueType, class KeyHasher,
+          class KeyEqualityChecker>
+class HashIndex : public Index {
+  friend class IndexFactory;
+
+  // Define the container type
+  typedef std::unordered_multimap<KeyType, ValueType, KeyHasher,
+                                  KeyEqualityChecker> MapType;
+
+ public:
+  HashIndex(IndexMetadata *metadata);
+
+  ~HashIndex();
+
+  bool InsertEntry(const storage::Tuple *key, ItemPointer *value);
+
+  bool DeleteEntry(const storage::Tuple *key, ItemPointer *value);
+
+  bool CondInsertEntry(const storage::Tuple *key, ItemPointer *value,
+                       std::function<bool(const void *)> predicate);
+
+  void Scan(const std::vector<common::Value *> &value_list,
+            const std::vector<oid_t> &tuple_column_id_list,
+            const std::vector<ExpressionType> &expr_list,
+            const ScanDirectionType &scan_direction,
+            std::vector<ValueType> &result,
+            const ConjunctionScanPredicate *csp_p);
+
+  void ScanAllKeys(std::vector<ValueType> &result);
+
+  void ScanKey(const storage::Tuple *key, std::vector<ValueType> &result);
+
+  std::string GetTypeName() const;
+
+  bool Cleanup() { return true; }
+
+  size_t GetMemoryFootprint();
+
+  bool NeedGC() { return false; }
+
+  void PerformGC() { return; }
+
+ protected:
+  // Number of partitions, must be a power of two
+  static constexpr size_t partition_count = 64;
+
+  struct Partition {
+    MapType container;
+
+    // synch helper
+    RWLock partition_lock;
+  };
+
+  Partition &GetPartition(const KeyType &key);
+
+  // Scan the entries of every partition and keep those whose key satisfies
+  // the predicate
+  void ScanAllPartitions(const std::vector<common::Value *> &value_list,
+                         const std::vector<oid_t> &tuple_column_id_list,
+                         const std::vector<ExpressionType> &expr_list,
+                         std::vector<ValueType> &result);
+
+  std::unique_ptr<Partition[]> partitions;
+
+  // hash function
+  KeyHasher hasher;
+};
+
+}  // End index namespace
+}  // End peloton namespace
@@ -17,6 +17,7 @@
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "common/logger.h"
@@ -206,6 +207,14 @@ class Index : public Printable {
   virtual bool DeleteEntry(const storage::Tuple *key,
                            ItemPointer *location_ptr) = 0;
 
+  // delete a batch of index entries given as key and location pairs. the
+  // ordered indexes sort the batch by key, so that the deletions sharing a
+  // path in the tree are applied one after the other. by default the entries
+  // are deleted one at a time.
+  virtual void DeleteEntries(
+      const std::vector<std::pair<const storage::Tuple *, ItemPointer *>> &
+          entries);
+
   // First retrieve all Key-Value pairs of the given key
   // Return false if any of those k-v pairs satisfy the predicate
   // If not any of those k-v pair satisfy the predicate, insert the k-v pair
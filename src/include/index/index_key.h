@@ -233,8 +233,7 @@ class IntsKey {
     for (int ii = 0; ii < GetColumnCount; ii++) {
       switch (key_schema->GetColumn(ii).column_type) {
         case Type::BIGINT: {
-          std::unique_ptr<common::Value> val(tuple->GetValue(ii));
-          const int64_t value = ValuePeeker::PeekBigInt(val.get());
+          const int64_t value = tuple->GetTypedValue(ii).GetAs<int64_t>();
           const uint64_t key_value =
               ConvertSignedValueToUnsignedValue<INT64_MAX, int64_t, uint64_t>(
                   value);
@@ -242,8 +241,7 @@ class IntsKey {
           break;
         }
         case Type::INTEGER: {
-          std::unique_ptr<common::Value> val(tuple->GetValue(ii));
-          const int32_t value = ValuePeeker::PeekInteger(val.get());
+          const int32_t value = tuple->GetTypedValue(ii).GetAs<int32_t>();
           const uint32_t key_value =
               ConvertSignedValueToUnsignedValue<INT32_MAX, int32_t, uint32_t>(
                   value);
@@ -251,8 +249,7 @@ class IntsKey {
           break;
         }
         case Type::SMALLINT: {
-          std::unique_ptr<common::Value> val(tuple->GetValue(ii));
-          const int16_t value = ValuePeeker::PeekSmallInt(val.get());
+          const int16_t value = tuple->GetTypedValue(ii).GetAs<int16_t>();
           const uint16_t key_value =
               ConvertSignedValueToUnsignedValue<INT16_MAX, int16_t, uint16_t>(
                   value);
@@ -260,8 +257,7 @@ class IntsKey {
           break;
         }
         case Type::TINYINT: {
-          std::unique_ptr<common::Value> val(tuple->GetValue(ii));
-          const int8_t value = ValuePeeker::PeekTinyInt(val.get());
+          const int8_t value = tuple->GetTypedValue(ii).GetAs<int8_t>();
           const uint8_t key_value =
               ConvertSignedValueToUnsignedValue<INT8_MAX, int8_t, uint8_t>(
                   value);
@@ -286,8 +282,8 @@ class IntsKey {
     for (int ii = 0; ii < GetColumnCount; ii++) {
       switch (key_schema->GetColumn(ii).column_type) {
         case Type::BIGINT: {
-          std::unique_ptr<common::Value> val(tuple->GetValue(indices[ii]));
-          const int64_t value = ValuePeeker::PeekBigInt(val.get());
+          const int64_t value =
+              tuple->GetTypedValue(indices[ii]).GetAs<int64_t>();
           const uint64_t key_value =
               ConvertSignedValueToUnsignedValue<INT64_MAX, int64_t, uint64_t>(
                   value);
@@ -295,9 +291,8 @@ class IntsKey {
           break;
         }
         case Type::INTEGER: {
-          std::unique_ptr<common::Value> val(tuple->GetValue(indices[ii]));
           const int32_t value =
-              ValuePeeker::PeekInteger(val.get());
+              tuple->GetTypedValue(indices[ii]).GetAs<int32_t>();
           const uint32_t key_value =
               ConvertSignedValueToUnsignedValue<INT32_MAX, int32_t, uint32_t>(
                   value);
@@ -305,8 +300,8 @@ class IntsKey {
           break;
         }
         case Type::SMALLINT: {
-          std::unique_ptr<common::Value> val(tuple->GetValue(indices[ii]));
-          const int16_t value = ValuePeeker::PeekSmallInt(val.get());
+          const int16_t value =
+              tuple->GetTypedValue(indices[ii]).GetAs<int16_t>();
           const uint16_t key_value =
               ConvertSignedValueToUnsignedValue<INT16_MAX, int16_t, uint16_t>(
                   value);
@@ -314,8 +309,8 @@ class IntsKey {
           break;
         }
         case Type::TINYINT: {
-          std::unique_ptr<common::Value> val(tuple->GetValue(indices[ii]));
-          const int8_t value = ValuePeeker::PeekTinyInt(val.get());
+          const int8_t value =
+              tuple->GetTypedValue(indices[ii]).GetAs<int8_t>();
           const uint8_t key_value =
               ConvertSignedValueToUnsignedValue<INT8_MAX, int8_t, uint8_t>(
                   value);
@@ -466,6 +461,14 @@ class GenericKey {
     return Value::DeserializeFrom(data_ptr, column_type, is_inlined);
   }
 
+  inline const common::TypedValue ToTypedValueFast(
+      const catalog::Schema *schema, int column_id) const {
+    const Type::TypeId column_type = schema->GetType(column_id);
+    const char *data_ptr = &data[schema->GetOffset(column_id)];
+
+    return common::TypedValue::DeserializeFrom(data_ptr, column_type);
+  }
+
   // actual location of data, extends past the end.
   char data[KeySize];
 
@@ -484,19 +487,16 @@ class GenericComparator {
 
     for (oid_t column_itr = 0; column_itr < schema->GetColumnCount();
          column_itr++) {
-      std::unique_ptr<const common::Value> lhs_value(
-          lhs.ToValueFast(schema, column_itr));
-      std::unique_ptr<const common::Value> rhs_value(
-          rhs.ToValueFast(schema, column_itr));
-      
-      std::unique_ptr<common::Value> res_lt(
-          lhs_value->CompareLessThan(*rhs_value));
-      if (res_lt->IsTrue())
+      const common::TypedValue lhs_value =
+          lhs.ToTypedValueFast(schema, column_itr);
+      const common::TypedValue rhs_value =
+          rhs.ToTypedValueFast(schema, column_itr);
+
+      if (common::CompareLessThan(lhs_value, rhs_value) == common::CMP_TRUE)
         return true;
 
-      std::unique_ptr<common::Value> res_gt(
-          lhs_value->CompareGreaterThan(*rhs_value));
-      if (res_gt->IsTrue())
+      if (common::CompareGreaterThan(lhs_value, rhs_value) ==
+          common::CMP_TRUE)
         return false;
     }
 
@@ -519,19 +519,16 @@ class GenericComparatorRaw {
 
     for (oid_t column_itr = 0; column_itr < schema->GetColumnCount();
          column_itr++) {
-      std::unique_ptr<const common::Value> lhs_value(
-          lhs.ToValueFast(schema, column_itr));
-      std::unique_ptr<const common::Value> rhs_value(
-          rhs.ToValueFast(schema, column_itr));
+      const common::TypedValue lhs_value =
+          lhs.ToTypedValueFast(schema, column_itr);
+      const common::TypedValue rhs_value =
+          rhs.ToTypedValueFast(schema, column_itr);
 
-      std::unique_ptr<common::Value> res_lt(
-        lhs_value->CompareLessThan(*rhs_value));
-      if (res_lt->IsTrue())
+      if (common::CompareLessThan(lhs_value, rhs_value) == common::CMP_TRUE)
         return VALUE_COMPARE_LESSTHAN;
 
-      std::unique_ptr<common::Value> res_gt(
-        lhs_value->CompareGreaterThan(*rhs_value));
-      if (res_gt->IsTrue())
+      if (common::CompareGreaterThan(lhs_value, rhs_value) ==
+          common::CMP_TRUE)
         return VALUE_COMPARE_GREATERTHAN;
     }
 
@@ -13,7 +13,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <vector>
+#include <deque>
 #include <mutex>
 #include <condition_variable>
 
@@ -23,15 +25,26 @@
 #include "logging/log_buffer.h"
 #include "common/platform.h"
 #include "common/varlen_pool.h"
+#include "concurrency/transaction.h"
 #include "logging/circular_buffer_pool.h"
 
 namespace peloton {
+
+namespace storage {
+class TileGroup;
+}
+
 namespace logging {
 
 //===--------------------------------------------------------------------===//
 // Backend Logger
 //===--------------------------------------------------------------------===//
 
+// Every worker has its own backend logger, and writes its records into the
+// current log buffer without taking a lock. The lock is only taken to swap
+// the buffer, by the worker when it is full and by the frontend logger when
+// it collects it.
+
 class BackendLogger : public Logger {
   friend class FrontendLogger;
 
@@ -56,6 +69,17 @@ class BackendLogger : public Logger {
                                     ItemPointer delete_location,
                                     const void *data = nullptr) = 0;
 
+  // Serialize a tuple record straight from the tile group into the log
+  // buffer
+  virtual void LogTupleRecord(LogRecordType log_record_type, cid_t commit_id,
+                              storage::TileGroup *tile_group,
+                              ItemPointer insert_location,
+                              ItemPointer delete_location) = 0;
+
+  // Serialize a transaction record straight into the log buffer
+  virtual void LogTransactionRecord(LogRecordType log_record_type,
+                                    cid_t commit_id);
+
   void SetLoggingCidLowerBound(cid_t cid) {
     // XXX bad synchronization practice
     log_buffer_lock.Lock();
@@ -95,24 +119,43 @@ class BackendLogger : public Logger {
   // gets the Varlenpool used for log serialization
   common::VarlenPool *GetVarlenPool() { return backend_pool.get(); }
 
+  // hold the callback until the log is flushed up to the given commit id
+  void AddCommitCallback(cid_t commit_id,
+                         const concurrency::CommitCallback &callback);
+
+  // move the callbacks of the commits up to the given commit id to released,
+  // in the order they were added, without running them
+  void CollectCommitCallbacks(
+      cid_t persistent_commit_id,
+      std::vector<concurrency::CommitCallback> &released);
+
+  // run the callbacks of the commits up to the given commit id, in the order
+  // they were added
+  void ReleaseCommitCallbacks(cid_t persistent_commit_id);
+
  protected:
-  // the lock for the buffer being used currently
+  // Write a serialized record into the current log buffer
+  void WriteRecord(LogRecordType log_record_type, cid_t commit_id,
+                   const char *data, size_t len);
+
+  // Hand the full buffer over to the frontend, and open a new one with room
+  // for a record of the given length
+  LogBuffer *AcquireLogBuffer(size_t len);
+
+  // the lock for swapping the buffer being used currently
   Spinlock log_buffer_lock;
 
   // temporary local_queue used by backend
   std::vector<std::unique_ptr<LogBuffer>> local_queue;
 
   // commit id of the highest value committed so far
-  cid_t highest_logged_commit_message = INVALID_CID;
+  std::atomic<cid_t> highest_logged_commit_message{INVALID_CID};
 
   // id of the corresponding frontend logger
   int frontend_logger_id = -1;  // default
 
   // lower bound for values this backend may commit
-  cid_t logging_cid_lower_bound = INVALID_CID;
-
-  // max cid for the current log buffer
-  cid_t max_log_id_buffer = 0;
+  std::atomic<cid_t> logging_cid_lower_bound{INVALID_CID};
 
   // temporary serialization buffer
   CopySerializeOutput output_buffer;
@@ -120,6 +163,9 @@ class BackendLogger : public Logger {
   // the current buffer
   std::unique_ptr<LogBuffer> log_buffer_;
 
+  // the current buffer, as the worker reads it without the lock
+  std::atomic<LogBuffer *> current_buffer_{nullptr};
+
   // the pool of available buffers
   std::unique_ptr<BufferPool> available_buffer_pool_;
 
@@ -131,6 +177,12 @@ class BackendLogger : public Logger {
 
   // shutdown flag
   bool shutdown = false;
+
+  // the lock for the pending commit callbacks
+  Spinlock commit_callbacks_lock;
+
+  // callbacks of the commits that are not durable yet
+  std::deque<std::pair<cid_t, concurrency::CommitCallback>> commit_callbacks;
 };
 
 }  // namespace logging
@@ -66,6 +66,9 @@ class Checkpoint {
 
   void InitDirectory();
 
+  // set the checkpoint version to the latest one in the checkpoint directory
+  void InitVersionNumber();
+
   // whether file access is disabled. mainly used for testing
   bool disable_file_access = false;
 
@@ -0,0 +1,199 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// fuzzy_checkpoint.h
+//
+// Identification: src/include/logging/checkpoint/fuzzy_checkpoint.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/serializeio.h"
+#include "logging/checkpoint.h"
+
+// number of checkpoints between two full ones in incremental mode
+#define DEFAULT_FULL_CHECKPOINT_INTERVAL 10
+
+namespace peloton {
+
+namespace catalog {
+class Schema;
+}
+
+namespace storage {
+class Tile;
+class TileGroup;
+}
+
+namespace logging {
+
+//===--------------------------------------------------------------------===//
+// Fuzzy Checkpoint
+//===--------------------------------------------------------------------===//
+
+// A checkpoint of the MVCC snapshot of a read-only transaction. Writers are
+// never blocked: the snapshot only keeps the versions it sees from being
+// reclaimed while the tile groups are scanned.
+//
+// The tile groups are scanned in parallel, and every scan thread writes the
+// image of a tile group into its own bounded buffer, which is appended to the
+// checkpoint file once full. The file is made of
+//
+//   [snapshot cid] [is delta] [tile group count] { [tile group id] }
+//   { [block size] [database oid] [table oid] [tile group id]
+//     [slot count] [tuple length] [tuple count]
+//     { [tuple slot] [begin cid] }
+//     [tuple slots]
+//     { [varlen size] [varlen payload] } }
+//   [0] [snapshot cid]
+//
+// where every block is the image of one tile group. The tuple slots are kept
+// in the row layout of the table, with the invisible slots and the varlen
+// pointers zeroed, and the varlen payloads of the visible tuples follow them.
+// Recovery maps the file and copies the images into the tile groups in
+// parallel, instead of inserting the tuples one at a time. A file without the
+// trailing snapshot cid was torn and is ignored.
+//
+// With a full checkpoint interval above one, most checkpoints are deltas that
+// only image the tile groups modified since the previous checkpoint, and
+// every interval-th checkpoint is a full one that replaces the chain. The
+// header lists the tile groups that were live at the snapshot, and recovery
+// loads each of them from the latest image in the chain.
+class FuzzyCheckpoint : public Checkpoint {
+ public:
+  FuzzyCheckpoint(const FuzzyCheckpoint &) = delete;
+  FuzzyCheckpoint &operator=(const FuzzyCheckpoint &) = delete;
+  FuzzyCheckpoint(FuzzyCheckpoint &&) = delete;
+  FuzzyCheckpoint &operator=(FuzzyCheckpoint &&) = delete;
+  FuzzyCheckpoint(bool disable_file_access);
+  ~FuzzyCheckpoint();
+
+  // Inherited functions
+  void DoCheckpoint();
+
+  // Loads the latest complete checkpoint with the deltas it chains to. If a
+  // checkpoint of the chain is missing, nothing is loaded and INVALID_CID is
+  // returned, as the log before the latest checkpoint may be truncated.
+  cid_t DoRecovery();
+
+  // Getters and Setters
+  inline void SetScanThreadCount(size_t scan_thread_count) {
+    scan_thread_count_ = scan_thread_count;
+  }
+
+  inline size_t GetScanThreadCount() const { return scan_thread_count_; }
+
+  inline void SetFullCheckpointInterval(size_t full_checkpoint_interval) {
+    full_checkpoint_interval_ = full_checkpoint_interval;
+  }
+
+  inline size_t GetFullCheckpointInterval() const {
+    return full_checkpoint_interval_;
+  }
+
+ private:
+  // a tile group to scan, with the table it belongs to
+  struct ScanTask {
+    oid_t database_oid;
+    storage::DataTable *table;
+    std::shared_ptr<storage::TileGroup> tile_group;
+  };
+
+  // where a column of the table is found in a tile group and in its image
+  struct ImageColumn {
+    storage::Tile *tile;
+    size_t tile_offset;
+    size_t image_offset;
+    size_t length;
+    bool is_varlen;
+  };
+
+  // a tile group image in a mapped checkpoint file
+  struct ImageBlock {
+    const char *data;
+    size_t size;
+    oid_t tile_group_id;
+  };
+
+  // a checkpoint file mapped for recovery
+  struct MappedCheckpoint {
+    void *address = nullptr;
+    size_t size = 0;
+    cid_t snapshot_cid = INVALID_CID;
+    bool is_delta = false;
+    // the tile groups that were live at the snapshot
+    std::vector<oid_t> tile_group_ids;
+    std::vector<ImageBlock> blocks;
+  };
+
+  static std::vector<ImageColumn> GetImageColumns(
+      storage::TileGroup *tile_group, const catalog::Schema *schema);
+
+  // Scan the tasks handed out by the cursor until none is left
+  void ScanTileGroups(const std::vector<ScanTask> &scan_tasks,
+                      std::atomic<size_t> &scan_cursor);
+
+  // Write the image of the tuples of a tile group that are visible to the
+  // snapshot
+  void SerializeTileGroup(const ScanTask &scan_task,
+                          CopySerializeOutput &output_buffer);
+
+  // Append a buffer of complete blocks to the checkpoint file
+  void WriteBuffer(CopySerializeOutput &output_buffer);
+
+  // Check that a checkpoint file is complete, and get its snapshot cid
+  bool ReadSnapshotCid(FileHandle &file_handle, cid_t &snapshot_cid);
+
+  // Map a complete checkpoint file, and find its blocks
+  bool MapFile(int version, MappedCheckpoint &checkpoint);
+
+  // Load the blocks handed out by the cursor until none is left
+  void LoadTileGroups(const std::vector<ImageBlock> &blocks,
+                      std::atomic<size_t> &block_cursor,
+                      oid_t &max_tile_group_id);
+
+  // Copy a tile group image into its tile group, and return its id
+  oid_t RecoverTileGroup(SerializeInput &input);
+
+  void CreateFile();
+
+  void Cleanup(bool is_delta);
+
+  FileHandle file_handle_ = INVALID_FILE_HANDLE;
+
+  // serializes the scan threads' writes to the checkpoint file
+  std::mutex file_mutex_;
+
+  // number of threads that scan the tile groups
+  size_t scan_thread_count_ = std::thread::hardware_concurrency();
+
+  // Keep tracking max oid for setting next_oid in manager
+  // For active processing after recovery
+  oid_t max_oid_ = 0;
+
+  // snapshot cid of current checkpoint
+  cid_t snapshot_cid_ = 0;
+
+  // every interval-th checkpoint is a full one. one disables the deltas.
+  size_t full_checkpoint_interval_ = 1;
+
+  // snapshot cid of the previous checkpoint of the chain, if there is one
+  cid_t previous_snapshot_cid_ = INVALID_CID;
+
+  // number of delta checkpoints since the last full one
+  size_t delta_count_ = 0;
+};
+
+}  // namespace logging
+}  // namespace peloton
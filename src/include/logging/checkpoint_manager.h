@@ -72,6 +72,9 @@ class CheckpointManager {
   // remove all checkpointers
   void DestroyCheckpointers();
 
+  // truncate the log up to a durable checkpoint
+  void TruncateLogs(cid_t checkpoint_cid);
+
   void SetRecoveredCid(cid_t recovered_cid);
 
   cid_t GetRecoveredCid();
@@ -19,6 +19,7 @@
 #include <vector>
 #include <unistd.h>
 #include <map>
+#include <queue>
 #include <thread>
 #include <algorithm>
 
@@ -42,7 +43,8 @@ class FrontendLogger : public Logger {
   ~FrontendLogger();
 
   static FrontendLogger *GetFrontendLogger(LoggingType logging_type,
-                                           bool test_mode = false);
+                                           bool test_mode = false,
+                                           int logger_id = 0);
 
   void MainLoop(void);
 
@@ -82,6 +84,15 @@ class FrontendLogger : public Logger {
 
   void UpdateGlobalMaxFlushId();
 
+  // run the callback once the log is flushed up to the given commit id. the
+  // commit ids may come in any order.
+  void AddSnapshotCallback(cid_t commit_id,
+                           const concurrency::CommitCallback &callback);
+
+  // release the responses of the durable commits of the backend loggers and
+  // of the snapshot callbacks
+  void ReleaseCommitCallbacks(cid_t persistent_commit_id);
+
   // reset the frontend logger to its original state (for testing
   void Reset() {
     backend_loggers_lock.Lock();
@@ -122,6 +133,18 @@ class FrontendLogger : public Logger {
   // To synch the status
   Spinlock backend_loggers_lock;
 
+  // Callbacks of the read-only txns, smallest commit id first
+  typedef std::pair<cid_t, concurrency::CommitCallback> SnapshotCallback;
+  struct SnapshotCallbackOrder {
+    bool operator()(const SnapshotCallback &lhs,
+                    const SnapshotCallback &rhs) const {
+      return lhs.first > rhs.first;
+    }
+  };
+  std::priority_queue<SnapshotCallback, std::vector<SnapshotCallback>,
+                      SnapshotCallbackOrder> snapshot_callbacks;
+  Spinlock snapshot_callbacks_lock;
+
   // period with which it collects log records from backend loggers
   int wait_timeout;
 
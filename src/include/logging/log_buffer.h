@@ -25,6 +25,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <memory>
 
@@ -39,6 +40,11 @@ class BackendLogger;
 //===--------------------------------------------------------------------===//
 // Log Buffer
 //===--------------------------------------------------------------------===//
+
+// The worker that owns a buffer writes its records in place: it reserves a
+// range of the buffer, serializes the record into it, and publishes it. The
+// frontend logger seals the buffer to take it over as it is, which stops
+// new reservations and waits for the reserved records to be published.
 class LogBuffer {
  public:
   LogBuffer(BackendLogger *);
@@ -51,6 +57,25 @@ class LogBuffer {
   // serialize and write a log record to buffer
   bool WriteRecord(LogRecord *);
 
+  // reserve room for a record, return nullptr if the buffer is full or sealed
+  char *ReserveRecord(size_t len);
+
+  // make a record written in its reserved room visible to Seal
+  inline void PublishRecord(size_t len) {
+    published_size_.fetch_add(len, std::memory_order_release);
+  }
+
+  // stop the reservations, wait for the reserved records, and return the size
+  size_t Seal();
+
+  // open the buffer for the reservations, with room for a record of the
+  // given length
+  void Open(size_t len);
+
+  inline size_t GetReservedSize() {
+    return reserved_size_.load() & ~SEALED_BUFFER_FLAG;
+  }
+
   // clean up and reset content
   void ResetData();
 
@@ -71,9 +96,18 @@ class LogBuffer {
   // write data to the log buffer, return false if not enough space
   bool WriteData(char *data, size_t len);
 
+  // set in the reserved size once the buffer is sealed
+  static constexpr size_t SEALED_BUFFER_FLAG = ~(~size_t(0) >> 1);
+
   // the size of buffer used already
   size_t size_ = 0;
 
+  // the size of the reserved records
+  std::atomic<size_t> reserved_size_;
+
+  // the size of the published records
+  std::atomic<size_t> published_size_;
+
   // the total capacity of the buffer
   size_t capacity_;
 
@@ -13,8 +13,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include <map>
+#include <thread>
 #include <vector>
 
 #include "logging/logger.h"
@@ -108,6 +110,16 @@ class LogManager {
   // wait for the flush of a frontend logger (for worker thread)
   void WaitForFlush(cid_t cid);
 
+  // run the callback once the log is flushed up to the given commit id,
+  // without blocking the worker thread
+  void ReleaseOnFlush(cid_t commit_id,
+                      const concurrency::CommitCallback &callback);
+
+  // run the callback of a read-only txn once every commit in its snapshot
+  // is durable, without blocking the worker thread
+  void ReleaseSnapshotOnFlush(cid_t snapshot_cid,
+                              const concurrency::CommitCallback &callback);
+
   // get the current persistent flushed commit
   cid_t GetPersistentFlushedCommitId();
 
@@ -186,8 +198,11 @@ class LogManager {
   // log a delete
   void LogDelete(cid_t commit_id, const ItemPointer &delete_location);
 
-  // commit a transaction and wait until stable
-  void LogCommitTransaction(cid_t commit_id);
+  // commit a transaction and wait until stable. if synchronous commit is off,
+  // return right away and run the callback once the commit is stable.
+  void LogCommitTransaction(cid_t commit_id,
+                            const concurrency::CommitCallback &callback =
+                                concurrency::CommitCallback());
 
   // used by the checkpointer to truncate unneeded log files
   void TruncateLogs(txn_id_t commit_id);
@@ -241,6 +256,17 @@ class LogManager {
 
   inline bool GetNoWrite() const { return no_write_; }
 
+  // get the number of threads that replay the log and rebuild the indexes
+  inline unsigned int GetRecoveryThreadCount() const {
+    return recovery_thread_count_;
+  }
+
+  // set the number of threads that replay the log and rebuild the indexes,
+  // shared by all frontend loggers
+  inline void SetRecoveryThreadCount(unsigned int recovery_thread_count) {
+    recovery_thread_count_ = recovery_thread_count;
+  }
+
  private:
   LogManager();
   ~LogManager();
@@ -295,6 +321,9 @@ class LogManager {
   bool syncronization_commit =
       true;  // default should be true because it is safest
 
+  // largest commit id logged so far
+  std::atomic<cid_t> max_logged_commit_id{0};
+
   // name of log file (for wbl)
   std::string log_file_name;
 
@@ -311,10 +340,11 @@ class LogManager {
   // and cid
   int update_managers_count = 0;
 
-  bool replicating_ = false;
-
   bool no_write_ = false;
 
+  // one recovery thread per core by default
+  unsigned int recovery_thread_count_ = std::thread::hardware_concurrency();
+
   // max oid after recovery
   oid_t max_oid = 0;
 
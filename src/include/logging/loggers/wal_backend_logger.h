@@ -37,6 +37,15 @@ class WriteAheadBackendLogger : public BackendLogger {
                             ItemPointer insert_location,
                             ItemPointer delete_location,
                             const void *data = nullptr);
+
+  void LogTupleRecord(LogRecordType log_record_type, cid_t commit_id,
+                      storage::TileGroup *tile_group,
+                      ItemPointer insert_location,
+                      ItemPointer delete_location);
+
+ private:
+  // Get the write ahead record type of a tuple record
+  static LogRecordType GetWriteAheadRecordType(LogRecordType log_record_type);
 };
 
 }  // namespace logging
@@ -32,6 +32,10 @@ namespace concurrency {
 class Transaction;
 }
 
+namespace index {
+class Index;
+}
+
 namespace logging {
 
 typedef std::chrono::high_resolution_clock Clock;
@@ -47,7 +51,7 @@ class WriteAheadFrontendLogger : public FrontendLogger {
  public:
   WriteAheadFrontendLogger(void);
 
-  WriteAheadFrontendLogger(bool for_testing);
+  WriteAheadFrontendLogger(bool for_testing, int logger_id = 0);
 
   WriteAheadFrontendLogger(std::string log_dir);
 
@@ -63,6 +67,8 @@ class WriteAheadFrontendLogger : public FrontendLogger {
 
   void RecoverIndex();
 
+  void ReplayRecoveryPartitions();
+
   void StartTransactionRecovery(cid_t commit_id);
 
   void CommitTransactionRecovery(cid_t commit_id);
@@ -105,14 +111,22 @@ class WriteAheadFrontendLogger : public FrontendLogger {
 
   static constexpr auto wal_directory_path = "wal_log";
 
+  // the directory, relative to the log directory, of a log stream
+  static std::string GetStreamDirectoryName(int logger_id);
+
  private:
   std::string GetLogFileName(void);
 
+  // Give the versions visible at start_cid the indirections the indexes of
+  // the table point to
+  void RecoverTableIndirections(storage::DataTable *target_table,
+                                cid_t start_cid);
+
   bool RecoverTableIndexHelper(storage::DataTable *target_table,
-                               cid_t start_cid);
+                               index::Index *target_index, cid_t start_cid);
 
-  void InsertIndexEntry(storage::Tuple *tuple, storage::DataTable *table,
-                        ItemPointer target_location);
+  void InsertIndexEntry(storage::Tuple *key, index::Index *index,
+                        ItemPointer *indirection);
 
   //===--------------------------------------------------------------------===//
   // Member Variables
@@ -124,6 +138,13 @@ class WriteAheadFrontendLogger : public FrontendLogger {
   // Txn table during recovery
   std::map<txn_id_t, std::vector<TupleRecord *>> recovery_txn_table;
 
+  // Records of committed txns waiting to be replayed, partitioned by the tile
+  // group they modify. Each partition is replayed by its own thread.
+  std::vector<std::vector<TupleRecord *>> recovery_partitions_;
+
+  // number of records in all the recovery partitions
+  size_t recovery_partition_size_ = 0;
+
   // Keep tracking max oid for setting next_oid in manager
   // For active processing after recovery
   oid_t max_oid = 0;
@@ -46,6 +46,14 @@ class WriteBehindBackendLogger : public BackendLogger {
                             ItemPointer delete_location,
                             const void *data = nullptr);
 
+  // the records only carry the locations to sync, so they are still built
+  void LogTupleRecord(LogRecordType log_record_type, cid_t commit_id,
+                      storage::TileGroup *tile_group,
+                      ItemPointer insert_location,
+                      ItemPointer delete_location);
+
+  void LogTransactionRecord(LogRecordType log_record_type, cid_t commit_id);
+
   void CollectRecordsAndClear(
       std::vector<std::unique_ptr<LogRecord>> &frontend_queue);
 
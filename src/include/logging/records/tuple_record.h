@@ -64,6 +64,13 @@ class TupleRecord : public LogRecord, Printable {
 
   void SerializeHeader(CopySerializeOutput &output);
 
+  // Serialize the header of a tuple record without building the record
+  static void SerializeHeader(CopySerializeOutput &output,
+                              LogRecordType log_record_type, oid_t db_oid,
+                              oid_t table_oid, cid_t cid,
+                              const ItemPointer &insert_location,
+                              const ItemPointer &delete_location);
+
   void DeserializeHeader(CopySerializeInput &input);
 
   //===--------------------------------------------------------------------===//
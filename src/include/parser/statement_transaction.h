@@ -19,7 +19,8 @@ namespace parser {
 
 /**
  * @struct TransactionStatement
- * @brief Represents "BEGIN or COMMIT or ROLLBACK [TRANSACTION]"
+ * @brief Represents "BEGIN [TRANSACTION] [READ ONLY]" or
+ * "COMMIT or ROLLBACK [TRANSACTION]"
  */
 struct TransactionStatement : SQLStatement {
   enum CommandType {
@@ -32,6 +33,9 @@ struct TransactionStatement : SQLStatement {
       : SQLStatement(STATEMENT_TYPE_TRANSACTION), type(type) {}
 
   CommandType type;
+
+  // Only set for BEGIN
+  bool read_only = false;
 };
 
 }  // End parser namespace
@@ -22,6 +22,7 @@
 #include "statistics/latency_metric.h"
 #include "statistics/database_metric.h"
 #include "statistics/query_metric.h"
+#include "statistics/version_chain_metric.h"
 #include "container/cuckoo_map.h"
 #include "container/lock_free_queue.h"
 
@@ -75,6 +76,9 @@ class BackendStatsContext {
   // Returns the latency metric
   LatencyMetric& GetTxnLatencyMetric();
 
+  // Returns the version chain metric
+  VersionChainMetric& GetVersionChainMetric();
+
   // Increment the read stat for given tile group
   void IncrementTableReads(oid_t tile_group_id);
 
@@ -106,6 +110,12 @@ class BackendStatsContext {
   // Increment the abortion stat for given database
   void IncrementTxnAborted(oid_t database_id);
 
+  // Record the length of a traversed version chain
+  void RecordVersionChainLength(size_t chain_length);
+
+  // Increment the pruned version stat by prune_count
+  void IncrementPrunedVersions(size_t prune_count);
+
   // Initialize the query stat
   void InitQueryMetric(std::string query_string, oid_t database_oid);
 
@@ -165,6 +175,9 @@ class BackendStatsContext {
   // Latencies recorded by this worker
   LatencyMetric txn_latencies_;
 
+  // Version chains traversed by this worker
+  VersionChainMetric version_chain_metric_;
+
   // Whether this context is registered to the global aggregator
   bool is_registered_to_aggregator_;
 
@@ -0,0 +1,101 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// gc_metric.h
+//
+// Identification: src/include/statistics/gc_metric.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <sstream>
+
+#include "common/types.h"
+#include "statistics/abstract_metric.h"
+
+namespace peloton {
+
+namespace gc {
+class GCManager;
+}
+
+namespace stats {
+
+/**
+ * Metric for the garbage collector: how much garbage is waiting to be
+ * unlinked and reclaimed, how fast the versions are reclaimed, and how many
+ * GC threads the garbage is handed to. Unlike the other metrics, it is not
+ * collected by the workers but sampled from the GC.
+ */
+class GCMetric : public AbstractMetric {
+ public:
+  GCMetric(MetricType type);
+
+  //===--------------------------------------------------------------------===//
+  // ACCESSORS
+  //===--------------------------------------------------------------------===//
+
+  // Sample the backlog of the GC, and the rate at which the versions were
+  // reclaimed since the previous sample
+  void Sample(gc::GCManager &gc_manager, double interval_seconds);
+
+  inline size_t GetUnlinkBacklog() const { return unlink_backlog_; }
+
+  inline size_t GetReclaimBacklog() const { return reclaim_backlog_; }
+
+  inline size_t GetReclaimedVersions() const { return reclaimed_versions_; }
+
+  inline double GetReclaimRate() const { return reclaim_rate_; }
+
+  inline cid_t GetOldestUnreclaimedCid() const {
+    return oldest_unreclaimed_cid_;
+  }
+
+  inline size_t GetDeadVersionBytes() const { return dead_version_bytes_; }
+
+  inline int GetActiveThreadCount() const { return active_thread_count_; }
+
+  //===--------------------------------------------------------------------===//
+  // HELPER METHODS
+  //===--------------------------------------------------------------------===//
+
+  void Reset();
+
+  void Aggregate(AbstractMetric &source);
+
+  const std::string GetInfo() const;
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // MEMBERS
+  //===--------------------------------------------------------------------===//
+
+  // Garbage contexts waiting to be unlinked from the indexes
+  size_t unlink_backlog_ = 0;
+
+  // Unlinked garbage contexts waiting to be reclaimed
+  size_t reclaim_backlog_ = 0;
+
+  // Versions reclaimed since the start
+  size_t reclaimed_versions_ = 0;
+
+  // Versions reclaimed per second over the last interval
+  double reclaim_rate_ = 0;
+
+  // Timestamp of the oldest garbage that was not reclaimed yet
+  cid_t oldest_unreclaimed_cid_ = MAX_CID;
+
+  // Bytes held by the garbage the GC threads picked up
+  size_t dead_version_bytes_ = 0;
+
+  // GC threads the garbage is handed to
+  int active_thread_count_ = 0;
+};
+
+}  // namespace stats
+}  // namespace peloton
@@ -24,6 +24,7 @@
 #include "common/logger.h"
 #include "common/macros.h"
 #include "statistics/backend_stats_context.h"
+#include "statistics/gc_metric.h"
 #include "storage/database.h"
 #include "storage/data_table.h"
 #include "concurrency/transaction.h"
@@ -78,6 +79,9 @@ class StatsAggregator {
   // Get the current aggregated stats of all threads (including history)
   inline BackendStatsContext &GetAggregatedStats() { return aggregated_stats_; }
 
+  // Get the GC stats sampled at the last aggregation
+  inline GCMetric &GetGCMetric() { return gc_metric_; }
+
   //===--------------------------------------------------------------------===//
   // HELPER FUNCTIONS
   //===--------------------------------------------------------------------===//
@@ -114,6 +118,9 @@ class StatsAggregator {
   // Stores all aggregated stats
   BackendStatsContext aggregated_stats_;
 
+  // Stores the GC stats, which are sampled from the GC manager
+  GCMetric gc_metric_{GC_METRIC};
+
   // Protect register and unregister of BackendStatsContext*
   std::mutex stats_mutex_{};
 
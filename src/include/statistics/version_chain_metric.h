@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// version_chain_metric.h
+//
+// Identification: src/include/statistics/version_chain_metric.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <sstream>
+#include <vector>
+
+#include "common/types.h"
+#include "statistics/counter_metric.h"
+#include "statistics/abstract_metric.h"
+
+// number of buckets of the chain length histogram. bucket i counts the chains
+// of 2^i to 2^(i+1) - 1 versions, the last one counts all the longer chains.
+#define VERSION_CHAIN_HISTOGRAM_BUCKETS 8
+
+namespace peloton {
+namespace stats {
+
+/**
+ * Metric for the version chains traversed by the reads: a histogram of their
+ * lengths, and the number of old versions pruned from them.
+ */
+class VersionChainMetric : public AbstractMetric {
+ public:
+  VersionChainMetric(MetricType type);
+
+  //===--------------------------------------------------------------------===//
+  // ACCESSORS
+  //===--------------------------------------------------------------------===//
+
+  // Count a traversed chain in the bucket of its length
+  inline void RecordChainLength(size_t chain_length) {
+    size_t bucket = 0;
+    while (chain_length > 1 && bucket + 1 < VERSION_CHAIN_HISTOGRAM_BUCKETS) {
+      chain_length >>= 1;
+      bucket++;
+    }
+    chain_lengths_[bucket].Increment();
+  }
+
+  inline void IncrementPrunedVersions(size_t count) {
+    pruned_versions_.Increment(count);
+  }
+
+  inline CounterMetric &GetChainLengthCount(size_t bucket) {
+    return chain_lengths_[bucket];
+  }
+
+  inline CounterMetric &GetPrunedVersions() { return pruned_versions_; }
+
+  //===--------------------------------------------------------------------===//
+  // HELPER METHODS
+  //===--------------------------------------------------------------------===//
+
+  inline void Reset() {
+    for (auto &chain_length_count : chain_lengths_) {
+      chain_length_count.Reset();
+    }
+    pruned_versions_.Reset();
+  }
+
+  void Aggregate(AbstractMetric &source);
+
+  const std::string GetInfo() const;
+
+ private:
+  //===--------------------------------------------------------------------===//
+  // MEMBERS
+  //===--------------------------------------------------------------------===//
+
+  // Count of the traversed chains in each bucket of length
+  std::vector<CounterMetric> chain_lengths_;
+
+  // Count of the old versions unlinked by the workers
+  CounterMetric pruned_versions_{MetricType::COUNTER_METRIC};
+};
+
+}  // namespace stats
+}  // namespace peloton
@@ -38,6 +38,10 @@ extern std::vector<peloton::oid_t> sdbench_column_ids;
 
 const int ACTIVE_TILEGROUP_COUNT = 1;
 
+// active tile groups of a table that hands every inserting thread its own.
+// the threads beyond that many share them.
+const int PER_THREAD_TILEGROUP_COUNT = 64;
+
 const int ACTIVE_INDIRECTION_ARRAY_COUNT = 1;
 
 
@@ -132,7 +136,8 @@ class DataTable : public AbstractTable {
 
   void AddTileGroup(const std::shared_ptr<TileGroup> &tile_group);
 
-  // Offset is a 0-based number local to the table
+  // Offset is a 0-based number local to the table. Offsets are stable: a
+  // dropped tile group leaves a hole, for which nullptr is returned.
   std::shared_ptr<storage::TileGroup> GetTileGroup(
       const std::size_t &tile_group_offset) const;
 
@@ -142,9 +147,21 @@ class DataTable : public AbstractTable {
 
   size_t GetTileGroupCount() const;
 
+  // Drop a tile group that holds no version anymore. Used by compaction
+  void DropTileGroup(const std::size_t &tile_group_offset);
+
   // Get a tile group with given layout
   TileGroup *GetTileGroupWithLayout(const column_map_type &partitioning);
 
+  // Hand every inserting thread an active tile group of its own, so that
+  // concurrent inserts neither claim slots in the same tile group nor wait
+  // for the same full tile group to be replaced
+  inline void SetPerThreadInsertion(bool per_thread_insertion) {
+    per_thread_insertion_ = per_thread_insertion;
+  }
+
+  inline bool GetPerThreadInsertion() const { return per_thread_insertion_; }
+
   //===--------------------------------------------------------------------===//
   // INDEX
   //===--------------------------------------------------------------------===//
@@ -244,6 +261,10 @@ class DataTable : public AbstractTable {
                        concurrency::Transaction *transaction, 
                        ItemPointer **index_entry_ptr);
 
+  // allocate the index entry that holds the location of a version chain
+  // header. the indexes of the table point to it.
+  ItemPointer *AllocateIndirection(const ItemPointer &location);
+
  protected:
 
   //===--------------------------------------------------------------------===//
@@ -262,6 +283,9 @@ class DataTable : public AbstractTable {
   // add a tile group to the table. replace the active_tile_group_id-th active tile group.
   oid_t AddDefaultTileGroup(const size_t &active_tile_group_id);
 
+  // get the active tile group the calling thread inserts into
+  size_t GetActiveTileGroupId();
+
   oid_t AddDefaultIndirectionArray(const size_t &active_indirection_array_id);
   
   // get a partitioning with given layout type
@@ -292,7 +316,14 @@ class DataTable : public AbstractTable {
   // TILE GROUPS
   LockFreeArray<oid_t> tile_groups_;
 
-  std::shared_ptr<storage::TileGroup> active_tile_groups_[ACTIVE_TILEGROUP_COUNT];
+  // the first ACTIVE_TILEGROUP_COUNT are shared by all the inserting threads.
+  // with per-thread insertion, each thread inserts into the one it hashes to,
+  // which is created on its first insert. a slot is read and replaced with
+  // std::atomic_load and std::atomic_store, as the threads that hash to it
+  // share it.
+  std::shared_ptr<storage::TileGroup> active_tile_groups_[PER_THREAD_TILEGROUP_COUNT];
+
+  std::atomic<bool> per_thread_insertion_ = ATOMIC_VAR_INIT(false);
 
   std::atomic<size_t> tile_group_count_ = ATOMIC_VAR_INIT(0);
 
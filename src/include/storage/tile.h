@@ -18,6 +18,7 @@
 #include "common/serializer.h"
 #include "common/serializeio.h"
 #include "common/varlen_pool.h"
+#include "common/typed_value.h"
 #include "common/printable.h"
 
 #include <mutex>
@@ -82,6 +83,12 @@ class Tile : public Printable {
    */
   common::Value *GetValue(const oid_t tuple_offset, const oid_t column_id);
 
+  /**
+   * Returns a view of the value present at slot, without allocating
+   */
+  common::TypedValue GetTypedValue(const oid_t tuple_offset,
+                                   const oid_t column_id) const;
+
   /*
    * Faster way to get value
    * By amortizing schema lookups
@@ -22,8 +22,10 @@
 
 #include "common/types.h"
 #include "common/value.h"
+#include "common/typed_value.h"
 #include "common/printable.h"
 #include "common/varlen_pool.h"
+#include "storage/zone_map.h"
 
 namespace peloton {
 
@@ -163,10 +165,20 @@ class TileGroup : public Printable {
 
   common::Value *GetValue(oid_t tuple_id, oid_t column_id);
 
+  common::TypedValue GetTypedValue(oid_t tuple_id, oid_t column_id);
+
   void SetValue(common::Value &value, oid_t tuple_id, oid_t column_id);
 
   double GetSchemaDifference(const storage::column_map_type &new_column_map);
 
+  // Get the zone map of the tile group, rebuilding it first if it was
+  // invalidated
+  const ZoneMap &GetZoneMap();
+
+  // To be called after writing to the tiles without going through the tile
+  // group
+  void InvalidateZoneMap() { zone_map->Invalidate(); }
+
   // Sync the contents
   void Sync();
 
@@ -206,6 +218,9 @@ class TileGroup : public Printable {
   // column to tile mapping :
   // <column offset> to <tile offset, tile column offset>
   column_map_type column_map;
+
+  // per-column min/max summary used to skip the tile group in scans
+  std::unique_ptr<ZoneMap> zone_map;
 };
 
 }  // End storage namespace
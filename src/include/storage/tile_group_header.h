@@ -78,6 +78,10 @@ class TileGroupHeader : public Printable {
     num_tuple_slots = other.num_tuple_slots;
     oid_t val = other.next_tuple_slot;
     next_tuple_slot = val;
+    cid_t modified_cid = other.modified_commit_id;
+    modified_commit_id = modified_cid;
+    bool immutable = other.immutable;
+    this->immutable = immutable;
 
     return *this;
   }
@@ -130,6 +134,27 @@ class TileGroupHeader : public Printable {
 
   oid_t GetActiveTupleCount();
 
+  // the latest commit id that created or invalidated a version in this tile
+  // group. incremental checkpoints skip the tile groups that were not
+  // modified since the previous checkpoint.
+  inline cid_t GetModifiedCommitId() const { return modified_commit_id; }
+
+  inline void SetModifiedCommitId(const cid_t &commit_id) {
+    cid_t current_cid = modified_commit_id;
+    while (current_cid < commit_id &&
+           modified_commit_id.compare_exchange_weak(current_cid, commit_id) ==
+               false) {
+    }
+  }
+
+  // an immutable tile group is being compacted. its free slots are not
+  // reused, so that it empties out and can be dropped.
+  inline bool GetImmutability() const { return immutable; }
+
+  inline void SetImmutability() { immutable = true; }
+
+  inline TileGroup *GetTileGroup() const { return tile_group; }
+
   //===--------------------------------------------------------------------===//
   // MVCC utilities
   //===--------------------------------------------------------------------===//
@@ -217,6 +242,24 @@ class TileGroupHeader : public Printable {
                                         transaction_id);
   }
 
+  inline bool SetAtomicEndCommitId(const oid_t &tuple_slot_id,
+                                   const cid_t &old_end_cid,
+                                   const cid_t &new_end_cid) const {
+    cid_t *end_cid_ptr = (cid_t *)(TUPLE_HEADER_LOCATION + end_cid_offset);
+    return __sync_bool_compare_and_swap(end_cid_ptr, old_end_cid,
+                                        new_end_cid);
+  }
+
+  inline bool SetAtomicNextItemPointer(const oid_t &tuple_slot_id,
+                                       const ItemPointer &old_item,
+                                       const ItemPointer &new_item) const {
+    int64_t *item_ptr =
+        (int64_t *)(TUPLE_HEADER_LOCATION + next_pointer_offset);
+    return __sync_bool_compare_and_swap(
+        item_ptr, *reinterpret_cast<const int64_t *>(&old_item),
+        *reinterpret_cast<const int64_t *>(&new_item));
+  }
+
   void PrintVisibility(txn_id_t txn_id, cid_t at_cid);
 
   // Getter for spin lock
@@ -271,6 +314,12 @@ class TileGroupHeader : public Printable {
   // IT MAY OUT OF BOUNDARY! ALWAYS CHECK IF IT EXCEEDS num_tuple_slots
   std::atomic<oid_t> next_tuple_slot;
 
+  // latest commit id that modified the tile group
+  std::atomic<cid_t> modified_commit_id;
+
+  // whether the tile group is being compacted
+  std::atomic<bool> immutable;
+
   Spinlock tile_header_lock;
 };
 
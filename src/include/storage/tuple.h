@@ -105,6 +105,9 @@ class Tuple : public AbstractTuple {
   // (expensive) checks the schema to see how to return the Value.
   common::Value *GetValue(oid_t column_id) const;
 
+  // Get a view of the value at given column id without materializing it
+  common::TypedValue GetTypedValue(oid_t column_id) const;
+
   /**
    * Allocate space to copy strings that can't be inlined rather
    * than copying the pointer.
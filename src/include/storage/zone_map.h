@@ -0,0 +1,96 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map.h
+//
+// Identification: src/include/storage/zone_map.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "common/typed_value.h"
+#include "common/types.h"
+
+namespace peloton {
+namespace storage {
+
+//===--------------------------------------------------------------------===//
+// Zone Map
+//===--------------------------------------------------------------------===//
+
+/**
+ * Per-column summary (min, max and null count) of the values stored in a
+ * tile group, used by the scans to skip tile groups that cannot match.
+ *
+ * The summary covers every version in the tile group, visible or not. It is
+ * widened on every write and never narrowed, so it is always conservative.
+ * Writers that bypass the tile group invalidate it and the tile group rebuilds
+ * it lazily the next time it is asked for.
+ *
+ * Only fixed-width, ordered types are summarized. Other columns never allow a
+ * tile group to be skipped.
+ */
+class ZoneMap {
+  ZoneMap(ZoneMap const &) = delete;
+
+ public:
+  ZoneMap(const std::vector<common::Type::TypeId> &column_types);
+
+  // Whether the values of the column are summarized
+  bool IsSummarized(oid_t column_id) const;
+
+  // Widen the summary of a column with a value written to the tile group
+  void Update(oid_t column_id, const common::TypedValue &value);
+
+  // Whether the summary covers the contents of the tile group
+  bool IsValid() const { return valid_.load(); }
+
+  void Invalidate() { valid_ = false; }
+
+  void Validate() { valid_ = true; }
+
+  // Whether some value of the column may satisfy "column <op> constant".
+  // Only comparison operators are understood; anything else may match.
+  bool MayMatch(oid_t column_id, ExpressionType op,
+                const common::TypedValue &constant) const;
+
+  // Get the smallest and the largest values written to the column. Returns
+  // false if the column is not summarized or holds no non-null value.
+  bool GetMinMax(oid_t column_id, common::TypedValue &min,
+                 common::TypedValue &max) const;
+
+  // Number of NULL values written to the column. As overwritten values are
+  // not subtracted, this is an upper bound on the NULLs in the tile group.
+  oid_t GetNullCount(oid_t column_id) const;
+
+  oid_t GetColumnCount() const { return column_count_; }
+
+ private:
+  struct ColumnSummary {
+    common::Type::TypeId type_id;
+
+    // Bounds are kept as order-preserving 64-bit keys so that they can be
+    // widened with a CAS. min > max means that nothing was written.
+    std::atomic<int64_t> min;
+    std::atomic<int64_t> max;
+
+    std::atomic<oid_t> null_count;
+  };
+
+  oid_t column_count_;
+
+  std::unique_ptr<ColumnSummary[]> columns_;
+
+  std::atomic<bool> valid_;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -40,17 +40,21 @@ class TrafficCop {
   ~TrafficCop();
 
   // PortalExec - Execute query string
+  // A read_only query runs in a declared read-only transaction, and fails
+  // without running if it writes anything
   Result ExecuteStatement(const std::string &query,
                           std::vector<ResultType> &result,
                           std::vector<FieldInfoType> &tuple_descriptor,
-                          int &rows_changed, std::string &error_message);
+                          int &rows_changed, std::string &error_message,
+                          const bool read_only = false);
 
   // ExecPrepStmt - Execute a statement from a prepared and bound statement
   Result ExecuteStatement(const std::shared_ptr<Statement> &statement,
                           const bool unnamed,
                           const std::vector<int> &result_format,
                           std::vector<ResultType> &result, int &rows_change,
-                          std::string &error_message);
+                          std::string &error_message,
+                          const bool read_only = false);
 
   // InitBindPrepStmt - Prepare and bind a query from a query string
   std::shared_ptr<Statement> PrepareStatement(const std::string &statement_name,
@@ -107,6 +107,11 @@ class PacketManager {
    */
   bool HardcodedExecuteFilter(std::string query_type);
 
+  /* Track whether the current txn block was opened with BEGIN READ ONLY,
+   * whose statements then run in read-only transactions
+   */
+  void UpdateTxnReadOnly(const Statement& statement);
+
   /* Execute a Simple query protocol message */
   void ExecQueryMessage(Packet* pkt, ResponseBuffer& responses);
 
@@ -137,6 +142,9 @@ class PacketManager {
   // gloabl txn state
   uchar txn_state_;
 
+  // whether the txn block is read-only
+  bool txn_read_only_ = false;
+
   // state to mang skipped queries
   bool skipped_stmt_ = false;
   std::string skipped_query_string_;
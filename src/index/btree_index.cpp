@@ -10,6 +10,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+
 #include "index/btree_index.h"
 #include "index/index_key.h"
 #include "index/index_util.h"
@@ -65,29 +67,7 @@ bool BTREE_TEMPLATE_TYPE::DeleteEntry(const storage::Tuple *key,
   {
     index_lock.WriteLock();
 
-    // Delete the < key, location > pair
-    bool try_again = true;
-    while (try_again == true) {
-      // Unset try again
-      try_again = false;
-
-      // Lookup matching entries
-      auto entries = container.equal_range(index_key);
-      for (auto iterator = entries.first; iterator != entries.second;
-           iterator++) {
-        ValueType ret_value = iterator->second;
-
-        if (ret_value == value) {
-          container.erase(iterator);
-          // We could not proceed here since erase() may invalidate
-          // iterators by one or more node merge
-          try_again = true;
-          delete_count++;
-
-          break;
-        }
-      }
-    }
+    delete_count = DeleteFromContainer(index_key, value);
 
     index_lock.Unlock();
   }
@@ -99,6 +79,73 @@ bool BTREE_TEMPLATE_TYPE::DeleteEntry(const storage::Tuple *key,
   return true;
 }
 
+BTREE_TEMPLATE_ARGUMENT
+void BTREE_TEMPLATE_TYPE::DeleteEntries(
+    const std::vector<std::pair<const storage::Tuple *, ItemPointer *>> &
+        entries) {
+  std::vector<std::pair<KeyType, ValueType>> index_entries(entries.size());
+  for (size_t entry_idx = 0; entry_idx < entries.size(); entry_idx++) {
+    index_entries[entry_idx].first.SetFromKey(entries[entry_idx].first);
+    index_entries[entry_idx].second = entries[entry_idx].second;
+  }
+
+  // the deletions of neighbouring keys go down the same path of the tree
+  std::sort(index_entries.begin(), index_entries.end(),
+            [this](const std::pair<KeyType, ValueType> &lhs,
+                   const std::pair<KeyType, ValueType> &rhs) {
+              return comparator(lhs.first, rhs.first);
+            });
+
+  size_t delete_count = 0;
+
+  {
+    index_lock.WriteLock();
+
+    for (auto &index_entry : index_entries) {
+      delete_count += DeleteFromContainer(index_entry.first, index_entry.second);
+    }
+
+    index_lock.Unlock();
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexDeletes(
+        delete_count, metadata);
+  }
+}
+
+BTREE_TEMPLATE_ARGUMENT
+size_t BTREE_TEMPLATE_TYPE::DeleteFromContainer(const KeyType &index_key,
+                                                ValueType value) {
+  size_t delete_count = 0;
+
+  // Delete the < key, location > pair
+  bool try_again = true;
+  while (try_again == true) {
+    // Unset try again
+    try_again = false;
+
+    // Lookup matching entries
+    auto entries = container.equal_range(index_key);
+    for (auto iterator = entries.first; iterator != entries.second;
+         iterator++) {
+      ValueType ret_value = iterator->second;
+
+      if (ret_value == value) {
+        container.erase(iterator);
+        // We could not proceed here since erase() may invalidate
+        // iterators by one or more node merge
+        try_again = true;
+        delete_count++;
+
+        break;
+      }
+    }
+  }
+
+  return delete_count;
+}
+
 BTREE_TEMPLATE_ARGUMENT
 bool BTREE_TEMPLATE_TYPE::CondInsertEntry(const storage::Tuple *key,
                                           ItemPointer *value,
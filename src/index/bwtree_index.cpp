@@ -10,6 +10,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+
 #include "common/logger.h"
 #include "common/config.h"
 #include "index/bwtree_index.h"
@@ -89,6 +91,35 @@ bool BWTREE_INDEX_TYPE::DeleteEntry(const storage::Tuple *key,
   return ret;
 }
 
+/*
+ * DeleteEntries() - Removes a batch of key-value pairs
+ *
+ * The batch is sorted by key, and then deleted within a single epoch
+ */
+BWTREE_TEMPLATE_ARGUMENTS
+void BWTREE_INDEX_TYPE::DeleteEntries(
+    const std::vector<std::pair<const storage::Tuple *, ItemPointer *>> &
+        entries) {
+  std::vector<std::pair<KeyType, ValueType>> items(entries.size());
+  for (size_t entry_idx = 0; entry_idx < entries.size(); entry_idx++) {
+    items[entry_idx].first.SetFromKey(entries[entry_idx].first);
+    items[entry_idx].second = entries[entry_idx].second;
+  }
+
+  std::sort(items.begin(), items.end(),
+            [this](const std::pair<KeyType, ValueType> &lhs,
+                   const std::pair<KeyType, ValueType> &rhs) {
+              return comparator(lhs.first, rhs.first);
+            });
+
+  size_t delete_count = container.DeleteBatch(items);
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexDeletes(
+        delete_count, metadata);
+  }
+}
+
 BWTREE_TEMPLATE_ARGUMENTS
 bool BWTREE_INDEX_TYPE::CondInsertEntry(
     const storage::Tuple *key, ItemPointer *value,
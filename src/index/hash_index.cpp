@@ -0,0 +1,293 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_index.cpp
+//
+// Identification: src/index/hash_index.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "index/hash_index.h"
+#include "index/index_key.h"
+#include "index/index_util.h"
+#include "index/scan_optimizer.h"
+#include "common/logger.h"
+#include "common/config.h"
+#include "storage/tuple.h"
+#include "statistics/stats_aggregator.h"
+
+namespace peloton {
+namespace index {
+
+#define HASH_INDEX_TEMPLATE_ARGUMENT                                   \
+  template <typename KeyType, typename ValueType, typename KeyHasher, \
+            typename KeyEqualityChecker>
+
+#define HASH_INDEX_TYPE \
+  HashIndex<KeyType, ValueType, KeyHasher, KeyEqualityChecker>
+
+HASH_INDEX_TEMPLATE_ARGUMENT
+constexpr size_t HASH_INDEX_TYPE::partition_count;
+
+HASH_INDEX_TEMPLATE_ARGUMENT
+HASH_INDEX_TYPE::HashIndex(IndexMetadata *metadata)
+    : Index(metadata), partitions(new Partition[partition_count]), hasher() {}
+
+HASH_INDEX_TEMPLATE_ARGUMENT
+HASH_INDEX_TYPE::~HashIndex() {}
+
+HASH_INDEX_TEMPLATE_ARGUMENT
+typename HASH_INDEX_TYPE::Partition &HASH_INDEX_TYPE::GetPartition(
+    const KeyType &key) {
+  // Fold the upper 32 bits of the hash into the lower 32 bits, so keys that
+  // only differ in the upper bits still spread, and pick the partition from
+  // bits 6-11 of the result (partition_count is 64)
+  size_t hash = hasher(key);
+  return partitions[(hash ^ (hash >> 32)) >> 6 & (partition_count - 1)];
+}
+
+/////////////////////////////////////////////////////////////////////
+// Mutating operations
+/////////////////////////////////////////////////////////////////////
+
+HASH_INDEX_TEMPLATE_ARGUMENT
+bool HASH_INDEX_TYPE::InsertEntry(const storage::Tuple *key,
+                                  ItemPointer *value) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  auto &partition = GetPartition(index_key);
+  {
+    PelotonWriteLock lock(partition.partition_lock);
+    partition.container.emplace(index_key, value);
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(metadata);
+  }
+
+  return true;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENT
+bool HASH_INDEX_TYPE::DeleteEntry(const storage::Tuple *key,
+                                  ItemPointer *value) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+  size_t delete_count = 0;
+
+  auto &partition = GetPartition(index_key);
+  {
+    PelotonWriteLock lock(partition.partition_lock);
+
+    // Delete the < key, location > pairs
+    auto entries = partition.container.equal_range(index_key);
+    for (auto iterator = entries.first; iterator != entries.second;) {
+      if (iterator->second == value) {
+        iterator = partition.container.erase(iterator);
+        delete_count++;
+      } else {
+        iterator++;
+      }
+    }
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexDeletes(
+        delete_count, metadata);
+  }
+  return true;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENT
+bool HASH_INDEX_TYPE::CondInsertEntry(
+    const storage::Tuple *key, ItemPointer *value,
+    std::function<bool(const void *)> predicate) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  auto &partition = GetPartition(index_key);
+  {
+    PelotonWriteLock lock(partition.partition_lock);
+
+    // find the <key, location> pair
+    auto entries = partition.container.equal_range(index_key);
+    for (auto entry = entries.first; entry != entries.second; ++entry) {
+      if (predicate(entry->second)) {
+        // this key is already visible or dirty in the index
+        return false;
+      }
+    }
+
+    // Insert the key, val pair
+    partition.container.emplace(index_key, value);
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexInserts(metadata);
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Scan operations
+/////////////////////////////////////////////////////////////////////
+
+HASH_INDEX_TEMPLATE_ARGUMENT
+void HASH_INDEX_TYPE::Scan(const std::vector<common::Value *> &value_list,
+                           const std::vector<oid_t> &tuple_column_id_list,
+                           const std::vector<ExpressionType> &expr_list,
+                           const ScanDirectionType &scan_direction,
+                           std::vector<ValueType> &result,
+                           const ConjunctionScanPredicate *csp_p) {
+  // First make sure all three components of the scan predicate are
+  // of the same length
+  // Since there is a 1-to-1 correspondense between these three vectors
+  PL_ASSERT(tuple_column_id_list.size() == expr_list.size());
+  PL_ASSERT(tuple_column_id_list.size() == value_list.size());
+
+  // This is a hack - we do not support backward scan
+  if (scan_direction == SCAN_DIRECTION_TYPE_INVALID) {
+    throw Exception("Invalid scan direction \n");
+  }
+
+  LOG_TRACE("Point Query = %d; Full Scan = %d ", csp_p->IsPointQuery(),
+            csp_p->IsFullIndexScan());
+
+  if (csp_p->IsPointQuery() == true) {
+    // A point query only needs the partition of its key
+    KeyType point_query_key;
+    point_query_key.SetFromKey(csp_p->GetPointQueryKey());
+
+    auto &partition = GetPartition(point_query_key);
+    PelotonReadLock lock(partition.partition_lock);
+
+    auto entries = partition.container.equal_range(point_query_key);
+    for (auto entry = entries.first; entry != entries.second; ++entry) {
+      result.push_back(entry->second);
+    }
+  } else {
+    // Ranges cannot be located in a hash table, so go over all the keys
+    ScanAllPartitions(value_list, tuple_column_id_list, expr_list, result);
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
+  return;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENT
+void HASH_INDEX_TYPE::ScanAllPartitions(
+    const std::vector<common::Value *> &value_list,
+    const std::vector<oid_t> &tuple_column_id_list,
+    const std::vector<ExpressionType> &expr_list,
+    std::vector<ValueType> &result) {
+  for (size_t partition_itr = 0; partition_itr < partition_count;
+       partition_itr++) {
+    auto &partition = partitions[partition_itr];
+    PelotonReadLock lock(partition.partition_lock);
+
+    for (auto &entry : partition.container) {
+      // Unpack the key as a standard tuple for comparison
+      auto scan_current_key = entry.first;
+      auto tuple =
+          scan_current_key.GetTupleForComparison(metadata->GetKeySchema());
+
+      if (Compare(tuple, tuple_column_id_list, expr_list, value_list) == true) {
+        result.push_back(entry.second);
+      }
+    }
+  }
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENT
+void HASH_INDEX_TYPE::ScanAllKeys(std::vector<ValueType> &result) {
+  for (size_t partition_itr = 0; partition_itr < partition_count;
+       partition_itr++) {
+    auto &partition = partitions[partition_itr];
+    PelotonReadLock lock(partition.partition_lock);
+
+    // scan all entries
+    for (auto &entry : partition.container) {
+      result.push_back(entry.second);
+    }
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
+}
+
+/**
+ * @brief Return all locations related to this key.
+ */
+HASH_INDEX_TEMPLATE_ARGUMENT
+void HASH_INDEX_TYPE::ScanKey(const storage::Tuple *key,
+                              std::vector<ValueType> &result) {
+  KeyType index_key;
+  index_key.SetFromKey(key);
+
+  auto &partition = GetPartition(index_key);
+  {
+    PelotonReadLock lock(partition.partition_lock);
+
+    // find the <key, location> pair
+    auto entries = partition.container.equal_range(index_key);
+    for (auto entry = entries.first; entry != entries.second; ++entry) {
+      result.push_back(entry->second);
+    }
+  }
+
+  if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
+    stats::BackendStatsContext::GetInstance()->IncrementIndexReads(
+        result.size(), metadata);
+  }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////
+
+HASH_INDEX_TEMPLATE_ARGUMENT
+size_t HASH_INDEX_TYPE::GetMemoryFootprint() {
+  // Each entry is a node holding the pair and a next pointer, plus one
+  // pointer per bucket
+  size_t footprint = sizeof(Partition) * partition_count;
+  for (size_t partition_itr = 0; partition_itr < partition_count;
+       partition_itr++) {
+    auto &partition = partitions[partition_itr];
+    PelotonReadLock lock(partition.partition_lock);
+
+    footprint += partition.container.size() *
+                 (sizeof(typename MapType::value_type) + sizeof(void *));
+    footprint += partition.container.bucket_count() * sizeof(void *);
+  }
+  return footprint;
+}
+
+HASH_INDEX_TEMPLATE_ARGUMENT
+std::string HASH_INDEX_TYPE::GetTypeName() const { return "Hash"; }
+
+// Explicit template instantiation
+
+template class HashIndex<GenericKey<4>, ItemPointer *, GenericHasher<4>,
+                         GenericEqualityChecker<4>>;
+template class HashIndex<GenericKey<8>, ItemPointer *, GenericHasher<8>,
+                         GenericEqualityChecker<8>>;
+template class HashIndex<GenericKey<16>, ItemPointer *, GenericHasher<16>,
+                         GenericEqualityChecker<16>>;
+template class HashIndex<GenericKey<64>, ItemPointer *, GenericHasher<64>,
+                         GenericEqualityChecker<64>>;
+template class HashIndex<GenericKey<256>, ItemPointer *, GenericHasher<256>,
+                         GenericEqualityChecker<256>>;
+
+template class HashIndex<TupleKey, ItemPointer *, TupleKeyHasher,
+                         TupleKeyEqualityChecker>;
+
+}  // End index namespace
+}  // End peloton namespace
@@ -148,6 +148,16 @@ Index::~Index() {
   return;
 }
 
+void Index::DeleteEntries(
+    const std::vector<std::pair<const storage::Tuple *, ItemPointer *>> &
+        entries) {
+  for (auto &entry : entries) {
+    DeleteEntry(entry.first, entry.second);
+  }
+
+  return;
+}
+
 void Index::ScanTest(const std::vector<common::Value *> &value_list,
                      const std::vector<oid_t> &tuple_column_id_list,
                      const std::vector<ExpressionType> &expr_list,
@@ -19,6 +19,7 @@
 #include "index/index_key.h"
 #include "index/btree_index.h"
 #include "index/bwtree_index.h"
+#include "index/hash_index.h"
 
 namespace peloton {
 namespace index {
@@ -89,6 +90,26 @@ Index *IndexFactory::GetInstance(IndexMetadata *metadata) {
           TupleKey, ItemPointer *, TupleKeyComparator, TupleKeyEqualityChecker,
           TupleKeyHasher, ItemPointerComparator, ItemPointerHashFunc>(metadata);
     }
+  } else if (index_type == INDEX_TYPE_HASH) {
+    if (key_size <= 4) {
+      return new HashIndex<GenericKey<4>, ItemPointer *, GenericHasher<4>,
+                           GenericEqualityChecker<4>>(metadata);
+    } else if (key_size <= 8) {
+      return new HashIndex<GenericKey<8>, ItemPointer *, GenericHasher<8>,
+                           GenericEqualityChecker<8>>(metadata);
+    } else if (key_size <= 16) {
+      return new HashIndex<GenericKey<16>, ItemPointer *, GenericHasher<16>,
+                           GenericEqualityChecker<16>>(metadata);
+    } else if (key_size <= 64) {
+      return new HashIndex<GenericKey<64>, ItemPointer *, GenericHasher<64>,
+                           GenericEqualityChecker<64>>(metadata);
+    } else if (key_size <= 256) {
+      return new HashIndex<GenericKey<256>, ItemPointer *, GenericHasher<256>,
+                           GenericEqualityChecker<256>>(metadata);
+    } else {
+      return new HashIndex<TupleKey, ItemPointer *, TupleKeyHasher,
+                           TupleKeyEqualityChecker>(metadata);
+    }
   } else {
     throw IndexException("Unsupported index scheme.");
   }
@@ -69,55 +69,89 @@ void BackendLogger::Log(LogRecord *record) {
   // Enqueue the serialized log record into the queue
   record->Serialize(output_buffer);
 
-  this->log_buffer_lock.Lock();
-  if (!log_buffer_) {
-    LOG_TRACE("Acquire the first log buffer in backend logger");
-    this->log_buffer_lock.Unlock();
-    std::unique_ptr<LogBuffer> new_buff =
-        std::move(available_buffer_pool_->Get());
-    this->log_buffer_lock.Lock();
-    log_buffer_ = std::move(new_buff);
-  }
-  // update max logged commit id
-  if (record->GetType() == LOGRECORD_TYPE_TRANSACTION_COMMIT) {
-    auto new_log_commit_id = record->GetTransactionId();
-    PL_ASSERT(new_log_commit_id > highest_logged_commit_message);
-    highest_logged_commit_message = new_log_commit_id;
-    logging_cid_lower_bound = INVALID_CID;
+  WriteRecord(record->GetType(), record->GetTransactionId(),
+              output_buffer.Data(), output_buffer.Size());
+}
+
+void BackendLogger::LogTransactionRecord(LogRecordType log_record_type,
+                                         cid_t commit_id) {
+  // same layout as TransactionRecord::Serialize
+  output_buffer.Reset();
+  output_buffer.WriteEnumInSingleByte(log_record_type);
+  size_t start = output_buffer.Position();
+  output_buffer.WriteInt(0);
+  output_buffer.WriteLong(commit_id);
+  output_buffer.WriteIntAt(start, static_cast<int32_t>(output_buffer.Position() -
+                                                       start - sizeof(int32_t)));
+
+  WriteRecord(log_record_type, commit_id, output_buffer.Data(),
+              output_buffer.Size());
+}
+
+/**
+ * @brief write a serialized record into the current log buffer
+ * The record is copied into the range reserved for it, and published. The
+ * lock is only taken when there is no room left in the buffer.
+ */
+void BackendLogger::WriteRecord(LogRecordType log_record_type,
+                                cid_t commit_id, const char *data,
+                                size_t len) {
+  LogBuffer *log_buffer = current_buffer_.load();
+  char *location =
+      (log_buffer != nullptr) ? log_buffer->ReserveRecord(len) : nullptr;
+
+  // the frontend may seal the new buffer before the worker reserves in it
+  while (location == nullptr) {
+    LOG_TRACE("Log buffer is full - Attempt to acquire a new one");
+    log_buffer = AcquireLogBuffer(len);
+    location = log_buffer->ReserveRecord(len);
   }
 
-  // update the max logged id for the current buffer
-  cid_t cur_log_id = record->GetTransactionId();
+  PL_MEMCPY(location, data, len);
 
-  // set if this is the max log_id seen so far
-  if (cur_log_id > max_log_id_buffer) {
-    log_buffer_->SetMaxLogId(cur_log_id);
-    max_log_id_buffer = cur_log_id;
+  // set if this is the max log_id seen so far. the frontend only reads it
+  // once the record is published.
+  if (commit_id > log_buffer->GetMaxLogId()) {
+    log_buffer->SetMaxLogId(commit_id);
   }
+  log_buffer->PublishRecord(len);
 
-  if (!log_buffer_->WriteRecord(record)) {
-    LOG_TRACE("Log buffer is full - Attempt to acquire a new one");
-    // put back a buffer
-    max_log_id_buffer = 0;  // reset
-    persist_buffer_pool_->Put(std::move(log_buffer_));
-    this->log_buffer_lock.Unlock();
-
-    // get a new one
-    std::unique_ptr<LogBuffer> new_buff =
-        std::move(available_buffer_pool_->Get());
-    this->log_buffer_lock.Lock();
-    log_buffer_ = std::move(new_buff);
-
-    // write to the new log buffer
-    auto success = log_buffer_->WriteRecord(record);
-    if (!success) {
-      LOG_ERROR("Write record to log buffer failed");
+  // update max logged commit id, once the commit record can be collected
+  if (log_record_type == LOGRECORD_TYPE_TRANSACTION_COMMIT) {
+    PL_ASSERT(commit_id > highest_logged_commit_message);
+    highest_logged_commit_message = commit_id;
+    logging_cid_lower_bound = INVALID_CID;
+  }
+}
+
+LogBuffer *BackendLogger::AcquireLogBuffer(size_t len) {
+  this->log_buffer_lock.Lock();
+  if (log_buffer_) {
+    if (log_buffer_->Seal() == 0) {
+      // an empty buffer is only too small for the record
+      log_buffer_->Open(len);
       this->log_buffer_lock.Unlock();
-      return;
+      return log_buffer_.get();
     }
+
+    // put back a buffer
+    current_buffer_ = nullptr;
+    persist_buffer_pool_->Put(std::move(log_buffer_));
   }
+  this->log_buffer_lock.Unlock();
+
+  // get a new one
+  std::unique_ptr<LogBuffer> new_buff =
+      std::move(available_buffer_pool_->Get());
+  new_buff->Open(len);
+  LogBuffer *log_buffer = new_buff.get();
 
+  this->log_buffer_lock.Lock();
+  log_buffer_ = std::move(new_buff);
+  current_buffer_ = log_buffer;
   this->log_buffer_lock.Unlock();
+
+  return log_buffer;
 }
 
 // used by the frontend logger to collect data on the current state of the
@@ -128,20 +162,30 @@ void BackendLogger::Log(LogRecord *record) {
 std::pair<cid_t, cid_t> BackendLogger::PrepareLogBuffers() {
   this->log_buffer_lock.Lock();
   std::pair<cid_t, cid_t> ret(INVALID_CID, INVALID_CID);
+
+  // the records of the commits read here were published before, so the
+  // buffer sealed next holds them
+  cid_t lower_bound = logging_cid_lower_bound;
+  cid_t highest_commit = highest_logged_commit_message;
+  bool has_records = (log_buffer_ && log_buffer_->GetReservedSize() > 0);
+
   // prepare the cid's seen so far
-  if (logging_cid_lower_bound != INVALID_CID ||
-      (log_buffer_ && log_buffer_->GetSize() > 0)) {
-    ret.second = highest_logged_commit_message;
-    if (logging_cid_lower_bound > highest_logged_commit_message) {
-      ret.first = logging_cid_lower_bound;
+  if (lower_bound != INVALID_CID || has_records) {
+    ret.second = highest_commit;
+    if (lower_bound > highest_commit) {
+      ret.first = lower_bound;
     }
   }
-  if (log_buffer_ && log_buffer_->GetSize() > 0) {
+  if (has_records) {
+    // take the buffer over as it is, once its reserved records are written
+    log_buffer_->Seal();
+    current_buffer_ = nullptr;
+
     // put back a buffer
     LOG_TRACE(
         "Move the current log buffer to buffer pool, "
         "highest_logged_commit_message: %d, logging_cid_lower_bound: %d",
-        (int)highest_logged_commit_message, (int)logging_cid_lower_bound);
+        (int)highest_commit, (int)lower_bound);
     persist_buffer_pool_->Put(std::move(log_buffer_));
   }
   this->log_buffer_lock.Unlock();
@@ -163,5 +207,43 @@ void BackendLogger::GrantEmptyBuffer(std::unique_ptr<LogBuffer> empty_buffer) {
 // set when the frontend logger is shutting down, prevents deadlock between
 // frontend and backend
 void BackendLogger::SetShutdown(bool val) { shutdown = val; }
+
+void BackendLogger::AddCommitCallback(
+    cid_t commit_id, const concurrency::CommitCallback &callback) {
+  commit_callbacks_lock.Lock();
+  commit_callbacks.emplace_back(commit_id, callback);
+  commit_callbacks_lock.Unlock();
+}
+
+/**
+ * @brief collect the callbacks of the durable commits
+ * Commit ids only grow within a worker, so the durable commits are at the
+ * front of the queue.
+ */
+void BackendLogger::CollectCommitCallbacks(
+    cid_t persistent_commit_id,
+    std::vector<concurrency::CommitCallback> &released) {
+  commit_callbacks_lock.Lock();
+  while (!commit_callbacks.empty() &&
+         commit_callbacks.front().first <= persistent_commit_id) {
+    released.push_back(std::move(commit_callbacks.front().second));
+    commit_callbacks.pop_front();
+  }
+  commit_callbacks_lock.Unlock();
+}
+
+/**
+ * @brief run the callbacks of the durable commits
+ * The callbacks run outside of the lock, on the thread that noticed the
+ * flush.
+ */
+void BackendLogger::ReleaseCommitCallbacks(cid_t persistent_commit_id) {
+  std::vector<concurrency::CommitCallback> released;
+  CollectCommitCallbacks(persistent_commit_id, released);
+
+  for (auto &callback : released) {
+    callback();
+  }
+}
 }  // namespace logging
 }
@@ -0,0 +1,629 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// fuzzy_checkpoint.cpp
+//
+// Identification: src/logging/checkpoint/fuzzy_checkpoint.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <sys/mman.h>
+#include <algorithm>
+#include <cstdio>
+#include <unordered_set>
+
+#include "logging/checkpoint/fuzzy_checkpoint.h"
+#include "logging/checkpoint_tile_scanner.h"
+#include "logging/checkpoint_manager.h"
+#include "logging/logging_util.h"
+
+#include "concurrency/transaction_manager_factory.h"
+#include "concurrency/transaction.h"
+#include "catalog/manager.h"
+#include "catalog/catalog.h"
+
+#include "common/logger.h"
+#include "common/macros.h"
+#include "common/types.h"
+#include "common/value.h"
+#include "common/varlen_pool.h"
+
+#include "storage/database.h"
+#include "storage/data_table.h"
+#include "storage/tile.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+
+// size of a scan thread's buffer before it is written to the checkpoint file
+#define CHECKPOINT_BUFFER_SIZE (1 << 20)
+
+namespace peloton {
+namespace logging {
+//===--------------------------------------------------------------------===//
+// Fuzzy Checkpoint
+//===--------------------------------------------------------------------===//
+
+FuzzyCheckpoint::FuzzyCheckpoint(bool disable_file_access)
+    : Checkpoint(disable_file_access) {
+  InitDirectory();
+  InitVersionNumber();
+}
+
+FuzzyCheckpoint::~FuzzyCheckpoint() {}
+
+void FuzzyCheckpoint::DoCheckpoint() {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // every txn that could still commit below the snapshot has finished, and
+  // the versions of the snapshot are not reclaimed until it ends
+  auto txn = txn_manager.BeginReadOnlyTransaction();
+  snapshot_cid_ = txn->GetBeginCommitId();
+  LOG_TRACE("DoCheckpoint snapshot cid = %lu", snapshot_cid_);
+
+  // a delta checkpoint only holds the tile groups modified since the previous
+  // checkpoint of the chain. every few checkpoints, a full one compacts the
+  // chain.
+  bool is_delta = (previous_snapshot_cid_ != INVALID_CID &&
+                   delta_count_ + 1 < full_checkpoint_interval_);
+
+  CreateFile();
+
+  std::vector<ScanTask> scan_tasks;
+  std::vector<oid_t> tile_group_ids;
+  auto catalog = catalog::Catalog::GetInstance();
+  auto database_count = catalog->GetDatabaseCount();
+
+  // loop all databases
+  for (oid_t database_idx = 1; database_idx < database_count; database_idx++) {
+    auto database = catalog->GetDatabaseWithOffset(database_idx);
+    auto table_count = database->GetTableCount();
+    auto database_oid = database->GetOid();
+
+    // loop all tables
+    for (oid_t table_idx = 0; table_idx < table_count; table_idx++) {
+      storage::DataTable *target_table = database->GetTable(table_idx);
+      PL_ASSERT(target_table);
+
+      // tile groups added from now on only hold newer versions
+      auto tile_group_count = target_table->GetTileGroupCount();
+      for (oid_t tile_group_offset = START_OID;
+           tile_group_offset < tile_group_count; tile_group_offset++) {
+        auto tile_group = target_table->GetTileGroup(tile_group_offset);
+        // dropped by compaction
+        if (tile_group == nullptr) {
+          continue;
+        }
+        tile_group_ids.push_back(tile_group->GetTileGroupId());
+
+        if (is_delta == true &&
+            tile_group->GetHeader()->GetModifiedCommitId() <=
+                previous_snapshot_cid_) {
+          continue;
+        }
+        scan_tasks.push_back({database_oid, target_table, tile_group});
+      }
+    }
+  }
+
+  // the live tile groups tell recovery which images of the chain to load
+  CopySerializeOutput header_buffer;
+  header_buffer.WriteLong(snapshot_cid_);
+  header_buffer.WriteBool(is_delta);
+  header_buffer.WriteInt(tile_group_ids.size());
+  for (auto tile_group_id : tile_group_ids) {
+    header_buffer.WriteInt(tile_group_id);
+  }
+  WriteBuffer(header_buffer);
+
+  std::atomic<size_t> scan_cursor(0);
+  size_t thread_count = std::max<size_t>(
+      1, std::min<size_t>(scan_thread_count_, scan_tasks.size()));
+  std::vector<std::thread> scan_threads;
+
+  // the checkpoint thread scans too
+  for (size_t thread_itr = 1; thread_itr < thread_count; thread_itr++) {
+    scan_threads.emplace_back(&FuzzyCheckpoint::ScanTileGroups, this,
+                              std::cref(scan_tasks), std::ref(scan_cursor));
+  }
+  ScanTileGroups(scan_tasks, scan_cursor);
+
+  for (auto &scan_thread : scan_threads) {
+    scan_thread.join();
+  }
+
+  // release the snapshot
+  txn_manager.CommitTransaction(txn);
+
+  // a block size of zero ends the blocks
+  CopySerializeOutput trailer_buffer;
+  trailer_buffer.WriteInt(0);
+  trailer_buffer.WriteLong(snapshot_cid_);
+  WriteBuffer(trailer_buffer);
+
+  Cleanup(is_delta);
+  most_recent_checkpoint_cid = snapshot_cid_;
+  previous_snapshot_cid_ = snapshot_cid_;
+  delta_count_ = is_delta ? delta_count_ + 1 : 0;
+  LOG_TRACE("Wrote %lu of %lu tile groups", scan_tasks.size(),
+            tile_group_ids.size());
+}
+
+cid_t FuzzyCheckpoint::DoRecovery() {
+  std::vector<MappedCheckpoint> chain(1);
+
+  // find the latest complete checkpoint. a crash may have torn the latest one
+  for (; checkpoint_version >= 0; checkpoint_version--) {
+    if (MapFile(checkpoint_version, chain[0]) == true) {
+      break;
+    }
+    LOG_ERROR("Skip torn checkpoint version %d", checkpoint_version);
+  }
+
+  // No checkpoint to recover from
+  if (checkpoint_version < 0) {
+    return 0;
+  }
+
+  // follow the deltas back to the full checkpoint they are based on
+  for (int version = checkpoint_version - 1; chain.back().is_delta == true;
+       version--) {
+    MappedCheckpoint checkpoint;
+    if (version < 0 || MapFile(version, checkpoint) == false) {
+      LOG_ERROR("Checkpoint version %d of the chain is missing", version);
+      for (auto &mapped_checkpoint : chain) {
+        munmap(mapped_checkpoint.address, mapped_checkpoint.size);
+      }
+      return INVALID_CID;
+    }
+    chain.push_back(std::move(checkpoint));
+  }
+
+  // a live tile group is loaded from the latest image of it
+  std::unordered_set<oid_t> live_tile_group_ids(
+      chain[0].tile_group_ids.begin(), chain[0].tile_group_ids.end());
+  std::vector<ImageBlock> blocks;
+  for (auto &checkpoint : chain) {
+    for (auto &block : checkpoint.blocks) {
+      if (live_tile_group_ids.erase(block.tile_group_id) > 0) {
+        blocks.push_back(block);
+      }
+    }
+  }
+
+  std::atomic<size_t> block_cursor(0);
+  size_t thread_count =
+      std::max<size_t>(1, std::min<size_t>(scan_thread_count_, blocks.size()));
+  std::vector<oid_t> max_tile_group_ids(thread_count, 0);
+  std::vector<std::thread> load_threads;
+
+  for (size_t thread_itr = 1; thread_itr < thread_count; thread_itr++) {
+    load_threads.emplace_back(&FuzzyCheckpoint::LoadTileGroups, this,
+                              std::cref(blocks), std::ref(block_cursor),
+                              std::ref(max_tile_group_ids[thread_itr]));
+  }
+  LoadTileGroups(blocks, block_cursor, max_tile_group_ids[0]);
+
+  for (auto &load_thread : load_threads) {
+    load_thread.join();
+  }
+  for (auto max_tile_group_id : max_tile_group_ids) {
+    max_oid_ = std::max(max_oid_, max_tile_group_id);
+  }
+
+  for (auto &checkpoint : chain) {
+    munmap(checkpoint.address, checkpoint.size);
+  }
+
+  // After finishing recovery, set the next oid with maximum oid
+  // observed during the recovery
+  auto &manager = catalog::Manager::GetInstance();
+  if (max_oid_ > manager.GetNextTileGroupId()) {
+    manager.SetNextTileGroupId(max_oid_);
+  }
+
+  // the next delta checkpoint extends the recovered chain
+  snapshot_cid_ = chain[0].snapshot_cid;
+  previous_snapshot_cid_ = snapshot_cid_;
+  delta_count_ = chain.size() - 1;
+
+  concurrency::TransactionManagerFactory::GetInstance().SetNextCid(
+      snapshot_cid_);
+  CheckpointManager::GetInstance().SetRecoveredCid(snapshot_cid_);
+  most_recent_checkpoint_cid = snapshot_cid_;
+  return snapshot_cid_;
+}
+
+void FuzzyCheckpoint::ScanTileGroups(const std::vector<ScanTask> &scan_tasks,
+                                     std::atomic<size_t> &scan_cursor) {
+  CopySerializeOutput output_buffer;
+
+  for (size_t task_itr = scan_cursor++; task_itr < scan_tasks.size();
+       task_itr = scan_cursor++) {
+    SerializeTileGroup(scan_tasks[task_itr], output_buffer);
+
+    if (output_buffer.Size() >= CHECKPOINT_BUFFER_SIZE) {
+      WriteBuffer(output_buffer);
+    }
+  }
+
+  WriteBuffer(output_buffer);
+}
+
+std::vector<FuzzyCheckpoint::ImageColumn> FuzzyCheckpoint::GetImageColumns(
+    storage::TileGroup *tile_group, const catalog::Schema *schema) {
+  std::vector<ImageColumn> image_columns;
+  auto column_count = schema->GetColumnCount();
+
+  for (oid_t column_id = 0; column_id < column_count; column_id++) {
+    oid_t tile_offset, tile_column_id;
+    tile_group->LocateTileAndColumn(column_id, tile_offset, tile_column_id);
+    auto tile = tile_group->GetTile(tile_offset);
+    auto column_type = schema->GetType(column_id);
+
+    // a varlen field holds a pointer to its payload, inlined or not
+    image_columns.push_back(
+        {tile, tile->GetSchema()->GetOffset(tile_column_id),
+         schema->GetOffset(column_id), schema->GetLength(column_id),
+         column_type == common::Type::VARCHAR ||
+             column_type == common::Type::VARBINARY});
+  }
+
+  return image_columns;
+}
+
+void FuzzyCheckpoint::SerializeTileGroup(const ScanTask &scan_task,
+                                         CopySerializeOutput &output_buffer) {
+  auto &tile_group = scan_task.tile_group;
+  auto tile_group_header = tile_group->GetHeader();
+  auto schema = scan_task.table->GetSchema();
+  CheckpointTileScanner scanner;
+
+  std::vector<oid_t> position_list;
+  oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+  for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+    if (scanner.IsVisible(tile_group_header, tuple_id, snapshot_cid_)) {
+      position_list.push_back(tuple_id);
+    }
+  }
+
+  // the slots up to the last visible one are imaged. an empty image is still
+  // written, as it replaces the older images of the tile group in the chain.
+  oid_t slot_count = position_list.empty() ? 0 : position_list.back() + 1;
+  size_t tuple_length = schema->GetLength();
+
+  size_t block_start = output_buffer.ReserveBytes(sizeof(int32_t));
+  output_buffer.WriteInt(scan_task.database_oid);
+  output_buffer.WriteInt(scan_task.table->GetOid());
+  output_buffer.WriteInt(tile_group->GetTileGroupId());
+  output_buffer.WriteInt(slot_count);
+  output_buffer.WriteInt(tuple_length);
+  output_buffer.WriteInt(position_list.size());
+
+  // visibility
+  for (auto tuple_id : position_list) {
+    output_buffer.WriteInt(tuple_id);
+    output_buffer.WriteLong(tile_group_header->GetBeginCommitId(tuple_id));
+  }
+
+  // the tuple slots, in the row layout of the table. the invisible slots and
+  // the varlen pointers stay zero.
+  auto image_columns = GetImageColumns(tile_group.get(), schema);
+  size_t image_start = output_buffer.Position();
+  output_buffer.WriteZeros(slot_count * tuple_length);
+  for (auto tuple_id : position_list) {
+    size_t image_tuple_start = image_start + tuple_id * tuple_length;
+    for (auto &image_column : image_columns) {
+      if (image_column.is_varlen == false) {
+        output_buffer.WriteBytesAt(
+            image_tuple_start + image_column.image_offset,
+            image_column.tile->GetTupleLocation(tuple_id) +
+                image_column.tile_offset,
+            image_column.length);
+      }
+    }
+  }
+
+  // the varlen payloads, with their length prefix
+  for (auto tuple_id : position_list) {
+    for (auto &image_column : image_columns) {
+      if (image_column.is_varlen == false) {
+        continue;
+      }
+      const char *varlen = *reinterpret_cast<const char **>(
+          image_column.tile->GetTupleLocation(tuple_id) +
+          image_column.tile_offset);
+      if (varlen == nullptr) {
+        output_buffer.WriteInt(0);
+        continue;
+      }
+
+      uint32_t varlen_length = *reinterpret_cast<const uint32_t *>(varlen);
+      int32_t varlen_size = sizeof(uint32_t);
+      if (varlen_length != common::PELOTON_VARCHAR_MAX_LEN) {
+        varlen_size += varlen_length;
+      }
+      output_buffer.WriteInt(varlen_size);
+      output_buffer.WriteBytes(varlen, varlen_size);
+    }
+  }
+
+  output_buffer.WriteIntAt(
+      block_start, static_cast<int32_t>(output_buffer.Position() -
+                                        block_start - sizeof(int32_t)));
+  LOG_TRACE("Serialized %lu tuples of tile group %u", position_list.size(),
+            tile_group->GetTileGroupId());
+}
+
+void FuzzyCheckpoint::WriteBuffer(CopySerializeOutput &output_buffer) {
+  if (!disable_file_access && output_buffer.Size() > 0) {
+    std::lock_guard<std::mutex> lock(file_mutex_);
+    PL_ASSERT(file_handle_.file);
+    fwrite(output_buffer.Data(), sizeof(char), output_buffer.Size(),
+           file_handle_.file);
+  }
+  output_buffer.Reset();
+}
+
+bool FuzzyCheckpoint::ReadSnapshotCid(FileHandle &file_handle,
+                                      cid_t &snapshot_cid) {
+  const size_t header_size = sizeof(int64_t);
+  const size_t trailer_size = sizeof(int32_t) + sizeof(int64_t);
+
+  auto size = LoggingUtil::GetLogFileSize(file_handle);
+  if (size < header_size + trailer_size) {
+    return false;
+  }
+
+  char trailer[trailer_size];
+  fseek(file_handle.file, size - trailer_size, SEEK_SET);
+  if (fread(trailer, 1, trailer_size, file_handle.file) != trailer_size) {
+    return false;
+  }
+  CopySerializeInput trailer_input(trailer, trailer_size);
+  auto end_marker = trailer_input.ReadInt();
+  cid_t trailer_cid = trailer_input.ReadLong();
+
+  char header[header_size];
+  fseek(file_handle.file, 0, SEEK_SET);
+  if (fread(header, 1, header_size, file_handle.file) != header_size) {
+    return false;
+  }
+  CopySerializeInput header_input(header, header_size);
+  cid_t header_cid = header_input.ReadLong();
+
+  if (end_marker != 0 || header_cid != trailer_cid) {
+    return false;
+  }
+
+  file_handle.size = size;
+  snapshot_cid = header_cid;
+  return true;
+}
+
+bool FuzzyCheckpoint::MapFile(int version, MappedCheckpoint &checkpoint) {
+  std::string file_name = ConcatFileName(checkpoint_dir, version);
+  FileHandle file_handle;
+  if (LoggingUtil::InitFileHandle(file_name.c_str(), file_handle, "rb") ==
+      false) {
+    return false;
+  }
+
+  bool success = ReadSnapshotCid(file_handle, checkpoint.snapshot_cid);
+  if (success == true) {
+    checkpoint.size = file_handle.size;
+    checkpoint.address = mmap(nullptr, checkpoint.size, PROT_READ,
+                              MAP_PRIVATE, file_handle.fd, 0);
+    success = (checkpoint.address != MAP_FAILED);
+  }
+
+  // the mapping outlives the file
+  fclose(file_handle.file);
+  if (success == false) {
+    return false;
+  }
+  madvise(checkpoint.address, checkpoint.size, MADV_WILLNEED);
+
+  ReferenceSerializeInput input(checkpoint.address, checkpoint.size);
+  input.ReadLong();
+  checkpoint.is_delta = input.ReadBool();
+  oid_t tile_group_count = input.ReadInt();
+  for (oid_t tile_group_itr = 0; tile_group_itr < tile_group_count;
+       tile_group_itr++) {
+    checkpoint.tile_group_ids.push_back(input.ReadInt());
+  }
+
+  // the trailer is there, so the blocks are complete
+  while (true) {
+    int32_t block_size = input.ReadInt();
+
+    // reached the trailer
+    if (block_size == 0) {
+      break;
+    }
+
+    auto block_data =
+        reinterpret_cast<const char *>(input.getRawPointer(block_size));
+    ReferenceSerializeInput block_input(block_data, block_size);
+    block_input.ReadInt();  // database oid
+    block_input.ReadInt();  // table oid
+    oid_t tile_group_id = block_input.ReadInt();
+    checkpoint.blocks.push_back(
+        {block_data, (size_t)block_size, tile_group_id});
+  }
+
+  return true;
+}
+
+void FuzzyCheckpoint::LoadTileGroups(const std::vector<ImageBlock> &blocks,
+                                     std::atomic<size_t> &block_cursor,
+                                     oid_t &max_tile_group_id) {
+  for (size_t block_itr = block_cursor++; block_itr < blocks.size();
+       block_itr = block_cursor++) {
+    ReferenceSerializeInput block_input(blocks[block_itr].data,
+                                        blocks[block_itr].size);
+    auto tile_group_id = RecoverTileGroup(block_input);
+
+    if (tile_group_id != INVALID_OID && max_tile_group_id < tile_group_id) {
+      max_tile_group_id = tile_group_id;
+    }
+  }
+}
+
+oid_t FuzzyCheckpoint::RecoverTileGroup(SerializeInput &input) {
+  oid_t database_oid = input.ReadInt();
+  oid_t table_oid = input.ReadInt();
+  oid_t tile_group_id = input.ReadInt();
+  oid_t slot_count = input.ReadInt();
+  size_t tuple_length = input.ReadInt();
+  oid_t tuple_count = input.ReadInt();
+
+  auto catalog = catalog::Catalog::GetInstance();
+  auto database = catalog->GetDatabaseWithOid(database_oid);
+  if (database == nullptr) {
+    return INVALID_OID;
+  }
+  auto table = database->GetTableWithOid(table_oid);
+  if (table == nullptr) {
+    // the table was dropped
+    return INVALID_OID;
+  }
+
+  // the tile group had no visible tuple
+  if (tuple_count == 0) {
+    return tile_group_id;
+  }
+
+  auto schema = table->GetSchema();
+  if (tuple_length != schema->GetLength()) {
+    LOG_ERROR("Tile group %u does not match the schema of table %u",
+              tile_group_id, table_oid);
+    return INVALID_OID;
+  }
+
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group = manager.GetTileGroup(tile_group_id);
+
+  // Create new tile group if table doesn't already have that tile group
+  if (tile_group == nullptr) {
+    table->AddTileGroupWithOidForRecovery(tile_group_id);
+    tile_group = manager.GetTileGroup(tile_group_id);
+  }
+
+  if (slot_count > tile_group->GetAllocatedTupleCount()) {
+    LOG_ERROR("Tile group %u has fewer slots than its image", tile_group_id);
+    return INVALID_OID;
+  }
+
+  std::vector<std::pair<oid_t, cid_t>> visible_slots(tuple_count);
+  for (auto &visible_slot : visible_slots) {
+    visible_slot.first = input.ReadInt();
+    visible_slot.second = input.ReadLong();
+  }
+
+  const char *image = reinterpret_cast<const char *>(
+      input.getRawPointer(slot_count * tuple_length));
+  auto image_columns = GetImageColumns(tile_group.get(), schema);
+
+  // a recovered tile group has the row layout of the image, so the tuple
+  // slots are copied at once
+  bool same_layout = (tile_group->NumTiles() == 1);
+  for (auto &image_column : image_columns) {
+    same_layout &= (image_column.tile_offset == image_column.image_offset);
+  }
+
+  if (same_layout == true) {
+    PL_MEMCPY(tile_group->GetTile(0)->GetTupleLocation(0), image,
+              slot_count * tuple_length);
+  } else {
+    for (auto &visible_slot : visible_slots) {
+      const char *image_tuple = image + visible_slot.first * tuple_length;
+      for (auto &image_column : image_columns) {
+        PL_MEMCPY(image_column.tile->GetTupleLocation(visible_slot.first) +
+                      image_column.tile_offset,
+                  image_tuple + image_column.image_offset,
+                  image_column.length);
+      }
+    }
+  }
+
+  // the varlen payloads go to the pools of their tiles
+  for (auto &visible_slot : visible_slots) {
+    for (auto &image_column : image_columns) {
+      if (image_column.is_varlen == false) {
+        continue;
+      }
+      int32_t varlen_size = input.ReadInt();
+      char *varlen = nullptr;
+      if (varlen_size > 0) {
+        varlen = reinterpret_cast<char *>(
+            image_column.tile->GetPool()->Allocate(varlen_size));
+        input.ReadBytes(varlen, varlen_size);
+      }
+      *reinterpret_cast<char **>(
+          image_column.tile->GetTupleLocation(visible_slot.first) +
+          image_column.tile_offset) = varlen;
+    }
+  }
+
+  // Set MVCC info
+  auto tile_group_header = tile_group->GetHeader();
+  tile_group_header->GetEmptyTupleSlot(slot_count - 1);
+  for (auto &visible_slot : visible_slots) {
+    tile_group_header->SetTransactionId(visible_slot.first, INITIAL_TXN_ID);
+    tile_group_header->SetBeginCommitId(visible_slot.first,
+                                        visible_slot.second);
+    tile_group_header->SetEndCommitId(visible_slot.first, MAX_CID);
+    tile_group_header->SetNextItemPointer(visible_slot.first,
+                                          INVALID_ITEMPOINTER);
+  }
+  tile_group->InvalidateZoneMap();
+
+  table->IncreaseTupleCount(tuple_count);
+
+  LOG_TRACE("Recovered %u tuples of tile group %u", tuple_count,
+            tile_group_id);
+  return tile_group_id;
+}
+
+// Private Functions
+void FuzzyCheckpoint::CreateFile() {
+  if (disable_file_access) return;
+  // a torn checkpoint may have left a file with the same version behind
+  std::string file_name = ConcatFileName(checkpoint_dir, ++checkpoint_version);
+  bool success =
+      LoggingUtil::InitFileHandle(file_name.c_str(), file_handle_, "wb");
+  if (!success) {
+    PL_ASSERT(false);
+    return;
+  }
+  LOG_TRACE("Created a new checkpoint file: %s", file_name.c_str());
+}
+
+void FuzzyCheckpoint::Cleanup(bool is_delta) {
+  if (!disable_file_access) {
+    // the checkpoint must be durable before the log it replaces is removed
+    LoggingUtil::FFlushFsync(file_handle_);
+    fclose(file_handle_.file);
+    file_handle_ = INVALID_FILE_HANDLE;
+
+    // a full checkpoint replaces the whole chain of previous versions
+    if (is_delta == false) {
+      for (int version = checkpoint_version - 1; version >= 0; version--) {
+        auto previous_version = ConcatFileName(checkpoint_dir, version);
+        if (remove(previous_version.c_str()) != 0) {
+          LOG_TRACE("Failed to remove file %s", previous_version.c_str());
+          break;
+        }
+      }
+    }
+  }
+
+  // Truncate logs
+  CheckpointManager::GetInstance().TruncateLogs(snapshot_cid_);
+}
+
+}  // namespace logging
+}  // namespace peloton
@@ -234,6 +234,12 @@ void SimpleCheckpoint::Scan(storage::DataTable *target_table,
     // Retrieve a tile group
     auto tile_group = target_table->GetTileGroup(current_tile_group_offset);
 
+    // Dropped by compaction
+    if (tile_group == nullptr) {
+      current_tile_group_offset++;
+      continue;
+    }
+
     // Retrieve a logical tile
     std::unique_ptr<executor::LogicalTile> logical_tile(
         scanner.Scan(tile_group, column_ids, start_commit_id_));
@@ -341,31 +347,7 @@ void SimpleCheckpoint::Cleanup() {
     }
   }
   // Truncate logs
-  LogManager::GetInstance().TruncateLogs(start_commit_id_);
-}
-
-void SimpleCheckpoint::InitVersionNumber() {
-  // Get checkpoint version
-  LOG_TRACE("Trying to read checkpoint directory");
-  struct dirent *file;
-  auto dirp = opendir(checkpoint_dir.c_str());
-  if (dirp == nullptr) {
-    LOG_TRACE("Opendir failed: Errno: %d, error: %s", errno, strerror(errno));
-    return;
-  }
-
-  while ((file = readdir(dirp)) != NULL) {
-    if (strncmp(file->d_name, FILE_PREFIX.c_str(), FILE_PREFIX.length()) == 0) {
-      // found a checkpoint file!
-      LOG_TRACE("Found a checkpoint file with name %s", file->d_name);
-      int version = LoggingUtil::ExtractNumberFromFileName(file->d_name);
-      if (version > checkpoint_version) {
-        checkpoint_version = version;
-      }
-    }
-  }
-  closedir(dirp);
-  LOG_TRACE("set checkpoint version to: %d", checkpoint_version);
+  CheckpointManager::GetInstance().TruncateLogs(start_commit_id_);
 }
 
 }  // namespace logging
@@ -14,6 +14,7 @@
 #include "common/macros.h"
 #include "logging/checkpoint/simple_checkpoint.h"
 #include "logging/checkpoint_manager.h"
+#include "logging/log_manager.h"
 
 namespace peloton {
 namespace logging {
@@ -98,6 +99,13 @@ void CheckpointManager::SetCheckpointStatus(
   }
 }
 
+void CheckpointManager::TruncateLogs(cid_t checkpoint_cid) {
+  // only the write ahead log holds records a checkpoint makes redundant
+  if (IsBasedOnWriteAheadLogging(peloton_logging_mode)) {
+    LogManager::GetInstance().TruncateLogs(checkpoint_cid);
+  }
+}
+
 void CheckpointManager::SetRecoveredCid(cid_t recovered_cid) {
   this->recovered_cid_ = recovered_cid;
 }
@@ -48,14 +48,16 @@ FrontendLogger::~FrontendLogger() {
 
 /** * @brief Return the frontend logger based on logging type
  * @param logging type can be write ahead logging or write behind logging
+ * @param logger_id the log stream of the frontend logger
  */
 FrontendLogger *FrontendLogger::GetFrontendLogger(LoggingType logging_type,
-                                                  bool test_mode) {
+                                                  bool test_mode,
+                                                  int logger_id) {
   FrontendLogger *frontend_logger = nullptr;
 
   LOG_TRACE("Logging_type is %d", (int)logging_type);
   if (IsBasedOnWriteAheadLogging(logging_type) == true) {
-    frontend_logger = new WriteAheadFrontendLogger(test_mode);
+    frontend_logger = new WriteAheadFrontendLogger(test_mode, logger_id);
   } else if (IsBasedOnWriteBehindLogging(logging_type) == true) {
     frontend_logger = new WriteBehindFrontendLogger();
   } else {
@@ -268,6 +270,36 @@ void FrontendLogger::SetMaxFlushedCommitId(cid_t cid) {
   max_flushed_commit_id = cid;
 }
 
+void FrontendLogger::AddSnapshotCallback(
+    cid_t commit_id, const concurrency::CommitCallback &callback) {
+  snapshot_callbacks_lock.Lock();
+  snapshot_callbacks.emplace(commit_id, callback);
+  snapshot_callbacks_lock.Unlock();
+}
+
+void FrontendLogger::ReleaseCommitCallbacks(cid_t persistent_commit_id) {
+  std::vector<concurrency::CommitCallback> released;
+
+  backend_loggers_lock.Lock();
+  for (auto backend_logger : backend_loggers) {
+    backend_logger->CollectCommitCallbacks(persistent_commit_id, released);
+  }
+  backend_loggers_lock.Unlock();
+
+  snapshot_callbacks_lock.Lock();
+  while (!snapshot_callbacks.empty() &&
+         snapshot_callbacks.top().first <= persistent_commit_id) {
+    released.push_back(snapshot_callbacks.top().second);
+    snapshot_callbacks.pop();
+  }
+  snapshot_callbacks_lock.Unlock();
+
+  // a callback may take a while, and must not hold up the backend loggers
+  for (auto &callback : released) {
+    callback();
+  }
+}
+
 void FrontendLogger::SetBackendLoggerLoggedCid(BackendLogger &bel) {
   backend_loggers_lock.Lock();
   bel.SetLoggingCidLowerBound(max_seen_commit_id);
@@ -17,6 +17,7 @@
 #include "common/macros.h"
 
 #include <cstring>
+#include <xmmintrin.h>
 
 namespace peloton {
 namespace logging {
@@ -24,8 +25,12 @@ namespace logging {
 //===--------------------------------------------------------------------===//
 // Log Buffer
 //===--------------------------------------------------------------------===//
+constexpr size_t LogBuffer::SEALED_BUFFER_FLAG;
+
 LogBuffer::LogBuffer(BackendLogger *backend_logger)
-    : backend_logger_(backend_logger) {
+    : reserved_size_(ATOMIC_VAR_INIT(0)),
+      published_size_(ATOMIC_VAR_INIT(0)),
+      backend_logger_(backend_logger) {
   capacity_ = LogManager::GetInstance().GetLogBufferCapacity();
   elastic_data_.reset(new char[capacity_]);
 }
@@ -37,6 +42,53 @@ bool LogBuffer::WriteRecord(LogRecord *record) {
 
 void LogBuffer::ResetData() { size_ = 0; }
 
+/**
+ * @brief reserve room for a record
+ * Only the owning worker reserves, so the exchange fails only when the
+ * frontend seals the buffer at the same time.
+ */
+char *LogBuffer::ReserveRecord(size_t len) {
+  size_t offset = reserved_size_.load(std::memory_order_relaxed);
+  do {
+    if ((offset & SEALED_BUFFER_FLAG) || offset + len > capacity_) {
+      return nullptr;
+    }
+  } while (!reserved_size_.compare_exchange_weak(offset, offset + len));
+
+  return elastic_data_.get() + offset;
+}
+
+size_t LogBuffer::Seal() {
+  size_t reserved_size =
+      reserved_size_.fetch_or(SEALED_BUFFER_FLAG) & ~SEALED_BUFFER_FLAG;
+
+  // a record is only reserved while it is being written
+  while (published_size_.load(std::memory_order_acquire) != reserved_size) {
+    _mm_pause();
+  }
+
+  size_ = reserved_size;
+  return size_;
+}
+
+/**
+ * @brief open the buffer for the reservations
+ * The buffer stays sealed until its worker opens it again, so a worker that
+ * still holds it from before it was flushed can not reserve in it.
+ */
+void LogBuffer::Open(size_t len) {
+  while (len > capacity_) {
+    // double log buffer capacity for large records
+    capacity_ *= 2;
+    elastic_data_.reset(new char[capacity_]);
+  }
+
+  size_ = 0;
+  max_log_id = 0;
+  published_size_ = 0;
+  reserved_size_ = 0;
+}
+
 // Internal Methods
 bool LogBuffer::WriteData(char *data, size_t len) {
   // Not enough space
@@ -51,7 +103,12 @@ bool LogBuffer::WriteData(char *data, size_t len) {
   }
   PL_ASSERT(data);
   PL_ASSERT(len);
-  PL_MEMCPY(elastic_data_.get() + size_, data, len);
+  char *location = ReserveRecord(len);
+  if (location == nullptr) {
+    return false;
+  }
+  PL_MEMCPY(location, data, len);
+  PublishRecord(len);
   size_ += len;
   return true;
 }
@@ -10,8 +10,11 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <condition_variable>
 #include <memory>
+#include <pthread.h>
+#include <sched.h>
 
 #include "concurrency/transaction_manager_factory.h"
 #include "logging/log_manager.h"
@@ -168,8 +171,7 @@ void LogManager::DoneLogging() {
 void LogManager::LogBeginTransaction(cid_t commit_id) {
   if (this->IsInLoggingMode()) {
     auto logger = this->GetBackendLogger();
-    TransactionRecord record(LOGRECORD_TYPE_TRANSACTION_BEGIN, commit_id);
-    logger->Log(&record);
+    logger->LogTransactionRecord(LOGRECORD_TYPE_TRANSACTION_BEGIN, commit_id);
   }
 }
 
@@ -177,39 +179,13 @@ void LogManager::LogUpdate(cid_t commit_id, const ItemPointer &old_version,
                            const ItemPointer &new_version) {
   if (this->IsInLoggingMode()) {
     auto &manager = catalog::Manager::GetInstance();
-    auto catalog = catalog::Catalog::GetInstance();
-
     auto new_tuple_tile_group = manager.GetTileGroup(new_version.block);
 
+    // the new version is serialized straight from the tile group
     auto logger = this->GetBackendLogger();
-
-    std::unique_ptr<LogRecord> record;
-    std::unique_ptr<storage::Tuple> tuple;
-    auto schema = catalog->GetTableWithOid(
-                               new_tuple_tile_group->GetDatabaseId(),
-                               new_tuple_tile_group->GetTableId())->GetSchema();
-    // Can we avoid allocate tuple in head each time?
-    if (IsBasedOnWriteAheadLogging(logging_type_) || replicating_) {
-      tuple.reset(new storage::Tuple(schema, true));
-      for (oid_t col = 0; col < schema->GetColumnCount(); col++) {
-        std::unique_ptr<common::Value> val(
-            new_tuple_tile_group->GetValue(new_version.offset, col));
-        tuple->SetValue(col, *val, logger->GetVarlenPool());
-      }
-      record.reset(
-          logger->GetTupleRecord(LOGRECORD_TYPE_TUPLE_UPDATE, commit_id,
-                                 new_tuple_tile_group->GetTableId(),
-                                 new_tuple_tile_group->GetDatabaseId(),
-                                 new_version, old_version, tuple.get()));
-    } else {
-      // if wbl without replication, do not include tuple data
-      record.reset(logger->GetTupleRecord(
-          LOGRECORD_TYPE_TUPLE_UPDATE, commit_id,
-          new_tuple_tile_group->GetTableId(),
-          new_tuple_tile_group->GetDatabaseId(), new_version, old_version));
-    }
-
-    logger->Log(record.get());
+    logger->LogTupleRecord(LOGRECORD_TYPE_TUPLE_UPDATE, commit_id,
+                           new_tuple_tile_group.get(), new_version,
+                           old_version);
   }
 }
 
@@ -217,37 +193,11 @@ void LogManager::LogInsert(cid_t commit_id, const ItemPointer &new_location) {
   if (this->IsInLoggingMode()) {
     auto logger = this->GetBackendLogger();
     auto &manager = catalog::Manager::GetInstance();
-    auto catalog = catalog::Catalog::GetInstance();
-
-    auto new_tuple_tile_group = manager.GetTileGroup(new_location.block);
-
     auto tile_group = manager.GetTileGroup(new_location.block);
-    std::unique_ptr<LogRecord> record;
-    std::unique_ptr<storage::Tuple> tuple;
-    if (IsBasedOnWriteAheadLogging(logging_type_)) {
-      auto schema =
-          catalog->GetTableWithOid(tile_group->GetDatabaseId(),
-                                   tile_group->GetTableId())->GetSchema();
-      tuple.reset(new storage::Tuple(schema, true));
-      for (oid_t col = 0; col < schema->GetColumnCount(); col++) {
-        std::unique_ptr<common::Value> val(
-            new_tuple_tile_group->GetValue(new_location.offset, col));
-        tuple->SetValue(col, *val, logger->GetVarlenPool());
-      }
 
-      record.reset(logger->GetTupleRecord(
-          LOGRECORD_TYPE_TUPLE_INSERT, commit_id, tile_group->GetTableId(),
-          new_tuple_tile_group->GetDatabaseId(), new_location,
-          INVALID_ITEMPOINTER, tuple.get()));
-
-    } else {
-      // do not construct the tuple for the wbl case
-      record.reset(logger->GetTupleRecord(LOGRECORD_TYPE_TUPLE_INSERT,
-                                          commit_id, tile_group->GetTableId(),
-                                          new_tuple_tile_group->GetDatabaseId(),
-                                          new_location, INVALID_ITEMPOINTER));
-    }
-    logger->Log(record.get());
+    logger->LogTupleRecord(LOGRECORD_TYPE_TUPLE_INSERT, commit_id,
+                           tile_group.get(), new_location,
+                           INVALID_ITEMPOINTER);
   }
 }
 
@@ -258,23 +208,38 @@ void LogManager::LogDelete(cid_t commit_id,
     auto &manager = catalog::Manager::GetInstance();
     auto tile_group = manager.GetTileGroup(delete_location.block);
 
-    std::unique_ptr<LogRecord> record(logger->GetTupleRecord(
-        LOGRECORD_TYPE_TUPLE_DELETE, commit_id, tile_group->GetTableId(),
-        tile_group->GetDatabaseId(), INVALID_ITEMPOINTER, delete_location));
-
-    logger->Log(record.get());
+    logger->LogTupleRecord(LOGRECORD_TYPE_TUPLE_DELETE, commit_id,
+                           tile_group.get(), INVALID_ITEMPOINTER,
+                           delete_location);
   }
 }
 
-void LogManager::LogCommitTransaction(cid_t commit_id) {
+void LogManager::LogCommitTransaction(
+    cid_t commit_id, const concurrency::CommitCallback &callback) {
   if (this->IsInLoggingMode()) {
     auto logger = this->GetBackendLogger();
-    TransactionRecord record(LOGRECORD_TYPE_TRANSACTION_COMMIT, commit_id);
-    logger->Log(&record);
+
+    // queue the callback before the commit record, so that the flush that
+    // covers the commit finds it
+    if (!syncronization_commit && callback) {
+      ReleaseOnFlush(commit_id, callback);
+    }
+
+    auto max_logged = max_logged_commit_id.load();
+    while (max_logged < commit_id &&
+           !max_logged_commit_id.compare_exchange_weak(max_logged, commit_id))
+      ;
+
+    logger->LogTransactionRecord(LOGRECORD_TYPE_TRANSACTION_COMMIT, commit_id);
     if (syncronization_commit) {
       WaitForFlush(commit_id);
+      if (callback) {
+        callback();
+      }
     }
     //logger->GetVarlenPool()->Purge();
+  } else if (callback) {
+    callback();
   }
 }
 
@@ -300,6 +265,24 @@ BackendLogger *LogManager::GetBackendLogger(unsigned int hint_idx) {
           backend_logger);
       backend_logger->SetFrontendLoggerID(i % num_frontend_loggers_);
 
+    } else if (logger_mapping_strategy_ == LOGGER_MAPPING_TYPE_AFFINITY) {
+      // the stream of the core the worker runs on, so that workers on
+      // different cores do not share a stream. the worker is pinned to that
+      // core, otherwise the scheduler could move it away from its stream.
+      int cpu = sched_getcpu();
+      if (cpu >= 0) {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(cpu, &cpu_set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set),
+                                   &cpu_set) != 0) {
+          LOG_ERROR("Could not pin the worker to core %d", cpu);
+        }
+      }
+      unsigned int stream = (cpu < 0 ? i : cpu) % num_frontend_loggers_;
+      frontend_loggers[stream].get()->AddBackendLogger(backend_logger);
+      backend_logger->SetFrontendLoggerID(stream);
+
     } else if (logger_mapping_strategy_ == LOGGER_MAPPING_TYPE_MANUAL) {
       // manual mapping with hint
       PL_ASSERT(hint_idx < frontend_loggers.size());
@@ -319,7 +302,7 @@ void LogManager::InitFrontendLoggers() {
   if (frontend_loggers.size() == 0) {
     for (unsigned int i = 0; i < num_frontend_loggers_; i++) {
       std::unique_ptr<FrontendLogger> frontend_logger(
-          FrontendLogger::GetFrontendLogger(logging_type_, test_mode_));
+          FrontendLogger::GetFrontendLogger(logging_type_, test_mode_, i));
       frontend_logger->SetNoWrite(no_write_);
 
       if (frontend_logger.get() != nullptr) {
@@ -446,6 +429,12 @@ void LogManager::SetGlobalMaxFlushedCommitId(cid_t new_max) {
   global_max_flushed_commit_id = new_max;
 }
 
+/**
+ * @brief the commit id up to which every log stream is durable
+ * A stream that has nothing to log follows the others, so the slowest stream
+ * with pending commits decides. A stream that has not flushed yet holds the
+ * persistent commit id back.
+ */
 cid_t LogManager::GetPersistentFlushedCommitId() {
   int num_loggers;
   num_loggers = this->frontend_loggers.size();
@@ -453,13 +442,11 @@ cid_t LogManager::GetPersistentFlushedCommitId() {
 
   for (int i = 0; i < num_loggers; i++) {
     FrontendLogger *frontend_logger = this->frontend_loggers[i].get();
-    id = reinterpret_cast<WriteAheadFrontendLogger *>(frontend_logger)
-             ->GetMaxFlushedCommitId();
+    id = frontend_logger->GetMaxFlushedCommitId();
     LOG_TRACE("FrontendLogger%d has max flushed commit id as %d", (int)i,
               (int)id);
 
-    // assume 0 is INACTIVE STATE
-    if (id != INVALID_CID && id < persistent_flushed_commit_id)
+    if (id < persistent_flushed_commit_id)
       persistent_flushed_commit_id = id;
   }
 
@@ -474,6 +461,12 @@ void LogManager::FrontendLoggerFlushed() {
     std::unique_lock<std::mutex> wait_lock(flush_notify_mutex);
     flush_notify_cv.notify_all();
   }
+
+  // release the responses of the transactions that are now durable
+  auto persistent_flushed_commit_id = GetPersistentFlushedCommitId();
+  for (auto &frontend_logger : frontend_loggers) {
+    frontend_logger->ReleaseCommitCallbacks(persistent_flushed_commit_id);
+  }
 }
 
 void LogManager::WaitForFlush(cid_t cid) {
@@ -493,6 +486,57 @@ void LogManager::WaitForFlush(cid_t cid) {
   }
 }
 
+void LogManager::ReleaseOnFlush(cid_t commit_id,
+                                const concurrency::CommitCallback &callback) {
+  if (!this->IsInLoggingMode()) {
+    callback();
+    return;
+  }
+
+  auto logger = this->GetBackendLogger();
+  logger->AddCommitCallback(commit_id, callback);
+
+  // the flush that covers the commit may have happened before the callback
+  // was queued, and there may be no flush after it
+  auto persistent_flushed_commit_id = GetPersistentFlushedCommitId();
+  if (persistent_flushed_commit_id >= commit_id) {
+    logger->ReleaseCommitCallbacks(persistent_flushed_commit_id);
+  }
+}
+
+/**
+ * @brief run the callback of a read-only txn after its snapshot is durable
+ * Every commit at or below the snapshot was logged before the snapshot was
+ * taken, so the snapshot only waits for the largest of them. The snapshot
+ * cid is older than the latest commits of the worker, so the callback waits
+ * in the commit-id ordered queue of the frontend logger instead of the queue
+ * of the backend logger.
+ */
+void LogManager::ReleaseSnapshotOnFlush(
+    cid_t snapshot_cid, const concurrency::CommitCallback &callback) {
+  if (!this->IsInLoggingMode()) {
+    callback();
+    return;
+  }
+
+  auto commit_id = std::min(snapshot_cid, max_logged_commit_id.load());
+  if (GetPersistentFlushedCommitId() >= commit_id) {
+    callback();
+    return;
+  }
+
+  auto logger = this->GetBackendLogger();
+  auto &frontend_logger = frontend_loggers[logger->GetFrontendLoggerID()];
+  frontend_logger->AddSnapshotCallback(commit_id, callback);
+
+  // the flush that covers the snapshot may have happened before the callback
+  // was queued
+  auto persistent_flushed_commit_id = GetPersistentFlushedCommitId();
+  if (persistent_flushed_commit_id >= commit_id) {
+    frontend_logger->ReleaseCommitCallbacks(persistent_flushed_commit_id);
+  }
+}
+
 void LogManager::NotifyRecoveryDone() {
   LOG_TRACE("One frontend logger has notified that it has completed recovery");
 
@@ -13,10 +13,13 @@
 
 #include <iostream>
 
+#include "catalog/schema.h"
 #include "logging/records/tuple_record.h"
 #include "logging/log_manager.h"
 #include "logging/frontend_logger.h"
 #include "logging/loggers/wal_backend_logger.h"
+#include "storage/abstract_table.h"
+#include "storage/tile_group.h"
 
 namespace peloton {
 namespace logging {
@@ -34,33 +37,69 @@ LogRecord *WriteAheadBackendLogger::GetTupleRecord(
     oid_t db_oid, ItemPointer insert_location, ItemPointer delete_location,
     const void *data) {
   // Build the log record
+  LogRecord *record = new TupleRecord(GetWriteAheadRecordType(log_record_type),
+                                      txn_id, table_oid, insert_location,
+                                      delete_location, data, db_oid);
+
+  return record;
+}
+
+/**
+ * @brief serialize a tuple record straight from the tile group
+ * The record has the layout of TupleRecord::Serialize, without building the
+ * record and a copy of the tuple for it.
+ */
+void WriteAheadBackendLogger::LogTupleRecord(LogRecordType log_record_type,
+                                             cid_t commit_id,
+                                             storage::TileGroup *tile_group,
+                                             ItemPointer insert_location,
+                                             ItemPointer delete_location) {
+  log_record_type = GetWriteAheadRecordType(log_record_type);
+
+  output_buffer.Reset();
+  TupleRecord::SerializeHeader(output_buffer, log_record_type,
+                               tile_group->GetDatabaseId(),
+                               tile_group->GetTableId(), commit_id,
+                               insert_location, delete_location);
+
+  // the tuple, as storage::Tuple::SerializeTo writes it
+  if (log_record_type != LOGRECORD_TYPE_WAL_TUPLE_DELETE) {
+    auto schema = tile_group->GetAbstractTable()->GetSchema();
+    size_t start = output_buffer.ReserveBytes(sizeof(int32_t));
+    for (oid_t col = 0; col < schema->GetColumnCount(); col++) {
+      std::unique_ptr<common::Value> value(
+          tile_group->GetValue(insert_location.offset, col));
+      value->SerializeTo(output_buffer);
+    }
+    output_buffer.WriteIntAt(
+        start, static_cast<int32_t>(output_buffer.Position() - start -
+                                    sizeof(int32_t)));
+  }
+
+  WriteRecord(log_record_type, commit_id, output_buffer.Data(),
+              output_buffer.Size());
+}
+
+LogRecordType WriteAheadBackendLogger::GetWriteAheadRecordType(
+    LogRecordType log_record_type) {
   switch (log_record_type) {
     case LOGRECORD_TYPE_TUPLE_INSERT: {
-      log_record_type = LOGRECORD_TYPE_WAL_TUPLE_INSERT;
-      break;
+      return LOGRECORD_TYPE_WAL_TUPLE_INSERT;
     }
 
     case LOGRECORD_TYPE_TUPLE_DELETE: {
-      log_record_type = LOGRECORD_TYPE_WAL_TUPLE_DELETE;
-      break;
+      return LOGRECORD_TYPE_WAL_TUPLE_DELETE;
     }
 
     case LOGRECORD_TYPE_TUPLE_UPDATE: {
-      log_record_type = LOGRECORD_TYPE_WAL_TUPLE_UPDATE;
-      break;
+      return LOGRECORD_TYPE_WAL_TUPLE_UPDATE;
     }
 
     default: {
       PL_ASSERT(false);
-      break;
+      return log_record_type;
     }
   }
-
-  LogRecord *record =
-      new TupleRecord(log_record_type, txn_id, table_oid, insert_location,
-                      delete_location, data, db_oid);
-
-  return record;
 }
 
 }  // namespace logging
@@ -14,8 +14,11 @@
 #include <sys/types.h>
 #include <sys/mman.h>
 #include <algorithm>
+#include <atomic>
 #include <dirent.h>
+#include <functional>
 #include <numeric>
+#include <thread>
 
 #include "catalog/catalog.h"
 #include "catalog/manager.h"
@@ -43,10 +46,11 @@
 #include "executor/executor_context.h"
 #include "planner/seq_scan_plan.h"
 
-int logger_id_counter = 0;
-
 //#define LOG_FILE_SWITCH_LIMIT (1024)
 
+// number of committed tuple records buffered before they are replayed
+#define RECOVERY_BATCH_SIZE (1 << 16)
+
 namespace peloton {
 namespace logging {
 
@@ -59,8 +63,12 @@ WriteAheadFrontendLogger::WriteAheadFrontendLogger()
 
 /**
  * @brief Open logfile and file descriptor
+ * @param for_testing whether to keep the log in memory only
+ * @param logger_id the log stream of the logger, which picks its file set
  */
-WriteAheadFrontendLogger::WriteAheadFrontendLogger(bool for_testing) {
+WriteAheadFrontendLogger::WriteAheadFrontendLogger(bool for_testing,
+                                                   int logger_id)
+    : logger_id(logger_id) {
   test_mode_ = for_testing;
 
   // allocate pool
@@ -73,7 +81,7 @@ WriteAheadFrontendLogger::WriteAheadFrontendLogger(bool for_testing) {
 }
 
 WriteAheadFrontendLogger::WriteAheadFrontendLogger(std::string log_dir)
-    : peloton_log_directory(log_dir) {
+    : peloton_log_directory(log_dir), logger_id(0) {
   LOG_TRACE("Instantiating wal_fel with log directory: %s", log_dir.c_str());
   
   // allocate pool
@@ -83,7 +91,6 @@ WriteAheadFrontendLogger::WriteAheadFrontendLogger(std::string log_dir)
 }
 
 void WriteAheadFrontendLogger::InitSelf() {
-  SetLoggerID(__sync_fetch_and_add(&logger_id_counter, 1));
   InitLogDirectory();
   InitLogFilesList();
   UpdateMaxDelimiterForRecovery();
@@ -236,6 +243,13 @@ void WriteAheadFrontendLogger::DoRecovery() {
   LOG_TRACE("Got start_commit_id as %d, global max flushed as %d",
             (int)start_commit_id, (int)global_max_flushed_id_for_recovery);
 
+  // the log streams are recovered at the same time, so each one gets its
+  // share of the recovery threads
+  size_t logger_count = log_manager.GetFrontendLoggersList().size();
+  size_t partition_count = std::max<size_t>(
+      1, log_manager.GetRecoveryThreadCount() / std::max<size_t>(1, logger_count));
+  recovery_partitions_.resize(partition_count);
+
   // open first file
   OpenNextLogFile();
 
@@ -258,8 +272,8 @@ void WriteAheadFrontendLogger::DoRecovery() {
         TransactionRecord txn_rec(record_type);
         if (LoggingUtil::ReadTransactionRecordHeader(
                 txn_rec, cur_file_handle) == false) {
-          cur_file_handle = INVALID_FILE_HANDLE;
-          return;
+          reached_end_of_log = true;
+          break;
         }
         log_id = txn_rec.GetTransactionId();
         if (log_id <= start_commit_id ||
@@ -276,8 +290,9 @@ void WriteAheadFrontendLogger::DoRecovery() {
         if (LoggingUtil::ReadTupleRecordHeader(*tuple_record,
                                                cur_file_handle) == false) {
           LOG_ERROR("Could not read tuple record header.");
-          cur_file_handle = INVALID_FILE_HANDLE;
-          return;
+          delete tuple_record;
+          reached_end_of_log = true;
+          break;
         }
 
         log_id = tuple_record->GetTransactionId();
@@ -294,8 +309,9 @@ void WriteAheadFrontendLogger::DoRecovery() {
         if (recovery_txn_table.find(log_id) == recovery_txn_table.end()) {
           LOG_ERROR("Insert txd id %d not found in recovery txn table",
                     (int)log_id);
-          cur_file_handle = INVALID_FILE_HANDLE;
-          return;
+          delete tuple_record;
+          reached_end_of_log = true;
+          break;
         }
 
         // Read off the tuple record body from the log
@@ -309,8 +325,9 @@ void WriteAheadFrontendLogger::DoRecovery() {
         // Check for torn log write
         if (LoggingUtil::ReadTupleRecordHeader(*tuple_record,
                                                cur_file_handle) == false) {
-          cur_file_handle = INVALID_FILE_HANDLE;
-          return;
+          delete tuple_record;
+          reached_end_of_log = true;
+          break;
         }
 
         log_id = tuple_record->GetTransactionId();
@@ -322,8 +339,9 @@ void WriteAheadFrontendLogger::DoRecovery() {
         if (recovery_txn_table.find(log_id) == recovery_txn_table.end()) {
           LOG_TRACE("Delete txd id %d not found in recovery txn table",
                     (int)log_id);
-          cur_file_handle = INVALID_FILE_HANDLE;
-          return;
+          delete tuple_record;
+          reached_end_of_log = true;
+          break;
         }
         break;
       }
@@ -369,6 +387,9 @@ void WriteAheadFrontendLogger::DoRecovery() {
     }
   }
 
+  // A torn record ends the log. Replay what was committed before it.
+  ReplayRecoveryPartitions();
+
   // Finally, abort ACTIVE transactions in recovery_txn_table
   AbortActiveTransactions();
 
@@ -380,6 +401,35 @@ void WriteAheadFrontendLogger::DoRecovery() {
   cur_file_handle = INVALID_FILE_HANDLE;
 }
 
+/**
+ * @brief run the tasks on up to thread_count threads, the caller included
+ * @param task_count number of tasks
+ * @param thread_count maximum number of threads
+ * @param task the function that runs a task, given its offset
+ */
+static void RunRecoveryTasks(size_t task_count, size_t thread_count,
+                             const std::function<void(size_t)> &task) {
+  // the threads take the next task until none are left
+  std::atomic<size_t> next_task(0);
+  auto run_tasks = [&]() {
+    for (size_t task_itr = next_task++; task_itr < task_count;
+         task_itr = next_task++) {
+      task(task_itr);
+    }
+  };
+
+  thread_count = std::min(thread_count, task_count);
+  std::vector<std::thread> task_threads;
+  for (size_t thread_itr = 1; thread_itr < thread_count; thread_itr++) {
+    task_threads.emplace_back(run_tasks);
+  }
+  run_tasks();
+
+  for (auto &task_thread : task_threads) {
+    task_thread.join();
+  }
+}
+
 void WriteAheadFrontendLogger::RecoverIndex() {
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
   LOG_TRACE("Recovering the indexes");
@@ -389,6 +439,13 @@ void WriteAheadFrontendLogger::RecoverIndex() {
   auto catalog = catalog::Catalog::GetInstance();
   auto database_count = catalog->GetDatabaseCount();
 
+  // the tables that have indexes
+  std::vector<storage::DataTable *> table_tasks;
+
+  // every index of every table is rebuilt by a separate task
+  std::vector<std::pair<storage::DataTable *, std::shared_ptr<index::Index>>>
+      index_tasks;
+
   // loop all databases
   for (oid_t database_idx = 1; database_idx < database_count; database_idx++) {
     auto database = catalog->GetDatabaseWithOffset(database_idx);
@@ -402,29 +459,88 @@ void WriteAheadFrontendLogger::RecoverIndex() {
       LOG_TRACE("SeqScan: database oid %u table oid %u: %s", database_idx,
                 table_idx, target_table->GetName().c_str());
 
-      if (!RecoverTableIndexHelper(target_table, cid)) {
-        break;
+      auto index_count = target_table->GetIndexCount();
+      if (index_count > 0) {
+        table_tasks.push_back(target_table);
+      }
+      for (oid_t index_itr = 0; index_itr < index_count; index_itr++) {
+        index_tasks.emplace_back(target_table,
+                                 target_table->GetIndex(index_itr));
       }
     }
   }
+
+  auto thread_count = LogManager::GetInstance().GetRecoveryThreadCount();
+
+  // the index entries point to the indirections of the versions, so every
+  // table gets its indirections before any index is loaded
+  RunRecoveryTasks(table_tasks.size(), thread_count, [&](size_t task_itr) {
+    RecoverTableIndirections(table_tasks[task_itr], cid);
+  });
+
+  RunRecoveryTasks(index_tasks.size(), thread_count, [&](size_t task_itr) {
+    RecoverTableIndexHelper(index_tasks[task_itr].first,
+                            index_tasks[task_itr].second.get(), cid);
+  });
 }
 
-bool WriteAheadFrontendLogger::RecoverTableIndexHelper(
+void WriteAheadFrontendLogger::RecoverTableIndirections(
     storage::DataTable *target_table, cid_t start_cid) {
-  auto schema = target_table->GetSchema();
-  PL_ASSERT(schema);
-  std::vector<oid_t> column_ids;
-  column_ids.resize(schema->GetColumnCount());
-  std::iota(column_ids.begin(), column_ids.end(), 0);
+  auto table_tile_group_count = target_table->GetTileGroupCount();
+  CheckpointTileScanner scanner;
+
+  for (oid_t tile_group_offset = START_OID;
+       tile_group_offset < table_tile_group_count; tile_group_offset++) {
+    auto tile_group = target_table->GetTileGroup(tile_group_offset);
+    // dropped by compaction
+    if (tile_group == nullptr) {
+      continue;
+    }
+    auto tile_group_header = tile_group->GetHeader();
+    auto tile_group_id = tile_group->GetTileGroupId();
+
+    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      // a version that was inserted before the recovery keeps its indirection
+      if (scanner.IsVisible(tile_group_header, tuple_id, start_cid) == false ||
+          tile_group_header->GetIndirection(tuple_id) != nullptr) {
+        continue;
+      }
+
+      ItemPointer location(tile_group_id, tuple_id);
+      tile_group_header->SetIndirection(
+          tuple_id, target_table->AllocateIndirection(location));
+    }
+  }
+}
+
+bool WriteAheadFrontendLogger::RecoverTableIndexHelper(
+    storage::DataTable *target_table, index::Index *target_index,
+    cid_t start_cid) {
+  // only the key columns are scanned
+  auto index_schema = target_index->GetKeySchema();
+  std::vector<oid_t> column_ids = index_schema->GetIndexedColumns();
+  auto key_column_count = column_ids.size();
 
   oid_t current_tile_group_offset = START_OID;
   auto table_tile_group_count = target_table->GetTileGroupCount();
   LOG_TRACE("Recovering tile group count: %ld", table_tile_group_count);
   CheckpointTileScanner scanner;
 
+  // the keys of the visible versions, with the indirections that point to them
+  typedef std::pair<std::unique_ptr<storage::Tuple>, ItemPointer *>
+      index_entry_type;
+  std::vector<index_entry_type> index_entries;
+
   while (current_tile_group_offset < table_tile_group_count) {
     // Retrieve a tile group
     auto tile_group = target_table->GetTileGroup(current_tile_group_offset);
+    // dropped by compaction
+    if (tile_group == nullptr) {
+      current_tile_group_offset++;
+      continue;
+    }
+    auto tile_group_header = tile_group->GetHeader();
 
     // Retrieve a logical tile
     std::unique_ptr<executor::LogicalTile> logical_tile(
@@ -436,57 +552,53 @@ bool WriteAheadFrontendLogger::RecoverTableIndexHelper(
       continue;
     }
 
-    auto tile_group_id = logical_tile->GetColumnInfo(0)
-                             .base_tile->GetTileGroup()
-                             ->GetTileGroupId();
-    LOG_TRACE("Retrieved tile group %u", tile_group_id);
+    LOG_TRACE("Retrieved tile group %u", tile_group->GetTileGroupId());
 
     // Go over the logical tile
     for (oid_t tuple_id : *logical_tile) {
       expression::ContainerTuple<executor::LogicalTile> cur_tuple(
           logical_tile.get(), tuple_id);
 
-      // Index update
-      {
-        // construct a physical tuple from the logical tuple
-        std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(schema, true));
-        for (auto column_id : column_ids) {
-          std::unique_ptr<common::Value> val(cur_tuple.GetValue(column_id));
-          tuple->SetValue(column_id, *val,
-                          recovery_pool);
-        }
-
-        ItemPointer location(tile_group_id, tuple_id);
-        InsertIndexEntry(tuple.get(), target_table, location);
+      // construct the key from the logical tuple
+      std::unique_ptr<storage::Tuple> key(
+          new storage::Tuple(index_schema, true));
+      for (oid_t key_column_itr = 0; key_column_itr < key_column_count;
+           key_column_itr++) {
+        std::unique_ptr<common::Value> val(cur_tuple.GetValue(key_column_itr));
+        key->SetValue(key_column_itr, *val, target_index->GetPool());
       }
+
+      index_entries.emplace_back(std::move(key),
+                                 tile_group_header->GetIndirection(tuple_id));
     }
     current_tile_group_offset++;
   }
+
+  // the index is loaded in key order, so every insert lands next to the
+  // previous one instead of at a random leaf
+  std::sort(index_entries.begin(), index_entries.end(),
+            [](const index_entry_type &lhs, const index_entry_type &rhs) {
+              return lhs.first->Compare(*rhs.first) < 0;
+            });
+
+  for (auto &index_entry : index_entries) {
+    InsertIndexEntry(index_entry.first.get(), target_index, index_entry.second);
+  }
   return true;
 }
 
-void WriteAheadFrontendLogger::InsertIndexEntry(storage::Tuple *tuple,
-                                                storage::DataTable *table,
-                                                ItemPointer target_location UNUSED_ATTRIBUTE) {
-  PL_ASSERT(tuple);
-  PL_ASSERT(table);
-  auto index_count = table->GetIndexCount();
-  LOG_TRACE("Insert tuple (%u, %u) into %u indexes", target_location.block,
-            target_location.offset, index_count);
-
-  for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
-    auto index = table->GetIndex(index_itr);
-    auto index_schema = index->GetKeySchema();
-    auto indexed_columns = index_schema->GetIndexedColumns();
-    std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
-    key->SetFromTuple(tuple, indexed_columns, index->GetPool());
-
-    // TODO: workaround. this can cause memory leak.
-    // since currently logging does not work, we will handle this later.
-    // index->InsertEntry(key.get(), new ItemPointer(target_location));
-    // Increase the indexes' number of tuples by 1 as well
-    index->IncreaseNumberOfTuplesBy(1);
-  }
+void WriteAheadFrontendLogger::InsertIndexEntry(storage::Tuple *key,
+                                                index::Index *index,
+                                                ItemPointer *indirection) {
+  PL_ASSERT(key);
+  PL_ASSERT(index);
+  PL_ASSERT(indirection);
+  LOG_TRACE("Insert tuple (%u, %u) into index %s", indirection->block,
+            indirection->offset, index->GetName().c_str());
+
+  index->InsertEntry(key, indirection);
+  // Increase the indexes' number of tuples by 1 as well
+  index->IncreaseNumberOfTuplesBy(1);
 }
 
 /**
@@ -512,31 +624,37 @@ void WriteAheadFrontendLogger::StartTransactionRecovery(cid_t commit_id) {
 }
 
 /**
- * @brief move tuples from current txn to recovery txn so that we can commit
- * them later
- * @param recovery txn
+ * @brief move the tuples of a committed txn to the recovery partitions of the
+ * tile groups they modify, and replay the partitions once enough accumulated
+ * @param commit id of the recovery txn
  */
 void WriteAheadFrontendLogger::CommitTransactionRecovery(cid_t commit_id) {
+  PL_ASSERT(recovery_partitions_.empty() == false);
   std::vector<TupleRecord *> &tuple_records = recovery_txn_table[commit_id];
-  for (auto it = tuple_records.begin(); it != tuple_records.end(); it++) {
-    TupleRecord *curr = *it;
+  for (auto curr : tuple_records) {
+    oid_t tile_group_id;
     switch (curr->GetType()) {
       case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
-        InsertTuple(curr);
+        tile_group_id = curr->GetInsertLocation().block;
         break;
       case LOGRECORD_TYPE_WAL_TUPLE_UPDATE:
-        UpdateTuple(curr);
-        break;
       case LOGRECORD_TYPE_WAL_TUPLE_DELETE:
-        DeleteTuple(curr);
+        tile_group_id = curr->GetDeleteLocation().block;
         break;
       default:
+        delete curr;
         continue;
     }
-    delete curr;
+    recovery_partitions_[tile_group_id % recovery_partitions_.size()]
+        .push_back(curr);
+    recovery_partition_size_++;
   }
   max_cid = commit_id + 1;
   recovery_txn_table.erase(commit_id);
+
+  if (recovery_partition_size_ >= RECOVERY_BATCH_SIZE) {
+    ReplayRecoveryPartitions();
+  }
 }
 
 void InsertTupleHelper(oid_t &max_tg, cid_t commit_id, oid_t db_id,
@@ -640,6 +758,73 @@ void UpdateTupleHelper(oid_t &max_tg, cid_t commit_id, oid_t db_id,
   tile_group->UpdateTupleFromRecovery(commit_id, remove_loc.offset, insert_loc);
 }
 
+/**
+ * @brief apply the records of a recovery partition in commit order
+ * @param tuple_records the partition, emptied once applied
+ * @param max_tg the maximum tile group id seen so far
+ */
+void ReplayRecoveryPartition(std::vector<TupleRecord *> &tuple_records,
+                             oid_t &max_tg) {
+  for (auto record : tuple_records) {
+    switch (record->GetType()) {
+      case LOGRECORD_TYPE_WAL_TUPLE_INSERT:
+        InsertTupleHelper(max_tg, record->GetTransactionId(),
+                          record->GetDatabaseOid(), record->GetTableId(),
+                          record->GetInsertLocation(), record->GetTuple());
+        break;
+      case LOGRECORD_TYPE_WAL_TUPLE_UPDATE:
+        UpdateTupleHelper(max_tg, record->GetTransactionId(),
+                          record->GetDatabaseOid(), record->GetTableId(),
+                          record->GetDeleteLocation(),
+                          record->GetInsertLocation(), record->GetTuple());
+        break;
+      case LOGRECORD_TYPE_WAL_TUPLE_DELETE:
+        DeleteTupleHelper(max_tg, record->GetTransactionId(),
+                          record->GetDatabaseOid(), record->GetTableId(),
+                          record->GetDeleteLocation());
+        break;
+      default:
+        break;
+    }
+    delete record;
+  }
+  tuple_records.clear();
+}
+
+/**
+ * @brief replay the recovery partitions in parallel.
+ * Every tuple slot keeps the version with the highest commit id, so the
+ * partitions do not need to be applied in any order relative to each other,
+ * even when an update moves a tuple to a tile group of another partition.
+ */
+void WriteAheadFrontendLogger::ReplayRecoveryPartitions() {
+  if (recovery_partition_size_ == 0) {
+    return;
+  }
+
+  auto partition_count = recovery_partitions_.size();
+  std::vector<oid_t> max_tile_group_ids(partition_count, 0);
+  std::vector<std::thread> replay_threads;
+
+  // the recovery thread replays the first partition itself
+  for (size_t partition_itr = 1; partition_itr < partition_count;
+       partition_itr++) {
+    replay_threads.emplace_back(
+        ReplayRecoveryPartition, std::ref(recovery_partitions_[partition_itr]),
+        std::ref(max_tile_group_ids[partition_itr]));
+  }
+  ReplayRecoveryPartition(recovery_partitions_[0], max_tile_group_ids[0]);
+
+  for (auto &replay_thread : replay_threads) {
+    replay_thread.join();
+  }
+
+  for (auto max_tile_group_id : max_tile_group_ids) {
+    max_oid = std::max(max_oid, max_tile_group_id);
+  }
+  recovery_partition_size_ = 0;
+}
+
 /**
  * @brief read tuple record from log file and add them tuples to recovery txn
  * @param recovery txn
@@ -1069,7 +1254,7 @@ void WriteAheadFrontendLogger::InitLogDirectory() {
   // Get log directory
   auto &log_manager = logging::LogManager::GetInstance();
   peloton_log_directory =
-      log_manager.GetLogDirectoryName() + wal_directory_path;
+      log_manager.GetLogDirectoryName() + GetStreamDirectoryName(logger_id);
 
   auto success =
       LoggingUtil::CreateDirectory(peloton_log_directory.c_str(), 0700);
@@ -1179,9 +1364,18 @@ WriteAheadFrontendLogger::ExtractMaxLogIdAndMaxDelimFromLogFileRecords(
   return std::pair<cid_t, cid_t>(max_log_id_so_far, max_delim_so_far);
 }
 
-void WriteAheadFrontendLogger::SetLoggerID(int id) {
-  logger_id = id;
-  peloton_log_directory += std::to_string(id);
+void WriteAheadFrontendLogger::SetLoggerID(int id) { logger_id = id; }
+
+/**
+ * @brief the directory of the files of a log stream
+ * The first stream keeps the directory of a single stream log, so that a log
+ * written with one stream can be recovered with more.
+ */
+std::string WriteAheadFrontendLogger::GetStreamDirectoryName(int logger_id) {
+  if (logger_id == 0) {
+    return wal_directory_path;
+  }
+  return std::string(wal_directory_path) + "_" + std::to_string(logger_id);
 }
 
 void WriteAheadFrontendLogger::UpdateMaxDelimiterForRecovery() {
@@ -20,6 +20,7 @@
 #include "logging/loggers/wbl_backend_logger.h"
 
 #include "catalog/manager.h"
+#include "storage/tile_group.h"
 
 namespace peloton {
 namespace logging {
@@ -76,6 +77,23 @@ void WriteBehindBackendLogger::Log(LogRecord *record) {
   log_buffer_lock.Unlock();
 }
 
+void WriteBehindBackendLogger::LogTupleRecord(LogRecordType log_record_type,
+                                              cid_t commit_id,
+                                              storage::TileGroup *tile_group,
+                                              ItemPointer insert_location,
+                                              ItemPointer delete_location) {
+  std::unique_ptr<LogRecord> record(GetTupleRecord(
+      log_record_type, commit_id, tile_group->GetTableId(),
+      tile_group->GetDatabaseId(), insert_location, delete_location));
+  Log(record.get());
+}
+
+void WriteBehindBackendLogger::LogTransactionRecord(
+    LogRecordType log_record_type, cid_t commit_id) {
+  TransactionRecord record(log_record_type, commit_id);
+  Log(&record);
+}
+
 void WriteBehindBackendLogger::SyncDataForCommit() {
   auto &manager = catalog::Manager::GetInstance();
 
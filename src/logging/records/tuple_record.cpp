@@ -68,6 +68,15 @@ bool TupleRecord::Serialize(CopySerializeOutput &output) {
  * @param output
  */
 void TupleRecord::SerializeHeader(CopySerializeOutput &output) {
+  SerializeHeader(output, log_record_type, db_oid, table_oid, cid,
+                  insert_location, delete_location);
+}
+
+void TupleRecord::SerializeHeader(CopySerializeOutput &output,
+                                  LogRecordType log_record_type, oid_t db_oid,
+                                  oid_t table_oid, cid_t cid,
+                                  const ItemPointer &insert_location,
+                                  const ItemPointer &delete_location) {
   // Record LogRecordType first
   output.WriteEnumInSingleByte(log_record_type);
 
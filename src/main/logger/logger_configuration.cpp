@@ -40,6 +40,9 @@ void Usage(FILE* out) {
           "   -v --flush-mode        :  Flush mode \n"
           "   -r --commit-interval   :  Group commit interval \n"
           "   -j --log-dir           :  Log directory\n"
+          "   -L --log-streams       :  # of log streams \n"
+          "   -R --recovery-threads  :  # of recovery threads (0 : one per core) \n"
+          "   -C --checkpoint-type   :  Checkpoint type \n"
           "   -y --benchmark-type    :  Benchmark type \n");
 }
 
@@ -54,6 +57,9 @@ static struct option opts[] = {
     {"commit-interval", optional_argument, NULL, 'r'},
     {"benchmark-type", optional_argument, NULL, 'y'},
     {"log-dir", optional_argument, NULL, 'j'},
+    {"log-streams", optional_argument, NULL, 'L'},
+    {"recovery-threads", optional_argument, NULL, 'R'},
+    {"checkpoint-type", optional_argument, NULL, 'C'},
     {NULL, 0, NULL, 0}};
 
 static void ValidateLoggingType(const configuration& state) {
@@ -146,6 +152,25 @@ static void ValidateDataFileSize(const configuration& state) {
   LOG_INFO("data_file_size :: %lu", state.data_file_size);
 }
 
+static void ValidateLogStreamCount(const configuration& state) {
+  if (state.log_stream_count <= 0) {
+    LOG_ERROR("Invalid log_stream_count :: %d", state.log_stream_count);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("log_stream_count :: %d", state.log_stream_count);
+}
+
+static void ValidateRecoveryThreadCount(const configuration& state) {
+  if (state.recovery_thread_count < 0) {
+    LOG_ERROR("Invalid recovery_thread_count :: %d",
+              state.recovery_thread_count);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("recovery_thread_count :: %d", state.recovery_thread_count);
+}
+
 static void ValidateExperimentType(const configuration& state) {
   if (state.experiment_type < 0 || state.experiment_type > 4) {
     LOG_ERROR("Invalid experiment_type :: %d", state.experiment_type);
@@ -231,6 +256,8 @@ void ParseArguments(int argc, char* argv[], configuration& state) {
   state.pcommit_latency = 0;
   state.asynchronous_mode = ASYNCHRONOUS_TYPE_SYNC;
   state.checkpoint_type = CHECKPOINT_TYPE_INVALID;
+  state.log_stream_count = 1;
+  state.recovery_thread_count = 0;
 
   // YCSB Default Values
   ycsb::state.index = INDEX_TYPE_BWTREE;
@@ -263,10 +290,10 @@ void ParseArguments(int argc, char* argv[], configuration& state) {
   // Parse args
   while (1) {
     int idx = 0;
-    // logger - hs:x:f:l:t:q:v:r:y:
+    // logger - hs:x:f:l:t:q:v:r:y:j:L:R:C:
     // ycsb   - hemgi:k:d:p:b:c:o:u:z:n:
     // tpcc   - heagi:k:d:p:b:w:n:
-    int c = getopt_long(argc, argv, "hs:x:f:l:t:q:v:r:y:emgi:k:d:p:b:c:o:u:z:n:aw:j:",
+    int c = getopt_long(argc, argv, "hs:x:f:l:t:q:v:r:y:emgi:k:d:p:b:c:o:u:z:n:aw:j:L:R:C:",
                         opts, &idx);
 
     if (c == -1) break;
@@ -284,6 +311,15 @@ void ParseArguments(int argc, char* argv[], configuration& state) {
       case 'j':
         state.log_file_dir = optarg;
         break;
+      case 'L':
+        state.log_stream_count = atoi(optarg);
+        break;
+      case 'R':
+        state.recovery_thread_count = atoi(optarg);
+        break;
+      case 'C':
+        state.checkpoint_type = (CheckpointType)atoi(optarg);
+        break;
       case 'l':
         state.logging_type = (LoggingType)atoi(optarg);
         break;
@@ -384,11 +420,13 @@ void ParseArguments(int argc, char* argv[], configuration& state) {
     }
   }
 
-  if (state.checkpoint_type == CHECKPOINT_TYPE_NORMAL &&
+  if ((state.checkpoint_type == CHECKPOINT_TYPE_NORMAL ||
+       state.checkpoint_type == CHECKPOINT_TYPE_FUZZY ||
+       state.checkpoint_type == CHECKPOINT_TYPE_INCREMENTAL) &&
       (state.logging_type == LOGGING_TYPE_NVM_WAL ||
        state.logging_type == LOGGING_TYPE_SSD_WAL ||
        state.logging_type == LOGGING_TYPE_HDD_WAL)) {
-    peloton_checkpoint_mode = CHECKPOINT_TYPE_NORMAL;
+    peloton_checkpoint_mode = state.checkpoint_type;
   }
 
   // Print Logger configuration
@@ -398,6 +436,8 @@ void ParseArguments(int argc, char* argv[], configuration& state) {
   ValidateBenchmarkType(state);
   ValidateDataFileSize(state);
   ValidateLogFileDir(state);
+  ValidateLogStreamCount(state);
+  ValidateRecoveryThreadCount(state);
   ValidateWaitTimeout(state);
   ValidateFlushMode(state);
   ValidateNVMLatency(state);
@@ -15,6 +15,7 @@
 #include <string>
 #include <getopt.h>
 #include <sys/stat.h>
+#include <dirent.h>
 #include <fts.h>
 #include <unistd.h>
 
@@ -232,17 +233,49 @@ void CleanUpLogDirectory() {
   std::string wbl_directory_path =
       state.log_file_dir + logging::WriteBehindFrontendLogger::wbl_log_path;
 
-  // remove wal log directory (for wal if it exists)
-  // for now hardcode for 1 logger
-  std::string wal_directory_path =
-      state.log_file_dir +
-      logging::WriteAheadFrontendLogger::wal_directory_path;
-
   std::string checkpoint_dir_path = state.log_file_dir + "pl_checkpoint";
 
   RemoveDirectory(wbl_directory_path.c_str());
 
-  RemoveDirectory(wal_directory_path.c_str());
+  // remove the wal log directory of every stream (for wal if it exists)
+  for (int stream_itr = 0; stream_itr < state.log_stream_count; stream_itr++) {
+    std::string wal_directory_path =
+        state.log_file_dir +
+        logging::WriteAheadFrontendLogger::GetStreamDirectoryName(stream_itr);
+
+    RemoveDirectory(wal_directory_path.c_str());
+  }
+}
+
+/**
+ * @brief the size of the wal log files of all streams, in bytes
+ */
+size_t GetLogSize() {
+  size_t log_size = 0;
+
+  for (int stream_itr = 0; stream_itr < state.log_stream_count; stream_itr++) {
+    std::string wal_directory_path = GetFilePath(
+        state.log_file_dir,
+        logging::WriteAheadFrontendLogger::GetStreamDirectoryName(stream_itr));
+
+    DIR* dir = opendir(wal_directory_path.c_str());
+    if (dir == nullptr) {
+      continue;
+    }
+
+    struct dirent* file;
+    while ((file = readdir(dir)) != nullptr) {
+      struct stat file_stat;
+      std::string file_path = GetFilePath(wal_directory_path, file->d_name);
+      if (stat(file_path.c_str(), &file_stat) == 0 &&
+          S_ISREG(file_stat.st_mode)) {
+        log_size += file_stat.st_size;
+      }
+    }
+    closedir(dir);
+  }
+
+  return log_size;
 }
 
 /**
@@ -256,6 +289,13 @@ bool PrepareLogFile() {
   auto& log_manager = logging::LogManager::GetInstance();
   log_manager.SetLogDirectoryName(state.log_file_dir);
 
+  // one log stream per group of cores
+  log_manager.Configure(peloton_logging_mode, false, state.log_stream_count,
+                        LOGGER_MAPPING_TYPE_AFFINITY);
+  if (state.recovery_thread_count > 0) {
+    log_manager.SetRecoveryThreadCount(state.recovery_thread_count);
+  }
+
   if (IsBasedOnWriteAheadLogging(peloton_logging_mode)) {
     log_manager.SetLogFileName(state.log_file_dir + "/" +
                                logging::WriteAheadFrontendLogger::wal_directory_path);
@@ -324,10 +364,38 @@ bool PrepareLogFile() {
     }
   }
 
+  double throughput = 0;
+  double duration = 0;
+  int backend_count = 0;
   if (state.benchmark_type == BENCHMARK_TYPE_YCSB) {
     ycsb::WriteOutput();
+    throughput = ycsb::state.throughput;
+    duration = ycsb::state.duration;
+    backend_count = ycsb::state.backend_count;
   } else if (state.benchmark_type == BENCHMARK_TYPE_TPCC) {
     tpcc::WriteOutput();
+    throughput = tpcc::state.throughput;
+    duration = tpcc::state.duration;
+    backend_count = tpcc::state.backend_count;
+  }
+
+  // Worker time (in us) and log volume of a transaction. The logging overhead
+  // of a transaction is the difference of its time with the one of a run with
+  // logging disabled.
+  if (throughput > 0) {
+    double transaction_time = backend_count * 1000000.0 / throughput;
+    double transaction_log_size = GetLogSize() / (throughput * duration);
+    LOG_INFO("transaction time: %lf us (%lf bytes of log)", transaction_time,
+             transaction_log_size);
+
+    if (state.experiment_type == EXPERIMENT_TYPE_LATENCY) {
+      std::ofstream out("outputfile-logging.summary");
+      out << state.asynchronous_mode << " ";
+      out << backend_count << " ";
+      out << transaction_time << " ";
+      out << transaction_log_size << "\n";
+      out.flush();
+    }
   }
 
   return true;
@@ -366,6 +434,8 @@ void DoRecovery() {
   std::thread thread;
   std::thread cp_thread;
 
+  size_t log_size = GetLogSize();
+
   timer.Start();
 
   // Do recovery
@@ -395,8 +465,26 @@ void DoRecovery() {
     tpcc::WriteOutput();
   }
 
-  // Recovery time (in ms)
-  LOG_INFO("recovery time: %lf", timer.GetDuration());
+  // Recovery time (in ms) and throughput (in MB/s)
+  double recovery_time = timer.GetDuration();
+  double recovery_throughput = 0;
+  if (recovery_time > 0) {
+    recovery_throughput =
+        (log_size / (1024.0 * 1024.0)) / (recovery_time / 1000.0);
+  }
+  LOG_INFO("recovery time: %lf", recovery_time);
+  LOG_INFO("recovery throughput: %lf MB/s (%lu bytes of log)",
+           recovery_throughput, log_size);
+
+  if (state.experiment_type == EXPERIMENT_TYPE_RECOVERY) {
+    std::ofstream out("outputfile-recovery.summary");
+    out << state.log_stream_count << " ";
+    out << state.recovery_thread_count << " ";
+    out << log_size << " ";
+    out << recovery_time << " ";
+    out << recovery_throughput << "\n";
+    out.flush();
+  }
 }
 
 //===--------------------------------------------------------------------===//
@@ -20,6 +20,7 @@
 #include "benchmark/tpcc/tpcc_loader.h"
 #include "benchmark/tpcc/tpcc_workload.h"
 
+#include "concurrency/transaction_manager_factory.h"
 #include "gc/gc_manager_factory.h"
 
 namespace peloton {
@@ -35,6 +36,11 @@ void RunBenchmark() {
     gc::GCManagerFactory::Configure(state.gc_backend_count);
   }
   
+  concurrency::TransactionManagerFactory::Configure(state.protocol);
+
+  concurrency::TransactionManagerFactory::GetInstance().SetTxnIdBatchSize(
+      state.txn_id_batch_size);
+
   gc::GCManagerFactory::GetInstance().StartGC();
   
   // Create the database
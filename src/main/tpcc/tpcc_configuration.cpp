@@ -36,6 +36,9 @@ void Usage(FILE *out) {
           "   -a --affinity          :  enable client affinity \n"
           "   -g --gc_mode           :  enable garbage collection \n"
           "   -n --gc_backend_count  :  # of gc backends \n"
+          "   -s --txn_id_batch_size :  # of txn ids a backend reserves \n"
+          "   -t --protocol          :  concurrency control: to (default), occ,\n"
+          "                             2pl_nowait, 2pl_waitdie or ssi\n"
   );
 }
 
@@ -50,6 +53,8 @@ static struct option opts[] = {
     { "affinity", no_argument, NULL, 'a' },
     { "gc_mode", no_argument, NULL, 'g' },
     { "gc_backend_count", optional_argument, NULL, 'n' },
+    { "txn_id_batch_size", optional_argument, NULL, 's' },
+    { "protocol", optional_argument, NULL, 't' },
     { NULL, 0, NULL, 0 }
 };
 
@@ -115,6 +120,26 @@ void ValidateGCBackendCount(const configuration &state) {
 }
 
 
+void ValidateTxnIdBatchSize(const configuration &state) {
+  if (state.txn_id_batch_size <= 0) {
+    LOG_ERROR("Invalid txn_id_batch_size :: %d", state.txn_id_batch_size);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_TRACE("%s : %d", "txn_id_batch_size", state.txn_id_batch_size);
+}
+
+void ValidateProtocol(const configuration &state) {
+  if (state.protocol != CONCURRENCY_TYPE_TIMESTAMP_ORDERING &&
+      state.protocol != CONCURRENCY_TYPE_OPTIMISTIC &&
+      state.protocol != CONCURRENCY_TYPE_TWO_PHASE_LOCKING_NO_WAIT &&
+      state.protocol != CONCURRENCY_TYPE_TWO_PHASE_LOCKING_WAIT_DIE &&
+      state.protocol != CONCURRENCY_TYPE_SERIALIZABLE_SNAPSHOT) {
+    LOG_ERROR("Invalid protocol");
+    exit(EXIT_FAILURE);
+  }
+}
+
 void ParseArguments(int argc, char *argv[], configuration &state) {
   // Default Values
   state.index = INDEX_TYPE_BWTREE;
@@ -127,11 +152,13 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   state.affinity = false;
   state.gc_mode = false;
   state.gc_backend_count = 1;
+  state.txn_id_batch_size = 1;
+  state.protocol = CONCURRENCY_TYPE_TIMESTAMP_ORDERING;
 
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "heagi:k:d:p:b:w:n:", opts, &idx);
+    int c = getopt_long(argc, argv, "heagi:k:d:p:b:w:n:s:t:", opts, &idx);
 
     if (c == -1) break;
 
@@ -175,6 +202,27 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'n':
         state.gc_backend_count = atof(optarg);
         break;
+      case 's':
+        state.txn_id_batch_size = atoi(optarg);
+        break;
+      case 't': {
+        char *protocol = optarg;
+        if (strcmp(protocol, "to") == 0) {
+          state.protocol = CONCURRENCY_TYPE_TIMESTAMP_ORDERING;
+        } else if (strcmp(protocol, "occ") == 0) {
+          state.protocol = CONCURRENCY_TYPE_OPTIMISTIC;
+        } else if (strcmp(protocol, "2pl_nowait") == 0) {
+          state.protocol = CONCURRENCY_TYPE_TWO_PHASE_LOCKING_NO_WAIT;
+        } else if (strcmp(protocol, "2pl_waitdie") == 0) {
+          state.protocol = CONCURRENCY_TYPE_TWO_PHASE_LOCKING_WAIT_DIE;
+        } else if (strcmp(protocol, "ssi") == 0) {
+          state.protocol = CONCURRENCY_TYPE_SERIALIZABLE_SNAPSHOT;
+        } else {
+          LOG_ERROR("Unknown protocol: %s", protocol);
+          exit(EXIT_FAILURE);
+        }
+        break;
+      }
 
       case 'h':
         Usage(stderr);
@@ -202,6 +250,8 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   ValidateBackendCount(state);
   ValidateWarehouseCount(state);
   ValidateGCBackendCount(state);
+  ValidateTxnIdBatchSize(state);
+  ValidateProtocol(state);
 
   LOG_TRACE("%s : %d", "Run client affinity", state.run_affinity);
   LOG_TRACE("%s : %d", "Run exponential backoff", state.run_backoff);
@@ -19,6 +19,7 @@
 #include "benchmark/ycsb/ycsb_loader.h"
 #include "benchmark/ycsb/ycsb_workload.h"
 
+#include "concurrency/transaction_manager_factory.h"
 #include "gc/gc_manager_factory.h"
 
 namespace peloton {
@@ -33,6 +34,11 @@ void RunBenchmark() {
     gc::GCManagerFactory::Configure(state.gc_backend_count);
   }
   
+  concurrency::TransactionManagerFactory::Configure(state.protocol);
+
+  concurrency::TransactionManagerFactory::GetInstance().SetTxnIdBatchSize(
+      state.txn_id_batch_size);
+
   gc::GCManagerFactory::GetInstance().StartGC();
 
   // Create the database
@@ -27,7 +27,7 @@ void Usage(FILE *out) {
   fprintf(out,
           "Command line options : ycsb <options> \n"
           "   -h --help              :  print help message \n"
-          "   -i --index             :  index type: bwtree (default) or btree\n"
+          "   -i --index             :  index type: bwtree (default), btree or hash\n"
           "   -k --scale_factor      :  # of K tuples \n"
           "   -d --duration          :  execution duration \n"
           "   -p --profile_duration  :  profile duration \n"
@@ -40,6 +40,9 @@ void Usage(FILE *out) {
           "   -m --string_mode       :  store strings \n"
           "   -g --gc_mode           :  enable garbage collection \n"
           "   -n --gc_backend_count  :  # of gc backends \n"
+          "   -s --txn_id_batch_size :  # of txn ids a backend reserves \n"
+          "   -t --protocol          :  concurrency control: to (default), occ,\n"
+          "                             2pl_nowait, 2pl_waitdie or ssi\n"
   );
 }
 
@@ -57,11 +60,14 @@ static struct option opts[] = {
     { "string_mode", no_argument, NULL, 'm' },
     { "gc_mode", no_argument, NULL, 'g' },
     { "gc_backend_count", optional_argument, NULL, 'n' },
+    { "txn_id_batch_size", optional_argument, NULL, 's' },
+    { "protocol", optional_argument, NULL, 't' },
     { NULL, 0, NULL, 0 }
 };
 
 void ValidateIndex(const configuration &state) {
-  if (state.index != INDEX_TYPE_BTREE && state.index != INDEX_TYPE_BWTREE) {
+  if (state.index != INDEX_TYPE_BTREE && state.index != INDEX_TYPE_BWTREE &&
+      state.index != INDEX_TYPE_HASH) {
     LOG_ERROR("Invalid index");
     exit(EXIT_FAILURE);
   }
@@ -148,6 +154,26 @@ void ValidateGCBackendCount(const configuration &state) {
   LOG_TRACE("%s : %d", "gc_backend_count", state.gc_backend_count);
 }
 
+void ValidateTxnIdBatchSize(const configuration &state) {
+  if (state.txn_id_batch_size <= 0) {
+    LOG_ERROR("Invalid txn_id_batch_size :: %d", state.txn_id_batch_size);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_TRACE("%s : %d", "txn_id_batch_size", state.txn_id_batch_size);
+}
+
+void ValidateProtocol(const configuration &state) {
+  if (state.protocol != CONCURRENCY_TYPE_TIMESTAMP_ORDERING &&
+      state.protocol != CONCURRENCY_TYPE_OPTIMISTIC &&
+      state.protocol != CONCURRENCY_TYPE_TWO_PHASE_LOCKING_NO_WAIT &&
+      state.protocol != CONCURRENCY_TYPE_TWO_PHASE_LOCKING_WAIT_DIE &&
+      state.protocol != CONCURRENCY_TYPE_SERIALIZABLE_SNAPSHOT) {
+    LOG_ERROR("Invalid protocol");
+    exit(EXIT_FAILURE);
+  }
+}
+
 void ParseArguments(int argc, char *argv[], configuration &state) {
   // Default Values
   state.index = INDEX_TYPE_BWTREE;
@@ -163,11 +189,13 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   state.string_mode = false;
   state.gc_mode = false;
   state.gc_backend_count = 1;
+  state.txn_id_batch_size = 1;
+  state.protocol = CONCURRENCY_TYPE_TIMESTAMP_ORDERING;
 
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "hemgi:k:d:p:b:c:o:u:z:n:", opts, &idx);
+    int c = getopt_long(argc, argv, "hemgi:k:d:p:b:c:o:u:z:n:s:t:", opts, &idx);
 
     if (c == -1) break;
 
@@ -178,6 +206,8 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
           state.index = INDEX_TYPE_BTREE;
         } else if (strcmp(index, "bwtree") == 0) {
           state.index = INDEX_TYPE_BWTREE;
+        } else if (strcmp(index, "hash") == 0) {
+          state.index = INDEX_TYPE_HASH;
         } else {
           LOG_ERROR("Unknown index: %s", index);
           exit(EXIT_FAILURE);
@@ -220,6 +250,27 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'n':
         state.gc_backend_count = atof(optarg);
         break;
+      case 's':
+        state.txn_id_batch_size = atoi(optarg);
+        break;
+      case 't': {
+        char *protocol = optarg;
+        if (strcmp(protocol, "to") == 0) {
+          state.protocol = CONCURRENCY_TYPE_TIMESTAMP_ORDERING;
+        } else if (strcmp(protocol, "occ") == 0) {
+          state.protocol = CONCURRENCY_TYPE_OPTIMISTIC;
+        } else if (strcmp(protocol, "2pl_nowait") == 0) {
+          state.protocol = CONCURRENCY_TYPE_TWO_PHASE_LOCKING_NO_WAIT;
+        } else if (strcmp(protocol, "2pl_waitdie") == 0) {
+          state.protocol = CONCURRENCY_TYPE_TWO_PHASE_LOCKING_WAIT_DIE;
+        } else if (strcmp(protocol, "ssi") == 0) {
+          state.protocol = CONCURRENCY_TYPE_SERIALIZABLE_SNAPSHOT;
+        } else {
+          LOG_ERROR("Unknown protocol: %s", protocol);
+          exit(EXIT_FAILURE);
+        }
+        break;
+      }
         
       case 'h':
         Usage(stderr);
@@ -245,6 +296,8 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   ValidateUpdateRatio(state);
   ValidateZipfTheta(state);
   ValidateGCBackendCount(state);
+  ValidateTxnIdBatchSize(state);
+  ValidateProtocol(state);
 
   LOG_TRACE("%s : %d", "Run exponential backoff", state.run_backoff);
   LOG_TRACE("%s : %d", "Run string mode", state.string_mode);
@@ -216,6 +216,18 @@ bool PacketManager::HardcodedExecuteFilter(std::string query_type) {
   return true;
 }
 
+void PacketManager::UpdateTxnReadOnly(const Statement &statement) {
+  auto query_type =
+      boost::to_upper_copy(get_query_type(statement.GetQueryString()));
+
+  // the access mode of BEGIN comes from its parse tree
+  if (!query_type.compare("BEGIN")) {
+    txn_read_only_ = statement.IsReadOnlyBegin();
+  } else if (!query_type.compare("COMMIT") || !query_type.compare("ROLLBACK")) {
+    txn_read_only_ = false;
+  }
+}
+
 // The Simple Query Protocol
 void PacketManager::ExecQueryMessage(Packet *pkt, ResponseBuffer &responses) {
   std::string q_str;
@@ -247,9 +259,17 @@ void PacketManager::ExecQueryMessage(Packet *pkt, ResponseBuffer &responses) {
       std::string error_message;
       int rows_affected;
 
-      // execute the query using tcop
-      auto status = tcop.ExecuteStatement(query, result, tuple_descriptor,
-                                          rows_affected, error_message);
+      // prepare and execute the query using tcop
+      auto statement =
+          tcop.PrepareStatement("unnamed", query, error_message);
+      auto status = Result::RESULT_FAILURE;
+      if (statement.get() != nullptr) {
+        std::vector<int> result_format(statement->GetTupleDescriptor().size(),
+                                       0);
+        status = tcop.ExecuteStatement(statement, true, result_format, result,
+                                       rows_affected, error_message,
+                                       txn_read_only_);
+      }
 
       // check status
       if (status == Result::RESULT_FAILURE) {
@@ -257,6 +277,9 @@ void PacketManager::ExecQueryMessage(Packet *pkt, ResponseBuffer &responses) {
         break;
       }
 
+      tuple_descriptor = statement->GetTupleDescriptor();
+      UpdateTxnReadOnly(*statement);
+
       // send the attribute names
       PutTupleDescriptor(tuple_descriptor, responses);
 
@@ -608,13 +631,16 @@ void PacketManager::ExecExecuteMessage(Packet *pkt, ResponseBuffer &responses) {
   bool unnamed = statement_name.empty();
 
   auto &tcop = tcop::TrafficCop::GetInstance();
-  auto status = tcop.ExecuteStatement(statement, unnamed, result_format_,
-                                      results, rows_affected, error_message);
+  auto status =
+      tcop.ExecuteStatement(statement, unnamed, result_format_, results,
+                            rows_affected, error_message, txn_read_only_);
 
   if (status == Result::RESULT_FAILURE) {
     LOG_ERROR("Failed to execute: %s", error_message.c_str());
     SendErrorResponse({{'M', error_message}}, responses);
     SendReadyForQuery(txn_state_, responses);
+  } else {
+    UpdateTxnReadOnly(*statement);
   }
   // put_row_desc(portal->rowdesc, responses);
   auto tuple_descriptor = statement->GetTupleDescriptor();
@@ -215,7 +215,7 @@ struct PARSER_CUST_LTYPE {
 %type <drop_stmt>	drop_statement
 %type <txn_stmt>    transaction_statement
 %type <sval> 		opt_alias alias
-%type <bval> 		opt_not_exists opt_exists opt_distinct opt_notnull opt_primary opt_unique opt_update
+%type <bval> 		opt_not_exists opt_exists opt_distinct opt_notnull opt_primary opt_unique opt_update opt_read_only
 %type <uval>		opt_join_type column_type opt_column_width opt_index_type
 %type <table> 		from_clause table_ref table_ref_atomic table_ref_name
 %type <table>		join_clause join_table table_ref_name_no_alias
@@ -486,14 +486,15 @@ opt_exists:
 
 /******************************
  * Transaction Statement
- * BEGIN [ TRANSACTION ]
+ * BEGIN [ TRANSACTION ] [ READ ONLY ]
  * COMMIT [ TRANSACTION ]
  * ROLLBACK [ TRANSACTION ]
  ******************************/
 
 transaction_statement:
-	BEGIN opt_transaction { 
+	BEGIN opt_transaction opt_read_only { 
 		$$ = new TransactionStatement(TransactionStatement::kBegin);
+		$$->read_only = $3;
 	}
 	| COMMIT opt_transaction {
 		$$ = new TransactionStatement(TransactionStatement::kCommit);
@@ -507,6 +508,21 @@ opt_transaction:
 	| TRANSACTION
 	;
 
+/* READ and ONLY are not reserved, so they stay valid identifiers */
+opt_read_only:
+		IDENTIFIER IDENTIFIER {
+			bool read_only = (strcmp($1, "read") == 0 && strcmp($2, "only") == 0);
+			free($1);
+			free($2);
+			if (!read_only) {
+				yyerror(&@1, result, scanner, "syntax error, expected READ ONLY");
+				YYABORT;
+			}
+			$$ = true;
+		}
+	|	/* empty */ { $$ = false; }
+	;
+
 /******************************
  * Delete Statement / Truncate statement
  * DELETE FROM students WHERE grade > 3.0
@@ -41,7 +41,8 @@ BackendStatsContext* BackendStatsContext::GetInstance() {
 
 BackendStatsContext::BackendStatsContext(size_t max_latency_history,
                                          bool regiser_to_aggregator)
-    : txn_latencies_(LATENCY_METRIC, max_latency_history) {
+    : txn_latencies_(LATENCY_METRIC, max_latency_history),
+      version_chain_metric_(VERSION_CHAIN_METRIC) {
   std::thread::id this_id = std::this_thread::get_id();
   thread_id_ = this_id;
 
@@ -96,6 +97,10 @@ LatencyMetric& BackendStatsContext::GetTxnLatencyMetric() {
   return txn_latencies_;
 }
 
+VersionChainMetric& BackendStatsContext::GetVersionChainMetric() {
+  return version_chain_metric_;
+}
+
 void BackendStatsContext::IncrementTableReads(oid_t tile_group_id) {
   oid_t table_id =
       catalog::Manager::GetInstance().GetTileGroup(tile_group_id)->GetTableId();
@@ -206,6 +211,14 @@ void BackendStatsContext::IncrementTxnAborted(oid_t database_id) {
   CompleteQueryMetric();
 }
 
+void BackendStatsContext::RecordVersionChainLength(size_t chain_length) {
+  version_chain_metric_.RecordChainLength(chain_length);
+}
+
+void BackendStatsContext::IncrementPrunedVersions(size_t prune_count) {
+  version_chain_metric_.IncrementPrunedVersions(prune_count);
+}
+
 void BackendStatsContext::InitQueryMetric(std::string query_string,
                                           oid_t database_oid) {
   ongoing_query_metric_.reset(
@@ -222,6 +235,7 @@ void BackendStatsContext::Aggregate(BackendStatsContext& source) {
   // Aggregate all global metrics
   txn_latencies_.Aggregate(source.txn_latencies_);
   txn_latencies_.ComputeLatencies();
+  version_chain_metric_.Aggregate(source.version_chain_metric_);
 
   // Aggregate all per-database metrics
   for (auto& database_item : source.database_metrics_) {
@@ -256,6 +270,7 @@ void BackendStatsContext::Aggregate(BackendStatsContext& source) {
 
 void BackendStatsContext::Reset() {
   txn_latencies_.Reset();
+  version_chain_metric_.Reset();
 
   for (auto& database_item : database_metrics_) {
     database_item.second->Reset();
@@ -311,6 +326,7 @@ std::string BackendStatsContext::ToString() const {
   std::stringstream ss;
 
   ss << txn_latencies_.GetInfo() << std::endl;
+  ss << version_chain_metric_.GetInfo() << std::endl;
 
   for (auto& database_item : database_metrics_) {
     oid_t database_id = database_item.second->GetDatabaseId();
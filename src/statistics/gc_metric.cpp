@@ -0,0 +1,82 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// gc_metric.cpp
+//
+// Identification: src/statistics/gc_metric.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+
+#include "statistics/gc_metric.h"
+#include "common/macros.h"
+#include "gc/gc_manager.h"
+
+namespace peloton {
+namespace stats {
+
+GCMetric::GCMetric(MetricType type) : AbstractMetric(type) {}
+
+void GCMetric::Sample(gc::GCManager &gc_manager, double interval_seconds) {
+  size_t reclaimed_versions = gc_manager.GetReclaimedVersionCount();
+  if (interval_seconds > 0 && reclaimed_versions >= reclaimed_versions_) {
+    reclaim_rate_ =
+        (reclaimed_versions - reclaimed_versions_) / interval_seconds;
+  }
+  reclaimed_versions_ = reclaimed_versions;
+
+  unlink_backlog_ = gc_manager.GetUnlinkBacklog();
+  reclaim_backlog_ = gc_manager.GetReclaimBacklog();
+  oldest_unreclaimed_cid_ = gc_manager.GetOldestUnreclaimedCid();
+  dead_version_bytes_ = gc_manager.GetDeadVersionBytes();
+  active_thread_count_ = gc_manager.GetActiveThreadCount();
+}
+
+void GCMetric::Reset() {
+  unlink_backlog_ = 0;
+  reclaim_backlog_ = 0;
+  reclaimed_versions_ = 0;
+  reclaim_rate_ = 0;
+  oldest_unreclaimed_cid_ = MAX_CID;
+  dead_version_bytes_ = 0;
+  active_thread_count_ = 0;
+}
+
+void GCMetric::Aggregate(AbstractMetric &source) {
+  PL_ASSERT(source.GetType() == GC_METRIC);
+
+  GCMetric &gc_metric = static_cast<GCMetric &>(source);
+  unlink_backlog_ += gc_metric.GetUnlinkBacklog();
+  reclaim_backlog_ += gc_metric.GetReclaimBacklog();
+  reclaimed_versions_ += gc_metric.GetReclaimedVersions();
+  reclaim_rate_ += gc_metric.GetReclaimRate();
+  oldest_unreclaimed_cid_ =
+      std::min(oldest_unreclaimed_cid_, gc_metric.GetOldestUnreclaimedCid());
+  dead_version_bytes_ += gc_metric.GetDeadVersionBytes();
+  active_thread_count_ += gc_metric.GetActiveThreadCount();
+}
+
+const std::string GCMetric::GetInfo() const {
+  std::stringstream ss;
+  ss << "GC THREADS: " << active_thread_count_ << std::endl;
+  ss << "# garbage contexts to unlink: " << unlink_backlog_ << std::endl;
+  ss << "# garbage contexts to reclaim: " << reclaim_backlog_ << std::endl;
+  ss << "# versions reclaimed: " << reclaimed_versions_ << " ("
+     << reclaim_rate_ << " per second)" << std::endl;
+  ss << "Oldest unreclaimed cid: ";
+  if (oldest_unreclaimed_cid_ == MAX_CID) {
+    ss << "none";
+  } else {
+    ss << oldest_unreclaimed_cid_;
+  }
+  ss << std::endl;
+  ss << "Dead version bytes: " << dead_version_bytes_ << std::endl;
+  return ss.str();
+}
+
+}  // namespace stats
+}  // namespace peloton
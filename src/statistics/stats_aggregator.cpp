@@ -19,6 +19,7 @@
 #include "statistics/backend_stats_context.h"
 #include "catalog/catalog.h"
 #include "catalog/catalog_util.h"
+#include "gc/gc_manager_factory.h"
 
 namespace peloton {
 namespace stats {
@@ -112,6 +113,10 @@ void StatsAggregator::Aggregate(int64_t &interval_cnt, double &alpha,
   LOG_INFO("Moving avg. throughput: %lf txn/s\n", weighted_avg_throughput);
   LOG_INFO("Current throughput:     %lf txn/s\n\n", throughput_);
 
+  gc_metric_.Sample(gc::GCManagerFactory::GetInstance(),
+                    (double)aggregation_interval_ms_ / 1000);
+  LOG_INFO("%s\n", gc_metric_.GetInfo().c_str());
+
   // Write the stats to metric tables
   UpdateMetrics();
 
@@ -123,6 +128,7 @@ void StatsAggregator::Aggregate(int64_t &interval_cnt, double &alpha,
            << std::endl;
       ofs_ << "Average throughput=" << avg_throughput_ << std::endl;
       ofs_ << "Current throughput=" << throughput_ << std::endl;
+      ofs_ << gc_metric_.GetInfo();
     }
     catch (std::ofstream::failure &e) {
       LOG_ERROR("Error when writing to the stats log file %s", e.what());
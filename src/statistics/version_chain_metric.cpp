@@ -0,0 +1,55 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// version_chain_metric.cpp
+//
+// Identification: src/statistics/version_chain_metric.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "statistics/version_chain_metric.h"
+#include "common/macros.h"
+
+namespace peloton {
+namespace stats {
+
+VersionChainMetric::VersionChainMetric(MetricType type)
+    : AbstractMetric(type),
+      chain_lengths_(VERSION_CHAIN_HISTOGRAM_BUCKETS,
+                     CounterMetric(MetricType::COUNTER_METRIC)) {}
+
+void VersionChainMetric::Aggregate(AbstractMetric &source) {
+  PL_ASSERT(source.GetType() == VERSION_CHAIN_METRIC);
+
+  VersionChainMetric &chain_metric = static_cast<VersionChainMetric &>(source);
+  for (size_t bucket = 0; bucket < VERSION_CHAIN_HISTOGRAM_BUCKETS; bucket++) {
+    chain_lengths_[bucket].Aggregate(chain_metric.GetChainLengthCount(bucket));
+  }
+  pruned_versions_.Aggregate(chain_metric.GetPrunedVersions());
+}
+
+const std::string VersionChainMetric::GetInfo() const {
+  std::stringstream ss;
+  ss << "VERSION CHAIN LENGTH: [ ";
+  for (size_t bucket = 0; bucket < VERSION_CHAIN_HISTOGRAM_BUCKETS; bucket++) {
+    if (bucket > 0) {
+      ss << ", ";
+    }
+    ss << (1 << bucket);
+    if (bucket + 1 < VERSION_CHAIN_HISTOGRAM_BUCKETS) {
+      ss << "-" << (1 << (bucket + 1)) - 1;
+    } else {
+      ss << "+";
+    }
+    ss << "=" << chain_lengths_[bucket].GetInfo();
+  }
+  ss << " ]" << std::endl;
+  ss << "# versions pruned: " << pruned_versions_.GetInfo() << std::endl;
+  return ss.str();
+}
+
+}  // namespace stats
+}  // namespace peloton
@@ -10,6 +10,7 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <memory>
 #include <mutex>
 #include <utility>
 
@@ -149,15 +150,16 @@ ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple) {
   }
   //====================================================
 
-  size_t active_tile_group_id = number_of_tuples_ % ACTIVE_TILEGROUP_COUNT;
+  size_t active_tile_group_id = GetActiveTileGroupId();
   std::shared_ptr<storage::TileGroup> tile_group;
   oid_t tuple_slot = INVALID_OID;
   oid_t tile_group_id = INVALID_OID;
 
   // get valid tuple.
   while (true) {
-    // get the last tile group.
-    tile_group = active_tile_groups_[active_tile_group_id];
+    // get the last tile group. another thread that maps to the same slot may
+    // replace it at any time.
+    tile_group = std::atomic_load(&active_tile_groups_[active_tile_group_id]);
 
     tuple_slot = tile_group->InsertTuple(tuple);
 
@@ -292,43 +294,50 @@ ItemPointer DataTable::InsertTuple(const storage::Tuple *tuple) {
   return location;
 }
 
-/**
- * @brief Insert a tuple into all indexes. If index is primary/unique,
- * check visibility of existing
- * index entries.
- * @warning This still doesn't guarantee serializability.
- *
- * @returns True on success, false if a visible entry exists (in case of
- *primary/unique).
- */
-bool DataTable::InsertInIndexes(const storage::Tuple *tuple,
-                                ItemPointer location,
-                                concurrency::Transaction *transaction,
-                                ItemPointer **index_entry_ptr) {
-
-  int index_count = GetIndexCount();
-
+ItemPointer *DataTable::AllocateIndirection(const ItemPointer &location) {
   size_t active_indirection_array_id = number_of_tuples_ % ACTIVE_INDIRECTION_ARRAY_COUNT;
 
   size_t indirection_offset = INVALID_INDIRECTION_OFFSET;
-  
+  ItemPointer *indirection = nullptr;
+
   while (true) {
     auto active_indirection_array = active_indirection_arrays_[active_indirection_array_id];
     indirection_offset = active_indirection_array->AllocateIndirection();
 
     if (indirection_offset != INVALID_INDIRECTION_OFFSET) {
-      *index_entry_ptr = active_indirection_array->GetIndirectionByOffset(indirection_offset);
+      indirection = active_indirection_array->GetIndirectionByOffset(indirection_offset);
       break;
     }
   }
 
-  (*index_entry_ptr)->block = location.block;
-  (*index_entry_ptr)->offset = location.offset;
+  indirection->block = location.block;
+  indirection->offset = location.offset;
 
   if (indirection_offset == INDIRECTION_ARRAY_MAX_SIZE - 1) {
     AddDefaultIndirectionArray(active_indirection_array_id);
   }
 
+  return indirection;
+}
+
+/**
+ * @brief Insert a tuple into all indexes. If index is primary/unique,
+ * check visibility of existing
+ * index entries.
+ * @warning This still doesn't guarantee serializability.
+ *
+ * @returns True on success, false if a visible entry exists (in case of
+ *primary/unique).
+ */
+bool DataTable::InsertInIndexes(const storage::Tuple *tuple,
+                                ItemPointer location,
+                                concurrency::Transaction *transaction,
+                                ItemPointer **index_entry_ptr) {
+
+  int index_count = GetIndexCount();
+
+  *index_entry_ptr = AllocateIndirection(location);
+
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
 
@@ -620,6 +629,31 @@ oid_t DataTable::AddDefaultIndirectionArray(const size_t &active_indirection_arr
   return indirection_array_id;
 }
 
+size_t DataTable::GetActiveTileGroupId() {
+  if (per_thread_insertion_ == false) {
+    return number_of_tuples_ % ACTIVE_TILEGROUP_COUNT;
+  }
+
+  // threads are numbered on their first insert into any table
+  static std::atomic<size_t> insertion_thread_count(0);
+  thread_local static size_t insertion_thread_id = insertion_thread_count++;
+
+  size_t active_tile_group_id =
+      insertion_thread_id % PER_THREAD_TILEGROUP_COUNT;
+
+  // the threads that hash to the same tile group create it only once
+  if (std::atomic_load(&active_tile_groups_[active_tile_group_id]) ==
+      nullptr) {
+    std::lock_guard<std::mutex> lock(data_table_mutex_);
+    if (std::atomic_load(&active_tile_groups_[active_tile_group_id]) ==
+        nullptr) {
+      AddDefaultTileGroup(active_tile_group_id);
+    }
+  }
+
+  return active_tile_group_id;
+}
+
 oid_t DataTable::AddDefaultTileGroup() {
   size_t active_tile_group_id = number_of_tuples_ % ACTIVE_TILEGROUP_COUNT;
   return AddDefaultTileGroup(active_tile_group_id);
@@ -647,7 +681,7 @@ oid_t DataTable::AddDefaultTileGroup(const size_t &active_tile_group_id) {
   
   COMPILER_MEMORY_FENCE;
 
-  active_tile_groups_[active_tile_group_id] = tile_group;
+  std::atomic_store(&active_tile_groups_[active_tile_group_id], tile_group);
 
   // we must guarantee that the compiler always add tile group before adding
   // tile_group_count_.
@@ -663,6 +697,10 @@ oid_t DataTable::AddDefaultTileGroup(const size_t &active_tile_group_id) {
 void DataTable::AddTileGroupWithOidForRecovery(const oid_t &tile_group_id) {
   PL_ASSERT(tile_group_id);
 
+  // the log streams are replayed in parallel, and may all find the same tile
+  // group missing
+  std::lock_guard<std::mutex> lock(data_table_mutex_);
+
   std::vector<catalog::Schema> schemas;
   schemas.push_back(*schema);
 
@@ -703,7 +741,7 @@ void DataTable::AddTileGroup(const std::shared_ptr<TileGroup> &tile_group) {
 
   size_t active_tile_group_id = number_of_tuples_ % ACTIVE_TILEGROUP_COUNT;
 
-  active_tile_groups_[active_tile_group_id] = tile_group;
+  std::atomic_store(&active_tile_groups_[active_tile_group_id], tile_group);
 
   oid_t tile_group_id = tile_group->GetTileGroupId();
 
@@ -727,12 +765,29 @@ std::shared_ptr<storage::TileGroup> DataTable::GetTileGroup(
     const std::size_t &tile_group_offset) const {
   PL_ASSERT(tile_group_offset < GetTileGroupCount());
 
-  auto tile_group_id =
-      tile_groups_.FindValid(tile_group_offset, invalid_tile_group_id);
+  auto tile_group_id = tile_groups_.Find(tile_group_offset);
+  if (tile_group_id == invalid_tile_group_id) {
+    return nullptr;
+  }
 
   return GetTileGroupById(tile_group_id);
 }
 
+void DataTable::DropTileGroup(const std::size_t &tile_group_offset) {
+  PL_ASSERT(tile_group_offset < GetTileGroupCount());
+
+  auto tile_group_id = tile_groups_.Find(tile_group_offset);
+  if (tile_group_id == invalid_tile_group_id) {
+    return;
+  }
+
+  // the offsets of the other tile groups do not move, so that concurrent
+  // scans neither skip nor repeat any of them
+  tile_groups_.Erase(tile_group_offset, invalid_tile_group_id);
+  catalog::Manager::GetInstance().DropTileGroup(tile_group_id);
+  LOG_TRACE("Dropped tile group %u", tile_group_id);
+}
+
 std::shared_ptr<storage::TileGroup> DataTable::GetTileGroupById(
     const oid_t &tile_group_id) const {
   auto &manager = catalog::Manager::GetInstance();
@@ -775,6 +830,9 @@ const std::string DataTable::GetInfo() const {
   for (oid_t tile_group_itr = 0; tile_group_itr < tile_group_count;
        tile_group_itr++) {
     auto tile_group = GetTileGroup(tile_group_itr);
+    if (tile_group == nullptr) {
+      continue;
+    }
     table_id = tile_group->GetTableId();
     auto tile_tuple_count = tile_group->GetNextTupleSlot();
 
@@ -983,6 +1041,9 @@ void SetTransformedTileGroup(storage::TileGroup *orig_tile_group,
   auto header = orig_tile_group->GetHeader();
   auto new_header = new_tile_group->GetHeader();
   *new_header = *header;
+
+  // The tiles were written directly, so the zone map must be rebuilt
+  new_tile_group->InvalidateZoneMap();
 }
 
 storage::TileGroup *DataTable::TransformTileGroup(
@@ -993,12 +1054,20 @@ storage::TileGroup *DataTable::TransformTileGroup(
     return nullptr;
   }
 
-  auto tile_group_id =
-      tile_groups_.FindValid(tile_group_offset, invalid_tile_group_id);
+  auto tile_group_id = tile_groups_.Find(tile_group_offset);
+  if (tile_group_id == invalid_tile_group_id) {
+    return nullptr;
+  }
 
   // Get orig tile group from catalog
   auto &catalog_manager = catalog::Manager::GetInstance();
   auto tile_group = catalog_manager.GetTileGroup(tile_group_id);
+
+  // a tile group that is being compacted is about to be dropped
+  if (tile_group == nullptr || tile_group->GetHeader()->GetImmutability()) {
+    return nullptr;
+  }
+
   auto diff = tile_group->GetSchemaDifference(default_partition_);
 
   // Check threshold for transformation
@@ -120,6 +120,17 @@ common::Value *Tile::GetValue(const oid_t tuple_offset, const oid_t column_id) {
   return common::Value::DeserializeFrom(field_location, column_type, is_inlined);
 }
 
+common::TypedValue Tile::GetTypedValue(const oid_t tuple_offset,
+                                       const oid_t column_id) const {
+  PL_ASSERT(tuple_offset < GetAllocatedTupleCount());
+  PL_ASSERT(column_id < schema.GetColumnCount());
+
+  const char *field_location =
+      GetTupleLocation(tuple_offset) + schema.GetOffset(column_id);
+  return common::TypedValue::DeserializeFrom(field_location,
+                                             schema.GetType(column_id));
+}
+
 /*
  * Faster way to get value
  * By amortizing schema lookups
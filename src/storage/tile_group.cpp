@@ -53,6 +53,14 @@ TileGroup::TileGroup(BackendType backend_type,
     // Add a reference to the tile in the tile group
     tiles.push_back(tile);
   }
+
+  std::vector<common::Type::TypeId> column_types;
+  for (auto &column_map_entry : column_map) {
+    auto &tile_location = column_map_entry.second;
+    column_types.push_back(
+        tile_schemas[tile_location.first].GetType(tile_location.second));
+  }
+  zone_map.reset(new ZoneMap(column_types));
 }
 
 TileGroup::~TileGroup() {
@@ -118,6 +126,7 @@ void TileGroup::CopyTuple(const Tuple *tuple, const oid_t &tuple_slot_id) {
          tile_column_itr++) {
       std::unique_ptr<common::Value> val(tuple->GetValue(column_itr));
       tile_tuple.SetValue(tile_column_itr, *val, tile->GetPool());
+      zone_map->Update(column_itr, tuple->GetTypedValue(column_itr));
       column_itr++;
     }
   }
@@ -213,6 +222,7 @@ oid_t TileGroup::InsertTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
          tile_column_itr++) {
       std::unique_ptr<common::Value> val(tuple->GetValue(column_itr));
       tile_tuple.SetValue(tile_column_itr, *val, tile->GetPool());
+      zone_map->Update(column_itr, tuple->GetTypedValue(column_itr));
       column_itr++;
     }
   }
@@ -222,6 +232,7 @@ oid_t TileGroup::InsertTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
   tile_group_header->SetBeginCommitId(tuple_slot_id, commit_id);
   tile_group_header->SetEndCommitId(tuple_slot_id, MAX_CID);
   tile_group_header->SetNextItemPointer(tuple_slot_id, INVALID_ITEMPOINTER);
+  tile_group_header->SetModifiedCommitId(commit_id);
 
   tile_group_header->GetHeaderLock().Unlock();
 
@@ -248,6 +259,7 @@ oid_t TileGroup::DeleteTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id) {
   tile_group_header->SetBeginCommitId(tuple_slot_id, commit_id);
   tile_group_header->SetEndCommitId(tuple_slot_id, commit_id);
   tile_group_header->SetNextItemPointer(tuple_slot_id, INVALID_ITEMPOINTER);
+  tile_group_header->SetModifiedCommitId(commit_id);
   tile_group_header->GetHeaderLock().Unlock();
   return tuple_slot_id;
 }
@@ -274,6 +286,7 @@ oid_t TileGroup::UpdateTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
   tile_group_header->SetBeginCommitId(tuple_slot_id, commit_id);
   tile_group_header->SetEndCommitId(tuple_slot_id, commit_id);
   tile_group_header->SetNextItemPointer(tuple_slot_id, new_location);
+  tile_group_header->SetModifiedCommitId(commit_id);
   tile_group_header->GetHeaderLock().Unlock();
   return tuple_slot_id;
 }
@@ -313,6 +326,7 @@ oid_t TileGroup::InsertTupleFromCheckpoint(oid_t tuple_slot_id,
          tile_column_itr++) {
       std::unique_ptr<common::Value> val(tuple->GetValue(column_itr));
       tile_tuple.SetValue(tile_column_itr, *val, tile->GetPool());
+      zone_map->Update(column_itr, tuple->GetTypedValue(column_itr));
       column_itr++;
     }
   }
@@ -357,11 +371,38 @@ common::Value *TileGroup::GetValue(oid_t tuple_id, oid_t column_id) {
   return GetTile(tile_offset)->GetValue(tuple_id, tile_column_id);
 }
 
+common::TypedValue TileGroup::GetTypedValue(oid_t tuple_id, oid_t column_id) {
+  PL_ASSERT(tuple_id < GetNextTupleSlot());
+  oid_t tile_column_id, tile_offset;
+  LocateTileAndColumn(column_id, tile_offset, tile_column_id);
+  return GetTile(tile_offset)->GetTypedValue(tuple_id, tile_column_id);
+}
+
 void TileGroup::SetValue(common::Value &value, oid_t tuple_id, oid_t column_id) {
   PL_ASSERT(tuple_id < GetNextTupleSlot());
   oid_t tile_column_id, tile_offset;
   LocateTileAndColumn(column_id, tile_offset, tile_column_id);
   GetTile(tile_offset)->SetValue(value, tuple_id, tile_column_id);
+  if (zone_map->IsSummarized(column_id))
+    zone_map->Update(column_id, common::TypedValue::FromValue(value));
+}
+
+const ZoneMap &TileGroup::GetZoneMap() {
+  if (zone_map->IsValid()) return *zone_map;
+
+  std::lock_guard<std::mutex> lock(tile_group_mutex);
+  if (zone_map->IsValid()) return *zone_map;
+
+  // Widen the summary with every slot in use, whatever its visibility
+  oid_t tuple_count = GetNextTupleSlot();
+  for (oid_t column_itr = 0; column_itr < zone_map->GetColumnCount();
+       column_itr++) {
+    if (zone_map->IsSummarized(column_itr) == false) continue;
+    for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++)
+      zone_map->Update(column_itr, GetTypedValue(tuple_itr, column_itr));
+  }
+  zone_map->Validate();
+  return *zone_map;
 }
 
 
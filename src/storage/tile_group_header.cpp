@@ -35,6 +35,8 @@ TileGroupHeader::TileGroupHeader(const BackendType &backend_type,
       data(nullptr),
       num_tuple_slots(tuple_count),
       next_tuple_slot(0),
+      modified_commit_id(INVALID_CID),
+      immutable(false),
       tile_header_lock() {
   header_size = num_tuple_slots * header_entry_size;
 
@@ -40,6 +40,13 @@ common::Value *Tuple::GetValue(oid_t column_id) const {
   return common::Value::DeserializeFrom(data_ptr, column_type, is_inlined);
 }
 
+common::TypedValue Tuple::GetTypedValue(oid_t column_id) const {
+  PL_ASSERT(tuple_schema);
+  PL_ASSERT(tuple_data);
+  return common::TypedValue::DeserializeFrom(
+      GetDataPtr(column_id), tuple_schema->GetType(column_id));
+}
+
 // Set all columns by value into this tuple.
 void Tuple::SetValue(const oid_t column_offset, const common::Value &value,
                      common::VarlenPool *data_pool) {
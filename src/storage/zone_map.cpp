@@ -0,0 +1,210 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map.cpp
+//
+// Identification: src/storage/zone_map.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "storage/zone_map.h"
+
+#include <cstring>
+#include <limits>
+
+namespace peloton {
+namespace storage {
+
+using namespace peloton::common;
+
+namespace {
+
+bool IsSummarizedType(Type::TypeId type_id) {
+  switch (type_id) {
+    case Type::BOOLEAN:
+    case Type::TINYINT:
+    case Type::SMALLINT:
+    case Type::INTEGER:
+    case Type::BIGINT:
+    case Type::DECIMAL:
+    case Type::TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+const int64_t kSignBit = std::numeric_limits<int64_t>::min();
+
+// Map a non-null value onto a signed 64-bit key with the same order
+int64_t GetKey(const TypedValue &value) {
+  switch (value.GetTypeId()) {
+    case Type::BOOLEAN:
+      return value.GetAs<int8_t>();
+    case Type::TIMESTAMP:
+      return static_cast<int64_t>(value.GetAs<uint64_t>()) ^ kSignBit;
+    case Type::DECIMAL: {
+      // -0.0 and 0.0 compare equal, so they must share a key
+      double decimal = value.GetAs<double>();
+      if (decimal == 0) decimal = 0;
+      int64_t bits;
+      memcpy(&bits, &decimal, sizeof(bits));
+      // Negative doubles order backwards when read as integers
+      return (bits < 0) ? (bits ^ std::numeric_limits<int64_t>::max()) : bits;
+    }
+    default:
+      return value.GetAsBigInt();
+  }
+}
+
+TypedValue GetValue(Type::TypeId type_id, int64_t key) {
+  switch (type_id) {
+    case Type::BOOLEAN:
+      return TypedValue::GetBoolean(static_cast<int8_t>(key));
+    case Type::TINYINT:
+      return TypedValue(static_cast<int8_t>(key));
+    case Type::SMALLINT:
+      return TypedValue(static_cast<int16_t>(key));
+    case Type::INTEGER:
+      return TypedValue(static_cast<int32_t>(key));
+    case Type::TIMESTAMP:
+      return TypedValue::GetTimestamp(static_cast<uint64_t>(key ^ kSignBit));
+    case Type::DECIMAL: {
+      int64_t bits =
+          (key < 0) ? (key ^ std::numeric_limits<int64_t>::max()) : key;
+      double decimal;
+      memcpy(&decimal, &bits, sizeof(decimal));
+      return TypedValue(decimal);
+    }
+    default:
+      return TypedValue(key);
+  }
+}
+
+bool IsComparison(ExpressionType op) {
+  switch (op) {
+    case (EXPRESSION_TYPE_COMPARE_EQUAL):
+    case (EXPRESSION_TYPE_COMPARE_NOTEQUAL):
+    case (EXPRESSION_TYPE_COMPARE_LESSTHAN):
+    case (EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO):
+    case (EXPRESSION_TYPE_COMPARE_GREATERTHAN):
+    case (EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO):
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool IsComparable(const TypedValue &left, const TypedValue &right) {
+  bool left_numeric =
+      (left.IsInteger() || left.GetTypeId() == Type::DECIMAL);
+  bool right_numeric =
+      (right.IsInteger() || right.GetTypeId() == Type::DECIMAL);
+  if (left_numeric || right_numeric) return (left_numeric && right_numeric);
+  return (left.GetTypeId() == right.GetTypeId());
+}
+
+}  // namespace
+
+ZoneMap::ZoneMap(const std::vector<Type::TypeId> &column_types)
+    : column_count_(column_types.size()),
+      columns_(new ColumnSummary[column_types.size()]),
+      valid_(true) {
+  for (oid_t column_itr = 0; column_itr < column_count_; column_itr++) {
+    auto &column = columns_[column_itr];
+    column.type_id = column_types[column_itr];
+    column.min = std::numeric_limits<int64_t>::max();
+    column.max = std::numeric_limits<int64_t>::min();
+    column.null_count = 0;
+  }
+}
+
+bool ZoneMap::IsSummarized(oid_t column_id) const {
+  PL_ASSERT(column_id < column_count_);
+  return IsSummarizedType(columns_[column_id].type_id);
+}
+
+void ZoneMap::Update(oid_t column_id, const TypedValue &value) {
+  PL_ASSERT(column_id < column_count_);
+  auto &column = columns_[column_id];
+  if (IsSummarizedType(column.type_id) == false) return;
+
+  if (value.IsNull()) {
+    column.null_count++;
+    return;
+  }
+
+  // Bounds only move outwards, so a failed CAS just needs a retry when the
+  // value is still outside of the new bound
+  int64_t key = GetKey(value);
+  int64_t min = column.min.load();
+  while (key < min) {
+    if (column.min.compare_exchange_weak(min, key)) break;
+  }
+  int64_t max = column.max.load();
+  while (key > max) {
+    if (column.max.compare_exchange_weak(max, key)) break;
+  }
+}
+
+bool ZoneMap::GetMinMax(oid_t column_id, TypedValue &min,
+                        TypedValue &max) const {
+  PL_ASSERT(column_id < column_count_);
+  auto &column = columns_[column_id];
+  if (IsSummarizedType(column.type_id) == false) return false;
+
+  int64_t min_key = column.min.load();
+  int64_t max_key = column.max.load();
+  if (min_key > max_key) return false;
+
+  min = GetValue(column.type_id, min_key);
+  max = GetValue(column.type_id, max_key);
+  return true;
+}
+
+oid_t ZoneMap::GetNullCount(oid_t column_id) const {
+  PL_ASSERT(column_id < column_count_);
+  return columns_[column_id].null_count.load();
+}
+
+bool ZoneMap::MayMatch(oid_t column_id, ExpressionType op,
+                       const TypedValue &constant) const {
+  if (IsValid() == false || column_id >= column_count_) return true;
+  if (IsSummarized(column_id) == false || IsComparison(op) == false)
+    return true;
+
+  // Nothing compares true against NULL
+  if (constant.IsNull()) return false;
+
+  TypedValue min, max;
+  if (GetMinMax(column_id, min, max) == false) {
+    // Only NULLs, which never compare true
+    return false;
+  }
+
+  // Let the predicate itself report invalid comparisons
+  if (IsComparable(min, constant) == false) return true;
+
+  switch (op) {
+    case (EXPRESSION_TYPE_COMPARE_EQUAL):
+      return (min.CompareTo(constant) <= 0 && max.CompareTo(constant) >= 0);
+    case (EXPRESSION_TYPE_COMPARE_NOTEQUAL):
+      return (min.CompareTo(constant) != 0 || max.CompareTo(constant) != 0);
+    case (EXPRESSION_TYPE_COMPARE_LESSTHAN):
+      return (min.CompareTo(constant) < 0);
+    case (EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO):
+      return (min.CompareTo(constant) <= 0);
+    case (EXPRESSION_TYPE_COMPARE_GREATERTHAN):
+      return (max.CompareTo(constant) > 0);
+    case (EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO):
+      return (max.CompareTo(constant) >= 0);
+    default:
+      return true;
+  }
+}
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -28,6 +28,8 @@
 #include "executor/plan_executor.h"
 #include "optimizer/simple_optimizer.h"
 
+#include <sstream>
+
 #include <boost/algorithm/string.hpp>
 
 namespace peloton {
@@ -51,7 +53,7 @@ TrafficCop::~TrafficCop() {
 Result TrafficCop::ExecuteStatement(
     const std::string &query, std::vector<ResultType> &result,
     std::vector<FieldInfoType> &tuple_descriptor, int &rows_changed,
-    std::string &error_message) {
+    std::string &error_message, const bool read_only) {
   LOG_TRACE("Received %s", query.c_str());
 
   // Prepare the statement
@@ -66,7 +68,7 @@ Result TrafficCop::ExecuteStatement(
   bool unnamed = true;
   std::vector<int> result_format(statement->GetTupleDescriptor().size(), 0);
   auto status = ExecuteStatement(statement, unnamed, result_format, result,
-                                 rows_changed, error_message);
+                                 rows_changed, error_message, read_only);
 
   if (status == Result::RESULT_SUCCESS) {
     LOG_TRACE("Execution succeeded!");
@@ -82,7 +84,19 @@ Result TrafficCop::ExecuteStatement(
     const std::shared_ptr<Statement> &statement,
     UNUSED_ATTRIBUTE const bool unnamed, const std::vector<int> &result_format,
     std::vector<ResultType> &result, int &rows_changed,
-    UNUSED_ATTRIBUTE std::string &error_message) {
+    std::string &error_message, const bool read_only) {
+  auto plan = statement->GetPlanTree().get();
+  if (read_only == true && plan != nullptr &&
+      bridge::PlanExecutor::IsReadOnlyPlan(plan) == false) {
+    std::string query_type;
+    std::stringstream stream(statement->GetQueryString());
+    stream >> query_type;
+    error_message = "cannot execute " + boost::to_upper_copy(query_type) +
+                    " in a read-only transaction";
+    LOG_TRACE("%s", error_message.c_str());
+    return Result::RESULT_FAILURE;
+  }
+
   if (FLAGS_stats_mode != STATS_TYPE_INVALID) {
     stats::BackendStatsContext::GetInstance()->InitQueryMetric(
         statement->GetQueryString(), DEFAULT_DB_ID);
@@ -95,7 +109,7 @@ Result TrafficCop::ExecuteStatement(
   std::vector<common::Value *> params;
   bridge::PlanExecutor::PrintPlan(statement->GetPlanTree().get(), "Plan");
   bridge::peloton_status status = bridge::PlanExecutor::ExecutePlan(
-      statement->GetPlanTree().get(), params, result, result_format);
+      plan, params, result, result_format, read_only);
   LOG_TRACE("Statement executed. Result: %d", status.m_result);
 
   rows_changed = status.m_processed;
@@ -122,6 +136,11 @@ std::shared_ptr<Statement> TrafficCop::PrepareStatement(
     if (stmt->GetType() == STATEMENT_TYPE_SELECT) {
       auto tuple_descriptor = GenerateTupleDescriptor(query_string);
       statement->SetTupleDescriptor(tuple_descriptor);
+    } else if (stmt->GetType() == STATEMENT_TYPE_TRANSACTION) {
+      auto txn_stmt = (parser::TransactionStatement *)stmt;
+      statement->SetReadOnlyBegin(
+          txn_stmt->type == parser::TransactionStatement::kBegin &&
+          txn_stmt->read_only);
     }
     break;
   }
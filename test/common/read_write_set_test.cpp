@@ -0,0 +1,89 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// read_write_set_test.cpp
+//
+// Identification: test/common/read_write_set_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "common/read_write_set.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Read Write Set Tests
+//===--------------------------------------------------------------------===//
+
+class ReadWriteSetTests : public PelotonTest {};
+
+TEST_F(ReadWriteSetTests, BasicTest) {
+  auto rw_set = ReadWriteSet::Create();
+  EXPECT_TRUE(rw_set->empty());
+
+  // Enough tuples for the set to switch from linear search to its index
+  const oid_t tile_group_count = 10;
+  const oid_t tuple_count = 100;
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    for (oid_t tile_group_id = 0; tile_group_id < tile_group_count;
+         tile_group_id++) {
+      rw_set->Insert(tile_group_id, tuple_id, RW_TYPE_READ);
+    }
+  }
+  EXPECT_EQ(tile_group_count * tuple_count, rw_set->size());
+
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    auto type = rw_set->Find(tuple_id % tile_group_count, tuple_id);
+    ASSERT_TRUE(type != nullptr);
+    EXPECT_EQ(RW_TYPE_READ, *type);
+    *type = RW_TYPE_UPDATE;
+  }
+  EXPECT_TRUE(rw_set->Find(tile_group_count, 0) == nullptr);
+  EXPECT_TRUE(rw_set->Find(0, tuple_count) == nullptr);
+
+  // Set changes an existing entry or appends a new one
+  rw_set->Set(0, 1, RW_TYPE_DELETE);
+  rw_set->Set(tile_group_count, 0, RW_TYPE_INSERT);
+  EXPECT_EQ(tile_group_count * tuple_count + 1, rw_set->size());
+
+  // Entries are kept in the order of their first access
+  size_t position = 0;
+  size_t update_count = 0;
+  for (auto &entry : *rw_set) {
+    if (position < tile_group_count * tuple_count) {
+      EXPECT_EQ(position % tile_group_count, entry.tile_group_id);
+      EXPECT_EQ(position / tile_group_count, entry.tuple_id);
+    }
+    if (entry.type == RW_TYPE_UPDATE) update_count++;
+    position++;
+  }
+  EXPECT_EQ(tuple_count - 1, update_count);
+  EXPECT_EQ(RW_TYPE_DELETE, *rw_set->Find(0, 1));
+  EXPECT_EQ(RW_TYPE_INSERT, *rw_set->Find(tile_group_count, 0));
+
+  rw_set->Clear();
+  EXPECT_TRUE(rw_set->empty());
+  EXPECT_TRUE(rw_set->Find(0, 0) == nullptr);
+}
+
+TEST_F(ReadWriteSetTests, RecycleTest) {
+  auto rw_set = ReadWriteSet::Create();
+  rw_set->Insert(1, 2, RW_TYPE_INSERT);
+  auto rw_set_ptr = rw_set.get();
+  rw_set.reset();
+
+  // The thread gets its released set back, empty
+  auto shared_rw_set = ReadWriteSet::CreateShared();
+  EXPECT_EQ(rw_set_ptr, shared_rw_set.get());
+  EXPECT_TRUE(shared_rw_set->empty());
+  EXPECT_TRUE(shared_rw_set->Find(1, 2) == nullptr);
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// typed_value_test.cpp
+//
+// Identification: test/common/typed_value_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+
+#include "common/typed_value.h"
+#include "common/value_factory.h"
+#include "common/harness.h"
+
+namespace peloton {
+namespace test {
+
+class TypedValueTests : public PelotonTest {};
+
+using namespace peloton::common;
+
+TEST_F(TypedValueTests, NumericComparisonTest) {
+  TypedValue tiny((int8_t)3);
+  TypedValue big((int64_t)3);
+  TypedValue integer((int32_t)7);
+  TypedValue decimal(6.5);
+
+  EXPECT_EQ(CMP_TRUE, CompareEquals(tiny, big));
+  EXPECT_EQ(CMP_FALSE, CompareNotEquals(tiny, big));
+  EXPECT_EQ(CMP_TRUE, CompareLessThan(big, integer));
+  EXPECT_EQ(CMP_TRUE, CompareLessThanEquals(big, tiny));
+  EXPECT_EQ(CMP_TRUE, CompareGreaterThan(integer, decimal));
+  EXPECT_EQ(CMP_FALSE, CompareGreaterThanEquals(tiny, decimal));
+
+  // Equal values hash alike regardless of the integer width
+  EXPECT_EQ(tiny.Hash(), big.Hash());
+}
+
+TEST_F(TypedValueTests, NullComparisonTest) {
+  TypedValue null_int = TypedValue::GetNullValueByType(Type::INTEGER);
+  TypedValue integer((int32_t)7);
+
+  EXPECT_TRUE(null_int.IsNull());
+  EXPECT_EQ(CMP_NULL, CompareEquals(null_int, integer));
+  EXPECT_EQ(CMP_NULL, CompareLessThan(integer, null_int));
+}
+
+TEST_F(TypedValueTests, VarlenComparisonTest) {
+  std::unique_ptr<Value> abc(
+      new VarlenValue(ValueFactory::GetVarcharValue("abc")));
+  std::unique_ptr<Value> abd(
+      new VarlenValue(ValueFactory::GetVarcharValue("abd")));
+
+  TypedValue lhs = TypedValue::FromValue(*abc);
+  TypedValue rhs = TypedValue::FromValue(*abd);
+
+  EXPECT_EQ(CMP_TRUE, CompareLessThan(lhs, rhs));
+  EXPECT_EQ(CMP_FALSE, CompareEquals(lhs, rhs));
+  EXPECT_EQ(CMP_TRUE, CompareEquals(lhs, lhs));
+  EXPECT_EQ("abc", lhs.ToString());
+
+  // Round trip through the Value adapter
+  std::unique_ptr<Value> copy(lhs.ToValue());
+  std::unique_ptr<Value> cmp(copy->CompareEquals(*abc));
+  EXPECT_TRUE(cmp->IsTrue());
+}
+
+TEST_F(TypedValueTests, TypeMismatchTest) {
+  TypedValue integer((int32_t)7);
+  TypedValue timestamp = TypedValue::GetTimestamp(7);
+
+  EXPECT_THROW(CompareEquals(integer, timestamp), Exception);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,117 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// epoch_manager_test.cpp
+//
+// Identification: test/concurrency/epoch_manager_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "common/harness.h"
+#include "concurrency/epoch_manager.h"
+
+namespace peloton {
+
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Epoch Manager Tests
+//===--------------------------------------------------------------------===//
+
+class EpochManagerTests : public PelotonTest {};
+
+static void WaitEpochs(size_t epoch_count) {
+  std::this_thread::sleep_for(epoch_count *
+                              std::chrono::milliseconds(EPOCH_LENGTH));
+}
+
+TEST_F(EpochManagerTests, RunningTxnTest) {
+  concurrency::EpochManager epoch_manager;
+
+  // A running txn holds back every epoch from its own onwards
+  auto old_epoch = epoch_manager.EnterEpoch(10);
+  WaitEpochs(3);
+  auto new_epoch = epoch_manager.EnterEpoch(20);
+  EXPECT_LT(old_epoch, new_epoch);
+  epoch_manager.ExitEpoch(new_epoch);
+  WaitEpochs(3);
+  EXPECT_EQ(0, epoch_manager.GetMaxDeadTxnCid());
+
+  // Once it is done, the newer epochs die with it
+  epoch_manager.ExitEpoch(old_epoch);
+  WaitEpochs(3);
+  EXPECT_EQ(20, epoch_manager.GetMaxDeadTxnCid());
+
+  epoch_manager.Reset();
+  EXPECT_EQ(0, epoch_manager.GetMaxDeadTxnCid());
+}
+
+TEST_F(EpochManagerTests, ExitOnOtherThreadTest) {
+  concurrency::EpochManager epoch_manager;
+
+  // A txn handed to another thread exits through the slot it entered in
+  concurrency::EpochSlot *slot = nullptr;
+  auto epoch = epoch_manager.EnterEpoch(10, &slot);
+  EXPECT_TRUE(slot != nullptr);
+  WaitEpochs(3);
+  EXPECT_EQ(0, epoch_manager.GetMaxDeadTxnCid());
+
+  std::thread exit_thread(
+      [&epoch_manager, epoch, slot] { epoch_manager.ExitEpoch(epoch, slot); });
+  exit_thread.join();
+  WaitEpochs(3);
+  EXPECT_EQ(10, epoch_manager.GetMaxDeadTxnCid());
+
+  // Same for a snapshot, which holds back the max dead cid until it exits
+  auto snapshot_cid = epoch_manager.EnterSnapshot(&slot);
+  EXPECT_EQ(10, snapshot_cid);
+  epoch_manager.ExitEpoch(epoch_manager.EnterEpoch(20));
+  WaitEpochs(3);
+  EXPECT_EQ(10, epoch_manager.GetMaxDeadTxnCid());
+
+  std::thread snapshot_thread([&epoch_manager, snapshot_cid, slot] {
+    epoch_manager.ExitSnapshot(snapshot_cid, slot);
+  });
+  snapshot_thread.join();
+  WaitEpochs(3);
+  EXPECT_EQ(20, epoch_manager.GetMaxDeadTxnCid());
+}
+
+void EpochTest(concurrency::EpochManager *epoch_manager,
+               std::atomic<cid_t> *next_cid,
+               UNUSED_ATTRIBUTE uint64_t thread_itr) {
+  cid_t max_dead_cid = 0;
+  for (oid_t txn_itr = 1; txn_itr <= 50; txn_itr++) {
+    cid_t begin_cid = (*next_cid)++;
+    auto epoch = epoch_manager->EnterEpoch(begin_cid);
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    epoch_manager->ExitEpoch(epoch);
+
+    // The dead cid only moves forward
+    auto dead_cid = epoch_manager->GetMaxDeadTxnCid();
+    EXPECT_LE(max_dead_cid, dead_cid);
+    max_dead_cid = dead_cid;
+  }
+}
+
+TEST_F(EpochManagerTests, MultiThreadedTest) {
+  concurrency::EpochManager epoch_manager;
+  std::atomic<cid_t> next_cid(1);
+
+  LaunchParallelTest(8, EpochTest, &epoch_manager, &next_cid);
+
+  // Every txn is done once the epoch of the last one closes
+  WaitEpochs(3);
+  EXPECT_EQ(next_cid - 1, epoch_manager.GetMaxDeadTxnCid());
+}
+
+}  // End test namespace
+}  // End peloton namespace
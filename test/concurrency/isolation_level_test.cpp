@@ -25,7 +25,10 @@ namespace test {
 class IsolationLevelTest : public PelotonTest {};
 
 static std::vector<ConcurrencyType> TEST_TYPES = {
-    CONCURRENCY_TYPE_TIMESTAMP_ORDERING
+    CONCURRENCY_TYPE_TIMESTAMP_ORDERING,
+    CONCURRENCY_TYPE_OPTIMISTIC,
+    CONCURRENCY_TYPE_TWO_PHASE_LOCKING_NO_WAIT,
+    CONCURRENCY_TYPE_SERIALIZABLE_SNAPSHOT
 };
 
 void DirtyWriteTest() {
@@ -278,7 +281,7 @@ void PhantomTest() {
   }
 }
 
-// Can't pass this test!
+// Snapshot isolation alone can't pass this test!
 void WriteSkewTest() {
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
   std::unique_ptr<storage::DataTable> table(
@@ -395,7 +398,9 @@ TEST_F(IsolationLevelTest, SerializableTest) {
     DirtyWriteTest();
     DirtyReadTest();
     FuzzyReadTest();
-    // WriteSkewTest();
+    if (test_type == CONCURRENCY_TYPE_SERIALIZABLE_SNAPSHOT) {
+      WriteSkewTest();
+    }
     ReadSkewTest();
     PhantomTest();
     SIAnomalyTest1();
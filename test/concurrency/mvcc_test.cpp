@@ -27,7 +27,10 @@ namespace test {
 class MVCCTest : public PelotonTest {};
 
 static std::vector<ConcurrencyType> TEST_TYPES = {
-    CONCURRENCY_TYPE_TIMESTAMP_ORDERING
+    CONCURRENCY_TYPE_TIMESTAMP_ORDERING,
+    CONCURRENCY_TYPE_OPTIMISTIC,
+    CONCURRENCY_TYPE_TWO_PHASE_LOCKING_NO_WAIT,
+    CONCURRENCY_TYPE_SERIALIZABLE_SNAPSHOT
 };
 
 
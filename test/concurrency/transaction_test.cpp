@@ -11,6 +11,11 @@
 //===----------------------------------------------------------------------===//
 
 
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <thread>
+
 #include "common/harness.h"
 #include "concurrency/transaction_tests_util.h"
 
@@ -25,7 +30,9 @@ namespace test {
 class TransactionTests : public PelotonTest {};
 
 static std::vector<ConcurrencyType> TEST_TYPES = {
-    CONCURRENCY_TYPE_TIMESTAMP_ORDERING
+    CONCURRENCY_TYPE_TIMESTAMP_ORDERING,
+    CONCURRENCY_TYPE_OPTIMISTIC,
+    CONCURRENCY_TYPE_TWO_PHASE_LOCKING_NO_WAIT
 };
 
 void TransactionTest(concurrency::TransactionManager *txn_manager,
@@ -58,6 +65,62 @@ TEST_F(TransactionTests, TransactionTest) {
   }
 }
 
+void BatchedIdTest(concurrency::TransactionManager *txn_manager,
+                   std::vector<std::vector<cid_t>> *commit_ids,
+                   std::vector<std::vector<txn_id_t>> *txn_ids,
+                   uint64_t thread_itr) {
+  for (oid_t txn_itr = 1; txn_itr <= 100; txn_itr++) {
+    auto txn = txn_manager->BeginTransaction();
+    (*commit_ids)[thread_itr].push_back(txn->GetBeginCommitId());
+    (*txn_ids)[thread_itr].push_back(txn->GetTransactionId());
+    txn_manager->CommitTransaction(txn);
+  }
+}
+
+TEST_F(TransactionTests, BatchedIdTest) {
+  for (auto test_type : TEST_TYPES) {
+    concurrency::TransactionManagerFactory::Configure(test_type);
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    txn_manager.SetTxnIdBatchSize(16);
+
+    const size_t num_threads = 8;
+    std::vector<std::vector<cid_t>> commit_ids(num_threads);
+    std::vector<std::vector<txn_id_t>> txn_ids(num_threads);
+    LaunchParallelTest(num_threads, BatchedIdTest, &txn_manager, &commit_ids,
+                       &txn_ids);
+
+    // Ids are unique, and grow within a thread
+    std::set<cid_t> all_commit_ids;
+    std::set<txn_id_t> all_txn_ids;
+    for (size_t thread_itr = 0; thread_itr < num_threads; thread_itr++) {
+      auto &thread_commit_ids = commit_ids[thread_itr];
+      EXPECT_TRUE(std::is_sorted(thread_commit_ids.begin(),
+                                 thread_commit_ids.end()));
+      all_commit_ids.insert(thread_commit_ids.begin(),
+                            thread_commit_ids.end());
+      all_txn_ids.insert(txn_ids[thread_itr].begin(),
+                         txn_ids[thread_itr].end());
+    }
+    EXPECT_EQ(num_threads * 100, all_commit_ids.size());
+    EXPECT_EQ(num_threads * 100, all_txn_ids.size());
+
+    // Commit ids are not batched, so a transaction always begins after every
+    // commit id handed out before it
+    auto next_commit_id = txn_manager.GetCurrentCommitId();
+    EXPECT_LT(*all_commit_ids.rbegin(), next_commit_id);
+    auto txn = txn_manager.BeginTransaction();
+    EXPECT_EQ(next_commit_id, txn->GetBeginCommitId());
+    txn_manager.CommitTransaction(txn);
+
+    // Going back to one id at a time drops the reserved transaction ids
+    txn_manager.SetTxnIdBatchSize(1);
+    auto next_txn_id = *all_txn_ids.rbegin() + 1;
+    txn = txn_manager.BeginTransaction();
+    EXPECT_LE(next_txn_id, txn->GetTransactionId());
+    txn_manager.CommitTransaction(txn);
+  }
+}
+
 TEST_F(TransactionTests, SingleTransactionTest) {
   for (auto test_type : TEST_TYPES) {
     concurrency::TransactionManagerFactory::Configure(test_type);
@@ -210,5 +273,309 @@ TEST_F(TransactionTests, AbortTest) {
   }
 }
 
+TEST_F(TransactionTests, OptimisticValidationTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      CONCURRENCY_TYPE_OPTIMISTIC);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> table(
+      TransactionTestsUtil::CreateTable());
+
+  // Concurrent readers do not conflict
+  {
+    TransactionScheduler scheduler(2, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Read(0);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(1).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(RESULT_SUCCESS, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(RESULT_SUCCESS, scheduler.schedules[1].txn_result);
+  }
+
+  // A read that was overwritten before the commit fails validation
+  {
+    TransactionScheduler scheduler(2, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Update(0, 1);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(RESULT_SUCCESS, scheduler.schedules[1].txn_result);
+    EXPECT_EQ(RESULT_ABORTED, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(0, scheduler.schedules[0].results[0]);
+  }
+
+  // So does a read of a tuple that another txn is about to overwrite
+  {
+    TransactionScheduler scheduler(2, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(1);
+    scheduler.Txn(1).Update(1, 1);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(1).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(RESULT_ABORTED, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(RESULT_SUCCESS, scheduler.schedules[1].txn_result);
+  }
+
+  // A txn cannot overwrite a version that was replaced after it began
+  {
+    TransactionScheduler scheduler(2, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(2);
+    scheduler.Txn(1).Update(2, 1);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Update(2, 2);
+    scheduler.Txn(0).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(RESULT_SUCCESS, scheduler.schedules[1].txn_result);
+    EXPECT_EQ(RESULT_ABORTED, scheduler.schedules[0].txn_result);
+  }
+}
+
+TEST_F(TransactionTests, SerializableSnapshotTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      CONCURRENCY_TYPE_SERIALIZABLE_SNAPSHOT);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> table(
+      TransactionTestsUtil::CreateTable());
+
+  // A read that was overwritten before the commit is serialized before the
+  // writer, unlike in optimistic concurrency control
+  {
+    TransactionScheduler scheduler(2, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Update(0, 1);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(0).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(RESULT_SUCCESS, scheduler.schedules[1].txn_result);
+    EXPECT_EQ(RESULT_SUCCESS, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(0, scheduler.schedules[0].results[0]);
+    EXPECT_EQ(0, scheduler.schedules[0].results[1]);
+  }
+
+  // The first updater wins
+  {
+    TransactionScheduler scheduler(2, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(1);
+    scheduler.Txn(1).Update(1, 1);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Update(1, 2);
+    scheduler.Txn(0).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(RESULT_SUCCESS, scheduler.schedules[1].txn_result);
+    EXPECT_EQ(RESULT_ABORTED, scheduler.schedules[0].txn_result);
+  }
+
+  // Write skew: each txn overwrites what the other one read, so the second
+  // one to commit would close a cycle
+  {
+    TransactionScheduler scheduler(2, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(2);
+    scheduler.Txn(1).Read(3);
+    scheduler.Txn(0).Update(3, 1);
+    scheduler.Txn(1).Update(2, 1);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(1).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(RESULT_SUCCESS, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(RESULT_ABORTED, scheduler.schedules[1].txn_result);
+  }
+}
+
+TEST_F(TransactionTests, TwoPhaseLockingTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      CONCURRENCY_TYPE_TWO_PHASE_LOCKING_WAIT_DIE);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> table(
+      TransactionTestsUtil::CreateTable());
+
+  // Readers share the lock
+  {
+    TransactionScheduler scheduler(2, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Read(0);
+    scheduler.Txn(0).Commit();
+    scheduler.Txn(1).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(RESULT_SUCCESS, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(RESULT_SUCCESS, scheduler.schedules[1].txn_result);
+  }
+
+  // A younger txn dies instead of waiting for an older one
+  {
+    TransactionScheduler scheduler(2, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(1).Update(0, 1);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Update(0, 2);
+    scheduler.Txn(0).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(RESULT_ABORTED, scheduler.schedules[1].txn_result);
+    EXPECT_EQ(RESULT_SUCCESS, scheduler.schedules[0].txn_result);
+  }
+
+  // The locks are released at commit
+  {
+    TransactionScheduler scheduler(1, table.get(), &txn_manager);
+    scheduler.Txn(0).Read(0);
+    scheduler.Txn(0).Update(0, 3);
+    scheduler.Txn(0).Commit();
+
+    scheduler.Run();
+
+    EXPECT_EQ(RESULT_SUCCESS, scheduler.schedules[0].txn_result);
+    EXPECT_EQ(2, scheduler.schedules[0].results[0]);
+  }
+}
+
+void IncrementTest(concurrency::TransactionManager *txn_manager,
+                   storage::DataTable *table,
+                   UNUSED_ATTRIBUTE uint64_t thread_itr) {
+  for (int increment = 0; increment < 20; increment++) {
+    while (true) {
+      auto txn = txn_manager->BeginTransaction();
+      int value;
+      if (TransactionTestsUtil::ExecuteRead(txn, table, 0, value) == false ||
+          TransactionTestsUtil::ExecuteUpdate(txn, table, 0, value + 1) ==
+              false) {
+        txn_manager->AbortTransaction(txn);
+        continue;
+      }
+      if (txn_manager->CommitTransaction(txn) == RESULT_SUCCESS) {
+        break;
+      }
+    }
+  }
+}
+
+TEST_F(TransactionTests, ContendedIncrementTest) {
+  std::vector<ConcurrencyType> test_types = TEST_TYPES;
+  // wait-die needs the txns on different threads
+  test_types.push_back(CONCURRENCY_TYPE_TWO_PHASE_LOCKING_WAIT_DIE);
+  test_types.push_back(CONCURRENCY_TYPE_SERIALIZABLE_SNAPSHOT);
+
+  for (auto test_type : test_types) {
+    concurrency::TransactionManagerFactory::Configure(test_type);
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    std::unique_ptr<storage::DataTable> table(
+        TransactionTestsUtil::CreateTable());
+
+    const int num_threads = 4;
+    LaunchParallelTest(num_threads, IncrementTest, &txn_manager, table.get());
+
+    // No increment is lost
+    auto txn = txn_manager.BeginTransaction();
+    int value;
+    EXPECT_TRUE(TransactionTestsUtil::ExecuteRead(txn, table.get(), 0, value));
+    EXPECT_EQ(num_threads * 20, value);
+    EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction(txn));
+  }
+}
+
+TEST_F(TransactionTests, ReadOnlyTransactionTest) {
+  for (auto test_type : TEST_TYPES) {
+    concurrency::TransactionManagerFactory::Configure(test_type);
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    std::unique_ptr<storage::DataTable> table(
+        TransactionTestsUtil::CreateTable());
+
+    auto txn = txn_manager.BeginTransaction();
+    EXPECT_TRUE(TransactionTestsUtil::ExecuteUpdate(txn, table.get(), 0, 1));
+    EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction(txn));
+
+    auto read_only_txn = txn_manager.BeginReadOnlyTransaction();
+    EXPECT_TRUE(read_only_txn->IsDeclaredReadOnly());
+    int result;
+    EXPECT_TRUE(TransactionTestsUtil::ExecuteRead(read_only_txn, table.get(),
+                                                  0, result));
+    EXPECT_EQ(1, result);
+
+    // The read does not hold back a writer...
+    txn = txn_manager.BeginTransaction();
+    EXPECT_TRUE(TransactionTestsUtil::ExecuteUpdate(txn, table.get(), 0, 2));
+    EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction(txn));
+
+    // ...and still sees its snapshot afterwards
+    EXPECT_TRUE(TransactionTestsUtil::ExecuteRead(read_only_txn, table.get(),
+                                                  0, result));
+    EXPECT_EQ(1, result);
+    EXPECT_TRUE(read_only_txn->GetReadWriteSet().empty());
+    EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction(read_only_txn));
+
+    // A read-only txn cannot write
+    read_only_txn = txn_manager.BeginReadOnlyTransaction();
+    EXPECT_FALSE(TransactionTestsUtil::ExecuteUpdate(read_only_txn,
+                                                     table.get(), 1, 1));
+    EXPECT_EQ(RESULT_ABORTED, txn_manager.AbortTransaction(read_only_txn));
+  }
+}
+
+TEST_F(TransactionTests, ReadYourWritesTest) {
+  for (auto test_type : TEST_TYPES) {
+    concurrency::TransactionManagerFactory::Configure(test_type);
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    std::unique_ptr<storage::DataTable> table(
+        TransactionTestsUtil::CreateTable());
+
+    // Every read-only txn sees the commit that finished right before it
+    for (int value = 1; value <= 5; value++) {
+      auto txn = txn_manager.BeginTransaction();
+      EXPECT_TRUE(
+          TransactionTestsUtil::ExecuteUpdate(txn, table.get(), 0, value));
+      EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction(txn));
+
+      auto read_only_txn = txn_manager.BeginReadOnlyTransaction();
+      int result;
+      EXPECT_TRUE(TransactionTestsUtil::ExecuteRead(read_only_txn, table.get(),
+                                                    0, result));
+      EXPECT_EQ(value, result);
+      EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction(read_only_txn));
+    }
+
+    // Also when an older txn is still running on another thread
+    std::thread older_thread([&txn_manager, &table] {
+      auto older_txn = txn_manager.BeginTransaction();
+      int result;
+      EXPECT_TRUE(TransactionTestsUtil::ExecuteRead(older_txn, table.get(), 1,
+                                                    result));
+      std::this_thread::sleep_for(3 * std::chrono::milliseconds(EPOCH_LENGTH));
+      EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction(older_txn));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(EPOCH_LENGTH));
+
+    auto txn = txn_manager.BeginTransaction();
+    EXPECT_TRUE(TransactionTestsUtil::ExecuteUpdate(txn, table.get(), 0, 6));
+    EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction(txn));
+
+    auto read_only_txn = txn_manager.BeginReadOnlyTransaction();
+    int result;
+    EXPECT_TRUE(TransactionTestsUtil::ExecuteRead(read_only_txn, table.get(), 0,
+                                                  result));
+    EXPECT_EQ(6, result);
+    EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction(read_only_txn));
+
+    older_thread.join();
+  }
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -19,6 +19,8 @@
 #include "common/harness.h"
 
 #include "catalog/schema.h"
+#include "common/init.h"
+#include "common/thread_pool.h"
 #include "common/types.h"
 #include "common/value.h"
 #include "common/value_factory.h"
@@ -321,6 +323,71 @@ TEST_F(SeqScanTests, NonLeafNodePredicateTest) {
 
   txn_manager.CommitTransaction(txn);
 }
+
+// Values of the first column found by a scan of the table with the given
+// degree of parallelism, in the order they are returned.
+std::vector<int> ScanFirstColumn(storage::DataTable *table,
+                                 size_t degree_of_parallelism) {
+  // COL_A >= 10 * 25
+  std::unique_ptr<expression::AbstractExpression> predicate(
+      expression::ExpressionUtil::ComparisonFactory(
+          EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+          expression::ExpressionUtil::TupleValueFactory(common::Type::INTEGER,
+                                                        0, 0),
+          expression::ExpressionUtil::ConstantValueFactory(
+              common::ValueFactory::GetIntegerValue(
+                  ExecutorTestsUtil::PopulatedValue(25, 0)))));
+  planner::SeqScanPlan node(table, predicate.release(), {0, 1});
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  context->SetDegreeOfParallelism(degree_of_parallelism);
+
+  executor::SeqScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  std::vector<int> values;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    for (oid_t tuple_id : *result_tile) {
+      std::unique_ptr<common::Value> value(
+          result_tile->GetValue(tuple_id, 0));
+      values.push_back(value->GetAs<int32_t>());
+    }
+  }
+  txn_manager.CommitTransaction(txn);
+
+  return values;
+}
+
+// Sequential scan of table with several threads.
+TEST_F(SeqScanTests, ParallelScanTest) {
+  const int tuples_per_tilegroup = 10;
+  const int tuple_count = 20 * tuples_per_tilegroup;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tilegroup, false));
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto serial_values = ScanFirstColumn(table.get(), 1);
+  EXPECT_EQ(tuple_count - 25, serial_values.size());
+
+  // The calling thread scans every tile group if the pool is not running
+  EXPECT_EQ(serial_values, ScanFirstColumn(table.get(), 4));
+
+  thread_pool.Initialize(4, 0);
+  for (size_t degree_of_parallelism : {2, 4, 8}) {
+    EXPECT_EQ(serial_values,
+              ScanFirstColumn(table.get(), degree_of_parallelism));
+  }
+  thread_pool.Shutdown();
+}
 }
 
 }  // namespace test
@@ -0,0 +1,166 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// batch_evaluation_test.cpp
+//
+// Identification: test/expression/batch_evaluation_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/logical_tile.h"
+#include "executor/logical_tile_factory.h"
+#include "expression/container_tuple.h"
+#include "expression/expression_util.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Batch Evaluation Tests
+//===--------------------------------------------------------------------===//
+
+class BatchEvaluationTests : public PelotonTest {};
+
+static expression::AbstractExpression *CreateComparison(ExpressionType type,
+                                                        oid_t column_id,
+                                                        int value,
+                                                        bool constant_first) {
+  auto column = expression::ExpressionUtil::TupleValueFactory(
+      common::Type::INTEGER, 0, column_id);
+  auto constant = expression::ExpressionUtil::ConstantValueFactory(
+      common::ValueFactory::GetIntegerValue(value));
+  if (constant_first)
+    return expression::ExpressionUtil::ComparisonFactory(type, constant,
+                                                         column);
+  return expression::ExpressionUtil::ComparisonFactory(type, column, constant);
+}
+
+// Check that the batch kernels agree with tuple-at-a-time evaluation
+static void CheckBatchEvaluation(
+    std::shared_ptr<storage::TileGroup> tile_group,
+    expression::AbstractExpression *predicate) {
+  std::vector<oid_t> selection;
+  std::vector<oid_t> expected;
+  for (oid_t tuple_id = 0; tuple_id < tile_group->GetNextTupleSlot();
+       tuple_id++) {
+    selection.push_back(tuple_id);
+    expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+                                                         tuple_id);
+    if (predicate->Evaluate(&tuple, nullptr, nullptr)->IsTrue())
+      expected.push_back(tuple_id);
+  }
+
+  std::vector<oid_t> tile_group_output;
+  predicate->EvaluateBatch(tile_group.get(), selection, tile_group_output,
+                           nullptr);
+  EXPECT_EQ(expected, tile_group_output);
+
+  std::unique_ptr<executor::LogicalTile> logical_tile(
+      executor::LogicalTileFactory::WrapTileGroup(tile_group));
+  std::vector<oid_t> logical_tile_output;
+  predicate->EvaluateBatch(logical_tile.get(), selection, logical_tile_output,
+                           nullptr);
+  EXPECT_EQ(expected, logical_tile_output);
+}
+
+TEST_F(BatchEvaluationTests, ComparisonAndConjunctionTest) {
+  const int tuple_count = 50;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  auto tile_group = table->GetTileGroup(0);
+
+  // COL_A < 200
+  std::unique_ptr<expression::AbstractExpression> less_than(CreateComparison(
+      EXPRESSION_TYPE_COMPARE_LESSTHAN, 0, 200, false));
+  CheckBatchEvaluation(tile_group, less_than.get());
+
+  // 200 < COL_A
+  std::unique_ptr<expression::AbstractExpression> mirrored(CreateComparison(
+      EXPRESSION_TYPE_COMPARE_LESSTHAN, 0, 200, true));
+  CheckBatchEvaluation(tile_group, mirrored.get());
+
+  // COL_A >= 100 AND COL_B <= 301
+  std::unique_ptr<expression::AbstractExpression> conjunction(
+      expression::ExpressionUtil::ConjunctionFactory(
+          EXPRESSION_TYPE_CONJUNCTION_AND,
+          CreateComparison(EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO, 0,
+                           100, false),
+          CreateComparison(EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO, 1, 301,
+                           false)));
+  CheckBatchEvaluation(tile_group, conjunction.get());
+
+  // COL_A = 40 OR COL_B > 451
+  std::unique_ptr<expression::AbstractExpression> disjunction(
+      expression::ExpressionUtil::ConjunctionFactory(
+          EXPRESSION_TYPE_CONJUNCTION_OR,
+          CreateComparison(EXPRESSION_TYPE_COMPARE_EQUAL, 0, 40, false),
+          CreateComparison(EXPRESSION_TYPE_COMPARE_GREATERTHAN, 1, 451,
+                           false)));
+  CheckBatchEvaluation(tile_group, disjunction.get());
+}
+
+TEST_F(BatchEvaluationTests, ColumnLayoutTest) {
+  const int tuple_count = 50;
+
+  // Every column gets its own tile, so the vector kernels apply
+  peloton_layout_mode = LAYOUT_TYPE_COLUMN;
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+  peloton_layout_mode = LAYOUT_TYPE_ROW;
+
+  auto tile_group = table->GetTileGroup(0);
+  EXPECT_EQ(table->GetSchema()->GetColumnCount(), tile_group->GetTileCount());
+
+  // 200 < COL_A
+  std::unique_ptr<expression::AbstractExpression> mirrored(CreateComparison(
+      EXPRESSION_TYPE_COMPARE_LESSTHAN, 0, 200, true));
+  CheckBatchEvaluation(tile_group, mirrored.get());
+
+  // COL_A BETWEEN 100 AND 301
+  std::unique_ptr<expression::AbstractExpression> between(
+      expression::ExpressionUtil::ConjunctionFactory(
+          EXPRESSION_TYPE_CONJUNCTION_AND,
+          CreateComparison(EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO, 0,
+                           100, false),
+          CreateComparison(EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO, 0, 301,
+                           false)));
+  CheckBatchEvaluation(tile_group, between.get());
+
+  // COL_A <> 40 AND COL_B > 151
+  std::unique_ptr<expression::AbstractExpression> conjunction(
+      expression::ExpressionUtil::ConjunctionFactory(
+          EXPRESSION_TYPE_CONJUNCTION_AND,
+          CreateComparison(EXPRESSION_TYPE_COMPARE_NOTEQUAL, 0, 40, false),
+          CreateComparison(EXPRESSION_TYPE_COMPARE_GREATERTHAN, 1, 151,
+                           false)));
+  CheckBatchEvaluation(tile_group, conjunction.get());
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,199 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// column_kernels_test.cpp
+//
+// Identification: test/expression/column_kernels_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <random>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "expression/column_kernels.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Column Kernels Tests
+//===--------------------------------------------------------------------===//
+
+class ColumnKernelsTests : public PelotonTest {};
+
+using namespace peloton::common;
+
+static const ExpressionType comparison_types[] = {
+    EXPRESSION_TYPE_COMPARE_EQUAL,
+    EXPRESSION_TYPE_COMPARE_NOTEQUAL,
+    EXPRESSION_TYPE_COMPARE_LESSTHAN,
+    EXPRESSION_TYPE_COMPARE_GREATERTHAN,
+    EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO,
+    EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO};
+
+// Reference result computed with the typed value comparisons
+static std::vector<uint64_t> GetExpectedBitmap(
+    const std::vector<TypedValue> &values,
+    const std::vector<expression::ColumnComparison> &terms) {
+  std::vector<uint64_t> bitmap((values.size() + 63) / 64, 0);
+  for (size_t position = 0; position < values.size(); position++) {
+    bool match = true;
+    for (auto &term : terms) {
+      CmpBool result;
+      switch (term.op) {
+        case EXPRESSION_TYPE_COMPARE_EQUAL:
+          result = CompareEquals(values[position], term.constant);
+          break;
+        case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+          result = CompareNotEquals(values[position], term.constant);
+          break;
+        case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+          result = CompareLessThan(values[position], term.constant);
+          break;
+        case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+          result = CompareGreaterThan(values[position], term.constant);
+          break;
+        case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+          result = CompareLessThanEquals(values[position], term.constant);
+          break;
+        default:
+          result = CompareGreaterThanEquals(values[position], term.constant);
+          break;
+      }
+      match &= (result == CMP_TRUE);
+    }
+    if (match) bitmap[position / 64] |= 1ull << (position % 64);
+  }
+  return bitmap;
+}
+
+// Check every instruction set available on this machine against the
+// reference, for every operator alone and for every pair of operators
+template <class T>
+static void CheckKernels(Type::TypeId column_type,
+                         const std::vector<T> &column,
+                         const std::vector<TypedValue> &constants) {
+  std::vector<TypedValue> values;
+  for (auto value : column)
+    values.push_back(TypedValue::DeserializeFrom(
+        reinterpret_cast<const char *>(&value), column_type));
+
+  auto supported_isa = expression::ColumnKernels::GetSupportedIsa();
+  for (int isa = expression::COLUMN_KERNEL_ISA_SCALAR; isa <= supported_isa;
+       isa++) {
+    expression::ColumnKernels::SetIsa(
+        static_cast<expression::ColumnKernelIsa>(isa));
+    for (auto first_op : comparison_types) {
+      for (auto &first_constant : constants) {
+        std::vector<expression::ColumnComparison> terms = {
+            {first_op, first_constant}};
+        std::vector<uint64_t> bitmap;
+        EXPECT_TRUE(expression::ColumnKernels::Filter(
+            column_type, reinterpret_cast<const char *>(column.data()),
+            column.size(), terms.data(), terms.size(), bitmap));
+        EXPECT_EQ(GetExpectedBitmap(values, terms), bitmap);
+
+        for (auto second_op : comparison_types) {
+          terms = {{first_op, first_constant}, {second_op, constants.back()}};
+          EXPECT_TRUE(expression::ColumnKernels::Filter(
+              column_type, reinterpret_cast<const char *>(column.data()),
+              column.size(), terms.data(), terms.size(), bitmap));
+          EXPECT_EQ(GetExpectedBitmap(values, terms), bitmap);
+        }
+      }
+    }
+  }
+  expression::ColumnKernels::SetIsa(supported_isa);
+}
+
+// 203 values so that every kernel also goes through its scalar tail
+static const int column_size = 203;
+
+TEST_F(ColumnKernelsTests, IntegerTest) {
+  std::mt19937 generator(0);
+  std::uniform_int_distribution<int32_t> distribution(-10, 10);
+  std::vector<int32_t> column;
+  for (int position = 0; position < column_size; position++)
+    column.push_back(position % 17 == 0 ? PELOTON_INT32_NULL
+                                        : distribution(generator));
+
+  CheckKernels(Type::INTEGER, column,
+               {TypedValue((int32_t)-3), TypedValue((int64_t)0),
+                TypedValue((int8_t)5)});
+}
+
+TEST_F(ColumnKernelsTests, BigIntTest) {
+  std::mt19937 generator(0);
+  std::uniform_int_distribution<int64_t> distribution(-10, 10);
+  std::vector<int64_t> column;
+  for (int position = 0; position < column_size; position++)
+    column.push_back(position % 17 == 0 ? PELOTON_INT64_NULL
+                                        : distribution(generator) << 40);
+
+  CheckKernels(Type::BIGINT, column,
+               {TypedValue(-((int64_t)3 << 40)), TypedValue((int32_t)0),
+                TypedValue((int64_t)5 << 40)});
+}
+
+TEST_F(ColumnKernelsTests, DecimalTest) {
+  std::mt19937 generator(0);
+  std::uniform_int_distribution<int32_t> distribution(-10, 10);
+  std::vector<double> column;
+  for (int position = 0; position < column_size; position++)
+    column.push_back(position % 17 == 0 ? PELOTON_DECIMAL_NULL
+                                        : distribution(generator) / 2.0);
+
+  CheckKernels(Type::DECIMAL, column,
+               {TypedValue(-1.5), TypedValue((int32_t)0), TypedValue(2.5)});
+}
+
+TEST_F(ColumnKernelsTests, TimestampTest) {
+  std::mt19937 generator(0);
+  std::uniform_int_distribution<uint64_t> distribution(0, 20);
+  std::vector<uint64_t> column;
+  for (int position = 0; position < column_size; position++)
+    column.push_back(position % 17 == 0 ? PELOTON_TIMESTAMP_NULL
+                                        : distribution(generator) * 1000000);
+
+  // Values above 2^63 check that the kernels compare them as unsigned
+  column[1] = PELOTON_TIMESTAMP_MAX;
+  CheckKernels(Type::TIMESTAMP, column,
+               {TypedValue::GetTimestamp(5000000),
+                TypedValue::GetTimestamp(0),
+                TypedValue::GetTimestamp(15000000)});
+}
+
+TEST_F(ColumnKernelsTests, UnsupportedShapeTest) {
+  std::vector<int32_t> column(column_size, 1);
+  std::vector<uint64_t> bitmap;
+
+  // Constants that need a wider comparison than the column type
+  expression::ColumnComparison wide_term = {
+      EXPRESSION_TYPE_COMPARE_LESSTHAN, TypedValue((int64_t)1 << 40)};
+  EXPECT_FALSE(expression::ColumnKernels::Filter(
+      Type::INTEGER, reinterpret_cast<const char *>(column.data()),
+      column.size(), &wide_term, 1, bitmap));
+  expression::ColumnComparison decimal_term = {
+      EXPRESSION_TYPE_COMPARE_LESSTHAN, TypedValue(1.5)};
+  EXPECT_FALSE(expression::ColumnKernels::Filter(
+      Type::INTEGER, reinterpret_cast<const char *>(column.data()),
+      column.size(), &decimal_term, 1, bitmap));
+  EXPECT_TRUE(bitmap.empty());
+
+  // Nothing matches a NULL constant
+  expression::ColumnComparison null_term = {
+      EXPRESSION_TYPE_COMPARE_NOTEQUAL,
+      TypedValue::GetNullValueByType(Type::INTEGER)};
+  EXPECT_TRUE(expression::ColumnKernels::Filter(
+      Type::INTEGER, reinterpret_cast<const char *>(column.data()),
+      column.size(), &null_term, 1, bitmap));
+  EXPECT_EQ(std::vector<uint64_t>(4, 0), bitmap);
+}
+
+}  // namespace test
+}  // namespace peloton
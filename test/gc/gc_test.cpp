@@ -10,11 +10,18 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <functional>
+
 #include "common/harness.h"
+#include "catalog/manager.h"
 #include "concurrency/transaction_tests_util.h"
 #include "gc/gc_manager.h"
 #include "gc/gc_manager_factory.h"
+#include "gc/transaction_level_gc_manager.h"
 #include "concurrency/epoch_manager.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
 
 namespace peloton {
 namespace test {
@@ -28,6 +35,144 @@ class GCTest : public PelotonTest {};
 // FIXME: see the explanation rpc_client_test and rpc_server_test
 TEST_F(GCTest, BlankTest) {}
 
+TEST_F(GCTest, PruneVersionChainTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto &manager = catalog::Manager::GetInstance();
+
+  // the GC threads are started once the chain is pruned
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::GCManagerFactory::GetInstance();
+
+  // a table with one key, updated many times
+  const int update_count = 20;
+  std::unique_ptr<storage::DataTable> table(
+      TransactionTestsUtil::CreateTable(1, "TEST_TABLE", INVALID_OID,
+                                        INVALID_OID, 1234, true));
+  for (int value = 1; value <= update_count; value++) {
+    auto txn = txn_manager.BeginTransaction();
+    EXPECT_TRUE(TransactionTestsUtil::ExecuteUpdate(txn, table.get(), 0,
+                                                    value));
+    EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction(txn));
+  }
+
+  // the versions of the key, from the oldest to the newest
+  std::vector<ItemPointer> versions;
+  ItemPointer version(table->GetTileGroup(0)->GetTileGroupId(), 0);
+  while (version.IsNull() == false) {
+    versions.push_back(version);
+    version = manager.GetTileGroup(version.block)
+                  ->GetHeader()
+                  ->GetPrevItemPointer(version.offset);
+  }
+  ASSERT_EQ(update_count + 1, versions.size());
+  auto newest_version = versions.back();
+  auto newest_header = manager.GetTileGroup(newest_version.block)->GetHeader();
+  EXPECT_FALSE(newest_header->GetNextItemPointer(newest_version.offset)
+                   .IsNull());
+
+  // the newest version is older than every transaction once its epoch is dead
+  std::this_thread::sleep_for(3 * std::chrono::milliseconds(EPOCH_LENGTH));
+
+  // the read through the index cuts the older versions off the chain
+  auto txn = txn_manager.BeginTransaction();
+  int result;
+  EXPECT_TRUE(TransactionTestsUtil::ExecuteRead(txn, table.get(), 0, result));
+  EXPECT_EQ(update_count, result);
+  EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction(txn));
+
+  EXPECT_TRUE(
+      newest_header->GetNextItemPointer(newest_version.offset).IsNull());
+  for (size_t version_itr = 0; version_itr + 1 < versions.size();
+       version_itr++) {
+    auto &older_version = versions[version_itr];
+    EXPECT_EQ(INVALID_CID, manager.GetTileGroup(older_version.block)
+                               ->GetHeader()
+                               ->GetEndCommitId(older_version.offset));
+  }
+
+  // the GC resets the pruned versions once their readers are gone
+  gc_manager.StartGC();
+  size_t reset_count = 0;
+  for (int wait_itr = 0; wait_itr < 100 && reset_count + 1 < versions.size();
+       wait_itr++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(EPOCH_LENGTH));
+    reset_count = 0;
+    for (size_t version_itr = 0; version_itr + 1 < versions.size();
+         version_itr++) {
+      auto &older_version = versions[version_itr];
+      if (manager.GetTileGroup(older_version.block)
+              ->GetHeader()
+              ->GetTransactionId(older_version.offset) == INVALID_TXN_ID) {
+        reset_count++;
+      }
+    }
+  }
+  EXPECT_EQ(versions.size() - 1, reset_count);
+
+  // the newest version is still visible
+  txn = txn_manager.BeginTransaction();
+  EXPECT_TRUE(TransactionTestsUtil::ExecuteRead(txn, table.get(), 0, result));
+  EXPECT_EQ(update_count, result);
+  EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction(txn));
+  EXPECT_EQ(INITIAL_TXN_ID,
+            newest_header->GetTransactionId(newest_version.offset));
+}
+
+TEST_F(GCTest, AdaptiveThreadCountTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // wait for a condition, and run transactions meanwhile so that the epochs
+  // advance
+  auto wait_for = [&txn_manager](std::function<bool()> condition) {
+    for (int wait_itr = 0; wait_itr < 200 && condition() == false;
+         wait_itr++) {
+      auto txn = txn_manager.BeginTransaction();
+      txn_manager.CommitTransaction(txn);
+      std::this_thread::sleep_for(std::chrono::milliseconds(EPOCH_LENGTH));
+    }
+    return condition();
+  };
+
+  const int gc_thread_count = 4;
+  gc::TransactionLevelGCManager gc_manager(gc_thread_count);
+  EXPECT_FALSE(gc_manager.IsAdaptive());
+  gc_manager.SetAdaptive(true);
+  gc_manager.SetBacklogPerThread(10);
+  gc_manager.SetControlInterval(10);
+  gc_manager.StartGC();
+
+  // without garbage, the threads are parked one at a time
+  EXPECT_TRUE(wait_for(
+      [&gc_manager]() { return gc_manager.GetActiveThreadCount() == 1; }));
+
+  // a backlog that cannot be unlinked before the next transactions are over
+  cid_t timestamp = txn_manager.GetCurrentCommitId();
+  const size_t garbage_count = 100;
+  for (size_t garbage_itr = 0; garbage_itr < garbage_count; garbage_itr++) {
+    auto gc_set = ReadWriteSet::CreateShared();
+    gc_set->Insert(INVALID_OID, 0, RW_TYPE_UPDATE);
+    gc_manager.RecycleTransaction(gc_set, timestamp, GC_SET_TYPE_COMMITTED);
+  }
+
+  // the threads are all woken up at once
+  for (int wait_itr = 0;
+       wait_itr < 200 && gc_manager.GetActiveThreadCount() < gc_thread_count;
+       wait_itr++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(gc_thread_count, gc_manager.GetActiveThreadCount());
+
+  // and parked again once the garbage is reclaimed
+  EXPECT_TRUE(wait_for([&gc_manager]() {
+    return gc_manager.GetUnlinkBacklog() + gc_manager.GetReclaimBacklog() ==
+               0 &&
+           gc_manager.GetActiveThreadCount() == 1;
+  }));
+  EXPECT_EQ(garbage_count, gc_manager.GetReclaimedVersionCount());
+
+  gc_manager.StopGC();
+}
+
 /*
 int UpdateTable(storage::DataTable *table, const int scale, const int num_key,
 const int num_txn) {
@@ -0,0 +1,185 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_compactor_test.cpp
+//
+// Identification: test/gc/tile_group_compactor_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+#include "concurrency/epoch_manager.h"
+#include "concurrency/transaction_tests_util.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "executor/seq_scan_executor.h"
+#include "gc/gc_manager_factory.h"
+#include "gc/tile_group_compactor.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/tile_group_header.h"
+#include "storage/tile_group_iterator.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Tile Group Compactor Tests
+//===--------------------------------------------------------------------===//
+
+class TileGroupCompactorTests : public PelotonTest {};
+
+// Count the latest versions of the tuples in the first tile groups of a table
+static size_t CountLiveTuples(storage::DataTable *table,
+                              size_t tile_group_count) {
+  size_t live_tuple_count = 0;
+  for (size_t offset = 0; offset < tile_group_count; offset++) {
+    auto tile_group = table->GetTileGroup(offset);
+    auto tile_group_header = tile_group->GetHeader();
+    auto tuple_count = tile_group->GetNextTupleSlot();
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      if (tile_group_header->GetTransactionId(tuple_id) == INITIAL_TXN_ID &&
+          tile_group_header->GetEndCommitId(tuple_id) == MAX_CID) {
+        live_tuple_count++;
+      }
+    }
+  }
+  return live_tuple_count;
+}
+
+TEST_F(TileGroupCompactorTests, RelocateTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // 100 tuples per tile group, so the keys fill the first 5 tile groups
+  const int num_key = 500;
+  const int kept_key_interval = 25;
+  const size_t key_tile_group_count = 5;
+  std::unique_ptr<storage::DataTable> table(
+      TransactionTestsUtil::CreateTable(num_key));
+
+  // delete all but 4 tuples of each tile group
+  auto txn = txn_manager.BeginTransaction();
+  for (int id = 0; id < num_key; id++) {
+    if (id % kept_key_interval != 0) {
+      TransactionTestsUtil::ExecuteDelete(txn, table.get(), id);
+    }
+  }
+  EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction(txn));
+
+  size_t kept_key_count = num_key / kept_key_interval;
+  EXPECT_EQ(kept_key_count,
+            CountLiveTuples(table.get(), key_tile_group_count));
+
+  gc::TileGroupCompactor compactor;
+  compactor.SetMaxTuplesPerTxn(3);
+  compactor.CompactTable(table.get());
+
+  // the sparse tile groups were emptied
+  for (size_t offset = 0; offset < key_tile_group_count; offset++) {
+    EXPECT_TRUE(table->GetTileGroup(offset)->GetHeader()->GetImmutability());
+  }
+  EXPECT_EQ(0, CountLiveTuples(table.get(), key_tile_group_count));
+  EXPECT_EQ(kept_key_count, compactor.GetRelocatedTupleCount());
+  EXPECT_EQ(0, compactor.GetSkippedTupleCount());
+
+  // the indexes lead to the relocated tuples
+  txn = txn_manager.BeginTransaction();
+  for (int id = 0; id < num_key; id++) {
+    int result;
+    TransactionTestsUtil::ExecuteRead(txn, table.get(), id, result);
+    if (id % kept_key_interval == 0) {
+      EXPECT_EQ(0, result);
+    } else {
+      EXPECT_EQ(-1, result);
+    }
+  }
+  EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction(txn));
+}
+
+TEST_F(TileGroupCompactorTests, DropTest) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // the GC threads are started once the old versions are in place, so that
+  // their slots are not reused by the updates
+  gc::GCManagerFactory::Configure(1);
+  auto &gc_manager = gc::GCManagerFactory::GetInstance();
+
+  // 100 tuples per tile group, so the keys fill the first 5 tile groups
+  const int num_key = 500;
+  const int kept_key_interval = 25;
+  const size_t key_tile_group_count = 5;
+  std::unique_ptr<storage::DataTable> table(
+      TransactionTestsUtil::CreateTable(num_key));
+
+  // update all but 4 tuples of each tile group, which leaves the old
+  // versions behind for the GC
+  auto txn = txn_manager.BeginTransaction();
+  for (int id = 0; id < num_key; id++) {
+    if (id % kept_key_interval != 0) {
+      TransactionTestsUtil::ExecuteUpdate(txn, table.get(), id, 1);
+    }
+  }
+  EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction(txn));
+  gc_manager.StartGC();
+
+  // the tile groups are dropped once the GC has reset every version they
+  // hold, and the transactions that could read them are over
+  gc::TileGroupCompactor compactor;
+  for (int round_itr = 0; round_itr < 200 &&
+                          compactor.GetDroppedTileGroupCount() <
+                              key_tile_group_count;
+       round_itr++) {
+    compactor.CompactTable(table.get());
+
+    // the epochs only advance past the running transactions
+    txn = txn_manager.BeginTransaction();
+    EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction(txn));
+    std::this_thread::sleep_for(std::chrono::milliseconds(EPOCH_LENGTH));
+  }
+  EXPECT_EQ(key_tile_group_count, compactor.GetDroppedTileGroupCount());
+  EXPECT_EQ(num_key / kept_key_interval, compactor.GetRelocatedTupleCount());
+
+  auto tile_group_count = table->GetTileGroupCount();
+  for (size_t offset = 0; offset < key_tile_group_count; offset++) {
+    EXPECT_TRUE(table->GetTileGroup(offset) == nullptr);
+  }
+
+  // the iterators skip the holes
+  size_t live_tile_group_count = 0;
+  storage::TileGroupIterator tile_group_itr(table.get());
+  std::shared_ptr<storage::TileGroup> tile_group;
+  while (tile_group_itr.Next(tile_group) == true) {
+    EXPECT_NE(tile_group, nullptr);
+    live_tile_group_count++;
+  }
+  EXPECT_EQ(tile_group_count - key_tile_group_count, live_tile_group_count);
+
+  // and so do the scans, which still find every key
+  txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  planner::SeqScanPlan seq_scan_node(table.get(), nullptr, {0, 1});
+  executor::SeqScanExecutor seq_scan_executor(&seq_scan_node, context.get());
+  EXPECT_TRUE(seq_scan_executor.Init());
+  size_t scanned_tuple_count = 0;
+  while (seq_scan_executor.Execute() == true) {
+    std::unique_ptr<executor::LogicalTile> result_tile(
+        seq_scan_executor.GetOutput());
+    scanned_tuple_count += result_tile->GetTupleCount();
+  }
+  EXPECT_EQ(num_key, scanned_tuple_count);
+
+  for (int id = 0; id < num_key; id++) {
+    int result;
+    TransactionTestsUtil::ExecuteRead(txn, table.get(), id, result);
+    EXPECT_EQ(id % kept_key_interval == 0 ? 0 : 1, result);
+  }
+  EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction(txn));
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,182 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hash_index_test.cpp
+//
+// Identification: test/index/hash_index_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+#include "common/harness.h"
+
+#include "common/logger.h"
+#include "common/platform.h"
+#include "common/value_factory.h"
+#include "index/index_factory.h"
+#include "storage/tuple.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Hash Index Tests
+//===--------------------------------------------------------------------===//
+
+class HashIndexTests : public PelotonTest {};
+
+namespace {
+
+/*
+ * BuildIndex() - Builds a hash index on the first two of three columns
+ */
+index::Index *BuildIndex(catalog::Schema *&key_schema,
+                         std::unique_ptr<catalog::Schema> &tuple_schema) {
+  catalog::Column column1(common::Type::INTEGER,
+                          common::Type::GetTypeSize(common::Type::INTEGER),
+                          "A", true);
+  catalog::Column column2(common::Type::VARCHAR, 1024, "B", false);
+  catalog::Column column3(common::Type::DECIMAL,
+                          common::Type::GetTypeSize(common::Type::DECIMAL),
+                          "C", true);
+
+  std::vector<oid_t> key_attrs = {0, 1};
+  key_schema = new catalog::Schema({column1, column2});
+  key_schema->SetIndexedColumns(key_attrs);
+  // The index owns the key schema but not the tuple schema
+  tuple_schema.reset(new catalog::Schema({column1, column2, column3}));
+
+  index::IndexMetadata *index_metadata = new index::IndexMetadata(
+      "hash_index", 125,  // Index oid
+      INVALID_OID, INVALID_OID, INDEX_TYPE_HASH, INDEX_CONSTRAINT_TYPE_DEFAULT,
+      tuple_schema.get(), key_schema, key_attrs, false);
+
+  return index::IndexFactory::GetInstance(index_metadata);
+}
+
+storage::Tuple *BuildKey(catalog::Schema *key_schema, int a,
+                         const std::string &b) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  storage::Tuple *key = new storage::Tuple(key_schema, true);
+  key->SetValue(0, common::ValueFactory::GetIntegerValue(a), pool);
+  key->SetValue(1, common::ValueFactory::GetVarcharValue(b), pool);
+  return key;
+}
+
+// Insert keys (thread_itr * 1000 + 0 .. key_count - 1, "key") and a
+// duplicate of the first one
+void InsertKeys(index::Index *index, catalog::Schema *key_schema,
+                std::vector<ItemPointer> *locations, int key_count,
+                uint64_t thread_itr) {
+  for (int key_itr = 0; key_itr < key_count; key_itr++) {
+    int a = thread_itr * 1000 + key_itr;
+    std::unique_ptr<storage::Tuple> key(BuildKey(key_schema, a, "key"));
+    EXPECT_TRUE(index->InsertEntry(key.get(), &(*locations)[key_itr]));
+  }
+  std::unique_ptr<storage::Tuple> key(
+      BuildKey(key_schema, thread_itr * 1000, "key"));
+  EXPECT_TRUE(index->InsertEntry(key.get(), &(*locations)[key_count]));
+}
+
+}  // namespace
+
+TEST_F(HashIndexTests, BasicTest) {
+  catalog::Schema *key_schema;
+  std::unique_ptr<catalog::Schema> tuple_schema;
+  std::unique_ptr<index::Index> index(BuildIndex(key_schema, tuple_schema));
+  EXPECT_EQ("Hash", index->GetTypeName());
+
+  const int key_count = 100;
+  std::vector<ItemPointer> locations;
+  for (int key_itr = 0; key_itr <= key_count; key_itr++)
+    locations.emplace_back(key_itr, key_itr);
+  InsertKeys(index.get(), key_schema, &locations, key_count, 0);
+
+  std::vector<ItemPointer *> location_ptrs;
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(key_count + 1, location_ptrs.size());
+  location_ptrs.clear();
+
+  // Duplicate keys keep all their locations
+  std::unique_ptr<storage::Tuple> key0(BuildKey(key_schema, 0, "key"));
+  index->ScanKey(key0.get(), location_ptrs);
+  EXPECT_EQ(2, location_ptrs.size());
+  location_ptrs.clear();
+
+  // Keys differing in the varchar column are different keys
+  std::unique_ptr<storage::Tuple> keynonce(BuildKey(key_schema, 0, "nonce"));
+  index->ScanKey(keynonce.get(), location_ptrs);
+  EXPECT_EQ(0, location_ptrs.size());
+
+  // Deleting removes only the given location
+  EXPECT_TRUE(index->DeleteEntry(key0.get(), &locations[0]));
+  index->ScanKey(key0.get(), location_ptrs);
+  ASSERT_EQ(1, location_ptrs.size());
+  EXPECT_EQ(&locations[key_count], location_ptrs[0]);
+  location_ptrs.clear();
+
+  // Conditional insert fails when an existing location satisfies the
+  // predicate
+  ItemPointer new_location(key_count + 1, 0);
+  EXPECT_FALSE(index->CondInsertEntry(
+      key0.get(), &new_location,
+      [](const void *location) { return location != nullptr; }));
+  EXPECT_TRUE(index->CondInsertEntry(
+      key0.get(), &new_location,
+      [](const void *location) { return location == nullptr; }));
+  index->ScanKey(key0.get(), location_ptrs);
+  EXPECT_EQ(2, location_ptrs.size());
+  location_ptrs.clear();
+
+  // Point queries only look at their key
+  std::unique_ptr<common::Value> a_value(
+      common::ValueFactory::GetIntegerValue(42).Copy());
+  std::unique_ptr<common::Value> b_value(
+      common::ValueFactory::GetVarcharValue("key").Copy());
+  index->ScanTest({a_value.get(), b_value.get()}, {0, 1},
+                  {EXPRESSION_TYPE_COMPARE_EQUAL, EXPRESSION_TYPE_COMPARE_EQUAL},
+                  SCAN_DIRECTION_TYPE_FORWARD, location_ptrs);
+  ASSERT_EQ(1, location_ptrs.size());
+  EXPECT_EQ(&locations[42], location_ptrs[0]);
+  location_ptrs.clear();
+
+  // Range scans go over every key
+  index->ScanTest({a_value.get()}, {0}, {EXPRESSION_TYPE_COMPARE_LESSTHAN},
+                  SCAN_DIRECTION_TYPE_FORWARD, location_ptrs);
+  EXPECT_EQ(42 + 1, location_ptrs.size());
+  location_ptrs.clear();
+}
+
+TEST_F(HashIndexTests, MultiThreadedInsertTest) {
+  catalog::Schema *key_schema;
+  std::unique_ptr<catalog::Schema> tuple_schema;
+  std::unique_ptr<index::Index> index(BuildIndex(key_schema, tuple_schema));
+
+  const int key_count = 500;
+  const size_t num_threads = 4;
+  std::vector<ItemPointer> locations;
+  for (int key_itr = 0; key_itr <= key_count; key_itr++)
+    locations.emplace_back(key_itr, key_itr);
+  LaunchParallelTest(num_threads, InsertKeys, index.get(), key_schema,
+                     &locations, key_count);
+
+  std::vector<ItemPointer *> location_ptrs;
+  index->ScanAllKeys(location_ptrs);
+  EXPECT_EQ(num_threads * (key_count + 1), location_ptrs.size());
+  location_ptrs.clear();
+
+  for (size_t thread_itr = 0; thread_itr < num_threads; thread_itr++) {
+    std::unique_ptr<storage::Tuple> key(
+        BuildKey(key_schema, thread_itr * 1000 + 1, "key"));
+    index->ScanKey(key.get(), location_ptrs);
+    ASSERT_EQ(1, location_ptrs.size());
+    EXPECT_EQ(&locations[1], location_ptrs[0]);
+    location_ptrs.clear();
+  }
+}
+
+}  // namespace test
+}  // namespace peloton
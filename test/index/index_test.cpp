@@ -423,6 +423,50 @@ TEST_F(IndexTests, NonUniqueKeyDeleteTest) {
   delete tuple_schema;
 }
 
+TEST_F(IndexTests, DeleteEntriesTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer *> location_ptrs;
+
+  // INDEX
+  std::unique_ptr<index::Index> index(BuildIndex(false));
+
+  // every key maps to item0 and item1
+  const int key_count = 100;
+  std::vector<std::unique_ptr<storage::Tuple>> keys;
+  for (int key_itr = 0; key_itr < key_count; key_itr++) {
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(key_schema, true));
+    key->SetValue(0, common::ValueFactory::GetIntegerValue(key_itr), pool);
+    key->SetValue(1, common::ValueFactory::GetVarcharValue("a"), pool);
+    index->InsertEntry(key.get(), item0.get());
+    index->InsertEntry(key.get(), item1.get());
+    keys.push_back(std::move(key));
+  }
+
+  // delete item0 of every key, in reverse key order, and item1 of the first
+  // key. item2 was never inserted.
+  std::vector<std::pair<const storage::Tuple *, ItemPointer *>> entries;
+  for (int key_itr = key_count - 1; key_itr >= 0; key_itr--) {
+    entries.emplace_back(keys[key_itr].get(), item0.get());
+  }
+  entries.emplace_back(keys[0].get(), item1.get());
+  entries.emplace_back(keys[1].get(), item2.get());
+  index->DeleteEntries(entries);
+
+  // Checks
+  index->ScanKey(keys[0].get(), location_ptrs);
+  EXPECT_EQ(location_ptrs.size(), 0);
+  location_ptrs.clear();
+
+  for (int key_itr = 1; key_itr < key_count; key_itr++) {
+    index->ScanKey(keys[key_itr].get(), location_ptrs);
+    EXPECT_EQ(location_ptrs.size(), 1);
+    EXPECT_EQ(location_ptrs[0]->offset, item1->offset);
+    location_ptrs.clear();
+  }
+
+  delete tuple_schema;
+}
+
 TEST_F(IndexTests, MultiThreadedInsertTest) {
   auto pool = TestingHarness::GetInstance().GetTestingPool();
   std::vector<ItemPointer *> location_ptrs;
@@ -156,6 +156,31 @@ TEST_F(BufferPoolTests, LargeTupleRecordTest) {
   EXPECT_EQ(success, true);
 }
 
+TEST_F(BufferPoolTests, LogBufferSealTest) {
+  logging::LogBuffer log_buffer(0);
+  const char record[] = "record";
+
+  // reserved records are only taken over once they are published
+  char *location = log_buffer.ReserveRecord(sizeof(record));
+  EXPECT_TRUE(location != nullptr);
+  PL_MEMCPY(location, record, sizeof(record));
+  log_buffer.PublishRecord(sizeof(record));
+  EXPECT_EQ(log_buffer.GetReservedSize(), sizeof(record));
+
+  EXPECT_EQ(log_buffer.Seal(), sizeof(record));
+  EXPECT_EQ(log_buffer.GetSize(), sizeof(record));
+  EXPECT_EQ(std::string(log_buffer.GetData()), std::string(record));
+
+  // a sealed buffer takes no record until it is opened again
+  EXPECT_TRUE(log_buffer.ReserveRecord(sizeof(record)) == nullptr);
+  log_buffer.ResetData();
+  EXPECT_TRUE(log_buffer.ReserveRecord(sizeof(record)) == nullptr);
+
+  log_buffer.Open(sizeof(record));
+  EXPECT_EQ(log_buffer.GetReservedSize(), 0);
+  EXPECT_TRUE(log_buffer.ReserveRecord(sizeof(record)) != nullptr);
+}
+
 TEST_F(BufferPoolTests, BufferPoolConcurrentTest) {
   unsigned int txn_count = 9999;
 
@@ -10,17 +10,24 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <sys/stat.h>
+#include <chrono>
 #include <numeric>
+#include <thread>
 
 #include "common/harness.h"
 #include "catalog/catalog.h"
+#include "common/value_factory.h"
 #include "logging/checkpoint.h"
 #include "logging/logging_util.h"
 #include "logging/loggers/wal_backend_logger.h"
+#include "logging/loggers/wal_frontend_logger.h"
 #include "logging/checkpoint/simple_checkpoint.h"
+#include "logging/checkpoint/fuzzy_checkpoint.h"
 #include "logging/checkpoint_manager.h"
 #include "storage/database.h"
 
+#include "concurrency/epoch_manager.h"
 #include "concurrency/transaction_manager_factory.h"
 #include "executor/logical_tile_factory.h"
 #include "index/index.h"
@@ -115,6 +122,256 @@ TEST_F(CheckpointTests, CheckpointIntegrationTest) {
   logging::LoggingUtil::RemoveDirectory("pl_checkpoint", false);
 }
 
+TEST_F(CheckpointTests, FuzzyCheckpointTest) {
+  logging::LoggingUtil::RemoveDirectory("pl_checkpoint", false);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  size_t tile_group_size = TESTS_TUPLES_PER_TILEGROUP;
+  size_t table_tile_group_count = 3;
+  size_t tuple_count = tile_group_size * table_tile_group_count;
+
+  oid_t default_table_oid = 14;
+  // table has 3 tile groups
+  storage::DataTable *target_table =
+      ExecutorTestsUtil::CreateTable(tile_group_size, true, default_table_oid);
+  ExecutorTestsUtil::PopulateTable(target_table, tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+  auto tile_group_id = target_table->GetTileGroup(0)->GetTileGroupId();
+
+  // add table to catalog
+  auto catalog = catalog::Catalog::GetInstance();
+  storage::Database *db(new storage::Database(DEFAULT_DB_ID));
+  db->AddTable(target_table);
+  catalog->AddDatabase(db);
+
+  // The snapshot of the checkpoint only moves past the insert once its epoch
+  // is dead
+  std::this_thread::sleep_for(3 * std::chrono::milliseconds(EPOCH_LENGTH));
+
+  // create checkpoint, scanning the tile groups with several threads
+  auto &checkpoint_manager = logging::CheckpointManager::GetInstance();
+  checkpoint_manager.Configure(CHECKPOINT_TYPE_FUZZY, false, 1);
+  checkpoint_manager.DestroyCheckpointers();
+  checkpoint_manager.InitCheckpointers();
+  auto checkpointer = reinterpret_cast<logging::FuzzyCheckpoint *>(
+      checkpoint_manager.GetCheckpointer(0));
+  checkpointer->SetScanThreadCount(2);
+
+  checkpointer->DoCheckpoint();
+
+  auto most_recent_checkpoint_cid = checkpointer->GetMostRecentCheckpointCid();
+  EXPECT_NE(most_recent_checkpoint_cid, INVALID_CID);
+
+  // drop the table with its tile groups, and restart with an empty one
+  catalog->DropDatabaseWithOid(DEFAULT_DB_ID);
+  EXPECT_EQ(catalog::Manager::GetInstance().GetTileGroup(tile_group_id),
+            nullptr);
+  auto recovery_table =
+      ExecutorTestsUtil::CreateTable(tile_group_size, true, default_table_oid);
+  db = new storage::Database(DEFAULT_DB_ID);
+  db->AddTable(recovery_table);
+  catalog->AddDatabase(db);
+
+  checkpoint_manager.DestroyCheckpointers();
+  checkpoint_manager.InitCheckpointers();
+  logging::LogManager::GetInstance().PrepareRecovery();
+
+  // recovery from checkpoint
+  auto recovery_checkpointer = checkpoint_manager.GetCheckpointer(0);
+  EXPECT_EQ(recovery_checkpointer->DoRecovery(), most_recent_checkpoint_cid);
+
+  EXPECT_EQ(recovery_table->GetTupleCount(), tuple_count);
+
+  // the recovered tuples hold the values that were checkpointed
+  auto tile_group = catalog::Manager::GetInstance().GetTileGroup(tile_group_id);
+  ASSERT_NE(tile_group, nullptr);
+  for (oid_t tuple_id = 0; tuple_id < tile_group_size; tuple_id++) {
+    std::unique_ptr<common::Value> value(tile_group->GetValue(tuple_id, 0));
+    std::unique_ptr<common::Value> cmp(
+        value->CompareEquals(common::ValueFactory::GetIntegerValue(
+            ExecutorTestsUtil::PopulatedValue(tuple_id, 0))));
+    EXPECT_TRUE(cmp->IsTrue());
+
+    // the varlen payloads are copied into the pools of the tiles
+    std::unique_ptr<common::Value> string_value(
+        tile_group->GetValue(tuple_id, 3));
+    std::unique_ptr<common::Value> string_cmp(string_value->CompareEquals(
+        common::ValueFactory::GetVarcharValue(std::to_string(
+            ExecutorTestsUtil::PopulatedValue(tuple_id, 3)))));
+    EXPECT_TRUE(string_cmp->IsTrue());
+  }
+
+  // the indexes are rebuilt from the recovered tuples
+  logging::WriteAheadFrontendLogger wal_fel(true);
+  wal_fel.RecoverIndex();
+  auto primary_index = recovery_table->GetIndex(0);
+  EXPECT_EQ(primary_index->GetNumberOfTuples(), tuple_count);
+
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  for (oid_t tuple_id = 0; tuple_id < tile_group_size; tuple_id++) {
+    std::unique_ptr<storage::Tuple> key(
+        new storage::Tuple(primary_index->GetKeySchema(), true));
+    key->SetValue(0, common::ValueFactory::GetIntegerValue(
+                         ExecutorTestsUtil::PopulatedValue(tuple_id, 0)),
+                  pool);
+    std::vector<ItemPointer *> location_ptrs;
+    primary_index->ScanKey(key.get(), location_ptrs);
+    ASSERT_EQ(location_ptrs.size(), 1);
+    EXPECT_EQ(location_ptrs[0]->block, tile_group_id);
+    EXPECT_EQ(location_ptrs[0]->offset, tuple_id);
+  }
+
+  catalog->DropDatabaseWithOid(db->GetOid());
+  checkpoint_manager.Configure(CHECKPOINT_TYPE_NORMAL, false, 1);
+  checkpoint_manager.DestroyCheckpointers();
+  logging::LoggingUtil::RemoveDirectory("pl_checkpoint", false);
+}
+
+TEST_F(CheckpointTests, IncrementalCheckpointTest) {
+  logging::LoggingUtil::RemoveDirectory("pl_checkpoint", false);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  size_t tile_group_size = TESTS_TUPLES_PER_TILEGROUP;
+  size_t table_tile_group_count = 3;
+
+  oid_t default_table_oid = 15;
+  // table has 3 tile groups
+  storage::DataTable *target_table =
+      ExecutorTestsUtil::CreateTable(tile_group_size, false, default_table_oid);
+  ExecutorTestsUtil::PopulateTable(target_table,
+                                   tile_group_size * table_tile_group_count,
+                                   false, false, false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // add table to catalog
+  auto catalog = catalog::Catalog::GetInstance();
+  storage::Database *db(new storage::Database(DEFAULT_DB_ID));
+  db->AddTable(target_table);
+  catalog->AddDatabase(db);
+
+  auto &checkpoint_manager = logging::CheckpointManager::GetInstance();
+  checkpoint_manager.Configure(CHECKPOINT_TYPE_INCREMENTAL, false, 1);
+  checkpoint_manager.DestroyCheckpointers();
+  checkpoint_manager.InitCheckpointers();
+  auto checkpointer = reinterpret_cast<logging::FuzzyCheckpoint *>(
+      checkpoint_manager.GetCheckpointer(0));
+  EXPECT_EQ(checkpointer->GetFullCheckpointInterval(),
+            DEFAULT_FULL_CHECKPOINT_INTERVAL);
+
+  // the first checkpoint of the chain is a full one
+  std::this_thread::sleep_for(3 * std::chrono::milliseconds(EPOCH_LENGTH));
+  checkpointer->DoCheckpoint();
+  auto full_checkpoint_cid = checkpointer->GetMostRecentCheckpointCid();
+
+  // fill one more tile group
+  txn = txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(target_table, tile_group_size, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  for (oid_t tile_group_offset = 0; tile_group_offset <= table_tile_group_count;
+       tile_group_offset++) {
+    auto modified_cid = target_table->GetTileGroup(tile_group_offset)
+                            ->GetHeader()
+                            ->GetModifiedCommitId();
+    if (tile_group_offset < table_tile_group_count) {
+      EXPECT_LE(modified_cid, full_checkpoint_cid);
+    } else {
+      EXPECT_GT(modified_cid, full_checkpoint_cid);
+    }
+  }
+
+  // the delta only holds the modified tile group
+  std::this_thread::sleep_for(3 * std::chrono::milliseconds(EPOCH_LENGTH));
+  checkpointer->DoCheckpoint();
+  auto most_recent_checkpoint_cid = checkpointer->GetMostRecentCheckpointCid();
+
+  struct stat full_stat, delta_stat;
+  ASSERT_EQ(stat("pl_checkpoint/peloton_checkpoint_0.log", &full_stat), 0);
+  ASSERT_EQ(stat("pl_checkpoint/peloton_checkpoint_1.log", &delta_stat), 0);
+  EXPECT_LT(delta_stat.st_size * 2, full_stat.st_size);
+
+  // destroy and restart
+  checkpoint_manager.DestroyCheckpointers();
+  checkpoint_manager.InitCheckpointers();
+  logging::LogManager::GetInstance().PrepareRecovery();
+  target_table->SetTupleCount(0);
+
+  // recovery chains the delta to the full checkpoint
+  auto recovery_checkpointer = checkpoint_manager.GetCheckpointer(0);
+  EXPECT_EQ(recovery_checkpointer->DoRecovery(), most_recent_checkpoint_cid);
+
+  EXPECT_EQ(db->GetTable(0)->GetTupleCount(),
+            tile_group_size * (table_tile_group_count + 1));
+
+  catalog->DropDatabaseWithOid(db->GetOid());
+  checkpoint_manager.Configure(CHECKPOINT_TYPE_NORMAL, false, 1);
+  checkpoint_manager.DestroyCheckpointers();
+  logging::LoggingUtil::RemoveDirectory("pl_checkpoint", false);
+}
+
+TEST_F(CheckpointTests, IncrementalCheckpointBrokenChainTest) {
+  logging::LoggingUtil::RemoveDirectory("pl_checkpoint", false);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  size_t tile_group_size = TESTS_TUPLES_PER_TILEGROUP;
+
+  oid_t default_table_oid = 16;
+  storage::DataTable *target_table =
+      ExecutorTestsUtil::CreateTable(tile_group_size, false, default_table_oid);
+  ExecutorTestsUtil::PopulateTable(target_table, tile_group_size, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // add table to catalog
+  auto catalog = catalog::Catalog::GetInstance();
+  storage::Database *db(new storage::Database(DEFAULT_DB_ID));
+  db->AddTable(target_table);
+  catalog->AddDatabase(db);
+
+  auto &checkpoint_manager = logging::CheckpointManager::GetInstance();
+  checkpoint_manager.Configure(CHECKPOINT_TYPE_INCREMENTAL, false, 1);
+  checkpoint_manager.DestroyCheckpointers();
+  checkpoint_manager.InitCheckpointers();
+  auto checkpointer = checkpoint_manager.GetCheckpointer(0);
+
+  // a full checkpoint followed by two deltas, each with a new tile group
+  for (int checkpoint_itr = 0; checkpoint_itr < 3; checkpoint_itr++) {
+    if (checkpoint_itr > 0) {
+      txn = txn_manager.BeginTransaction();
+      ExecutorTestsUtil::PopulateTable(target_table, tile_group_size, false,
+                                       false, false, txn);
+      txn_manager.CommitTransaction(txn);
+    }
+    std::this_thread::sleep_for(3 * std::chrono::milliseconds(EPOCH_LENGTH));
+    checkpointer->DoCheckpoint();
+  }
+
+  // lose the first delta of the chain
+  EXPECT_EQ(remove("pl_checkpoint/peloton_checkpoint_1.log"), 0);
+
+  // destroy and restart
+  checkpoint_manager.DestroyCheckpointers();
+  checkpoint_manager.InitCheckpointers();
+  logging::LogManager::GetInstance().PrepareRecovery();
+  target_table->SetTupleCount(0);
+
+  // the latest delta cannot be loaded without the one it chains to, and the
+  // older checkpoints miss the log that was truncated since
+  auto recovery_checkpointer = checkpoint_manager.GetCheckpointer(0);
+  EXPECT_EQ(recovery_checkpointer->DoRecovery(), INVALID_CID);
+  EXPECT_EQ(db->GetTable(0)->GetTupleCount(), 0);
+
+  catalog->DropDatabaseWithOid(db->GetOid());
+  checkpoint_manager.Configure(CHECKPOINT_TYPE_NORMAL, false, 1);
+  checkpoint_manager.DestroyCheckpointers();
+  logging::LoggingUtil::RemoveDirectory("pl_checkpoint", false);
+}
+
 TEST_F(CheckpointTests, CheckpointScanTest) {
   logging::LoggingUtil::RemoveDirectory("pl_checkpoint", false);
 
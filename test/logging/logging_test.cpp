@@ -10,6 +10,9 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <pthread.h>
+#include <sched.h>
+
 #include "common/harness.h"
 #include "catalog/catalog.h"
 
@@ -372,5 +375,108 @@ TEST_F(LoggingTests, BasicLogManagerTest) {
   log_manager.EndLogging();
 }
 
+TEST_F(LoggingTests, GroupCommitTest) {
+  auto &log_manager = logging::LogManager::GetInstance();
+  std::atomic<bool> released(false);
+
+  // Without logging the response is released right away
+  log_manager.LogCommitTransaction(1, [&released] { released = true; });
+  EXPECT_TRUE(released);
+
+  released = false;
+  peloton_logging_mode = LOGGING_TYPE_NVM_WAL;
+  log_manager.DropFrontendLoggers();
+  log_manager.Configure(LOGGING_TYPE_NVM_WAL, true);
+  log_manager.SetSyncCommit(false);
+  log_manager.StartStandbyMode();
+  log_manager.StartRecoveryMode();
+  log_manager.WaitForModeTransition(LOGGING_STATUS_TYPE_LOGGING, true);
+
+  cid_t commit_id = 10;
+  log_manager.PrepareLogging();
+  log_manager.LogBeginTransaction(commit_id);
+  log_manager.LogCommitTransaction(commit_id,
+                                   [&released] { released = true; });
+
+  // The worker is not held back, the frontend logger releases the response
+  // once the commit is flushed
+  for (int i = 0; i < 1000 && released == false; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_TRUE(released);
+  EXPECT_LE(commit_id, log_manager.GetPersistentFlushedCommitId());
+
+  // A read-only txn logs nothing. Its snapshot is already durable, so its
+  // response is released on commit
+  released = false;
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginReadOnlyTransaction();
+  txn->SetCommitCallback([&released] { released = true; });
+  txn_manager.CommitTransaction(txn);
+  EXPECT_TRUE(released);
+
+  // Otherwise it waits for the flush that covers its snapshot, in commit id
+  // order whatever the order of the txns
+  auto frontend_logger = log_manager.GetFrontendLoggersList()[0].get();
+  auto flushed_commit_id = log_manager.GetPersistentFlushedCommitId();
+  std::vector<cid_t> released_commit_ids;
+  for (cid_t snapshot_cid : {flushed_commit_id + 2, flushed_commit_id + 1}) {
+    frontend_logger->AddSnapshotCallback(
+        snapshot_cid, [&released_commit_ids, snapshot_cid] {
+          released_commit_ids.push_back(snapshot_cid);
+        });
+  }
+  frontend_logger->ReleaseCommitCallbacks(flushed_commit_id);
+  EXPECT_TRUE(released_commit_ids.empty());
+  frontend_logger->ReleaseCommitCallbacks(flushed_commit_id + 2);
+  EXPECT_EQ(std::vector<cid_t>({flushed_commit_id + 1, flushed_commit_id + 2}),
+            released_commit_ids);
+
+  log_manager.EndLogging();
+  log_manager.SetSyncCommit(true);
+}
+
+TEST_F(LoggingTests, MultiStreamTest) {
+  auto &log_manager = logging::LogManager::GetInstance();
+  log_manager.DropFrontendLoggers();
+  log_manager.Configure(LOGGING_TYPE_NVM_WAL, true, 2,
+                        LOGGER_MAPPING_TYPE_AFFINITY);
+  log_manager.InitFrontendLoggers();
+  EXPECT_EQ(2, log_manager.GetFrontendLoggersList().size());
+
+  // Each stream writes its own file set
+  EXPECT_EQ("wal_log",
+            logging::WriteAheadFrontendLogger::GetStreamDirectoryName(0));
+  EXPECT_EQ("wal_log_1",
+            logging::WriteAheadFrontendLogger::GetStreamDirectoryName(1));
+
+  // A commit is only durable once every stream has flushed past it
+  auto stream_0 = log_manager.GetFrontendLogger(0);
+  auto stream_1 = log_manager.GetFrontendLogger(1);
+  stream_0->SetMaxFlushedCommitId(10);
+  stream_1->SetMaxFlushedCommitId(7);
+  EXPECT_EQ(7, log_manager.GetPersistentFlushedCommitId());
+  stream_1->SetMaxFlushedCommitId(12);
+  EXPECT_EQ(10, log_manager.GetPersistentFlushedCommitId());
+
+  // A worker logs to the stream of its core, and stays on that core
+  std::thread worker([&log_manager] {
+    auto backend_logger = log_manager.GetBackendLogger();
+    int cpu = sched_getcpu();
+    EXPECT_EQ(cpu % 2, backend_logger->GetFrontendLoggerID());
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    EXPECT_EQ(0, pthread_getaffinity_np(pthread_self(), sizeof(cpu_set),
+                                        &cpu_set));
+    EXPECT_EQ(1, CPU_COUNT(&cpu_set));
+    EXPECT_TRUE(CPU_ISSET(cpu, &cpu_set));
+  });
+  worker.join();
+
+  log_manager.DropFrontendLoggers();
+  log_manager.Configure(LOGGING_TYPE_NVM_WAL, true);
+}
+
 }  // End test namespace
 }  // End peloton namespace
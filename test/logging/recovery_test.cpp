@@ -233,6 +233,9 @@ TEST_F(RecoveryTests, RestartTest) {
   auto &log_manager = logging::LogManager::GetInstance();
   log_manager.SetGlobalMaxFlushedIdForRecovery(num_files + 1);
 
+  // replay the log and rebuild the indexes with several threads
+  log_manager.SetRecoveryThreadCount(4);
+
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
 
   wal_fel.DoRecovery();
@@ -252,6 +255,30 @@ TEST_F(RecoveryTests, RestartTest) {
               tile_group_size * table_tile_group_count - 1);
   }
 
+  // The rebuilt primary index finds every recovered tuple at the location
+  // it was logged at, but neither the deleted tuple nor the one committed
+  // after the durable commit id
+  auto primary_index = recovery_table->GetIndex(0);
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  for (int rowid = 0; rowid <= num_rows; rowid++) {
+    std::unique_ptr<storage::Tuple> key(
+        new storage::Tuple(primary_index->GetKeySchema(), true));
+    key->SetValue(0, common::ValueFactory::GetIntegerValue(
+                         ExecutorTestsUtil::PopulatedValue(rowid * 3, 0)),
+                  pool);
+    std::vector<ItemPointer *> location_ptrs;
+    primary_index->ScanKey(key.get(), location_ptrs);
+    if (rowid == 0 || rowid == num_rows) {
+      EXPECT_EQ(0, location_ptrs.size());
+      continue;
+    }
+    ASSERT_EQ(1, location_ptrs.size());
+    EXPECT_EQ(records[rowid].GetInsertLocation().block,
+              location_ptrs[0]->block);
+    EXPECT_EQ(records[rowid].GetInsertLocation().offset,
+              location_ptrs[0]->offset);
+  }
+
   // TODO check a few more invariants here
   wal_fel.CreateNewLogFile(false);
 
@@ -277,6 +304,137 @@ TEST_F(RecoveryTests, RestartTest) {
   catalog->DropDatabaseWithOid(DEFAULT_DB_ID);
 }
 
+// Write one committed txn with the given records to a log file
+static void WriteLogFile(const std::string &file_name, cid_t commit_id,
+                         std::vector<logging::TupleRecord *> records) {
+  cid_t default_commit_id = INVALID_CID;
+  cid_t default_delimiter = INVALID_CID;
+  FILE *fp = fopen(file_name.c_str(), "wb");
+
+  // the max log id and the max delimiter of the file
+  fwrite((void *)&default_commit_id, sizeof(default_commit_id), 1, fp);
+  fwrite((void *)&default_delimiter, sizeof(default_delimiter), 1, fp);
+
+  CopySerializeOutput output_buffer_begin;
+  logging::TransactionRecord record_begin(LOGRECORD_TYPE_TRANSACTION_BEGIN,
+                                          commit_id);
+  record_begin.Serialize(output_buffer_begin);
+  fwrite(record_begin.GetMessage(), sizeof(char),
+         record_begin.GetMessageLength(), fp);
+
+  for (auto record : records) {
+    CopySerializeOutput output_buffer;
+    record->Serialize(output_buffer);
+    fwrite(record->GetMessage(), sizeof(char), record->GetMessageLength(), fp);
+  }
+
+  CopySerializeOutput output_buffer_commit;
+  logging::TransactionRecord record_commit(LOGRECORD_TYPE_TRANSACTION_COMMIT,
+                                           commit_id);
+  record_commit.Serialize(output_buffer_commit);
+  fwrite(record_commit.GetMessage(), sizeof(char),
+         record_commit.GetMessageLength(), fp);
+
+  CopySerializeOutput output_buffer_delim;
+  logging::TransactionRecord record_delim(LOGRECORD_TYPE_ITERATION_DELIMITER,
+                                          commit_id);
+  record_delim.Serialize(output_buffer_delim);
+  fwrite(record_delim.GetMessage(), sizeof(char),
+         record_delim.GetMessageLength(), fp);
+
+  fclose(fp);
+}
+
+TEST_F(RecoveryTests, MultiStreamRestartTest) {
+  auto catalog = catalog::Catalog::GetInstance();
+  auto recovery_table = ExecutorTestsUtil::CreateTable(1024);
+
+  size_t tile_group_size = 5;
+  size_t table_tile_group_count = 3;
+  int stream_count = 2;
+
+  storage::Database *db = new storage::Database(DEFAULT_DB_ID);
+  catalog->AddDatabase(db);
+  db->AddTable(recovery_table);
+
+  int num_rows = tile_group_size * table_tile_group_count;
+  std::vector<std::shared_ptr<storage::Tuple>> tuples =
+      LoggingTestsUtil::BuildTuples(recovery_table, num_rows + 1, true, false);
+
+  // The inserts of tile group b commit at b + 1, the delete of the first
+  // tuple commits at 4
+  std::vector<logging::TupleRecord> records =
+      LoggingTestsUtil::BuildTupleRecordsForRestartTest(
+          tuples, tile_group_size, table_tile_group_count, 0, 1);
+
+  auto &log_manager = logging::LogManager::GetInstance();
+  log_manager.SetLogDirectoryName("./");
+  std::vector<std::string> dir_names;
+  for (int stream = 0; stream < stream_count; stream++) {
+    dir_names.push_back(
+        logging::WriteAheadFrontendLogger::GetStreamDirectoryName(stream));
+    logging::LoggingUtil::RemoveDirectory(dir_names[stream].c_str(), false);
+    EXPECT_TRUE(
+        logging::LoggingUtil::CreateDirectory(dir_names[stream].c_str(), 0700));
+  }
+
+  // Stream 0 logs the txns that commit at 2 and 3, stream 1 the one that
+  // commits at 4 and deletes a tuple that stream 0 inserted
+  for (int i = 0; i < 3; i++) {
+    std::vector<logging::TupleRecord *> txn_records;
+    for (size_t j = 0; j < tile_group_size; j++) {
+      txn_records.push_back(&records[i * tile_group_size + j]);
+    }
+    int stream = (i == 2) ? 1 : 0;
+    if (stream == 1) {
+      txn_records.push_back(&records[num_rows]);
+    }
+    std::string file_name = dir_names[stream] + "/peloton_log_" +
+                            std::to_string(stream == 0 ? i : 0) + ".log";
+    WriteLogFile(file_name, i + 2, txn_records);
+  }
+
+  logging::WriteAheadFrontendLogger stream_0(false, 0);
+  logging::WriteAheadFrontendLogger stream_1(false, 1);
+  EXPECT_EQ(2, stream_0.GetLogFileCounter());
+  EXPECT_EQ(1, stream_1.GetLogFileCounter());
+
+  // Every stream is durable up to 4. Replay the newer stream first, so the
+  // delete lands before the insert it deletes.
+  log_manager.SetGlobalMaxFlushedIdForRecovery(4);
+  stream_1.DoRecovery();
+  stream_0.DoRecovery();
+
+  EXPECT_EQ(num_rows - 1, recovery_table->GetTupleCount());
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.SetNextCid(5);
+  stream_0.RecoverIndex();
+
+  auto index = recovery_table->GetIndex(0);
+  EXPECT_EQ(num_rows - 1, index->GetNumberOfTuples());
+
+  // The deleted tuple stays deleted, the others are found by their key
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  for (int rowid = 0; rowid < 2; rowid++) {
+    std::unique_ptr<storage::Tuple> key(
+        new storage::Tuple(index->GetKeySchema(), true));
+    key->SetValue(0, common::ValueFactory::GetIntegerValue(
+                         ExecutorTestsUtil::PopulatedValue(rowid * 3, 0)),
+                  pool);
+    std::vector<ItemPointer *> location_ptrs;
+    index->ScanKey(key.get(), location_ptrs);
+    EXPECT_EQ(rowid == 0 ? 0 : 1, location_ptrs.size());
+  }
+
+  for (int stream = 0; stream < stream_count; stream++) {
+    EXPECT_TRUE(
+        logging::LoggingUtil::RemoveDirectory(dir_names[stream].c_str(), false));
+  }
+
+  catalog->DropDatabaseWithOid(DEFAULT_DB_ID);
+}
+
 TEST_F(RecoveryTests, BasicInsertTest) {
   auto recovery_table = ExecutorTestsUtil::CreateTable(1024);
   auto catalog = catalog::Catalog::GetInstance();
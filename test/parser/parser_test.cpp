@@ -196,6 +196,7 @@ TEST_F(ParserTest, TransactionTest) {
   valid_queries.push_back("BEGIN;");
   valid_queries.push_back("COMMIT TRANSACTION;");
   valid_queries.push_back("ROLLBACK TRANSACTION;");
+  valid_queries.push_back("BEGIN TRANSACTION READ ONLY;");
 
   for (auto query : valid_queries) {
     parser::SQLStatementList* result =
@@ -220,6 +221,7 @@ TEST_F(ParserTest, TransactionTest) {
   list = parser::Parser::ParseSQLString(valid_queries[1].c_str());
   stmt = (parser::TransactionStatement*)list->GetStatement(0);
   EXPECT_EQ(stmt->type, parser::TransactionStatement::kBegin);
+  EXPECT_FALSE(stmt->read_only);
   delete list;
 
   list = parser::Parser::ParseSQLString(valid_queries[2].c_str());
@@ -231,6 +233,21 @@ TEST_F(ParserTest, TransactionTest) {
   stmt = (parser::TransactionStatement*)list->GetStatement(0);
   EXPECT_EQ(stmt->type, parser::TransactionStatement::kRollback);
   delete list;
+
+  list = parser::Parser::ParseSQLString(valid_queries[4].c_str());
+  stmt = (parser::TransactionStatement*)list->GetStatement(0);
+  EXPECT_EQ(stmt->type, parser::TransactionStatement::kBegin);
+  EXPECT_TRUE(stmt->read_only);
+  delete list;
+
+  // READ and ONLY are not reserved
+  list = parser::Parser::ParseSQLString("SELECT read, only FROM read_log;");
+  EXPECT_TRUE(list->is_valid);
+  delete list;
+
+  list = parser::Parser::ParseSQLString("BEGIN READ WRITE;");
+  EXPECT_FALSE(list->is_valid);
+  delete list;
 }
 
 TEST_F(ParserTest, CreateTest) {
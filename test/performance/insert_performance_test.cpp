@@ -148,5 +148,46 @@ TEST_F(InsertTests, LoadingTest) {
                bytes_to_megabytes_converter);
 }
 
+TEST_F(InsertTests, ScalingTest) {
+  // We load tile groups with a growing number of threads, each inserting the
+  // same number of tuples, with the threads sharing the active tile group of
+  // the table or inserting into their own
+  oid_t tuples_per_tilegroup = TEST_TUPLES_PER_TILEGROUP;
+  bool build_indexes = false;
+
+  // Control the scale
+  std::vector<oid_t> loader_threads_counts = {1, 2, 4, 8, 16, 32, 64};
+  oid_t tilegroup_count_per_loader = 200;
+
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+
+  for (auto per_thread_insertion : {false, true}) {
+    for (auto loader_threads_count : loader_threads_counts) {
+      std::unique_ptr<storage::DataTable> data_table(
+          ExecutorTestsUtil::CreateTable(tuples_per_tilegroup, build_indexes));
+      data_table->SetPerThreadInsertion(per_thread_insertion);
+
+      Timer<> timer;
+
+      timer.Start();
+
+      LaunchParallelTest(loader_threads_count, InsertTuple, data_table.get(),
+                         testing_pool, tilegroup_count_per_loader);
+
+      timer.Stop();
+      auto duration = timer.GetDuration();
+
+      size_t total_tuple_count = loader_threads_count *
+                                 tilegroup_count_per_loader *
+                                 TEST_TUPLES_PER_TILEGROUP;
+      EXPECT_EQ(total_tuple_count, data_table->GetTupleCount());
+
+      LOG_INFO("%s tile groups, %u threads: %.2lf s, %.0lf inserts/s",
+               per_thread_insertion ? "Per-thread" : "Shared",
+               loader_threads_count, duration, total_tuple_count / duration);
+    }
+  }
+}
+
 }  // namespace test
 }  // namespace peloton
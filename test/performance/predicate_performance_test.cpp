@@ -0,0 +1,203 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// predicate_performance_test.cpp
+//
+// Identification: test/performance/predicate_performance_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+
+#include <memory>
+
+#include "common/harness.h"
+
+#include "common/timer.h"
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "expression/abstract_expression.h"
+#include "expression/column_kernels.h"
+#include "expression/container_tuple.h"
+#include "expression/expression_util.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Predicate Evaluation Performance Tests
+//===--------------------------------------------------------------------===//
+
+class PredicatePerformanceTests : public PelotonTest {};
+
+// Predicate : COL_A >= 10 * low AND COL_B < 10 * high + 1
+static expression::AbstractExpression *CreateRangePredicate(int low,
+                                                            int high) {
+  auto lower = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+      expression::ExpressionUtil::TupleValueFactory(common::Type::INTEGER, 0,
+                                                    0),
+      expression::ExpressionUtil::ConstantValueFactory(
+          common::ValueFactory::GetIntegerValue(
+              ExecutorTestsUtil::PopulatedValue(low, 0))));
+  auto upper = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_LESSTHAN,
+      expression::ExpressionUtil::TupleValueFactory(common::Type::INTEGER, 0,
+                                                    1),
+      expression::ExpressionUtil::ConstantValueFactory(
+          common::ValueFactory::GetIntegerValue(
+              ExecutorTestsUtil::PopulatedValue(high, 1))));
+  return expression::ExpressionUtil::ConjunctionFactory(
+      EXPRESSION_TYPE_CONJUNCTION_AND, lower, upper);
+}
+
+TEST_F(PredicatePerformanceTests, EvaluateThroughputTest) {
+  const int tuples_per_tilegroup = 1000;
+  const int tuple_count = 100 * tuples_per_tilegroup;
+  const int iterations = 10;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tilegroup, false));
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  std::unique_ptr<expression::AbstractExpression> predicate(
+      CreateRangePredicate(tuple_count / 4, tuple_count / 2));
+  const size_t expected_match_count = tuple_count / 4;
+
+  // Before : every evaluation allocates its operands and its result
+  Timer<> value_timer;
+  size_t value_match_count = 0;
+  value_timer.Start();
+  for (int itr = 0; itr < iterations; itr++) {
+    for (oid_t tg_itr = 0; tg_itr < table->GetTileGroupCount(); tg_itr++) {
+      auto tile_group = table->GetTileGroup(tg_itr);
+      oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+      for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+        expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+                                                             tuple_id);
+        auto eval = predicate->Evaluate(&tuple, nullptr, nullptr);
+        if (eval->IsTrue()) value_match_count++;
+      }
+    }
+  }
+  value_timer.Stop();
+
+  // After : typed values live on the stack
+  Timer<> typed_value_timer;
+  size_t typed_value_match_count = 0;
+  typed_value_timer.Start();
+  for (int itr = 0; itr < iterations; itr++) {
+    for (oid_t tg_itr = 0; tg_itr < table->GetTileGroupCount(); tg_itr++) {
+      auto tile_group = table->GetTileGroup(tg_itr);
+      oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+      for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+        expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+                                                             tuple_id);
+        auto eval = predicate->EvaluatePredicate(&tuple, nullptr, nullptr);
+        if (eval == common::CMP_TRUE) typed_value_match_count++;
+      }
+    }
+  }
+  typed_value_timer.Stop();
+
+  EXPECT_EQ(expected_match_count * iterations, value_match_count);
+  EXPECT_EQ(value_match_count, typed_value_match_count);
+
+  auto evaluations = static_cast<double>(tuple_count) * iterations;
+  LOG_INFO("Value evaluation      : %.2lf s (%.2lf M tuples/s)",
+           value_timer.GetDuration(),
+           evaluations / value_timer.GetDuration() / 1e6);
+  LOG_INFO("TypedValue evaluation : %.2lf s (%.2lf M tuples/s)",
+           typed_value_timer.GetDuration(),
+           evaluations / typed_value_timer.GetDuration() / 1e6);
+}
+
+// Scan every tile group with the batch kernels and return the match count
+static size_t ScanTable(storage::DataTable *table,
+                        expression::AbstractExpression *predicate) {
+  size_t match_count = 0;
+  std::vector<oid_t> selection;
+  std::vector<oid_t> output;
+  for (oid_t tg_itr = 0; tg_itr < table->GetTileGroupCount(); tg_itr++) {
+    auto tile_group = table->GetTileGroup(tg_itr);
+    selection.clear();
+    output.clear();
+    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++)
+      selection.push_back(tuple_id);
+    predicate->EvaluateBatch(tile_group.get(), selection, output, nullptr);
+    match_count += output.size();
+  }
+  return match_count;
+}
+
+TEST_F(PredicatePerformanceTests, ColumnKernelThroughputTest) {
+  const int tuples_per_tilegroup = 10000;
+  const int tuple_count = 20 * tuples_per_tilegroup;
+  const int iterations = 10;
+
+  peloton_layout_mode = LAYOUT_TYPE_COLUMN;
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tilegroup, false));
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+  peloton_layout_mode = LAYOUT_TYPE_ROW;
+
+  // COL_A BETWEEN 10 * low AND 10 * high
+  int low = tuple_count / 4, high = tuple_count / 2;
+  std::unique_ptr<expression::AbstractExpression> predicate(
+      expression::ExpressionUtil::ConjunctionFactory(
+          EXPRESSION_TYPE_CONJUNCTION_AND,
+          expression::ExpressionUtil::ComparisonFactory(
+              EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+              expression::ExpressionUtil::TupleValueFactory(
+                  common::Type::INTEGER, 0, 0),
+              expression::ExpressionUtil::ConstantValueFactory(
+                  common::ValueFactory::GetIntegerValue(
+                      ExecutorTestsUtil::PopulatedValue(low, 0)))),
+          expression::ExpressionUtil::ComparisonFactory(
+              EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO,
+              expression::ExpressionUtil::TupleValueFactory(
+                  common::Type::INTEGER, 0, 0),
+              expression::ExpressionUtil::ConstantValueFactory(
+                  common::ValueFactory::GetIntegerValue(
+                      ExecutorTestsUtil::PopulatedValue(high, 0))))));
+  const size_t expected_match_count = high - low + 1;
+
+  auto supported_isa = expression::ColumnKernels::GetSupportedIsa();
+  for (int isa = expression::COLUMN_KERNEL_ISA_SCALAR; isa <= supported_isa;
+       isa++) {
+    expression::ColumnKernels::SetIsa(
+        static_cast<expression::ColumnKernelIsa>(isa));
+
+    Timer<> timer;
+    size_t match_count = 0;
+    timer.Start();
+    for (int itr = 0; itr < iterations; itr++)
+      match_count += ScanTable(table.get(), predicate.get());
+    timer.Stop();
+
+    EXPECT_EQ(expected_match_count * iterations, match_count);
+    LOG_INFO("Column kernel (isa %d) : %.2lf s (%.2lf M tuples/s)", isa,
+             timer.GetDuration(),
+             static_cast<double>(tuple_count) * iterations /
+                 timer.GetDuration() / 1e6);
+  }
+  expression::ColumnKernels::SetIsa(supported_isa);
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -18,6 +18,7 @@
 #include "executor/executor_context.h"
 #include "executor/executor_tests_util.h"
 #include "executor/insert_executor.h"
+#include "gc/transaction_level_gc_manager.h"
 #include "statistics/backend_stats_context.h"
 #include "statistics/stats_aggregator.h"
 #include "statistics/stats_tests_util.h"
@@ -419,5 +420,60 @@ TEST_F(StatsTest, PerQueryStatsTest) {
   catalog->DropDatabaseWithName("emp_db", txn);
   txn_manager.CommitTransaction(txn);
 }
+
+TEST_F(StatsTest, VersionChainMetricTest) {
+  stats::VersionChainMetric metric{VERSION_CHAIN_METRIC};
+  metric.RecordChainLength(1);
+  metric.RecordChainLength(2);
+  metric.RecordChainLength(3);
+  metric.RecordChainLength(4);
+  metric.RecordChainLength(1000);
+  metric.IncrementPrunedVersions(5);
+
+  EXPECT_EQ(1, metric.GetChainLengthCount(0).GetCounter());
+  EXPECT_EQ(2, metric.GetChainLengthCount(1).GetCounter());
+  EXPECT_EQ(1, metric.GetChainLengthCount(2).GetCounter());
+  // the last bucket counts all the longer chains
+  EXPECT_EQ(1, metric.GetChainLengthCount(VERSION_CHAIN_HISTOGRAM_BUCKETS - 1)
+                   .GetCounter());
+  EXPECT_EQ(5, metric.GetPrunedVersions().GetCounter());
+
+  stats::VersionChainMetric aggregated{VERSION_CHAIN_METRIC};
+  aggregated.Aggregate(metric);
+  aggregated.Aggregate(metric);
+  EXPECT_EQ(4, aggregated.GetChainLengthCount(1).GetCounter());
+  EXPECT_EQ(10, aggregated.GetPrunedVersions().GetCounter());
+
+  aggregated.Reset();
+  EXPECT_EQ(0, aggregated.GetChainLengthCount(1).GetCounter());
+  EXPECT_EQ(0, aggregated.GetPrunedVersions().GetCounter());
+}
+
+TEST_F(StatsTest, GCMetricTest) {
+  // the GC threads are not started, so the garbage stays in the queues
+  gc::TransactionLevelGCManager gc_manager(2);
+  for (cid_t timestamp = 1; timestamp <= 3; timestamp++) {
+    auto gc_set = ReadWriteSet::CreateShared();
+    gc_set->Insert(timestamp, 0, RW_TYPE_UPDATE);
+    gc_manager.RecycleTransaction(gc_set, timestamp, GC_SET_TYPE_COMMITTED);
+  }
+
+  stats::GCMetric metric{GC_METRIC};
+  metric.Sample(gc_manager, 1);
+  EXPECT_EQ(3, metric.GetUnlinkBacklog());
+  EXPECT_EQ(0, metric.GetReclaimBacklog());
+  EXPECT_EQ(0, metric.GetReclaimedVersions());
+  EXPECT_EQ(MAX_CID, metric.GetOldestUnreclaimedCid());
+  EXPECT_EQ(2, metric.GetActiveThreadCount());
+
+  stats::GCMetric aggregated{GC_METRIC};
+  aggregated.Aggregate(metric);
+  aggregated.Aggregate(metric);
+  EXPECT_EQ(6, aggregated.GetUnlinkBacklog());
+
+  aggregated.Reset();
+  EXPECT_EQ(0, aggregated.GetUnlinkBacklog());
+  EXPECT_EQ(0, aggregated.GetActiveThreadCount());
+}
 }  // namespace stats
 }  // namespace peloton
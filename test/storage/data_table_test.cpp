@@ -10,6 +10,9 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <set>
+#include <thread>
+
 #include "common/harness.h"
 
 #include "storage/data_table.h"
@@ -88,5 +91,47 @@ TEST_F(DataTableTests, GlobalTableTest) {
   delete data_table_pointer;
 }
 
+TEST_F(DataTableTests, PerThreadInsertionTest) {
+  const size_t tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  const size_t thread_count = 4;
+
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  data_table->SetPerThreadInsertion(true);
+
+  // every thread fills a tile group, and goes on in the next one
+  std::vector<std::vector<ItemPointer>> locations(thread_count);
+  std::vector<std::thread> threads;
+  for (size_t thread_itr = 0; thread_itr < thread_count; thread_itr++) {
+    threads.emplace_back([&data_table, &locations, tuple_count, thread_itr]() {
+      for (size_t tuple_itr = 0; tuple_itr <= tuple_count; tuple_itr++) {
+        locations[thread_itr].push_back(data_table->InsertEmptyVersion());
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  // the threads number themselves one after the other, so none of them
+  // shares its slot of active tile groups with another
+  std::set<oid_t> tile_group_ids;
+  for (auto &thread_locations : locations) {
+    ASSERT_EQ(tuple_count + 1, thread_locations.size());
+    auto first_block = thread_locations[0].block;
+    for (size_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      EXPECT_EQ(first_block, thread_locations[tuple_itr].block);
+      EXPECT_EQ(tuple_itr, thread_locations[tuple_itr].offset);
+    }
+    EXPECT_NE(first_block, thread_locations[tuple_count].block);
+    EXPECT_EQ(0, thread_locations[tuple_count].offset);
+
+    tile_group_ids.insert(first_block);
+    tile_group_ids.insert(thread_locations[tuple_count].block);
+  }
+  EXPECT_EQ(2 * thread_count, tile_group_ids.size());
+  EXPECT_EQ(thread_count * (tuple_count + 1), data_table->GetTupleCount());
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -0,0 +1,160 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map_test.cpp
+//
+// Identification: test/storage/zone_map_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "common/harness.h"
+
+#include "common/value_factory.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "executor/executor_context.h"
+#include "executor/logical_tile.h"
+#include "executor/seq_scan_executor.h"
+#include "expression/expression_util.h"
+#include "planner/seq_scan_plan.h"
+#include "storage/data_table.h"
+#include "storage/tile_group.h"
+#include "storage/zone_map.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Zone Map Tests
+//===--------------------------------------------------------------------===//
+
+class ZoneMapTests : public PelotonTest {};
+
+using namespace peloton::common;
+
+TEST_F(ZoneMapTests, SummaryTest) {
+  storage::ZoneMap zone_map(
+      {Type::INTEGER, Type::DECIMAL, Type::TIMESTAMP, Type::VARCHAR});
+
+  for (int32_t value = -5; value <= 5; value++) {
+    zone_map.Update(0, TypedValue(value));
+    zone_map.Update(1, TypedValue(value * 0.5));
+  }
+  zone_map.Update(0, TypedValue::GetNullValueByType(Type::INTEGER));
+  zone_map.Update(2, TypedValue::GetNullValueByType(Type::TIMESTAMP));
+
+  TypedValue min, max;
+  EXPECT_TRUE(zone_map.GetMinMax(0, min, max));
+  EXPECT_EQ(-5, min.GetAs<int32_t>());
+  EXPECT_EQ(5, max.GetAs<int32_t>());
+  EXPECT_EQ(1, zone_map.GetNullCount(0));
+  EXPECT_TRUE(zone_map.GetMinMax(1, min, max));
+  EXPECT_EQ(-2.5, min.GetAs<double>());
+  EXPECT_EQ(2.5, max.GetAs<double>());
+
+  // Integer column
+  EXPECT_TRUE(zone_map.MayMatch(0, EXPRESSION_TYPE_COMPARE_EQUAL,
+                                TypedValue((int64_t)5)));
+  EXPECT_FALSE(zone_map.MayMatch(0, EXPRESSION_TYPE_COMPARE_EQUAL,
+                                 TypedValue((int32_t)6)));
+  EXPECT_FALSE(zone_map.MayMatch(0, EXPRESSION_TYPE_COMPARE_LESSTHAN,
+                                 TypedValue((int32_t)-5)));
+  EXPECT_TRUE(zone_map.MayMatch(0, EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO,
+                                TypedValue((int32_t)-5)));
+  EXPECT_FALSE(zone_map.MayMatch(0, EXPRESSION_TYPE_COMPARE_GREATERTHAN,
+                                 TypedValue(5.5)));
+  EXPECT_TRUE(zone_map.MayMatch(0, EXPRESSION_TYPE_COMPARE_NOTEQUAL,
+                                TypedValue((int32_t)0)));
+
+  // Decimal column, across the sign of zero
+  EXPECT_FALSE(zone_map.MayMatch(1, EXPRESSION_TYPE_COMPARE_LESSTHAN,
+                                 TypedValue(-2.5)));
+  EXPECT_TRUE(zone_map.MayMatch(
+      1, EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO, TypedValue((int32_t)2)));
+  EXPECT_FALSE(zone_map.MayMatch(1, EXPRESSION_TYPE_COMPARE_GREATERTHAN,
+                                 TypedValue(2.5)));
+
+  // A column holding only NULLs never matches
+  EXPECT_FALSE(zone_map.GetMinMax(2, min, max));
+  EXPECT_FALSE(zone_map.MayMatch(2, EXPRESSION_TYPE_COMPARE_NOTEQUAL,
+                                 TypedValue::GetTimestamp(0)));
+
+  // Neither does a NULL constant
+  auto null_constant = TypedValue::GetNullValueByType(Type::INTEGER);
+  EXPECT_FALSE(zone_map.MayMatch(0, EXPRESSION_TYPE_COMPARE_NOTEQUAL,
+                                 null_constant));
+
+  // Varchar columns are not summarized
+  EXPECT_FALSE(zone_map.IsSummarized(3));
+  EXPECT_TRUE(zone_map.MayMatch(3, EXPRESSION_TYPE_COMPARE_EQUAL,
+                                TypedValue("abc", 4)));
+
+  // An invalid zone map cannot rule anything out
+  zone_map.Invalidate();
+  EXPECT_TRUE(zone_map.MayMatch(0, EXPRESSION_TYPE_COMPARE_EQUAL,
+                                TypedValue((int32_t)6)));
+}
+
+TEST_F(ZoneMapTests, SeqScanSkipTest) {
+  const int tuples_per_tilegroup = 10;
+  const int tuple_count = 5 * tuples_per_tilegroup;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tilegroup, false));
+  ExecutorTestsUtil::PopulateTable(table.get(), tuple_count, false, false,
+                                   false, txn);
+  txn_manager.CommitTransaction(txn);
+
+  // COL_A >= 10 * 35 : only the last two tile groups may match
+  const int first_match = 35;
+  std::unique_ptr<expression::AbstractExpression> predicate(
+      expression::ExpressionUtil::ComparisonFactory(
+          EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+          expression::ExpressionUtil::TupleValueFactory(Type::INTEGER, 0, 0),
+          expression::ExpressionUtil::ConstantValueFactory(
+              ValueFactory::GetIntegerValue(
+                  ExecutorTestsUtil::PopulatedValue(first_match, 0)))));
+
+  for (oid_t tg_itr = 0; tg_itr < table->GetTileGroupCount(); tg_itr++) {
+    auto tile_group = table->GetTileGroup(tg_itr);
+    bool may_match = (tile_group->GetNextTupleSlot() > 0 &&
+                      (tg_itr + 1) * tuples_per_tilegroup > first_match);
+    EXPECT_EQ(may_match,
+              predicate->MayMatch(tile_group->GetZoneMap(), nullptr));
+  }
+
+  // A zone map that is rebuilt from the tiles gives the same answer
+  auto tile_group = table->GetTileGroup(0);
+  tile_group->InvalidateZoneMap();
+  EXPECT_FALSE(predicate->MayMatch(tile_group->GetZoneMap(), nullptr));
+  EXPECT_TRUE(tile_group->GetZoneMap().IsValid());
+
+  // Skipping tile groups does not change the result of the scan
+  txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+  planner::SeqScanPlan node(table.get(), predicate.release(), {0, 1});
+  executor::SeqScanExecutor executor(&node, context.get());
+  EXPECT_TRUE(executor.Init());
+
+  size_t result_count = 0;
+  while (executor.Execute()) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    result_count += result_tile->GetTupleCount();
+  }
+  txn_manager.CommitTransaction(txn);
+
+  EXPECT_EQ(tuple_count - first_match, result_count);
+}
+
+}  // namespace test
+}  // namespace peloton
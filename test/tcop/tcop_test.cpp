@@ -0,0 +1,96 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tcop_test.cpp
+//
+// Identification: test/tcop/tcop_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "common/harness.h"
+
+#include "catalog/catalog.h"
+#include "common/logger.h"
+#include "concurrency/transaction_manager_factory.h"
+#include "tcop/tcop.h"
+
+#include "gtest/gtest.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Traffic Cop Tests
+//===--------------------------------------------------------------------===//
+
+class TrafficCopTests : public PelotonTest {};
+
+Result ExecuteQuery(const std::string &query, std::vector<ResultType> &result,
+                    std::string &error_message, const bool read_only) {
+  std::vector<FieldInfoType> tuple_descriptor;
+  int rows_changed = 0;
+  result.clear();
+  error_message.clear();
+  return tcop::TrafficCop::GetInstance().ExecuteStatement(
+      query, result, tuple_descriptor, rows_changed, error_message, read_only);
+}
+
+TEST_F(TrafficCopTests, ReadOnlyTest) {
+  std::vector<ResultType> result;
+  std::string error_message;
+
+  EXPECT_EQ(RESULT_SUCCESS,
+            ExecuteQuery("CREATE TABLE department_table(dept_id INT PRIMARY "
+                         "KEY, dept_name TEXT);",
+                         result, error_message, false));
+  EXPECT_EQ(RESULT_SUCCESS,
+            ExecuteQuery("INSERT INTO department_table(dept_id,dept_name) "
+                         "VALUES (1,'hello_1');",
+                         result, error_message, false));
+
+  // A read-only query sees the commit that finished right before it
+  EXPECT_EQ(RESULT_SUCCESS,
+            ExecuteQuery("SELECT dept_name FROM department_table;", result,
+                         error_message, true));
+  EXPECT_EQ(1, result.size());
+  EXPECT_EQ("hello_1",
+            std::string(result[0].second.begin(), result[0].second.end()));
+
+  // Writes fail before they run
+  EXPECT_EQ(RESULT_FAILURE,
+            ExecuteQuery("INSERT INTO department_table(dept_id,dept_name) "
+                         "VALUES (2,'hello_2');",
+                         result, error_message, true));
+  EXPECT_EQ("cannot execute INSERT in a read-only transaction", error_message);
+
+  EXPECT_EQ(RESULT_FAILURE,
+            ExecuteQuery("UPDATE department_table SET dept_name = 'hello_2' "
+                         "WHERE dept_id = 1;",
+                         result, error_message, true));
+  EXPECT_EQ("cannot execute UPDATE in a read-only transaction", error_message);
+
+  EXPECT_EQ(RESULT_FAILURE,
+            ExecuteQuery("DELETE FROM department_table WHERE dept_id = 1;",
+                         result, error_message, true));
+  EXPECT_EQ("cannot execute DELETE in a read-only transaction", error_message);
+
+  // None of them changed the table
+  EXPECT_EQ(RESULT_SUCCESS,
+            ExecuteQuery("SELECT dept_name FROM department_table;", result,
+                         error_message, true));
+  EXPECT_EQ(1, result.size());
+  EXPECT_EQ("hello_1",
+            std::string(result[0].second.begin(), result[0].second.end()));
+
+  // free the database just created
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  catalog::Catalog::GetInstance()->DropDatabaseWithName(DEFAULT_DB_NAME, txn);
+  txn_manager.CommitTransaction(txn);
+}
+
+}  // End test namespace
+}  // End peloton namespace